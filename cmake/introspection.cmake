@@ -192,6 +192,21 @@ if(NOT MSVC)
   )
   set(ENABLE_AVX2 ${HAVE_AVX2})
 
+  # Check for AVX-512 population-count intrinsics.
+  set(AVX512_CXXFLAGS -mavx512f -mavx512vpopcntdq)
+  check_cxx_source_compiles_with_flags("${AVX512_CXXFLAGS}" "
+    #include <immintrin.h>
+
+    int main()
+    {
+      __m512i v = _mm512_set1_epi64(1);
+      v = _mm512_popcnt_epi64(v);
+      return (int)_mm512_reduce_add_epi64(v);
+    }
+    " HAVE_AVX512
+  )
+  set(ENABLE_AVX512 ${HAVE_AVX512})
+
   # Check for x86 SHA-NI intrinsics.
   set(X86_SHANI_CXXFLAGS -msse4 -msha)
   check_cxx_source_compiles_with_flags("${X86_SHANI_CXXFLAGS}" "
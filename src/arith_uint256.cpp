@@ -8,6 +8,7 @@
 #include <uint256.h>
 #include <crypto/common.h>
 
+#include <bit>
 #include <cassert>
 
 template <unsigned int BITS>
@@ -75,26 +76,90 @@ base_uint<BITS>& base_uint<BITS>::operator*=(const base_uint& b)
 template <unsigned int BITS>
 base_uint<BITS>& base_uint<BITS>::operator/=(const base_uint& b)
 {
-    base_uint<BITS> div = b;     // make a copy, so we can shift.
-    base_uint<BITS> num = *this; // make a copy, so we can subtract.
-    *this = 0;                   // the quotient.
-    int num_bits = num.bits();
-    int div_bits = div.bits();
+    int div_bits = b.bits();
     if (div_bits == 0)
         throw uint_error("Division by zero");
-    if (div_bits > num_bits) // the result is certainly 0.
+    int num_bits = bits();
+    if (div_bits > num_bits) { // the result is certainly 0.
+        *this = 0;
         return *this;
-    int shift = num_bits - div_bits;
-    div <<= shift; // shift so that div and num align.
-    while (shift >= 0) {
-        if (num >= div) {
-            num -= div;
-            pn[shift / 32] |= (1U << (shift & 31)); // set a bit of the result.
+    }
+
+    const int n = (div_bits + 31) / 32;     // limbs in the divisor
+    const int m = (num_bits + 31) / 32 - n; // extra limbs in the dividend
+
+    if (n == 1) {
+        // Single-limb divisor: schoolbook division with 64-bit steps.
+        const uint64_t d = b.pn[0];
+        uint64_t rem = 0;
+        for (int i = m; i >= 0; i--) {
+            uint64_t cur = (rem << 32) | pn[i];
+            pn[i] = (uint32_t)(cur / d);
+            rem = cur % d;
+        }
+        return *this;
+    }
+
+    // Knuth Algorithm D (TAOCP vol. 2, 4.3.1) with 32-bit limbs and 64-bit
+    // intermediate arithmetic: one quotient limb is estimated per iteration
+    // instead of one quotient bit, so a 256/256-bit division takes at most
+    // WIDTH multiply-subtract passes rather than up to BITS shift-compare
+    // rounds over full-width numbers.
+
+    // Normalize so that the divisor's most significant limb has its top bit
+    // set; this keeps the quotient-digit estimate within 2 of the true value.
+    const unsigned shift = std::countl_zero(b.pn[n - 1]);
+    base_uint<BITS> v = b;
+    v <<= shift;
+
+    // The normalized dividend needs one limb more than the original.
+    uint32_t un[WIDTH + 1];
+    un[0] = pn[0] << shift;
+    for (int i = 1; i < m + n; i++) {
+        un[i] = shift ? (pn[i] << shift) | (pn[i - 1] >> (32 - shift)) : pn[i];
+    }
+    un[m + n] = shift ? pn[m + n - 1] >> (32 - shift) : 0;
+
+    *this = 0; // the quotient.
+    for (int j = m; j >= 0; j--) {
+        // Estimate the quotient limb from the top two dividend limbs and the
+        // top divisor limb, then correct the (at most 2 too large) estimate
+        // using the second divisor limb.
+        const uint64_t top = ((uint64_t)un[j + n] << 32) | un[j + n - 1];
+        uint64_t qhat = top / v.pn[n - 1];
+        uint64_t rhat = top % v.pn[n - 1];
+        while (qhat >> 32 || qhat * v.pn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--;
+            rhat += v.pn[n - 1];
+            if (rhat >> 32) break;
+        }
+
+        // Multiply and subtract: un[j..j+n] -= qhat * v.
+        int64_t borrow = 0;
+        int64_t t = 0;
+        for (int i = 0; i < n; i++) {
+            uint64_t p = qhat * v.pn[i];
+            t = (int64_t)un[i + j] - borrow - (int64_t)(p & 0xffffffff);
+            un[i + j] = (uint32_t)t;
+            borrow = (int64_t)(p >> 32) - (t >> 32);
+        }
+        t = (int64_t)un[j + n] - borrow;
+        un[j + n] = (uint32_t)t;
+
+        pn[j] = (uint32_t)qhat;
+        if (t < 0) {
+            // The estimate was one too large (rare); add the divisor back.
+            pn[j]--;
+            uint64_t carry = 0;
+            for (int i = 0; i < n; i++) {
+                uint64_t s = (uint64_t)un[i + j] + v.pn[i] + carry;
+                un[i + j] = (uint32_t)s;
+                carry = s >> 32;
+            }
+            un[j + n] += (uint32_t)carry;
         }
-        div >>= 1; // shift back.
-        shift--;
     }
-    // num now contains the remainder of the division.
+    // un now contains the (normalized) remainder of the division.
     return *this;
 }
 
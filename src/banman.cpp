@@ -13,6 +13,8 @@
 #include <util/time.h>
 #include <util/translation.h>
 
+#include <algorithm>
+
 
 BanMan::BanMan(fs::path ban_file, CClientUIInterface* client_interface, int64_t default_ban_time)
     : m_client_interface(client_interface), m_ban_db(std::move(ban_file)), m_default_ban_time(default_ban_time)
@@ -43,6 +45,20 @@ void BanMan::LoadBanlist()
         m_banned = {};
         m_is_dirty = true;
     }
+    UpdateBannedSnapshot();
+}
+
+void BanMan::UpdateBannedSnapshot()
+{
+    AssertLockHeld(m_banned_mutex);
+    auto snapshot{std::make_shared<BannedSnapshot>(m_banned.begin(), m_banned.end())};
+    m_banned_snapshot.store(std::move(snapshot), std::memory_order_release);
+}
+
+void BanMan::UpdateDiscouragedSnapshot()
+{
+    AssertLockHeld(m_banned_mutex);
+    m_discouraged_snapshot.store(std::make_shared<const CRollingBloomFilter>(m_discouraged), std::memory_order_release);
 }
 
 void BanMan::DumpBanlist()
@@ -75,25 +91,24 @@ void BanMan::ClearBanned()
         LOCK(m_banned_mutex);
         m_banned.clear();
         m_is_dirty = true;
+        UpdateBannedSnapshot();
     }
     DumpBanlist(); //store banlist to disk
     if (m_client_interface) m_client_interface->BannedListChanged();
 }
 
-bool BanMan::IsDiscouraged(const CNetAddr& net_addr)
+bool BanMan::IsDiscouraged(const CNetAddr& net_addr) const
 {
-    LOCK(m_banned_mutex);
-    return m_discouraged.contains(net_addr.GetAddrBytes());
+    const auto filter{m_discouraged_snapshot.load(std::memory_order_acquire)};
+    return filter && filter->contains(net_addr.GetAddrBytes());
 }
 
-bool BanMan::IsBanned(const CNetAddr& net_addr)
+bool BanMan::IsBanned(const CNetAddr& net_addr) const
 {
+    const auto banned{m_banned_snapshot.load(std::memory_order_acquire)};
+    if (!banned) return false;
     auto current_time = GetTime();
-    LOCK(m_banned_mutex);
-    for (const auto& it : m_banned) {
-        CSubNet sub_net = it.first;
-        CBanEntry ban_entry = it.second;
-
+    for (const auto& [sub_net, ban_entry] : *banned) {
         if (current_time < ban_entry.nBanUntil && sub_net.Match(net_addr)) {
             return true;
         }
@@ -101,16 +116,17 @@ bool BanMan::IsBanned(const CNetAddr& net_addr)
     return false;
 }
 
-bool BanMan::IsBanned(const CSubNet& sub_net)
+bool BanMan::IsBanned(const CSubNet& sub_net) const
 {
+    const auto banned{m_banned_snapshot.load(std::memory_order_acquire)};
+    if (!banned) return false;
     auto current_time = GetTime();
-    LOCK(m_banned_mutex);
-    banmap_t::iterator i = m_banned.find(sub_net);
-    if (i != m_banned.end()) {
-        CBanEntry ban_entry = (*i).second;
-        if (current_time < ban_entry.nBanUntil) {
-            return true;
-        }
+    // The snapshot is sorted by subnet (it is copied from a banmap_t), so an
+    // exact match can be found with a binary search.
+    const auto it{std::lower_bound(banned->begin(), banned->end(), sub_net,
+                                   [](const auto& entry, const CSubNet& key) { return entry.first < key; })};
+    if (it != banned->end() && it->first == sub_net) {
+        return current_time < it->second.nBanUntil;
     }
     return false;
 }
@@ -125,6 +141,7 @@ void BanMan::Discourage(const CNetAddr& net_addr)
 {
     LOCK(m_banned_mutex);
     m_discouraged.insert(net_addr.GetAddrBytes());
+    UpdateDiscouragedSnapshot();
 }
 
 void BanMan::Ban(const CSubNet& sub_net, int64_t ban_time_offset, bool since_unix_epoch)
@@ -144,6 +161,7 @@ void BanMan::Ban(const CSubNet& sub_net, int64_t ban_time_offset, bool since_uni
         if (m_banned[sub_net].nBanUntil < ban_entry.nBanUntil) {
             m_banned[sub_net] = ban_entry;
             m_is_dirty = true;
+            UpdateBannedSnapshot();
         } else
             return;
     }
@@ -165,6 +183,7 @@ bool BanMan::Unban(const CSubNet& sub_net)
         LOCK(m_banned_mutex);
         if (m_banned.erase(sub_net) == 0) return false;
         m_is_dirty = true;
+        UpdateBannedSnapshot();
     }
     if (m_client_interface) m_client_interface->BannedListChanged();
     DumpBanlist(); //store banlist to disk immediately
@@ -199,8 +218,11 @@ void BanMan::SweepBanned()
         }
     }
 
-    // update UI
-    if (notify_ui && m_client_interface) {
-        m_client_interface->BannedListChanged();
+    if (notify_ui) {
+        UpdateBannedSnapshot();
+        // update UI
+        if (m_client_interface) {
+            m_client_interface->BannedListChanged();
+        }
     }
 }
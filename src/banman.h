@@ -11,9 +11,12 @@
 #include <sync.h>
 #include <util/fs.h>
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 // NOTE: When adjusting this, update rpcnet:setban's help ("24h")
 static constexpr unsigned int DEFAULT_MISBEHAVING_BANTIME = 60 * 60 * 24; // Default 24-hour ban
@@ -65,14 +68,15 @@ public:
     void Discourage(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
     void ClearBanned() EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
 
-    //! Return whether net_addr is banned
-    bool IsBanned(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
+    //! Return whether net_addr is banned. Reads a lock-free snapshot, so it
+    //! never contends with writers on m_banned_mutex.
+    bool IsBanned(const CNetAddr& net_addr) const;
 
-    //! Return whether sub_net is exactly banned
-    bool IsBanned(const CSubNet& sub_net) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
+    //! Return whether sub_net is exactly banned. Reads a lock-free snapshot.
+    bool IsBanned(const CSubNet& sub_net) const;
 
-    //! Return whether net_addr is discouraged.
-    bool IsDiscouraged(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
+    //! Return whether net_addr is discouraged. Reads a lock-free snapshot.
+    bool IsDiscouraged(const CNetAddr& net_addr) const;
 
     bool Unban(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
     bool Unban(const CSubNet& sub_net) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
@@ -84,6 +88,17 @@ private:
     //!clean unused entries (if bantime has expired)
     void SweepBanned() EXCLUSIVE_LOCKS_REQUIRED(m_banned_mutex);
 
+    //! Sorted copy of m_banned used by the lock-free readers, ordered like
+    //! banmap_t so exact-subnet lookups can binary search.
+    using BannedSnapshot = std::vector<std::pair<CSubNet, CBanEntry>>;
+
+    //! Publish a fresh immutable copy of m_banned for the lock-free readers.
+    //! Must be called whenever m_banned is modified.
+    void UpdateBannedSnapshot() EXCLUSIVE_LOCKS_REQUIRED(m_banned_mutex);
+    //! Publish a fresh immutable copy of m_discouraged for the lock-free
+    //! readers. Must be called whenever m_discouraged is modified.
+    void UpdateDiscouragedSnapshot() EXCLUSIVE_LOCKS_REQUIRED(m_banned_mutex);
+
     Mutex m_banned_mutex;
     banmap_t m_banned GUARDED_BY(m_banned_mutex);
     bool m_is_dirty GUARDED_BY(m_banned_mutex){false};
@@ -91,6 +106,14 @@ private:
     CBanDB m_ban_db;
     const int64_t m_default_ban_time;
     CRollingBloomFilter m_discouraged GUARDED_BY(m_banned_mutex) {50000, 0.000001};
+
+    // Immutable snapshots swapped atomically by the Update*Snapshot helpers.
+    // Readers hold a shared_ptr for the duration of a query, so a concurrent
+    // swap never invalidates what they are looking at. A null snapshot means
+    // "empty". Expired bans may linger in the snapshot until the next sweep;
+    // readers re-check nBanUntil, so this is not observable.
+    std::atomic<std::shared_ptr<const BannedSnapshot>> m_banned_snapshot;
+    std::atomic<std::shared_ptr<const CRollingBloomFilter>> m_discouraged_snapshot;
 };
 
 #endif // BITCOIN_BANMAN_H
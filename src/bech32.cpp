@@ -124,6 +124,43 @@ uint32_t EncodingConstant(Encoding encoding) {
     return encoding == Encoding::BECH32 ? 1 : 0x2bc830a3;
 }
 
+/** For every possible value of the top coefficient c0 of the checksum state, the combined
+ *  constant to XOR into the shifted state: the XOR of {2^n}k(x) for each set bit n of c0,
+ *  where k(x) = x^6 mod g(x). The five per-bit constants can be computed using the Sage
+ *  code in PolyMod below:
+ *
+ *  for i in [1,2,4,8,16]: # Print out {1,2,4,8,16}*(g(x) mod x^6), packed in hex integers.
+ *      v = 0
+ *      for coef in reversed((F.fetch_int(i)*(G % x**6)).coefficients(sparse=True)):
+ *          v = v*32 + coef.integer_representation()
+ *      print("0x%x" % v)
+ */
+constexpr std::array<uint32_t, 32> GeneratePolyModStepTable()
+{
+    constexpr uint32_t k[5] = {
+        0x3b6a57b2, //     k(x) = {29}x^5 + {22}x^4 + {20}x^3 + {21}x^2 + {29}x + {18}
+        0x26508e6d, //  {2}k(x) = {19}x^5 +  {5}x^4 +     x^3 +  {3}x^2 + {19}x + {13}
+        0x1ea119fa, //  {4}k(x) = {15}x^5 + {10}x^4 +  {2}x^3 +  {6}x^2 + {15}x + {26}
+        0x3d4233dd, //  {8}k(x) = {30}x^5 + {20}x^4 +  {4}x^3 + {12}x^2 + {30}x + {29}
+        0x2a1462b3, // {16}k(x) = {21}x^5 +     x^4 +  {8}x^3 + {24}x^2 + {21}x + {19}
+    };
+    std::array<uint32_t, 32> table{};
+    for (int c0 = 0; c0 < 32; ++c0) {
+        for (int n = 0; n < 5; ++n) {
+            if (c0 & (1 << n)) table[c0] ^= k[n];
+        }
+    }
+    return table;
+}
+constexpr std::array<uint32_t, 32> POLYMOD_STEP = GeneratePolyModStepTable();
+
+/** Advance the checksum state `c` by one input value. See PolyMod below for what this computes. */
+uint32_t PolyModStep(uint32_t c, uint8_t v_i)
+{
+    uint8_t c0 = c >> 25;
+    return (((c & 0x1ffffff) << 5) ^ v_i) ^ POLYMOD_STEP[c0];
+}
+
 /** This function will compute what 6 5-bit values to XOR into the last 6 input values, in order to
  *  make the checksum 0. These 6 values are packed together in a single 30-bit integer. The higher
  *  bits correspond to earlier values. */
@@ -205,12 +242,10 @@ uint32_t PolyMod(const data& v)
         //         v = v*32 + coef.integer_representation()
         //     print("0x%x" % v)
         //
-        if (c0 & 1)  c ^= 0x3b6a57b2; //     k(x) = {29}x^5 + {22}x^4 + {20}x^3 + {21}x^2 + {29}x + {18}
-        if (c0 & 2)  c ^= 0x26508e6d; //  {2}k(x) = {19}x^5 +  {5}x^4 +     x^3 +  {3}x^2 + {19}x + {13}
-        if (c0 & 4)  c ^= 0x1ea119fa; //  {4}k(x) = {15}x^5 + {10}x^4 +  {2}x^3 +  {6}x^2 + {15}x + {26}
-        if (c0 & 8)  c ^= 0x3d4233dd; //  {8}k(x) = {30}x^5 + {20}x^4 +  {4}x^3 + {12}x^2 + {30}x + {29}
-        if (c0 & 16) c ^= 0x2a1462b3; // {16}k(x) = {21}x^5 +     x^4 +  {8}x^3 + {24}x^2 + {21}x + {19}
-
+        // Rather than testing the 5 bits of c0 individually, all 32 possible combinations of
+        // {2^n}k(x) are folded into a single precomputed lookup (see POLYMOD_STEP below), making
+        // the update branch-free.
+        c ^= POLYMOD_STEP[c0];
     }
     return c;
 }
@@ -338,13 +373,18 @@ Encoding VerifyChecksum(const std::string& hrp, const data& values)
     return Encoding::INVALID;
 }
 
-/** Create a checksum. */
-data CreateChecksum(Encoding encoding, const std::string& hrp, const data& values)
+/** Create a checksum. The coefficients are fed through the checksum state directly rather than
+ *  materialized with PreparePolynomialCoefficients, so encoding performs no extra allocation. */
+std::array<uint8_t, CHECKSUM_SIZE> CreateChecksum(Encoding encoding, const std::string& hrp, const data& values)
 {
-    auto enc = PreparePolynomialCoefficients(hrp, values);
-    enc.insert(enc.end(), CHECKSUM_SIZE, 0x00);
-    uint32_t mod = PolyMod(enc) ^ EncodingConstant(encoding); // Determine what to XOR into those 6 zeroes.
-    data ret(CHECKSUM_SIZE);
+    uint32_t c = 1;
+    for (size_t i = 0; i < hrp.size(); ++i) c = PolyModStep(c, hrp[i] >> 5);
+    c = PolyModStep(c, 0);
+    for (size_t i = 0; i < hrp.size(); ++i) c = PolyModStep(c, hrp[i] & 0x1f);
+    for (const auto v_i : values) c = PolyModStep(c, v_i);
+    for (size_t i = 0; i < CHECKSUM_SIZE; ++i) c = PolyModStep(c, 0);
+    uint32_t mod = c ^ EncodingConstant(encoding); // Determine what to XOR into those 6 zeroes.
+    std::array<uint8_t, CHECKSUM_SIZE> ret;
     for (size_t i = 0; i < CHECKSUM_SIZE; ++i) {
         // Convert the 5-bit groups in mod to checksum values.
         ret[i] = (mod >> (5 * (5 - i))) & 31;
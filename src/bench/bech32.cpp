@@ -22,6 +22,28 @@ static void Bech32Encode(benchmark::Bench& bench)
 }
 
 
+/** Render a whole transaction's worth of output addresses per iteration, as
+ *  TxToUniv does for `getblock verbosity=2`. */
+static void Bech32EncodeBatch(benchmark::Bench& bench)
+{
+    constexpr size_t NUM_OUTPUTS{32};
+    constexpr std::array<uint8_t, 32> v{"c97f5a67ec381b760aeaf67573bc164845ff39a3bb26a1cee401ac67243b48db"_hex_u8};
+    std::vector<std::vector<unsigned char>> programs;
+    for (size_t n = 0; n < NUM_OUTPUTS; ++n) {
+        auto prog = v;
+        prog[0] = n;
+        std::vector<unsigned char> tmp = {0};
+        tmp.reserve(1 + prog.size() * 8 / 5);
+        ConvertBits<8, 5, true>([&](unsigned char c) { tmp.push_back(c); }, prog.begin(), prog.end());
+        programs.push_back(std::move(tmp));
+    }
+    bench.batch(NUM_OUTPUTS).unit("address").run([&] {
+        for (const auto& program : programs) {
+            bech32::Encode(bech32::Encoding::BECH32M, "bc", program);
+        }
+    });
+}
+
 static void Bech32Decode(benchmark::Bench& bench)
 {
     std::string addr = "bc1qkallence7tjawwvy0dwt4twc62qjgaw8f4vlhyd006d99f09";
@@ -32,4 +54,5 @@ static void Bech32Decode(benchmark::Bench& bench)
 
 
 BENCHMARK(Bech32Encode, benchmark::PriorityLevel::HIGH);
+BENCHMARK(Bech32EncodeBatch, benchmark::PriorityLevel::HIGH);
 BENCHMARK(Bech32Decode, benchmark::PriorityLevel::HIGH);
@@ -3,10 +3,14 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <bench/ibd_replay.h>
+#include <bench/mempool_replay.h>
 #include <common/args.h>
 #include <crypto/sha256.h>
 #include <tinyformat.h>
+#include <util/chaintype.h>
 #include <util/fs.h>
+#include <util/strencodings.h>
 #include <util/string.h>
 #include <test/util/setup_common.h>
 
@@ -39,6 +43,10 @@ static void SetupBenchArgs(ArgsManager& argsman)
     argsman.AddArg("-sanity-check", "Run benchmarks for only one iteration with no output", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-priority-level=<l1,l2,l3>", strprintf("Run benchmarks of one or multiple priority level(s) (%s), default: '%s'",
                                                            benchmark::ListPriorities(), DEFAULT_PRIORITY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-ibd-replay=<dir>", "Instead of running microbenchmarks, replay the blk*.dat files in <dir> through the full validation pipeline against a throwaway datadir and report per-stage throughput", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-ibd-chain=<chain>", "Chain the replayed block files belong to (default: main)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-ibd-dbcache=<mib1,mib2,...>", "Coins cache sizes to repeat the replay at, in MiB (default: 450)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-mempool-replay=<file>", "Instead of running microbenchmarks, replay a mempool trace captured with -mempooltrace through AcceptToMemoryPool and report accept-latency percentiles", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 }
 
 // parses a comma separated list like "10,20,30,50"
@@ -136,6 +144,33 @@ int main(int argc, char** argv)
     }
 
     try {
+        if (argsman.IsArgSet("-ibd-replay")) {
+            benchmark::IBDReplayArgs replay_args;
+            replay_args.blocks_dir = argsman.GetPathArg("-ibd-replay");
+            if (const auto chain_type{ChainTypeFromString(argsman.GetArg("-ibd-chain", "main"))}) {
+                replay_args.chain_type = *chain_type;
+            } else {
+                tfm::format(std::cerr, "Error: invalid -ibd-chain\n");
+                return EXIT_FAILURE;
+            }
+            if (argsman.IsArgSet("-ibd-dbcache")) {
+                replay_args.dbcache_sizes_mib.clear();
+                for (const auto& size_str : SplitString(argsman.GetArg("-ibd-dbcache", ""), ',')) {
+                    const auto mib{ToIntegral<size_t>(size_str)};
+                    if (!mib || *mib == 0) {
+                        tfm::format(std::cerr, "Error: invalid -ibd-dbcache value '%s'\n", size_str);
+                        return EXIT_FAILURE;
+                    }
+                    replay_args.dbcache_sizes_mib.push_back(*mib);
+                }
+            }
+            return benchmark::RunIBDReplay(replay_args);
+        }
+
+        if (argsman.IsArgSet("-mempool-replay")) {
+            return benchmark::RunMempoolReplay(argsman.GetPathArg("-mempool-replay"));
+        }
+
         benchmark::Args args;
         args.asymptote = parseAsymptote(argsman.GetArg("-asymptote", ""));
         args.is_list_only = argsman.GetBoolArg("-list", false);
@@ -8,6 +8,7 @@
 #include <key.h>
 #include <policy/policy.h>
 #include <primitives/transaction.h>
+#include <random.h>
 #include <script/script.h>
 #include <script/signingprovider.h>
 #include <test/util/transaction_utils.h>
@@ -55,3 +56,30 @@ static void CCoinsCaching(benchmark::Bench& bench)
 }
 
 BENCHMARK(CCoinsCaching, benchmark::PriorityLevel::HIGH);
+
+// Raw cache-hit lookups in a populated CCoinsViewCache. The cost here is
+// dominated by hashing the outpoint key into the backing CCoinsMap, so this
+// tracks the per-lookup overhead of SaltedOutpointHasher.
+static void CCoinsLookup(benchmark::Bench& bench)
+{
+    FastRandomContext rng{/*fDeterministic=*/true};
+    CCoinsView coins_dummy;
+    CCoinsViewCache coins(&coins_dummy);
+
+    constexpr size_t NUM_COINS{10000};
+    std::vector<COutPoint> outpoints;
+    outpoints.reserve(NUM_COINS);
+    for (size_t i{0}; i < NUM_COINS; ++i) {
+        COutPoint outpoint{Txid::FromUint256(rng.rand256()), rng.rand32() % 10};
+        coins.AddCoin(outpoint, Coin{CTxOut{CAmount{1} * COIN, CScript{} << OP_1}, /*nHeightIn=*/1, /*fCoinBaseIn=*/false}, /*possible_overwrite=*/false);
+        outpoints.push_back(outpoint);
+    }
+
+    size_t i{0};
+    bench.run([&] {
+        assert(coins.HaveCoinInCache(outpoints[i]));
+        if (++i == outpoints.size()) i = 0;
+    });
+}
+
+BENCHMARK(CCoinsLookup, benchmark::PriorityLevel::HIGH);
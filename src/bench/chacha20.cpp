@@ -19,6 +19,7 @@ static const uint64_t BUFFER_SIZE_LARGE = 1024*1024;
 
 static void CHACHA20(benchmark::Bench& bench, size_t buffersize)
 {
+    ChaCha20AutoDetect();
     std::vector<std::byte> key(32, {});
     ChaCha20 ctx(key);
     ctx.Seek({0, 0}, 0);
@@ -31,6 +32,7 @@ static void CHACHA20(benchmark::Bench& bench, size_t buffersize)
 
 static void FSCHACHA20POLY1305(benchmark::Bench& bench, size_t buffersize)
 {
+    ChaCha20AutoDetect();
     std::vector<std::byte> key(32);
     FSChaCha20Poly1305 ctx(key, 224);
     std::vector<std::byte> in(buffersize);
@@ -41,6 +43,20 @@ static void FSCHACHA20POLY1305(benchmark::Bench& bench, size_t buffersize)
     });
 }
 
+static void AEADCHACHA20POLY1305(benchmark::Bench& bench, size_t buffersize)
+{
+    ChaCha20AutoDetect();
+    std::vector<std::byte> key(32);
+    AEADChaCha20Poly1305 ctx(key);
+    std::vector<std::byte> in(buffersize);
+    std::vector<std::byte> aad(3);
+    std::vector<std::byte> out(buffersize + AEADChaCha20Poly1305::EXPANSION);
+    uint64_t nonce_counter{0};
+    bench.batch(in.size()).unit("byte").run([&] {
+        ctx.Encrypt(in, aad, {0, ++nonce_counter}, out);
+    });
+}
+
 static void CHACHA20_64BYTES(benchmark::Bench& bench)
 {
     CHACHA20(bench, BUFFER_SIZE_TINY);
@@ -56,6 +72,21 @@ static void CHACHA20_1MB(benchmark::Bench& bench)
     CHACHA20(bench, BUFFER_SIZE_LARGE);
 }
 
+static void AEADCHACHA20POLY1305_64BYTES(benchmark::Bench& bench)
+{
+    AEADCHACHA20POLY1305(bench, BUFFER_SIZE_TINY);
+}
+
+static void AEADCHACHA20POLY1305_256BYTES(benchmark::Bench& bench)
+{
+    AEADCHACHA20POLY1305(bench, BUFFER_SIZE_SMALL);
+}
+
+static void AEADCHACHA20POLY1305_1MB(benchmark::Bench& bench)
+{
+    AEADCHACHA20POLY1305(bench, BUFFER_SIZE_LARGE);
+}
+
 static void FSCHACHA20POLY1305_64BYTES(benchmark::Bench& bench)
 {
     FSCHACHA20POLY1305(bench, BUFFER_SIZE_TINY);
@@ -71,6 +102,9 @@ static void FSCHACHA20POLY1305_1MB(benchmark::Bench& bench)
     FSCHACHA20POLY1305(bench, BUFFER_SIZE_LARGE);
 }
 
+BENCHMARK(AEADCHACHA20POLY1305_64BYTES, benchmark::PriorityLevel::HIGH);
+BENCHMARK(AEADCHACHA20POLY1305_256BYTES, benchmark::PriorityLevel::HIGH);
+BENCHMARK(AEADCHACHA20POLY1305_1MB, benchmark::PriorityLevel::HIGH);
 BENCHMARK(CHACHA20_64BYTES, benchmark::PriorityLevel::HIGH);
 BENCHMARK(CHACHA20_256BYTES, benchmark::PriorityLevel::HIGH);
 BENCHMARK(CHACHA20_1MB, benchmark::PriorityLevel::HIGH);
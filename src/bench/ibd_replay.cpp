@@ -0,0 +1,97 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or https://opensource.org/license/mit/.
+
+#include <bench/ibd_replay.h>
+
+#include <kernel/cs_main.h>
+#include <node/blockstorage.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+#include <tinyformat.h>
+#include <util/fs.h>
+#include <util/time.h>
+#include <validation.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+//! Fixed coins database (leveldb) cache for every run, so that only the
+//! coins tip cache varies across the dbcache sweep.
+static constexpr size_t COINSDB_CACHE_BYTES{8 << 20};
+
+static void PrintStage(const std::string& name, SteadyClock::duration stage, SteadyClock::duration total, int64_t blocks)
+{
+    const double stage_s{Ticks<SecondsDouble>(stage)};
+    const double share{Ticks<SecondsDouble>(total) > 0 ? 100.0 * stage_s / Ticks<SecondsDouble>(total) : 0.0};
+    tfm::format(std::cout, "  %-18s %10.2fs %6.1f%% %8.3fms/blk\n",
+                name, stage_s, share, blocks > 0 ? 1000.0 * stage_s / blocks : 0.0);
+}
+
+int RunIBDReplay(const IBDReplayArgs& args)
+{
+    std::vector<fs::path> import_paths;
+    if (fs::is_directory(args.blocks_dir)) {
+        for (const auto& entry : fs::directory_iterator(args.blocks_dir)) {
+            const std::string name{entry.path().filename().string()};
+            if (entry.is_regular_file() && name.rfind("blk", 0) == 0 && entry.path().extension() == ".dat") {
+                import_paths.push_back(entry.path());
+            }
+        }
+    }
+    if (import_paths.empty()) {
+        tfm::format(std::cerr, "Error: no blk*.dat files found in %s\n", fs::PathToString(args.blocks_dir));
+        return EXIT_FAILURE;
+    }
+    std::sort(import_paths.begin(), import_paths.end());
+
+    for (const size_t dbcache_mib : args.dbcache_sizes_mib) {
+        // A fresh throwaway datadir per run; on-disk block tree and coins
+        // databases so that flushes behave as they would on a real node.
+        auto setup{MakeNoLogFileContext<TestingSetup>(args.chain_type,
+                                                      {.coins_db_in_memory = false,
+                                                       .block_tree_db_in_memory = false})};
+        ChainstateManager& chainman{*setup->m_node.chainman};
+        {
+            LOCK(cs_main);
+            chainman.ActiveChainstate().ResizeCoinsCaches(dbcache_mib << 20, COINSDB_CACHE_BYTES);
+        }
+
+        tfm::format(std::cout, "Replaying %zu block file(s) from %s with dbcache=%zu MiB ...\n",
+                    import_paths.size(), fs::PathToString(args.blocks_dir), dbcache_mib);
+
+        const auto start{SteadyClock::now()};
+        node::ImportBlocks(chainman, import_paths);
+        const auto wall{SteadyClock::now() - start};
+
+        LOCK(cs_main);
+        const auto stages{chainman.GetConnectStageTimes()};
+        const int height{chainman.ActiveChain().Height()};
+        const double wall_s{Ticks<SecondsDouble>(wall)};
+
+        tfm::format(std::cout, "Connected %d blocks to height %d in %.2fs (%.1f blk/s)\n",
+                    stages.num_blocks, height, wall_s, wall_s > 0 ? stages.num_blocks / wall_s : 0.0);
+        PrintStage("sanity checks", stages.check, wall, stages.num_blocks);
+        PrintStage("fork checks", stages.forks, wall, stages.num_blocks);
+        PrintStage("connect (coins)", stages.connect, wall, stages.num_blocks);
+        PrintStage("script verify", stages.verify, wall, stages.num_blocks);
+        PrintStage("undo write", stages.undo, wall, stages.num_blocks);
+        PrintStage("index write", stages.index, wall, stages.num_blocks);
+        PrintStage("chainstate write", stages.chainstate, wall, stages.num_blocks);
+        PrintStage("flush", stages.flush, wall, stages.num_blocks);
+        PrintStage("postprocess", stages.post_connect, wall, stages.num_blocks);
+        PrintStage("connect total", stages.total, wall, stages.num_blocks);
+        tfm::format(std::cout, "\n");
+    }
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace benchmark
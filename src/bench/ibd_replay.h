@@ -0,0 +1,40 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or https://opensource.org/license/mit/.
+
+#ifndef BITCOIN_BENCH_IBD_REPLAY_H
+#define BITCOIN_BENCH_IBD_REPLAY_H
+
+#include <util/chaintype.h>
+#include <util/fs.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace benchmark {
+
+struct IBDReplayArgs {
+    //! Directory holding blk?????.dat files to replay.
+    fs::path blocks_dir;
+    //! Chain the block files belong to.
+    ChainType chain_type{ChainType::MAIN};
+    //! Coins tip cache sizes to run the replay at, in MiB.
+    std::vector<size_t> dbcache_sizes_mib{450};
+};
+
+/**
+ * Replay a directory of block files through node::ImportBlocks() against a
+ * throwaway datadir, once per requested dbcache size, and print a per-stage
+ * throughput breakdown (sanity checks, connect, script verify, flush, ...)
+ * from the cumulative ConnectBlock() stage timers.
+ *
+ * Unlike the nanobench microbenchmarks this measures the whole validation
+ * pipeline on real chain data, so cross-subsystem effects show up.
+ *
+ * @return an exit code for main().
+ */
+int RunIBDReplay(const IBDReplayArgs& args);
+
+} // namespace benchmark
+
+#endif // BITCOIN_BENCH_IBD_REPLAY_H
@@ -0,0 +1,115 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or https://opensource.org/license/mit/.
+
+#include <bench/mempool_replay.h>
+
+#include <coins.h>
+#include <kernel/cs_main.h>
+#include <primitives/transaction.h>
+#include <streams.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+#include <tinyformat.h>
+#include <util/chaintype.h>
+#include <util/fs.h>
+#include <util/time.h>
+#include <validation.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace benchmark {
+
+int RunMempoolReplay(const fs::path& trace_file)
+{
+    AutoFile file{fsbridge::fopen(trace_file, "rb")};
+    if (file.IsNull()) {
+        tfm::format(std::cerr, "Error: unable to open mempool trace file %s\n", fs::PathToString(trace_file));
+        return EXIT_FAILURE;
+    }
+
+    // Accept on fee alone as little as possible; the trace decides the
+    // traffic shape, not this node's policy defaults.
+    auto setup{MakeNoLogFileContext<TestingSetup>(ChainType::REGTEST,
+                                                  {.extra_args = {"-minrelaytxfee=0"}})};
+    ChainstateManager& chainman{*setup->m_node.chainman};
+
+    std::vector<double> latencies_us;
+    std::unordered_set<COutPoint, SaltedOutpointHasher> trace_outpoints;
+    std::map<std::string, int> reject_reasons;
+    int accepted{0};
+
+    while (true) {
+        uint64_t timestamp_us;
+        CMutableTransaction mtx;
+        std::vector<Coin> spent_coins;
+        try {
+            file >> timestamp_us >> TX_WITH_WITNESS(mtx) >> spent_coins;
+        } catch (const std::ios_base::failure&) {
+            break; // end of trace
+        }
+        const CTransactionRef tx{MakeTransactionRef(std::move(mtx))};
+
+        {
+            // Provide the spent coins, except those created by earlier trace
+            // transactions (the mempool provides them, preserving the
+            // captured ancestry patterns). Heights are rewritten so coinbase
+            // maturity and BIP68 height locks relate to this chain's tip.
+            LOCK(cs_main);
+            CCoinsViewCache& coins{chainman.ActiveChainstate().CoinsTip()};
+            for (size_t i{0}; i < tx->vin.size(); ++i) {
+                const COutPoint& prevout{tx->vin[i].prevout};
+                if (i < spent_coins.size() && !spent_coins[i].IsSpent() && !trace_outpoints.contains(prevout)) {
+                    coins.AddCoin(prevout, Coin{spent_coins[i].out, /*nHeightIn=*/1, /*fCoinBaseIn=*/false}, /*possible_overwrite=*/true);
+                }
+            }
+        }
+
+        const auto start{SteadyClock::now()};
+        const auto result{chainman.ProcessTransaction(tx)};
+        latencies_us.push_back(Ticks<std::chrono::duration<double, std::micro>>(SteadyClock::now() - start));
+
+        if (result.m_result_type == MempoolAcceptResult::ResultType::VALID) {
+            ++accepted;
+            for (uint32_t n{0}; n < tx->vout.size(); ++n) {
+                trace_outpoints.emplace(tx->GetHash(), n);
+            }
+        } else {
+            ++reject_reasons[result.m_state.GetRejectReason()];
+        }
+    }
+
+    if (latencies_us.empty()) {
+        tfm::format(std::cerr, "Error: no records in mempool trace file %s\n", fs::PathToString(trace_file));
+        return EXIT_FAILURE;
+    }
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    const auto percentile{[&latencies_us](double p) {
+        return latencies_us[std::min(latencies_us.size() - 1, static_cast<size_t>(p * latencies_us.size()))];
+    }};
+    double total_us{0};
+    for (const double us : latencies_us) total_us += us;
+
+    tfm::format(std::cout, "Replayed %zu transactions: %d accepted, %zu rejected\n",
+                latencies_us.size(), accepted, latencies_us.size() - accepted);
+    tfm::format(std::cout, "Accept latency: p50 %.1fus, p90 %.1fus, p99 %.1fus, max %.1fus (%.0f tx/s)\n",
+                percentile(0.50), percentile(0.90), percentile(0.99), latencies_us.back(),
+                total_us > 0 ? 1e6 * latencies_us.size() / total_us : 0.0);
+    for (const auto& [reason, count] : reject_reasons) {
+        tfm::format(std::cout, "  rejected %6d: %s\n", count, reason);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace benchmark
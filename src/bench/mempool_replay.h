@@ -0,0 +1,31 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or https://opensource.org/license/mit/.
+
+#ifndef BITCOIN_BENCH_MEMPOOL_REPLAY_H
+#define BITCOIN_BENCH_MEMPOOL_REPLAY_H
+
+#include <util/fs.h>
+
+namespace benchmark {
+
+/**
+ * Replay a mempool trace captured with -mempooltrace through
+ * AcceptToMemoryPool on a throwaway regtest node and print accept-latency
+ * percentiles plus per-reason rejection counts.
+ *
+ * Each trace record carries the spent coins, which are injected into the
+ * coins cache (rewritten to height 1) before the transaction is submitted,
+ * so real captured signatures validate without the capturing node's
+ * chainstate. Transactions with anti-fee-sniping locktimes or relative
+ * timelocks anchored to the capture chain's height may be rejected as
+ * non-final here; those show up in the rejection breakdown rather than
+ * being silently skipped.
+ *
+ * @return an exit code for main().
+ */
+int RunMempoolReplay(const fs::path& trace_file);
+
+} // namespace benchmark
+
+#endif // BITCOIN_BENCH_MEMPOOL_REPLAY_H
@@ -9,11 +9,11 @@
 
 #include <vector>
 
-static void MerkleRoot(benchmark::Bench& bench)
+static void MerkleRootLeaves(benchmark::Bench& bench, size_t num_leaves)
 {
     FastRandomContext rng(true);
     std::vector<uint256> leaves;
-    leaves.resize(9001);
+    leaves.resize(num_leaves);
     for (auto& item : leaves) {
         item = rng.rand256();
     }
@@ -24,4 +24,24 @@ static void MerkleRoot(benchmark::Bench& bench)
     });
 }
 
+static void MerkleRoot(benchmark::Bench& bench)
+{
+    MerkleRootLeaves(bench, 9001);
+}
+
+// Stays below the parallel hashing threshold.
+static void MerkleRoot1kTx(benchmark::Bench& bench)
+{
+    MerkleRootLeaves(bench, 1000);
+}
+
+// Roughly a full block of minimum-size transactions; the first levels are
+// hashed in parallel.
+static void MerkleRoot32kTx(benchmark::Bench& bench)
+{
+    MerkleRootLeaves(bench, 32000);
+}
+
 BENCHMARK(MerkleRoot, benchmark::PriorityLevel::HIGH);
+BENCHMARK(MerkleRoot1kTx, benchmark::PriorityLevel::HIGH);
+BENCHMARK(MerkleRoot32kTx, benchmark::PriorityLevel::HIGH);
@@ -33,4 +33,18 @@ static void HexParse(benchmark::Bench& bench)
     });
 }
 
+// Block-scale payload, as submitted by submitblock or decoded by
+// getblock/getrawtransaction round-trips.
+static void HexParseLarge(benchmark::Bench& bench)
+{
+    auto data = generateHexString(2'000'000);
+
+    bench.batch(data.size()).unit("base16").run([&] {
+        auto result = TryParseHex(data);
+        assert(result != std::nullopt);
+        ankerl::nanobench::doNotOptimizeAway(result);
+    });
+}
+
 BENCHMARK(HexParse, benchmark::PriorityLevel::HIGH);
+BENCHMARK(HexParseLarge, benchmark::PriorityLevel::HIGH);
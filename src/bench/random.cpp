@@ -6,6 +6,7 @@
 #include <random.h>
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <iterator>
 #include <numeric>
@@ -75,6 +76,29 @@ void FastRandom_randrange1000(benchmark::Bench& bench) { BenchRandom_randrange<1
 void FastRandom_randrange1000000(benchmark::Bench& bench) { BenchRandom_randrange<1000000>(bench, FastRandomContext(true)); }
 void FastRandom_stdshuffle100(benchmark::Bench& bench) { BenchRandom_stdshuffle<100>(bench, FastRandomContext(true)); }
 
+//! Per-call construction: what ad-hoc `FastRandomContext().rand64()` call sites pay.
+void FastRandomPerCall_rand64(benchmark::Bench& bench)
+{
+    bench.batch(1).unit("number").run([&] {
+        FastRandomContext().rand64();
+    });
+}
+
+void ThreadLocalRng_rand64(benchmark::Bench& bench)
+{
+    bench.batch(1).unit("number").run([&] {
+        ThreadLocalRng().rand64();
+    });
+}
+
+void ThreadLocalRng_fillrand256(benchmark::Bench& bench)
+{
+    std::array<std::byte, 256> buf;
+    bench.batch(buf.size()).unit("byte").run([&] {
+        ThreadLocalRng().fillrand(buf);
+    });
+}
+
 void InsecureRandom_rand64(benchmark::Bench& bench) { BenchRandom_rand64(bench, InsecureRandomContext(251438)); }
 void InsecureRandom_rand32(benchmark::Bench& bench) { BenchRandom_rand32(bench, InsecureRandomContext(251438)); }
 void InsecureRandom_randbool(benchmark::Bench& bench) { BenchRandom_randbool(bench, InsecureRandomContext(251438)); }
@@ -95,6 +119,10 @@ BENCHMARK(FastRandom_randrange1000, benchmark::PriorityLevel::HIGH);
 BENCHMARK(FastRandom_randrange1000000, benchmark::PriorityLevel::HIGH);
 BENCHMARK(FastRandom_stdshuffle100, benchmark::PriorityLevel::HIGH);
 
+BENCHMARK(FastRandomPerCall_rand64, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ThreadLocalRng_rand64, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ThreadLocalRng_fillrand256, benchmark::PriorityLevel::HIGH);
+
 BENCHMARK(InsecureRandom_rand64, benchmark::PriorityLevel::HIGH);
 BENCHMARK(InsecureRandom_rand32, benchmark::PriorityLevel::HIGH);
 BENCHMARK(InsecureRandom_randbool, benchmark::PriorityLevel::HIGH);
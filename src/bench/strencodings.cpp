@@ -4,6 +4,7 @@
 
 #include <bench/bench.h>
 #include <bench/data/block413567.raw.h>
+#include <crypto/hex_base.h>
 #include <span.h>
 #include <util/strencodings.h>
 
@@ -11,6 +12,7 @@
 
 static void HexStrBench(benchmark::Bench& bench)
 {
+    HexStrAutoDetect();
     auto const& data = benchmark::data::block413567;
     bench.batch(data.size()).unit("byte").run([&] {
         auto hex = HexStr(data);
@@ -18,4 +20,16 @@ static void HexStrBench(benchmark::Bench& bench)
     });
 }
 
+// Txid-sized payloads, where the per-call overhead dominates.
+static void HexStrBenchSmall(benchmark::Bench& bench)
+{
+    HexStrAutoDetect();
+    auto const data = Span{benchmark::data::block413567}.first(32);
+    bench.batch(data.size()).unit("byte").run([&] {
+        auto hex = HexStr(data);
+        ankerl::nanobench::doNotOptimizeAway(hex);
+    });
+}
+
 BENCHMARK(HexStrBench, benchmark::PriorityLevel::HIGH);
+BENCHMARK(HexStrBenchSmall, benchmark::PriorityLevel::HIGH);
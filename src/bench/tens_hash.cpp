@@ -0,0 +1,129 @@
+// Copyright (c) 2025-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <crypto/tens_pow/tens_ctx_cache.h>
+#include <crypto/tens_pow/tens_hash.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+struct CtxDeleter {
+    void operator()(TensHashContext* ctx) const { tens_hash_free(ctx); }
+};
+using CtxPtr = std::unique_ptr<TensHashContext, CtxDeleter>;
+
+CtxPtr MakeContext(uint8_t fill)
+{
+    uint8_t seed[32];
+    memset(seed, fill, sizeof(seed));
+    return CtxPtr{tens_hash_init(seed)};
+}
+} // namespace
+
+/* Context construction: 66 ChaCha20-derived matrices (~67MB of keystream). */
+static void TensHashInit(benchmark::Bench& bench)
+{
+    TensHashAutoDetect();
+    uint8_t seed[32] = {1};
+    bench.unit("context").run([&] {
+        seed[0]++; // defeat any per-seed memoization
+        CtxPtr ctx{tens_hash_init(seed)};
+        assert(ctx);
+    });
+}
+
+/* Single hash through a prebuilt context (the header-verification kernel). */
+static void TensHashPrecomputed(benchmark::Bench& bench)
+{
+    TensHashAutoDetect();
+    CtxPtr ctx = MakeContext(0x42);
+    uint8_t input[TENS_IN_SIZE] = {0};
+    uint8_t output[TENS_IN_SIZE];
+    bench.unit("hash").run([&] {
+        input[0]++;
+        tens_hash_precomputed(input, ctx.get(), output);
+    });
+}
+
+/* Full hash including matrix generation (cache-cold header verification). */
+static void TensHashCold(benchmark::Bench& bench)
+{
+    TensHashAutoDetect();
+    uint8_t seed[32] = {2};
+    uint8_t input[TENS_IN_SIZE] = {0};
+    uint8_t output[TENS_IN_SIZE];
+    bench.unit("hash").run([&] {
+        seed[0]++;
+        tens_hash(input, seed, output);
+    });
+}
+
+/* Repeated-seed hashing through the shared context cache (warm path). */
+static void TensHashCacheWarm(benchmark::Bench& bench)
+{
+    TensHashAutoDetect();
+    uint8_t seed[32] = {3};
+    uint8_t input[TENS_IN_SIZE] = {0};
+    uint8_t output[TENS_IN_SIZE];
+    bench.unit("hash").run([&] {
+        input[0]++;
+        auto ctx = TensHashContexts().Get(seed);
+        tens_hash_precomputed(input, ctx.get(), output);
+    });
+}
+
+static void TensHashBatchN(benchmark::Bench& bench, size_t batch)
+{
+    TensHashAutoDetect();
+    CtxPtr ctx = MakeContext(0x17);
+    std::vector<uint8_t> inputs(batch * TENS_IN_SIZE, 0);
+    std::vector<uint8_t> outputs(batch * TENS_IN_SIZE);
+    for (size_t i = 0; i < batch; i++) inputs[i * TENS_IN_SIZE] = (uint8_t)i;
+    bench.batch(batch).unit("hash").run([&] {
+        inputs[1]++;
+        tens_hash_batch(inputs.data(), batch, ctx.get(), outputs.data());
+    });
+}
+
+static void TensHashBatch16(benchmark::Bench& bench) { TensHashBatchN(bench, 16); }
+static void TensHashBatch64(benchmark::Bench& bench) { TensHashBatchN(bench, 64); }
+static void TensHashBatch256(benchmark::Bench& bench) { TensHashBatchN(bench, 256); }
+
+/* Per-kernel comparison: same single-hash loop pinned to one kernel tier,
+ * so hosts can quantify what autodetection buys them. Silently skipped when
+ * the tier is not compiled in or not supported on this machine. */
+static void TensHashKernel(benchmark::Bench& bench, const std::string& kernel)
+{
+    if (!TensHashSelect(kernel)) return;
+    CtxPtr ctx = MakeContext(0x42);
+    uint8_t input[TENS_IN_SIZE] = {0};
+    uint8_t output[TENS_IN_SIZE];
+    bench.unit("hash").run([&] {
+        input[0]++;
+        tens_hash_precomputed(input, ctx.get(), output);
+    });
+    TensHashAutoDetect();
+}
+
+static void TensHashKernelPortable(benchmark::Bench& bench) { TensHashKernel(bench, "portable"); }
+static void TensHashKernelAVX2(benchmark::Bench& bench) { TensHashKernel(bench, "avx2"); }
+static void TensHashKernelAVX512(benchmark::Bench& bench) { TensHashKernel(bench, "avx512-vpopcnt"); }
+static void TensHashKernelNEON(benchmark::Bench& bench) { TensHashKernel(bench, "neon"); }
+
+BENCHMARK(TensHashInit, benchmark::PriorityLevel::HIGH);
+BENCHMARK(TensHashPrecomputed, benchmark::PriorityLevel::HIGH);
+BENCHMARK(TensHashCold, benchmark::PriorityLevel::LOW);
+BENCHMARK(TensHashCacheWarm, benchmark::PriorityLevel::HIGH);
+BENCHMARK(TensHashBatch16, benchmark::PriorityLevel::HIGH);
+BENCHMARK(TensHashBatch64, benchmark::PriorityLevel::HIGH);
+BENCHMARK(TensHashBatch256, benchmark::PriorityLevel::LOW);
+BENCHMARK(TensHashKernelPortable, benchmark::PriorityLevel::LOW);
+BENCHMARK(TensHashKernelAVX2, benchmark::PriorityLevel::LOW);
+BENCHMARK(TensHashKernelAVX512, benchmark::PriorityLevel::LOW);
+BENCHMARK(TensHashKernelNEON, benchmark::PriorityLevel::LOW);
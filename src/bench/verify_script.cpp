@@ -87,5 +87,40 @@ static void VerifyNestedIfScript(benchmark::Bench& bench)
     });
 }
 
+// Sighash throughput for a consolidation-style taproot transaction with many
+// inputs, where the transaction-level sighash prefix is shared by all inputs
+// through the midstate in PrecomputedTransactionData.
+static void TaprootSighashManyInputs(benchmark::Bench& bench)
+{
+    constexpr uint32_t NUM_INPUTS{500};
+
+    CMutableTransaction tx;
+    std::vector<CTxOut> spent_outputs;
+    tx.vin.reserve(NUM_INPUTS);
+    spent_outputs.reserve(NUM_INPUTS);
+    for (uint32_t i = 0; i < NUM_INPUTS; ++i) {
+        const Txid txid{Txid::FromUint256((HashWriter{} << i).GetSHA256())};
+        tx.vin.emplace_back(COutPoint{txid, 0});
+        const uint256 dummy_key{(HashWriter{} << i << i).GetSHA256()};
+        spent_outputs.emplace_back(CAmount{10000}, CScript() << OP_1 << ToByteVector(dummy_key));
+    }
+    tx.vout.emplace_back(CAmount{NUM_INPUTS * 10000 - 5000}, spent_outputs.front().scriptPubKey);
+
+    PrecomputedTransactionData txdata;
+    txdata.Init(tx, std::move(spent_outputs), /*force=*/true);
+    ScriptExecutionData execdata;
+    execdata.m_annex_init = true;
+    execdata.m_annex_present = false;
+
+    bench.run([&] {
+        uint256 sighash;
+        for (uint32_t i = 0; i < tx.vin.size(); ++i) {
+            const bool ok{SignatureHashSchnorr(sighash, execdata, tx, i, SIGHASH_DEFAULT, SigVersion::TAPROOT, txdata, MissingDataBehavior::ASSERT_FAIL)};
+            assert(ok);
+        }
+    });
+}
+
 BENCHMARK(VerifyScriptBench, benchmark::PriorityLevel::HIGH);
 BENCHMARK(VerifyNestedIfScript, benchmark::PriorityLevel::HIGH);
+BENCHMARK(TaprootSighashManyInputs, benchmark::PriorityLevel::HIGH);
@@ -21,4 +21,17 @@ static void Xor(benchmark::Bench& bench)
     });
 }
 
+static void XorObfuscationKey(benchmark::Bench& bench)
+{
+    FastRandomContext frc{/*fDeterministic=*/true};
+    // The blocksdir/db obfuscation path: an 8-byte key over bulk data.
+    auto data{frc.randbytes<std::byte>(1 << 20)};
+    auto key{frc.randbytes<std::byte>(8)};
+
+    bench.batch(data.size()).unit("byte").run([&] {
+        util::Xor(data, key);
+    });
+}
+
 BENCHMARK(Xor, benchmark::PriorityLevel::HIGH);
+BENCHMARK(XorObfuscationKey, benchmark::PriorityLevel::HIGH);
@@ -33,12 +33,19 @@
 #include <validation.h>
 #include <validationinterface.h>
 
+#include <streams.h>
+#include <util/time.h>
+
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <vector>
 
 int main(int argc, char* argv[])
 {
@@ -49,16 +56,49 @@ int main(int argc, char* argv[])
     LogInstance().DisableLogging();
 
     // SETUP: Argument parsing and handling
-    if (argc != 2) {
+    fs::path abs_datadir;
+    fs::path replay_dir;
+    int replay_from{-1};
+    int replay_to{-1};
+    int worker_threads{0};
+    size_t cache_mib{DEFAULT_KERNEL_CACHE >> 20};
+    bool bad_args{argc < 2};
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg{argv[i]};
+        if (arg.rfind("-replay=", 0) == 0) {
+            replay_dir = fs::absolute(fs::PathFromString(arg.substr(8)));
+        } else if (arg.rfind("-replay-from=", 0) == 0) {
+            replay_from = std::atoi(arg.c_str() + 13);
+        } else if (arg.rfind("-replay-to=", 0) == 0) {
+            replay_to = std::atoi(arg.c_str() + 11);
+        } else if (arg.rfind("-par=", 0) == 0) {
+            worker_threads = std::atoi(arg.c_str() + 5);
+        } else if (arg.rfind("-dbcache=", 0) == 0) {
+            cache_mib = std::strtoul(arg.c_str() + 9, nullptr, 10);
+        } else if (abs_datadir.empty() && !arg.empty() && arg[0] != '-') {
+            abs_datadir = fs::absolute(fs::PathFromString(arg));
+        } else {
+            bad_args = true;
+        }
+    }
+    if (bad_args || abs_datadir.empty()) {
         std::cerr
-            << "Usage: " << argv[0] << " DATADIR" << std::endl
+            << "Usage: " << argv[0] << " DATADIR [OPTIONS]" << std::endl
             << "Display DATADIR information, and process hex-encoded blocks on standard input." << std::endl
             << std::endl
+            << "Options (profiling / replay):" << std::endl
+            << "  -replay=<dir>      replay blk*.dat files from <dir> through kernel validation" << std::endl
+            << "                     instead of reading blocks from standard input, emitting" << std::endl
+            << "                     per-block stage timings as CSV on standard output" << std::endl
+            << "  -replay-from=<n>   first blk file number to replay (default: all)" << std::endl
+            << "  -replay-to=<n>     last blk file number to replay (default: all)" << std::endl
+            << "  -par=<n>           script verification worker threads (default: 0)" << std::endl
+            << "  -dbcache=<n>       total kernel cache size in MiB (default: " << (DEFAULT_KERNEL_CACHE >> 20) << ")" << std::endl
+            << std::endl
             << "IMPORTANT: THIS EXECUTABLE IS EXPERIMENTAL, FOR TESTING ONLY, AND EXPECTED TO" << std::endl
             << "           BREAK IN FUTURE VERSIONS. DO NOT USE ON YOUR ACTUAL DATADIR." << std::endl;
         return 1;
     }
-    fs::path abs_datadir{fs::absolute(argv[1])};
     fs::create_directories(abs_datadir);
 
 
@@ -74,18 +114,22 @@ int main(int argc, char* argv[])
     class KernelNotifications : public kernel::Notifications
     {
     public:
+        //! Suppress the chatty stdout notifications, so replay mode can emit
+        //! clean machine-readable output there.
+        bool quiet{false};
+
         kernel::InterruptResult blockTip(SynchronizationState, CBlockIndex&) override
         {
-            std::cout << "Block tip changed" << std::endl;
+            if (!quiet) std::cout << "Block tip changed" << std::endl;
             return {};
         }
         void headerTip(SynchronizationState, int64_t height, int64_t timestamp, bool presync) override
         {
-            std::cout << "Header tip changed: " << height << ", " << timestamp << ", " << presync << std::endl;
+            if (!quiet) std::cout << "Header tip changed: " << height << ", " << timestamp << ", " << presync << std::endl;
         }
         void progress(const bilingual_str& title, int progress_percent, bool resume_possible) override
         {
-            std::cout << "Progress: " << title.original << ", " << progress_percent << ", " << resume_possible << std::endl;
+            if (!quiet) std::cout << "Progress: " << title.original << ", " << progress_percent << ", " << resume_possible << std::endl;
         }
         void warningSet(kernel::Warning id, const bilingual_str& message) override
         {
@@ -105,6 +149,7 @@ int main(int argc, char* argv[])
         }
     };
     auto notifications = std::make_unique<KernelNotifications>();
+    notifications->quiet = !replay_dir.empty();
 
 
     // SETUP: Chainstate
@@ -114,6 +159,7 @@ int main(int argc, char* argv[])
         .datadir = abs_datadir,
         .notifications = *notifications,
         .signals = &validation_signals,
+        .worker_threads_num = worker_threads,
     };
     const node::BlockManager::Options blockman_opts{
         .chainparams = chainman_opts.chainparams,
@@ -123,7 +169,7 @@ int main(int argc, char* argv[])
     util::SignalInterrupt interrupt;
     ChainstateManager chainman{interrupt, chainman_opts, blockman_opts};
 
-    kernel::CacheSizes cache_sizes{DEFAULT_KERNEL_CACHE};
+    kernel::CacheSizes cache_sizes{cache_mib << 20};
     node::ChainstateLoadOptions options;
     auto [status, error] = node::LoadChainstate(chainman, cache_sizes, options);
     if (status != node::ChainstateLoadStatus::SUCCESS) {
@@ -145,6 +191,81 @@ int main(int argc, char* argv[])
         }
     }
 
+    // PROFILING: replay block files through kernel validation, emitting
+    // per-block stage timings as CSV. A minimal wallet-free, net-free way to
+    // profile consensus hot paths without the full daemon's background
+    // threads polluting the profile.
+    if (!replay_dir.empty()) {
+        std::vector<fs::path> import_paths;
+        if (fs::is_directory(replay_dir)) {
+            for (const auto& entry : fs::directory_iterator(replay_dir)) {
+                const std::string name{entry.path().filename().string()};
+                if (!entry.is_regular_file() || name.rfind("blk", 0) != 0 || entry.path().extension() != ".dat") continue;
+                const int num{std::atoi(name.c_str() + 3)};
+                if (replay_from >= 0 && num < replay_from) continue;
+                if (replay_to >= 0 && num > replay_to) continue;
+                import_paths.push_back(entry.path());
+            }
+        }
+        std::sort(import_paths.begin(), import_paths.end());
+        if (import_paths.empty()) {
+            std::cerr << "No blk*.dat files to replay in " << fs::PathToString(replay_dir) << std::endl;
+            goto epilogue;
+        }
+
+        // Prints one CSV row per connected block, with the stage time deltas
+        // from the chainstate manager's cumulative ConnectBlock() timers.
+        class StageTimingsPrinter final : public CValidationInterface
+        {
+        public:
+            explicit StageTimingsPrinter(ChainstateManager& chainman) : m_chainman(chainman) {}
+
+        protected:
+            void BlockConnected(ChainstateRole, const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex) override
+            {
+                const auto stages{WITH_LOCK(::cs_main, return m_chainman.GetConnectStageTimes())};
+                const auto us{[](SteadyClock::duration d) { return Ticks<std::chrono::microseconds>(d); }};
+                std::cout << pindex->nHeight << ',' << block->GetHash().ToString() << ',' << block->vtx.size()
+                          << ',' << us(stages.check - m_prev.check)
+                          << ',' << us(stages.forks - m_prev.forks)
+                          << ',' << us(stages.connect - m_prev.connect)
+                          << ',' << us(stages.verify - m_prev.verify)
+                          << ',' << us(stages.undo - m_prev.undo)
+                          << ',' << us(stages.index - m_prev.index)
+                          << ',' << us(stages.chainstate - m_prev.chainstate)
+                          << ',' << us(stages.flush - m_prev.flush)
+                          << ',' << us(stages.post_connect - m_prev.post_connect)
+                          << ',' << us(stages.total - m_prev.total) << '\n';
+                m_prev = stages;
+            }
+
+        private:
+            ChainstateManager& m_chainman;
+            ChainstateManager::ConnectStageTimes m_prev{};
+        };
+
+        auto printer = std::make_shared<StageTimingsPrinter>(chainman);
+        validation_signals.RegisterSharedValidationInterface(printer);
+        std::cout << "height,hash,txs,check_us,forks_us,connect_us,verify_us,undo_us,index_us,chainstate_us,flush_us,post_us,total_us" << std::endl;
+        for (const fs::path& path : import_paths) {
+            AutoFile file{fsbridge::fopen(path, "rb")};
+            if (file.IsNull()) {
+                std::cerr << "Failed to open " << fs::PathToString(path) << std::endl;
+                continue;
+            }
+            chainman.LoadExternalBlockFile(file);
+        }
+        for (Chainstate* chainstate : WITH_LOCK(::cs_main, return chainman.GetAll())) {
+            BlockValidationState state;
+            if (!chainstate->ActivateBestChain(state, nullptr)) {
+                std::cerr << "Failed to connect best block (" << state.ToString() << ")" << std::endl;
+                break;
+            }
+        }
+        validation_signals.UnregisterSharedValidationInterface(printer);
+        goto epilogue;
+    }
+
     // Main program logic starts here
     std::cout
         << "Hello! I'm going to print out some information about your datadir." << std::endl
@@ -13,13 +13,17 @@
 #include <common/system.h>
 #include <compat/compat.h>
 #include <core_io.h>
+#include <crypto/tens_pow/tens_hash.h>
 #include <streams.h>
+#include <uint256.h>
 #include <util/exception.h>
 #include <util/strencodings.h>
 #include <util/translation.h>
 
 #include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <thread>
@@ -85,28 +89,44 @@ static int AppInitUtil(ArgsManager& args, int argc, char* argv[])
     return CONTINUE_EXECUTION;
 }
 
-static void grind_task(uint32_t nBits, CBlockHeader header, uint32_t offset, uint32_t step, std::atomic<bool>& found, uint32_t& proposed_nonce)
+/** Number of nonces each worker hashes per tens_hash_batch() call. Large
+ *  enough to amortize streaming the matrices from memory across the batch,
+ *  small enough that workers notice `found` promptly. */
+static constexpr size_t GRIND_BATCH_SIZE{64};
+
+static void grind_task(const arith_uint256& target, TensHashContext* ctx, uint32_t offset, uint32_t step, std::atomic<bool>& found, uint32_t& proposed_nonce, std::atomic<uint64_t>& hash_count)
 {
-    arith_uint256 target;
-    bool neg, over;
-    target.SetCompact(nBits, &neg, &over);
-    if (target == 0 || neg || over) return;
-    header.nNonce = offset;
+    // The TensHash seed is the nonce-less header hash, so every nonce is
+    // tried under the one shared context; an attempt only varies the 32-byte
+    // nonce input. Batch hashing streams each matrix row from memory once per
+    // GRIND_BATCH_SIZE nonces instead of once per nonce.
+    uint8_t inputs[GRIND_BATCH_SIZE][TENS_IN_SIZE];
+    uint8_t outputs[GRIND_BATCH_SIZE][TENS_IN_SIZE];
+    uint32_t nonces[GRIND_BATCH_SIZE];
+    uint64_t next_nonce{offset};
+
+    while (!found) {
+        size_t count{0};
+        for (; count < GRIND_BATCH_SIZE && next_nonce <= std::numeric_limits<uint32_t>::max(); ++count, next_nonce += step) {
+            nonces[count] = static_cast<uint32_t>(next_nonce);
+            memset(inputs[count], 0, TENS_IN_SIZE);
+            memcpy(inputs[count], &nonces[count], sizeof(uint32_t));
+        }
+        if (count == 0) return; // nonce space exhausted
 
-    uint32_t finish = std::numeric_limits<uint32_t>::max() - step;
-    finish = finish - (finish % step) + offset;
+        tens_hash_batch(&inputs[0][0], count, ctx, &outputs[0][0]);
+        hash_count += count;
 
-    while (!found && header.nNonce < finish) {
-        const uint32_t next = (finish - header.nNonce < 5000*step) ? finish : header.nNonce + 5000*step;
-        do {
-            if (UintToArith256(header.GetHash()) <= target) {
+        for (size_t i{0}; i < count; ++i) {
+            uint256 pow_hash;
+            memcpy(pow_hash.begin(), outputs[i], TENS_IN_SIZE);
+            if (UintToArith256(pow_hash) <= target) {
                 if (!found.exchange(true)) {
-                    proposed_nonce = header.nNonce;
+                    proposed_nonce = nonces[i];
                 }
                 return;
             }
-            header.nNonce += step;
-        } while(header.nNonce != next);
+        }
     }
 }
 
@@ -123,19 +143,59 @@ static int Grind(const std::vector<std::string>& args, std::string& strPrint)
         return EXIT_FAILURE;
     }
 
-    uint32_t nBits = header.nBits;
+    arith_uint256 target;
+    bool neg, over;
+    target.SetCompact(header.nBits, &neg, &over);
+    if (target == 0 || neg || over) {
+        strPrint = "Could not decode difficulty target";
+        return EXIT_FAILURE;
+    }
+
+    // Build the context once from the nonce-less header hash; it is immutable
+    // after tens_hash_init(), so all workers share it read-only.
+    const uint256 seed{header.GetHash()};
+    TensHashContext* ctx{tens_hash_init(seed.begin())};
+    if (!ctx) {
+        strPrint = "Could not build TensHash context";
+        return EXIT_FAILURE;
+    }
+
     std::atomic<bool> found{false};
+    std::atomic<uint64_t> hash_count{0};
     uint32_t proposed_nonce{};
 
     std::vector<std::thread> threads;
     int n_tasks = std::max(1u, std::thread::hardware_concurrency());
     threads.reserve(n_tasks);
     for (int i = 0; i < n_tasks; ++i) {
-        threads.emplace_back(grind_task, nBits, header, i, n_tasks, std::ref(found), std::ref(proposed_nonce));
+        threads.emplace_back(grind_task, std::cref(target), ctx, i, n_tasks, std::ref(found), std::ref(proposed_nonce), std::ref(hash_count));
     }
+
+    // Report the aggregate hash rate every few seconds until the workers are
+    // done, so long grinds are distinguishable from a hung process.
+    std::atomic<bool> done{false};
+    std::thread reporter([&] {
+        auto last_time{std::chrono::steady_clock::now()};
+        uint64_t last_count{0};
+        while (!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{250});
+            const auto now{std::chrono::steady_clock::now()};
+            if (now - last_time < std::chrono::seconds{5}) continue;
+            const uint64_t count{hash_count.load()};
+            const double elapsed{std::chrono::duration<double>(now - last_time).count()};
+            tfm::format(std::cerr, "%.1f hash/s (%d hashes total)\n", (count - last_count) / elapsed, count);
+            last_time = now;
+            last_count = count;
+        }
+    });
+
     for (auto& t : threads) {
         t.join();
     }
+    done = true;
+    reporter.join();
+    tens_hash_free(ctx);
+
     if (found) {
         header.nNonce = proposed_nonce;
     } else {
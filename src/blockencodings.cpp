@@ -15,17 +15,31 @@
 #include <txmempool.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
 #include <unordered_map>
 
-CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block, const uint64_t nonce) :
-        nonce(nonce),
-        shorttxids(block.vtx.size() - 1), prefilledtxn(1), header(block) {
+CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block, const uint64_t nonce, const std::vector<uint16_t>& extra_prefill) :
+        nonce(nonce), header(block) {
     FillShortTxIDSelector();
-    //TODO: Use our mempool prior to block acceptance to predictively fill more than just the coinbase
-    prefilledtxn[0] = {0, block.vtx[0]};
+    prefilledtxn.reserve(1 + extra_prefill.size());
+    prefilledtxn.push_back({0, block.vtx[0]});
+    shorttxids.reserve(block.vtx.size() - 1 - extra_prefill.size());
+    uint16_t last_prefilled{0};
+    auto prefill_it{extra_prefill.begin()};
     for (size_t i = 1; i < block.vtx.size(); i++) {
         const CTransaction& tx = *block.vtx[i];
-        shorttxids[i - 1] = GetShortID(tx.GetWitnessHash());
+        if (prefill_it != extra_prefill.end() && *prefill_it == i) {
+            // The wire encoding stores the index as an offset since the last
+            // prefilled transaction.
+            prefilledtxn.push_back({static_cast<uint16_t>(i - last_prefilled - 1), block.vtx[i]});
+            last_prefilled = i;
+            ++prefill_it;
+        } else {
+            shorttxids.push_back(GetShortID(tx.GetWitnessHash()));
+        }
     }
 }
 
@@ -45,9 +59,14 @@ uint64_t CBlockHeaderAndShortTxIDs::GetShortID(const Wtxid& wtxid) const {
     return SipHashUint256(shorttxidk0, shorttxidk1, wtxid) & 0xffffffffffffL;
 }
 
+void CBlockHeaderAndShortTxIDs::GetShortIDs(Span<const uint256* const> wtxids, Span<uint64_t> out) const {
+    SipHashUint256Batch(shorttxidk0, shorttxidk1, wtxids, out);
+    for (uint64_t& id : out) id &= 0xffffffffffffL;
+}
+
 
 
-ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<CTransactionRef>& extra_txn) {
+ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::deque<CTransactionRef>& extra_txn) {
     if (cmpctblock.header.IsNull() || (cmpctblock.shorttxids.empty() && cmpctblock.prefilledtxn.empty()))
         return READ_STATUS_INVALID;
     if (cmpctblock.shorttxids.size() + cmpctblock.prefilledtxn.size() > MAX_BLOCK_WEIGHT / MIN_SERIALIZABLE_TRANSACTION_WEIGHT)
@@ -107,24 +126,83 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
     std::vector<bool> have_txn(txn_available.size());
     {
     LOCK(pool->cs);
-    for (const auto& tx : pool->txns_randomized) {
-        uint64_t shortid = cmpctblock.GetShortID(tx->GetWitnessHash());
-        std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
-        if (idit != shorttxids.end()) {
-            if (!have_txn[idit->second]) {
-                txn_available[idit->second] = tx;
-                have_txn[idit->second]  = true;
-                mempool_count++;
-            } else {
-                // If we find two mempool txn that match the short id, just request it.
-                // This should be rare enough that the extra bandwidth doesn't matter,
-                // but eating a round-trip due to FillBlock failure would be annoying
-                if (txn_available[idit->second]) {
-                    txn_available[idit->second].reset();
-                    mempool_count--;
+    // Matching the mempool against the short IDs is pure SipHash work over
+    // every wtxid; for large mempools, split the scan across threads and
+    // apply the collected matches serially below. The short ID keys are
+    // derived from this block's header and nonce, so the scan cannot be
+    // amortized across blocks by any persistent index.
+    std::vector<std::pair<uint16_t, CTransactionRef>> matches;
+    const auto& mempool_txns{pool->txns_randomized};
+    // Compute short IDs in batches of wtxids so the vectorized multi-lane
+    // SipHash implementation can be used.
+    constexpr size_t SHORTID_BATCH{64};
+    constexpr size_t MIN_PARALLEL_SCAN_TXNS{10'000};
+    if (mempool_txns.size() >= MIN_PARALLEL_SCAN_TXNS) {
+        const size_t num_threads{std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4)};
+        const size_t chunk{(mempool_txns.size() + num_threads - 1) / num_threads};
+        std::vector<std::vector<std::pair<uint16_t, CTransactionRef>>> thread_matches(num_threads);
+        std::atomic<size_t> num_found{0};
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t] {
+                std::array<const uint256*, SHORTID_BATCH> wtxids;
+                std::array<uint64_t, SHORTID_BATCH> ids;
+                const size_t end{std::min(chunk * (t + 1), mempool_txns.size())};
+                for (size_t i = chunk * t; i < end; i += SHORTID_BATCH) {
+                    if (num_found.load(std::memory_order_relaxed) >= shorttxids.size()) return;
+                    const size_t n{std::min(SHORTID_BATCH, end - i)};
+                    for (size_t j = 0; j < n; ++j) {
+                        wtxids[j] = &mempool_txns[i + j]->GetWitnessHash().ToUint256();
+                    }
+                    cmpctblock.GetShortIDs({wtxids.data(), n}, {ids.data(), n});
+                    for (size_t j = 0; j < n; ++j) {
+                        const auto idit{shorttxids.find(ids[j])};
+                        if (idit != shorttxids.end()) {
+                            thread_matches[t].emplace_back(idit->second, mempool_txns[i + j]);
+                            num_found.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        for (auto& found : thread_matches) {
+            matches.insert(matches.end(), std::make_move_iterator(found.begin()),
+                           std::make_move_iterator(found.end()));
+        }
+    } else {
+        std::array<const uint256*, SHORTID_BATCH> wtxids;
+        std::array<uint64_t, SHORTID_BATCH> ids;
+        for (size_t i = 0; i < mempool_txns.size() && matches.size() < shorttxids.size(); i += SHORTID_BATCH) {
+            const size_t n{std::min(SHORTID_BATCH, mempool_txns.size() - i)};
+            for (size_t j = 0; j < n; ++j) {
+                wtxids[j] = &mempool_txns[i + j]->GetWitnessHash().ToUint256();
+            }
+            cmpctblock.GetShortIDs({wtxids.data(), n}, {ids.data(), n});
+            for (size_t j = 0; j < n; ++j) {
+                const auto idit{shorttxids.find(ids[j])};
+                if (idit != shorttxids.end()) {
+                    matches.emplace_back(idit->second, mempool_txns[i + j]);
+                    if (matches.size() == shorttxids.size()) break;
                 }
             }
         }
+    }
+    for (auto& [index, tx] : matches) {
+        if (!have_txn[index]) {
+            txn_available[index] = std::move(tx);
+            have_txn[index] = true;
+            mempool_count++;
+        } else {
+            // If we find two mempool txn that match the short id, just request it.
+            // This should be rare enough that the extra bandwidth doesn't matter,
+            // but eating a round-trip due to FillBlock failure would be annoying
+            if (txn_available[index]) {
+                txn_available[index].reset();
+                mempool_count--;
+            }
+        }
         // Though ideally we'd continue scanning for the two-txn-match-shortid case,
         // the performance win of an early exit here is too good to pass up and worth
         // the extra risk.
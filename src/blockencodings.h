@@ -7,6 +7,8 @@
 
 #include <primitives/block.h>
 
+#include <deque>
+
 #include <functional>
 
 class CTxMemPool;
@@ -113,11 +115,20 @@ public:
 
     /**
      * @param[in]  nonce  This should be randomly generated, and is used for the siphash secret key
+     * @param[in]  extra_prefill  Sorted, unique indexes into block.vtx (never
+     *                            including 0, which is always prefilled) of
+     *                            transactions to include in full instead of as
+     *                            short IDs, e.g. because the receiving peer
+     *                            likely lacks them.
      */
-    CBlockHeaderAndShortTxIDs(const CBlock& block, const uint64_t nonce);
+    CBlockHeaderAndShortTxIDs(const CBlock& block, const uint64_t nonce, const std::vector<uint16_t>& extra_prefill = {});
 
     uint64_t GetShortID(const Wtxid& wtxid) const;
 
+    /** Compute short IDs for a batch of wtxids; equivalent to calling
+     *  GetShortID for each, but uses the vectorized SipHash batch path. */
+    void GetShortIDs(Span<const uint256* const> wtxids, Span<uint64_t> out) const;
+
     size_t BlockTxCount() const { return shorttxids.size() + prefilledtxn.size(); }
 
     SERIALIZE_METHODS(CBlockHeaderAndShortTxIDs, obj)
@@ -146,8 +157,8 @@ public:
 
     explicit PartiallyDownloadedBlock(CTxMemPool* poolIn) : pool(poolIn) {}
 
-    // extra_txn is a list of extra orphan/conflicted/etc transactions to look at
-    ReadStatus InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<CTransactionRef>& extra_txn);
+    // extra_txn is a list of extra orphan/conflicted/etc transactions to look at, oldest first
+    ReadStatus InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::deque<CTransactionRef>& extra_txn);
     bool IsTxAvailable(size_t index) const;
     ReadStatus FillBlock(CBlock& block, const std::vector<CTransactionRef>& vtx_missing);
 };
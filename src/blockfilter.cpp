@@ -2,8 +2,10 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <algorithm>
 #include <mutex>
 #include <set>
+#include <thread>
 
 #include <blockfilter.h>
 #include <crypto/siphash.h>
@@ -32,10 +34,37 @@ uint64_t GCSFilter::HashToRange(const Element& element) const
 
 std::vector<uint64_t> GCSFilter::BuildHashedSet(const ElementSet& elements) const
 {
-    std::vector<uint64_t> hashed_elements;
-    hashed_elements.reserve(elements.size());
-    for (const Element& element : elements) {
-        hashed_elements.push_back(HashToRange(element));
+    std::vector<uint64_t> hashed_elements(elements.size());
+
+    // Hashing is independent per element, so large sets (block filters
+    // regularly cover several thousand scripts) are spread across threads.
+    constexpr size_t MIN_PARALLEL_HASH_ELEMENTS{4096};
+    if (elements.size() >= MIN_PARALLEL_HASH_ELEMENTS) {
+        std::vector<const Element*> element_ptrs;
+        element_ptrs.reserve(elements.size());
+        for (const Element& element : elements) {
+            element_ptrs.push_back(&element);
+        }
+        const size_t num_threads{std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4)};
+        const size_t stride{(element_ptrs.size() + num_threads - 1) / num_threads};
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (size_t t = 0; t < num_threads; ++t) {
+            const size_t begin{t * stride};
+            const size_t end{std::min(begin + stride, element_ptrs.size())};
+            if (begin >= end) break;
+            threads.emplace_back([&, begin, end] {
+                for (size_t i = begin; i < end; ++i) {
+                    hashed_elements[i] = HashToRange(*element_ptrs[i]);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    } else {
+        size_t i{0};
+        for (const Element& element : elements) {
+            hashed_elements[i++] = HashToRange(element);
+        }
     }
     std::sort(hashed_elements.begin(), hashed_elements.end());
     return hashed_elements;
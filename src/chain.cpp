@@ -130,6 +130,15 @@ void CBlockIndex::BuildSkip()
 
 arith_uint256 GetBlockProof(const CBlockIndex& block)
 {
+    // nBits only changes at retarget boundaries (see GetNextWorkRequired), so
+    // during a headers sync the same compact target repeats for every block in
+    // a difficulty period. Memoize the last expansion and division per thread;
+    // nBits==0 yields proof 0 below without touching the cache, so 0 is a safe
+    // "empty" sentinel.
+    thread_local uint32_t cached_bits{0};
+    thread_local arith_uint256 cached_proof;
+    if (block.nBits == cached_bits) return cached_proof;
+
     arith_uint256 bnTarget;
     bool fNegative;
     bool fOverflow;
@@ -140,7 +149,10 @@ arith_uint256 GetBlockProof(const CBlockIndex& block)
     // as it's too large for an arith_uint256. However, as 2**256 is at least as large
     // as bnTarget+1, it is equal to ((2**256 - bnTarget - 1) / (bnTarget+1)) + 1,
     // or ~bnTarget / (bnTarget+1) + 1.
-    return (~bnTarget / (bnTarget + 1)) + 1;
+    arith_uint256 proof{(~bnTarget / (bnTarget + 1)) + 1};
+    cached_bits = block.nBits;
+    cached_proof = proof;
+    return proof;
 }
 
 int64_t GetBlockProofEquivalentTime(const CBlockIndex& to, const CBlockIndex& from, const CBlockIndex& tip, const Consensus::Params& params)
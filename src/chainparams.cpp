@@ -8,6 +8,7 @@
 #include <chainparamsbase.h>
 #include <common/args.h>
 #include <consensus/params.h>
+#include <crypto/tens_pow/tens_hash.h>
 #include <deploymentinfo.h>
 #include <logging.h>
 #include <tinyformat.h>
@@ -136,4 +137,6 @@ void SelectParams(const ChainType chain)
 {
     SelectBaseParams(chain);
     globalChainParams = CreateChainParams(gArgs, chain);
+    // Apply the network's TensHash geometry before any PoW context is built.
+    tens_hash_set_hidden_layers(globalChainParams->GetConsensus().tenshash_hidden_layers);
 }
@@ -11,8 +11,12 @@
 #include <util/threadnames.h>
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <iterator>
+#include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 /**
@@ -28,6 +32,12 @@
   * the master is done adding work, it temporarily joins the worker pool
   * as an N'th worker, until all jobs are done.
   *
+  * Work is distributed over per-worker deques rather than one shared stack:
+  * each Add() seeds one worker's deque, owners pop their newest entries and
+  * idle workers steal the oldest half of a victim's deque. Near the end of a
+  * block the remaining work therefore spreads across all workers instead of
+  * sitting in one straggler's batch, and the master's Complete() tracks
+  * total work rather than the slowest batch.
   */
 template <typename T, typename R = std::remove_cvref_t<decltype(std::declval<T>()().value())>>
 class CCheckQueue
@@ -42,12 +52,25 @@ private:
     //! Master thread blocks on this when out of work
     std::condition_variable m_master_cv;
 
-    //! The queue of elements to be processed.
-    //! As the order of booleans doesn't matter, it is used as a LIFO (stack)
-    std::vector<T> queue GUARDED_BY(m_mutex);
+    //! Per-worker queue of elements to be processed. The owner pops its own
+    //! newest entries (back); idle workers steal the oldest (front), so a
+    //! stolen range is the one least likely to still be hot in the owner's
+    //! cache.
+    struct WorkSlot {
+        Mutex m;
+        std::deque<T> jobs GUARDED_BY(m);
+    };
 
-    //! The number of workers (including the master) that are idle.
-    int nIdle GUARDED_BY(m_mutex){0};
+    //! One slot per worker thread, plus a final slot for the master.
+    std::vector<std::unique_ptr<WorkSlot>> m_slots;
+
+    //! Round-robin cursor so successive Add() calls seed different slots.
+    std::atomic<unsigned int> m_add_cursor{0};
+
+    //! Number of elements sitting in slots, not yet claimed by any worker.
+    //! Incremented under m_mutex (so waiters can't miss a wakeup), but
+    //! decremented in Claim() under the slot lock only.
+    std::atomic<unsigned int> m_queued{0};
 
     //! The total number of workers (including the master).
     int nTotal GUARDED_BY(m_mutex){0};
@@ -68,20 +91,64 @@ private:
     std::vector<std::thread> m_worker_threads;
     bool m_request_stop GUARDED_BY(m_mutex){false};
 
+    //! Base name for the worker threads (shown in thread listings and logs).
+    const std::string m_thread_name;
+
+    /**
+     * Move up to nBatchSize elements from the slots into vChecks and return
+     * how many were taken. Pops from the back of our own slot first; when it
+     * is empty, steals the oldest half (capped at nBatchSize) of the first
+     * non-empty victim. Returning 0 means another worker won a race for the
+     * remaining elements; the caller simply goes back to waiting.
+     */
+    unsigned int Claim(size_t self, std::vector<T>& vChecks)
+    {
+        {
+            WorkSlot& slot{*m_slots[self]};
+            LOCK(slot.m);
+            if (!slot.jobs.empty()) {
+                const unsigned int nNow{std::min<unsigned int>(nBatchSize, slot.jobs.size())};
+                for (unsigned int i = 0; i < nNow; ++i) {
+                    vChecks.push_back(std::move(slot.jobs.back()));
+                    slot.jobs.pop_back();
+                }
+                m_queued.fetch_sub(nNow, std::memory_order_relaxed);
+                return nNow;
+            }
+        }
+        for (size_t i = 1; i < m_slots.size(); ++i) {
+            WorkSlot& victim{*m_slots[(self + i) % m_slots.size()]};
+            LOCK(victim.m);
+            if (victim.jobs.empty()) continue;
+            const unsigned int nNow{std::min<unsigned int>(nBatchSize, (victim.jobs.size() + 1) / 2)};
+            for (unsigned int i2 = 0; i2 < nNow; ++i2) {
+                vChecks.push_back(std::move(victim.jobs.front()));
+                victim.jobs.pop_front();
+            }
+            m_queued.fetch_sub(nNow, std::memory_order_relaxed);
+            return nNow;
+        }
+        return 0;
+    }
+
     /** Internal function that does bulk of the verification work. If fMaster, return the final result. */
-    std::optional<R> Loop(bool fMaster) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    std::optional<R> Loop(bool fMaster, size_t self) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
         std::condition_variable& cond = fMaster ? m_master_cv : m_worker_cv;
         std::vector<T> vChecks;
         vChecks.reserve(nBatchSize);
         unsigned int nNow = 0;
+        bool fFirst = true;
         std::optional<R> local_result;
         bool do_work;
         do {
             {
                 WAIT_LOCK(m_mutex, lock);
                 // first do the clean-up of the previous loop run (allowing us to do it in the same critsect)
-                if (nNow) {
+                if (fFirst) {
+                    fFirst = false;
+                    nTotal++;
+                } else if (nNow) {
                     if (local_result.has_value() && !m_result.has_value()) {
                         std::swap(local_result, m_result);
                     }
@@ -90,12 +157,9 @@ private:
                         // We processed the last element; inform the master it can exit and return the result
                         m_master_cv.notify_one();
                     }
-                } else {
-                    // first iteration
-                    nTotal++;
                 }
                 // logically, the do loop starts here
-                while (queue.empty() && !m_request_stop) {
+                while (m_queued.load(std::memory_order_acquire) == 0 && !m_request_stop) {
                     if (fMaster && nTodo == 0) {
                         nTotal--;
                         std::optional<R> to_return = std::move(m_result);
@@ -104,27 +168,18 @@ private:
                         // return the current status
                         return to_return;
                     }
-                    nIdle++;
                     cond.wait(lock); // wait
-                    nIdle--;
                 }
                 if (m_request_stop) {
                     // return value does not matter, because m_request_stop is only set in the destructor.
                     return std::nullopt;
                 }
-
-                // Decide how many work units to process now.
-                // * Do not try to do everything at once, but aim for increasingly smaller batches so
-                //   all workers finish approximately simultaneously.
-                // * Try to account for idle jobs which will instantly start helping.
-                // * Don't do batches smaller than 1 (duh), or larger than nBatchSize.
-                nNow = std::max(1U, std::min(nBatchSize, (unsigned int)queue.size() / (nTotal + nIdle + 1)));
-                auto start_it = queue.end() - nNow;
-                vChecks.assign(std::make_move_iterator(start_it), std::make_move_iterator(queue.end()));
-                queue.erase(start_it, queue.end());
                 // Check whether we need to do work at all
                 do_work = !m_result.has_value();
             }
+            // Claim work outside m_mutex; a concurrent thief may leave us with
+            // nothing, in which case we loop around and wait again.
+            nNow = Claim(self, vChecks);
             // execute work
             if (do_work) {
                 for (T& check : vChecks) {
@@ -141,15 +196,19 @@ public:
     Mutex m_control_mutex;
 
     //! Create a new check queue
-    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num)
-        : nBatchSize(batch_size)
+    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num, const std::string& thread_name = "scriptch")
+        : nBatchSize(batch_size), m_thread_name(thread_name)
     {
-        LogInfo("Script verification uses %d additional threads", worker_threads_num);
+        LogInfo("%s verification uses %d additional threads", m_thread_name, worker_threads_num);
+        m_slots.reserve(worker_threads_num + 1);
+        for (int n = 0; n < worker_threads_num + 1; ++n) {
+            m_slots.push_back(std::make_unique<WorkSlot>());
+        }
         m_worker_threads.reserve(worker_threads_num);
         for (int n = 0; n < worker_threads_num; ++n) {
             m_worker_threads.emplace_back([this, n]() {
-                util::ThreadRename(strprintf("scriptch.%i", n));
-                Loop(false /* worker thread */);
+                util::ThreadRename(strprintf("%s.%i", m_thread_name, n));
+                Loop(false /* worker thread */, n);
             });
         }
     }
@@ -165,7 +224,7 @@ public:
     //! its error.
     std::optional<R> Complete() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
-        return Loop(true /* master thread */);
+        return Loop(true /* master thread */, m_slots.size() - 1);
     }
 
     //! Add a batch of checks to the queue
@@ -175,10 +234,21 @@ public:
             return;
         }
 
+        // Seed one slot with the whole batch (typically the input scripts of
+        // one transaction); the cursor spreads successive batches across
+        // workers, and stealing rebalances whatever ends up uneven.
+        {
+            WorkSlot& slot{*m_slots[m_add_cursor.fetch_add(1, std::memory_order_relaxed) % m_slots.size()]};
+            LOCK(slot.m);
+            for (T& check : vChecks) {
+                slot.jobs.push_back(std::move(check));
+            }
+        }
+
         {
             LOCK(m_mutex);
-            queue.insert(queue.end(), std::make_move_iterator(vChecks.begin()), std::make_move_iterator(vChecks.end()));
             nTodo += vChecks.size();
+            m_queued.fetch_add(vChecks.size(), std::memory_order_release);
         }
 
         if (vChecks.size() == 1) {
@@ -286,6 +286,16 @@ void CCoinsViewCache::Uncache(const COutPoint& hash)
     }
 }
 
+std::vector<COutPoint> CCoinsViewCache::GetCachedCoinKeys() const
+{
+    std::vector<COutPoint> keys;
+    keys.reserve(cacheCoins.size());
+    for (const auto& [outpoint, entry] : cacheCoins) {
+        if (!entry.coin.IsSpent()) keys.push_back(outpoint);
+    }
+    return keys;
+}
+
 unsigned int CCoinsViewCache::GetCacheSize() const {
     return cacheCoins.size();
 }
@@ -310,6 +320,20 @@ void CCoinsViewCache::ReallocateCache()
     m_cache_coins_memory_resource.~CCoinsMapMemoryResource();
     ::new (&m_cache_coins_memory_resource) CCoinsMapMemoryResource{};
     ::new (&cacheCoins) CCoinsMap{0, SaltedOutpointHasher{/*deterministic=*/m_deterministic}, CCoinsMap::key_equal{}, &m_cache_coins_memory_resource};
+    if (m_reserved_entries) cacheCoins.reserve(m_reserved_entries);
+}
+
+void CCoinsViewCache::Reserve(size_t target_bytes)
+{
+    // A typical UTXO entry costs roughly 128 bytes in this map: the 36-byte
+    // COutPoint key, the Coin (whose script usually fits the prevector
+    // inline, adding no heap data), the flagged-entry list pointers and the
+    // allocator node overhead. Dividing the budget by that turns it into an
+    // entry count; the resulting bucket array is about 1/16 of the budget
+    // and is counted by DynamicMemoryUsage like any other allocation.
+    constexpr size_t AVG_ENTRY_BYTES{128};
+    m_reserved_entries = target_bytes / AVG_ENTRY_BYTES;
+    cacheCoins.reserve(m_reserved_entries);
 }
 
 void CCoinsViewCache::SanityCheck() const
@@ -21,6 +21,7 @@
 
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 /**
  * A UTXO entry.
@@ -364,6 +365,10 @@ class CCoinsViewCache : public CCoinsViewBacked
 private:
     const bool m_deterministic;
 
+    //! Number of entries the hash table was last Reserve()d for, so the
+    //! reservation can be re-applied when ReallocateCache() rebuilds the map.
+    size_t m_reserved_entries{0};
+
 protected:
     /**
      * Make mutable so that we can "fill the cache" even from Get-methods
@@ -460,6 +465,13 @@ public:
      */
     void Uncache(const COutPoint &outpoint);
 
+    /**
+     * Collect the outpoints of every unspent coin currently held in this
+     * cache, without calling into the backing view. Used to persist the hot
+     * working set across restarts (see node::DumpCoinsCacheKeys()).
+     */
+    std::vector<COutPoint> GetCachedCoinKeys() const;
+
     //! Calculate the size of the cache (in number of transaction outputs)
     unsigned int GetCacheSize() const;
 
@@ -476,6 +488,12 @@ public:
     //! See: https://stackoverflow.com/questions/42114044/how-to-release-unordered-map-memory
     void ReallocateCache();
 
+    //! Pre-size the hash table for a memory budget of target_bytes, so the
+    //! cache can grow to its flush threshold without the incremental
+    //! rehashes that stall block connection on large dbcache settings. The
+    //! reservation survives Flush()/ReallocateCache().
+    void Reserve(size_t target_bytes);
+
     //! Run an internal sanity check on the cache data structure. */
     void SanityCheck() const;
 
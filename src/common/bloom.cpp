@@ -192,6 +192,18 @@ static inline uint32_t RollingBloomHash(unsigned int nHashNum, uint32_t nTweak,
     return MurmurHash3(nHashNum * 0xFBA4C795 + nTweak, vDataToHash);
 }
 
+/* Kirsch-Mitzenmacher double hashing: instead of running nHashFuncs
+ * independent MurmurHash3 rounds per key, run two and derive round n as
+ * h1 + n * h2. This preserves the false positive guarantee of independent
+ * hash functions while the per-round cost drops to a multiply-add. h2 is
+ * forced odd so the derived probe sequence never collapses onto one slot.
+ * Unlike CBloomFilter, this filter is never exchanged over the network, so
+ * its hash scheme is free to change. */
+static inline std::pair<uint32_t, uint32_t> RollingBloomHashPair(uint32_t nTweak, Span<const unsigned char> vKey)
+{
+    return {RollingBloomHash(0, nTweak, vKey), RollingBloomHash(1, nTweak, vKey) | 1};
+}
+
 void CRollingBloomFilter::insert(Span<const unsigned char> vKey)
 {
     if (nEntriesThisGeneration == nEntriesPerGeneration) {
@@ -212,8 +224,9 @@ void CRollingBloomFilter::insert(Span<const unsigned char> vKey)
     }
     nEntriesThisGeneration++;
 
+    const auto [h1, h2] = RollingBloomHashPair(nTweak, vKey);
     for (int n = 0; n < nHashFuncs; n++) {
-        uint32_t h = RollingBloomHash(n, nTweak, vKey);
+        uint32_t h = h1 + n * h2;
         int bit = h & 0x3F;
         /* FastMod works with the upper bits of h, so it is safe to ignore that the lower bits of h are already used for bit. */
         uint32_t pos = FastRange32(h, data.size());
@@ -225,8 +238,9 @@ void CRollingBloomFilter::insert(Span<const unsigned char> vKey)
 
 bool CRollingBloomFilter::contains(Span<const unsigned char> vKey) const
 {
+    const auto [h1, h2] = RollingBloomHashPair(nTweak, vKey);
     for (int n = 0; n < nHashFuncs; n++) {
-        uint32_t h = RollingBloomHash(n, nTweak, vKey);
+        uint32_t h = h1 + n * h2;
         int bit = h & 0x3F;
         uint32_t pos = FastRange32(h, data.size());
         /* If the relevant bit is not set in either data[pos & ~1] or data[pos | 1], the filter does not contain vKey */
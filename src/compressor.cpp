@@ -150,10 +150,24 @@ uint64_t CompressAmount(uint64_t n)
 {
     if (n == 0)
         return 0;
+    // Strip factors of ten in decreasing power-of-ten steps rather than one
+    // digit per iteration; round amounts (the common case in the UTXO set)
+    // need at most four divisions this way.
     int e = 0;
-    while (((n % 10) == 0) && e < 9) {
+    if ((n % 100000000) == 0) {
+        n /= 100000000;
+        e = 8;
+    } else if ((n % 10000) == 0) {
+        n /= 10000;
+        e = 4;
+    }
+    if (e < 8 && (n % 100) == 0) {
+        n /= 100;
+        e += 2;
+    }
+    if (e < 9 && (n % 10) == 0) {
         n /= 10;
-        e++;
+        e += 1;
     }
     if (e < 9) {
         int d = (n % 10);
@@ -184,9 +198,8 @@ uint64_t DecompressAmount(uint64_t x)
     } else {
         n = x+1;
     }
-    while (e) {
-        n *= 10;
-        e--;
-    }
-    return n;
+    // e is in [0..9]; scale by the corresponding power of ten in one step.
+    static constexpr uint64_t POW10[10] = {
+        1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000};
+    return n * POW10[e];
 }
@@ -6,6 +6,9 @@
 #include <hash.h>
 #include <util/check.h>
 
+#include <algorithm>
+#include <thread>
+
 /*     WARNING! If you're reading this because you're learning about crypto
        and/or designing a new system that will use merkle trees, keep in mind
        that the following merkle tree algorithm has a serious flaw related to
@@ -43,8 +46,17 @@
 */
 
 
+//! Minimum number of pairs in a level before it is hashed in parallel; below
+//! this, thread startup costs more than the hashing itself.
+static constexpr size_t MIN_PARALLEL_MERKLE_PAIRS{4096};
+
 uint256 ComputeMerkleRoot(std::vector<uint256> hashes, bool* mutated) {
     bool mutation = false;
+    // The pairs within a level are independent, so large levels are split
+    // across threads. The in-place SHA256D64 transform would let one range's
+    // output overwrite another range's not-yet-read input, so parallel levels
+    // ping-pong into a separate buffer instead.
+    std::vector<uint256> next;
     while (hashes.size() > 1) {
         if (mutated) {
             for (size_t pos = 0; pos + 1 < hashes.size(); pos += 2) {
@@ -54,8 +66,27 @@ uint256 ComputeMerkleRoot(std::vector<uint256> hashes, bool* mutated) {
         if (hashes.size() & 1) {
             hashes.push_back(hashes.back());
         }
-        SHA256D64(hashes[0].begin(), hashes[0].begin(), hashes.size() / 2);
-        hashes.resize(hashes.size() / 2);
+        const size_t pairs{hashes.size() / 2};
+        if (pairs >= MIN_PARALLEL_MERKLE_PAIRS) {
+            next.resize(pairs);
+            const size_t num_threads{std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4)};
+            const size_t chunk{(pairs + num_threads - 1) / num_threads};
+            std::vector<std::thread> threads;
+            threads.reserve(num_threads);
+            for (size_t t = 0; t < num_threads; ++t) {
+                const size_t start{chunk * t};
+                const size_t end{std::min(start + chunk, pairs)};
+                if (start >= end) break;
+                threads.emplace_back([&, start, end] {
+                    SHA256D64(next[start].begin(), hashes[2 * start].begin(), end - start);
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            hashes.swap(next);
+        } else {
+            SHA256D64(hashes[0].begin(), hashes[0].begin(), pairs);
+            hashes.resize(pairs);
+        }
     }
     if (mutated) *mutated = mutation;
     if (hashes.size() == 0) return uint256();
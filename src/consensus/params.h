@@ -32,6 +32,7 @@ constexpr bool ValidDeployment(BuriedDeployment dep) { return dep <= DEPLOYMENT_
 enum DeploymentPos : uint16_t {
     DEPLOYMENT_TESTDUMMY,
     DEPLOYMENT_TAPROOT, // Deployment of Schnorr/Taproot (BIPs 340-342)
+    DEPLOYMENT_POW_EPOCH, // Epoch-based TensHash seed schedule
     // NOTE: Also add new deployments to VersionBitsDeploymentInfo in deploymentinfo.cpp
     MAX_VERSION_BITS_DEPLOYMENTS
 };
@@ -114,6 +115,25 @@ struct Params {
       */
     bool enforce_BIP94;
     bool fPowNoRetargeting;
+    /** Number of TensHash hidden layers evaluated per PoW hash. Mainnet and
+     * the public test networks use the full 64-layer network; regtest runs a
+     * reduced one so test block generation is not dominated by PoW. */
+    int tenshash_hidden_layers{64};
+    /** Number of blocks sharing one TensHash matrix seed once
+     * DEPLOYMENT_POW_EPOCH activates. Today the seed is the header's own
+     * (nonce-zeroed) hash, so every candidate block derives a fresh ~17MB
+     * matrix set and no context can be reused across blocks. Under the epoch
+     * rule the seed becomes the hash of the last block before the current
+     * epoch (heights [N*len, (N+1)*len) use the block at N*len - 1), so
+     * miners and validators share one context per epoch, and the hashed
+     * input commits to the header hash instead of only the nonce.
+     *
+     * The deployment ships NEVER_ACTIVE on every network: the context-free
+     * proof-of-work pre-checks (headers anti-DoS in net_processing, the
+     * block-file integrity check in blockstorage) still assume per-header
+     * seeds and must be made epoch-aware before activation is scheduled.
+     * 0 disables the epoch rule regardless of deployment state. */
+    uint32_t tenshash_epoch_length{0};
     int64_t nPowTargetSpacing;
     int64_t nPowTargetTimespan;
     std::chrono::seconds PowTargetSpacing() const
@@ -8,6 +8,7 @@
 #include <consensus/amount.h>
 #include <util/result.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <optional>
@@ -16,6 +17,7 @@ class CBlock;
 class CBlockHeader;
 class CScript;
 class CTransaction;
+typedef std::shared_ptr<const CTransaction> CTransactionRef;
 struct CMutableTransaction;
 class SigningProvider;
 class uint256;
@@ -35,6 +37,11 @@ enum class TxVerbosity {
 CScript ParseScript(const std::string& s);
 std::string ScriptToAsmStr(const CScript& script, const bool fAttemptSighashDecode = false);
 [[nodiscard]] bool DecodeHexTx(CMutableTransaction& tx, const std::string& hex_tx, bool try_no_witness = false, bool try_witness = true);
+/** Like DecodeHexTx, but returns a shared transaction reference and memoizes
+ * recently decoded transactions, so resubmitting the same raw transaction
+ * (broadcast retries, testmempoolaccept followed by sendrawtransaction) skips
+ * the hex decode and deserialization. Returns nullptr on decode failure. */
+[[nodiscard]] CTransactionRef DecodeHexTxCached(const std::string& hex_tx, bool try_no_witness = false, bool try_witness = true);
 [[nodiscard]] bool DecodeHexBlk(CBlock&, const std::string& strHexBlk);
 bool DecodeHexBlockHeader(CBlockHeader&, const std::string& hex_header);
 
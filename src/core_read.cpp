@@ -4,16 +4,20 @@
 
 #include <core_io.h>
 
+#include <crypto/siphash.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
+#include <random.h>
 #include <script/script.h>
 #include <script/sign.h>
 #include <serialize.h>
 #include <streams.h>
+#include <sync.h>
 #include <util/result.h>
 #include <util/strencodings.h>
 
 #include <algorithm>
+#include <deque>
 #include <string>
 
 using util::SplitString;
@@ -203,6 +207,44 @@ bool DecodeHexTx(CMutableTransaction& tx, const std::string& hex_tx, bool try_no
     return DecodeTx(tx, txData, try_no_witness, try_witness);
 }
 
+CTransactionRef DecodeHexTxCached(const std::string& hex_tx, bool try_no_witness, bool try_witness)
+{
+    //! Number of recently decoded transactions remembered.
+    static constexpr size_t DECODE_CACHE_SIZE{64};
+    struct CachedDecode {
+        uint64_t key;
+        bool no_witness;
+        bool witness;
+        std::string hex;
+        CTransactionRef tx;
+    };
+    static Mutex cache_mutex;
+    static std::deque<CachedDecode> cache GUARDED_BY(cache_mutex);
+    static const uint64_t salt_k0{ThreadLocalRng().rand64()};
+    static const uint64_t salt_k1{ThreadLocalRng().rand64()};
+
+    const uint64_t key{CSipHasher{salt_k0, salt_k1}.Write(MakeUCharSpan(hex_tx)).Finalize()};
+    {
+        LOCK(cache_mutex);
+        for (const auto& entry : cache) {
+            // The full hex comparison guards against salted-hash collisions;
+            // it only runs when the 64-bit keys already match.
+            if (entry.key == key && entry.no_witness == try_no_witness && entry.witness == try_witness && entry.hex == hex_tx) {
+                return entry.tx;
+            }
+        }
+    }
+
+    CMutableTransaction mtx;
+    if (!DecodeHexTx(mtx, hex_tx, try_no_witness, try_witness)) return nullptr;
+    CTransactionRef tx{MakeTransactionRef(std::move(mtx))};
+
+    LOCK(cache_mutex);
+    cache.push_front({key, try_no_witness, try_witness, hex_tx, tx});
+    if (cache.size() > DECODE_CACHE_SIZE) cache.pop_back();
+    return tx;
+}
+
 bool DecodeHexBlockHeader(CBlockHeader& header, const std::string& hex_header)
 {
     if (!IsHex(hex_header)) return false;
@@ -7,13 +7,32 @@
 
 #include <crypto/common.h>
 #include <crypto/chacha20.h>
+#include <crypto/kernelstats.h>
 #include <support/cleanse.h>
 #include <span.h>
 
+#include <compat/cpuid.h>
+
 #include <algorithm>
 #include <bit>
 #include <string.h>
 
+namespace chacha20_avx2 {
+void Keystream(const uint32_t input[12], unsigned char* out, size_t blocks);
+void Crypt(const uint32_t input[12], const unsigned char* in, unsigned char* out, size_t blocks);
+} // namespace chacha20_avx2
+
+namespace {
+using ChaCha20KeystreamFn = void (*)(const uint32_t[12], unsigned char*, size_t);
+using ChaCha20CryptFn = void (*)(const uint32_t[12], const unsigned char*, unsigned char*, size_t);
+
+// Active multi-block implementations, set by ChaCha20AutoDetect(). When null,
+// the scalar per-block loop below handles everything; when set, it handles
+// groups of 8 blocks and the scalar loop only the tail.
+ChaCha20KeystreamFn g_chacha20_keystream{nullptr};
+ChaCha20CryptFn g_chacha20_crypt{nullptr};
+} // namespace
+
 #define QUARTERROUND(a,b,c,d) \
   a += b; d = std::rotl(d ^ a, 16); \
   c += d; b = std::rotl(b ^ c, 12); \
@@ -68,6 +87,18 @@ inline void ChaCha20Aligned::Keystream(Span<std::byte> output) noexcept
 
     if (!blocks) return;
 
+    // Hand groups of 8 blocks to the vectorized implementation, unless the
+    // 32-bit block counter would wrap within this span (the scalar loop below
+    // carries the wrap into the nonce).
+    if (g_chacha20_keystream && blocks >= 8 && uint64_t{input[8]} + blocks <= 0xFFFFFFFF) {
+        const size_t vec_blocks{blocks & ~size_t{7}};
+        g_chacha20_keystream(input, reinterpret_cast<unsigned char*>(c), vec_blocks);
+        input[8] += vec_blocks;
+        c += vec_blocks * BLOCKLEN;
+        blocks -= vec_blocks;
+        if (!blocks) return;
+    }
+
     j4 = input[0];
     j5 = input[1];
     j6 = input[2];
@@ -171,6 +202,17 @@ inline void ChaCha20Aligned::Crypt(Span<const std::byte> in_bytes, Span<std::byt
 
     if (!blocks) return;
 
+    // See the matching block in Keystream() above.
+    if (g_chacha20_crypt && blocks >= 8 && uint64_t{input[8]} + blocks <= 0xFFFFFFFF) {
+        const size_t vec_blocks{blocks & ~size_t{7}};
+        g_chacha20_crypt(input, reinterpret_cast<const unsigned char*>(m), reinterpret_cast<unsigned char*>(c), vec_blocks);
+        input[8] += vec_blocks;
+        c += vec_blocks * BLOCKLEN;
+        m += vec_blocks * BLOCKLEN;
+        blocks -= vec_blocks;
+        if (!blocks) return;
+    }
+
     j4 = input[0];
     j5 = input[1];
     j6 = input[2];
@@ -282,6 +324,7 @@ inline void ChaCha20Aligned::Crypt(Span<const std::byte> in_bytes, Span<std::byt
 void ChaCha20::Keystream(Span<std::byte> out) noexcept
 {
     if (out.empty()) return;
+    kernel_stats::Record(kernel_stats::Kernel::CHACHA20, out.size());
     if (m_bufleft) {
         unsigned reuse = std::min<size_t>(m_bufleft, out.size());
         std::copy(m_buffer.end() - m_bufleft, m_buffer.end() - m_bufleft + reuse, out.begin());
@@ -305,6 +348,7 @@ void ChaCha20::Crypt(Span<const std::byte> input, Span<std::byte> output) noexce
     assert(input.size() == output.size());
 
     if (!input.size()) return;
+    kernel_stats::Record(kernel_stats::Kernel::CHACHA20, input.size());
     if (m_bufleft) {
         unsigned reuse = std::min<size_t>(m_bufleft, input.size());
         for (unsigned i = 0; i < reuse; i++) {
@@ -370,3 +414,81 @@ void FSChaCha20::Crypt(Span<const std::byte> input, Span<std::byte> output) noex
         m_chunk_counter = 0;
     }
 }
+
+namespace {
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+/** Check whether the OS has enabled AVX registers. */
+bool AVXEnabled()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 6) == 6;
+}
+
+bool AVX2Supported()
+{
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    if (!(((ecx >> 27) & 1) && ((ecx >> 28) & 1) && AVXEnabled())) return false;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    return (ebx >> 5) & 1;
+}
+
+/** Verify the vectorized implementation against the scalar one. Called before
+ *  the dispatch pointers are set, so the reference runs go through the scalar
+ *  loop. */
+bool SelfTest()
+{
+    std::byte key[32];
+    for (int i = 0; i < 32; ++i) key[i] = std::byte(i * 7 + 1);
+    const ChaCha20Aligned::Nonce96 nonce{0x11223344, 0x5566778899aabbccULL};
+    const uint32_t counter{0xfffffff0};
+
+    constexpr size_t BLOCKS{16};
+    std::byte expected[BLOCKS * ChaCha20Aligned::BLOCKLEN];
+    ChaCha20Aligned ref{key};
+    ref.Seek(nonce, counter);
+    ref.Keystream(expected);
+
+    // Rebuild the internal state words the same way SetKey()/Seek() do.
+    uint32_t input[12];
+    for (int i = 0; i < 8; ++i) input[i] = ReadLE32(reinterpret_cast<const unsigned char*>(key) + 4 * i);
+    input[8] = counter;
+    input[9] = nonce.first;
+    input[10] = uint32_t(nonce.second);
+    input[11] = uint32_t(nonce.second >> 32);
+
+    unsigned char got[sizeof(expected)];
+    chacha20_avx2::Keystream(input, got, BLOCKS);
+    if (memcmp(expected, got, sizeof(got)) != 0) return false;
+
+    std::byte msg[sizeof(expected)];
+    for (size_t i = 0; i < sizeof(msg); ++i) msg[i] = std::byte(i * 13 + 5);
+    std::byte expected_c[sizeof(expected)];
+    ChaCha20Aligned ref2{key};
+    ref2.Seek(nonce, counter);
+    ref2.Crypt(msg, expected_c);
+
+    unsigned char got_c[sizeof(expected)];
+    chacha20_avx2::Crypt(input, reinterpret_cast<const unsigned char*>(msg), got_c, BLOCKS);
+    return memcmp(expected_c, got_c, sizeof(got_c)) == 0;
+}
+#endif
+} // namespace
+
+std::string ChaCha20AutoDetect()
+{
+    std::string ret = "generic";
+    g_chacha20_keystream = nullptr;
+    g_chacha20_crypt = nullptr;
+
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+    if (AVX2Supported() && SelfTest()) {
+        g_chacha20_keystream = chacha20_avx2::Keystream;
+        g_chacha20_crypt = chacha20_avx2::Crypt;
+        ret = "avx2-8way";
+    }
+#endif
+
+    return ret;
+}
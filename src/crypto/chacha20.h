@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <cstdlib>
 #include <stdint.h>
+#include <string>
 #include <utility>
 
 // classes for ChaCha20 256-bit stream cipher developed by Daniel J. Bernstein
@@ -156,4 +157,8 @@ public:
     void Crypt(Span<const std::byte> input, Span<std::byte> output) noexcept;
 };
 
+/** Choose the best available multi-block ChaCha20 implementation.
+ *  Returns the name of the implementation in use. */
+std::string ChaCha20AutoDetect();
+
 #endif // BITCOIN_CRYPTO_CHACHA20_H
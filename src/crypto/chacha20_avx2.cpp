@@ -0,0 +1,159 @@
+// Copyright (c) 2024-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// 8-way AVX2 ChaCha20 block function: each of the 16 state words is held in a
+// ymm register with one lane per block, so eight 64-byte blocks move through
+// the 20 rounds together. The caller (crypto/chacha20.cpp) guarantees that the
+// block counter does not wrap within the span, and handles the <8 block tail
+// with the scalar code.
+namespace chacha20_avx2 {
+namespace {
+
+inline __m256i Rotl16(__m256i x)
+{
+    const __m256i mask = _mm256_set_epi8(
+        13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+        13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+inline __m256i Rotl12(__m256i x)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(x, 12), _mm256_srli_epi32(x, 20));
+}
+
+inline __m256i Rotl8(__m256i x)
+{
+    const __m256i mask = _mm256_set_epi8(
+        14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+        14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+inline __m256i Rotl7(__m256i x)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(x, 7), _mm256_srli_epi32(x, 25));
+}
+
+inline void QuarterRound(__m256i& a, __m256i& b, __m256i& c, __m256i& d)
+{
+    a = _mm256_add_epi32(a, b); d = Rotl16(_mm256_xor_si256(d, a));
+    c = _mm256_add_epi32(c, d); b = Rotl12(_mm256_xor_si256(b, c));
+    a = _mm256_add_epi32(a, b); d = Rotl8(_mm256_xor_si256(d, a));
+    c = _mm256_add_epi32(c, d); b = Rotl7(_mm256_xor_si256(b, c));
+}
+
+//! Transpose an 8x8 matrix of 32-bit words held in v[0..7] (rows -> columns).
+inline void Transpose8(__m256i v[8])
+{
+    __m256i t0 = _mm256_unpacklo_epi32(v[0], v[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(v[0], v[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(v[2], v[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(v[2], v[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(v[4], v[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(v[4], v[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(v[6], v[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(v[6], v[7]);
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    v[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    v[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    v[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    v[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    v[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    v[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    v[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    v[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+//! Compute 8 blocks of keystream into lo[0..7] (first 32 bytes of each block,
+//! block per row after transpose) and hi[0..7] (last 32 bytes of each block).
+inline void Blocks8(const uint32_t input[12], uint32_t counter, __m256i lo[8], __m256i hi[8])
+{
+    __m256i j[16];
+    j[0] = _mm256_set1_epi32(0x61707865);
+    j[1] = _mm256_set1_epi32(0x3320646e);
+    j[2] = _mm256_set1_epi32(0x79622d32);
+    j[3] = _mm256_set1_epi32(0x6b206574);
+    for (int i = 0; i < 8; ++i) j[4 + i] = _mm256_set1_epi32(input[i]);
+    j[12] = _mm256_add_epi32(_mm256_set1_epi32(counter), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    j[13] = _mm256_set1_epi32(input[9]);
+    j[14] = _mm256_set1_epi32(input[10]);
+    j[15] = _mm256_set1_epi32(input[11]);
+
+    __m256i x[16];
+    for (int i = 0; i < 16; ++i) x[i] = j[i];
+
+    for (int round = 0; round < 10; ++round) {
+        QuarterRound(x[0], x[4], x[8], x[12]);
+        QuarterRound(x[1], x[5], x[9], x[13]);
+        QuarterRound(x[2], x[6], x[10], x[14]);
+        QuarterRound(x[3], x[7], x[11], x[15]);
+        QuarterRound(x[0], x[5], x[10], x[15]);
+        QuarterRound(x[1], x[6], x[11], x[12]);
+        QuarterRound(x[2], x[7], x[8], x[13]);
+        QuarterRound(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; ++i) x[i] = _mm256_add_epi32(x[i], j[i]);
+
+    for (int i = 0; i < 8; ++i) lo[i] = x[i];
+    for (int i = 0; i < 8; ++i) hi[i] = x[8 + i];
+    Transpose8(lo);
+    Transpose8(hi);
+}
+
+} // namespace
+
+void Keystream(const uint32_t input[12], unsigned char* out, size_t blocks)
+{
+    uint32_t counter = input[8];
+    while (blocks >= 8) {
+        __m256i lo[8], hi[8];
+        Blocks8(input, counter, lo, hi);
+        for (int b = 0; b < 8; ++b) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64 * b), lo[b]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64 * b + 32), hi[b]);
+        }
+        counter += 8;
+        out += 8 * 64;
+        blocks -= 8;
+    }
+}
+
+void Crypt(const uint32_t input[12], const unsigned char* in, unsigned char* out, size_t blocks)
+{
+    uint32_t counter = input[8];
+    while (blocks >= 8) {
+        __m256i lo[8], hi[8];
+        Blocks8(input, counter, lo, hi);
+        for (int b = 0; b < 8; ++b) {
+            __m256i m0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 64 * b));
+            __m256i m1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 64 * b + 32));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64 * b), _mm256_xor_si256(lo[b], m0));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64 * b + 32), _mm256_xor_si256(hi[b], m1));
+        }
+        counter += 8;
+        in += 8 * 64;
+        out += 8 * 64;
+        blocks -= 8;
+    }
+}
+
+} // namespace chacha20_avx2
+
+#endif // ENABLE_AVX2
@@ -4,10 +4,18 @@
 
 #include <crypto/hex_base.h>
 
+#include <compat/cpuid.h>
+
 #include <array>
 #include <cstring>
 #include <string>
 
+#if defined(ENABLE_SSE41)
+namespace hexstr_sse41 {
+void EncodeHex(const uint8_t* in, size_t len, char* out);
+} // namespace hexstr_sse41
+#endif
+
 namespace {
 
 using ByteAsHex = std::array<char, 2>;
@@ -24,22 +32,53 @@ constexpr std::array<ByteAsHex, 256> CreateByteToHexMap()
     return byte_to_hex;
 }
 
+void EncodeHexGeneric(const uint8_t* in, size_t len, char* out)
+{
+    static constexpr auto byte_to_hex = CreateByteToHexMap();
+    static_assert(sizeof(byte_to_hex) == 512);
+
+    for (size_t i = 0; i < len; ++i) {
+        std::memcpy(out + 2 * i, byte_to_hex[in[i]].data(), 2);
+    }
+}
+
+using HexEncodeFn = void (*)(const uint8_t*, size_t, char*);
+
+// Active encoder, set by HexStrAutoDetect(); defaults to the portable
+// table lookup.
+HexEncodeFn g_hex_encode{EncodeHexGeneric};
+
+#if defined(ENABLE_SSE41) && defined(HAVE_GETCPUID)
+bool SSE41Supported()
+{
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    return (ecx >> 19) & 1;
+}
+#endif
+
 } // namespace
 
 std::string HexStr(const Span<const uint8_t> s)
 {
     std::string rv(s.size() * 2, '\0');
-    static constexpr auto byte_to_hex = CreateByteToHexMap();
-    static_assert(sizeof(byte_to_hex) == 512);
+    g_hex_encode(s.data(), s.size(), rv.data());
+    return rv;
+}
 
-    char* it = rv.data();
-    for (uint8_t v : s) {
-        std::memcpy(it, byte_to_hex[v].data(), 2);
-        it += 2;
+std::string HexStrAutoDetect()
+{
+    std::string ret = "generic";
+    g_hex_encode = EncodeHexGeneric;
+
+#if defined(ENABLE_SSE41) && defined(HAVE_GETCPUID)
+    if (SSE41Supported()) {
+        g_hex_encode = hexstr_sse41::EncodeHex;
+        ret = "sse4.1";
     }
+#endif
 
-    assert(it == rv.data() + rv.size());
-    return rv;
+    return ret;
 }
 
 const signed char p_util_hexdigit[256] =
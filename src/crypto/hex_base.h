@@ -20,4 +20,7 @@ inline std::string HexStr(const Span<const std::byte> s) { return HexStr(MakeUCh
 
 signed char HexDigit(char c);
 
+/** Choose the best available HexStr implementation. Returns its name. */
+std::string HexStrAutoDetect();
+
 #endif // BITCOIN_CRYPTO_HEX_BASE_H
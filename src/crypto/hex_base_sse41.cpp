@@ -0,0 +1,36 @@
+// SSE4.1 hex encoding: expands 16 input bytes to 32 hex characters per
+// iteration, mapping each nibble to its character with a pshufb lookup.
+
+#ifdef ENABLE_SSE41
+
+#include <smmintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hexstr_sse41 {
+
+void EncodeHex(const uint8_t* in, size_t len, char* out)
+{
+    static constexpr char hexmap[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+    const __m128i hex_lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i nib_mask = _mm_set1_epi8(0x0f);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i lo = _mm_shuffle_epi8(hex_lut, _mm_and_si128(v, nib_mask));
+        __m128i hi = _mm_shuffle_epi8(hex_lut, _mm_and_si128(_mm_srli_epi16(v, 4), nib_mask));
+        // The high nibble's character comes first in the output.
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    for (; i < len; ++i) {
+        out[2 * i] = hexmap[in[i] >> 4];
+        out[2 * i + 1] = hexmap[in[i] & 15];
+    }
+}
+
+} // namespace hexstr_sse41
+
+#endif // ENABLE_SSE41
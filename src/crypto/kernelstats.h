@@ -0,0 +1,74 @@
+// Copyright (c) 2024-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_CRYPTO_KERNELSTATS_H
+#define BITCOIN_CRYPTO_KERNELSTATS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/** Call/byte counters for the crypto kernels.
+ *
+ * Each primitive records how often it is invoked and how many input bytes it
+ * processed, so the share of CPU going to SHA256 vs ChaCha20 vs SipHash vs
+ * TensHash per host can be estimated from RPC (getcryptostats) instead of an
+ * external profiler. This uses the same batched thread-local scheme as
+ * util/allocprofile.h, so recording on a per-message or per-hash path never
+ * touches a shared cache line; the published totals may lag by up to one
+ * unflushed batch per thread.
+ */
+namespace kernel_stats {
+
+enum class Kernel : std::size_t {
+    SHA256,
+    CHACHA20,
+    SIPHASH,
+    TENSHASH,
+};
+inline constexpr std::array<std::string_view, 4> KERNEL_NAMES{"sha256", "chacha20", "siphash", "tenshash"};
+
+struct KernelCounters {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> bytes{0};
+};
+inline std::array<KernelCounters, KERNEL_NAMES.size()> g_counters;
+
+namespace detail {
+struct LocalCounters {
+    uint64_t calls{0};
+    uint64_t bytes{0};
+};
+inline thread_local std::array<LocalCounters, KERNEL_NAMES.size()> t_counters;
+inline thread_local uint32_t t_unflushed{0};
+
+//! Number of records a thread accumulates before publishing them.
+inline constexpr uint32_t FLUSH_INTERVAL{4096};
+} // namespace detail
+
+inline void Flush() noexcept
+{
+    for (std::size_t i = 0; i < KERNEL_NAMES.size(); ++i) {
+        detail::LocalCounters& local{detail::t_counters[i]};
+        if (local.calls == 0) continue;
+        g_counters[i].calls.fetch_add(local.calls, std::memory_order_relaxed);
+        g_counters[i].bytes.fetch_add(local.bytes, std::memory_order_relaxed);
+        local = {};
+    }
+    detail::t_unflushed = 0;
+}
+
+inline void Record(Kernel kernel, std::size_t bytes) noexcept
+{
+    detail::LocalCounters& local{detail::t_counters[static_cast<std::size_t>(kernel)]};
+    ++local.calls;
+    local.bytes += bytes;
+    if (++detail::t_unflushed >= detail::FLUSH_INTERVAL) Flush();
+}
+
+} // namespace kernel_stats
+
+#endif // BITCOIN_CRYPTO_KERNELSTATS_H
@@ -4,7 +4,11 @@
 
 #include <crypto/siphash.h>
 
+#include <compat/cpuid.h>
+#include <crypto/kernelstats.h>
+
 #include <bit>
+#include <cassert>
 
 #define SIPROUND do { \
     v0 += v1; v1 = std::rotl(v1, 13); v1 ^= v0; \
@@ -27,6 +31,7 @@ CSipHasher::CSipHasher(uint64_t k0, uint64_t k1)
 
 CSipHasher& CSipHasher::Write(uint64_t data)
 {
+    kernel_stats::Record(kernel_stats::Kernel::SIPHASH, 8);
     uint64_t v0 = v[0], v1 = v[1], v2 = v[2], v3 = v[3];
 
     assert(count % 8 == 0);
@@ -47,6 +52,7 @@ CSipHasher& CSipHasher::Write(uint64_t data)
 
 CSipHasher& CSipHasher::Write(Span<const unsigned char> data)
 {
+    kernel_stats::Record(kernel_stats::Kernel::SIPHASH, data.size());
     uint64_t v0 = v[0], v1 = v[1], v2 = v[2], v3 = v[3];
     uint64_t t = tmp;
     uint8_t c = count;
@@ -94,6 +100,7 @@ uint64_t CSipHasher::Finalize() const
 
 uint64_t SipHashUint256(uint64_t k0, uint64_t k1, const uint256& val)
 {
+    kernel_stats::Record(kernel_stats::Kernel::SIPHASH, 32);
     /* Specialized implementation for efficiency */
     uint64_t d = val.GetUint64(0);
 
@@ -134,6 +141,7 @@ uint64_t SipHashUint256(uint64_t k0, uint64_t k1, const uint256& val)
 
 uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint32_t extra)
 {
+    kernel_stats::Record(kernel_stats::Kernel::SIPHASH, 36);
     /* Specialized implementation for efficiency */
     uint64_t d = val.GetUint64(0);
 
@@ -172,3 +180,65 @@ uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint3
     SIPROUND;
     return v0 ^ v1 ^ v2 ^ v3;
 }
+
+#if defined(ENABLE_AVX2)
+namespace siphash_avx2 {
+void SipHashUint256Batch(uint64_t k0, uint64_t k1, Span<const uint256* const> vals, Span<uint64_t> out);
+} // namespace siphash_avx2
+#endif
+
+namespace {
+void SipHashUint256BatchGeneric(uint64_t k0, uint64_t k1, Span<const uint256* const> vals, Span<uint64_t> out)
+{
+    for (size_t i = 0; i < vals.size(); ++i) {
+        out[i] = SipHashUint256(k0, k1, *vals[i]);
+    }
+}
+
+using SipHashBatchFn = void (*)(uint64_t, uint64_t, Span<const uint256* const>, Span<uint64_t>);
+
+// Active batch implementation, set by SipHashAutoDetect(); defaults to the
+// portable scalar loop.
+SipHashBatchFn g_siphash_batch{SipHashUint256BatchGeneric};
+
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+/** Check whether the OS has enabled AVX registers. */
+bool AVXEnabled()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 6) == 6;
+}
+
+bool AVX2Supported()
+{
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    if (!(((ecx >> 27) & 1) && ((ecx >> 28) & 1) && AVXEnabled())) return false;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    return (ebx >> 5) & 1;
+}
+#endif
+} // namespace
+
+void SipHashUint256Batch(uint64_t k0, uint64_t k1, Span<const uint256* const> vals, Span<uint64_t> out)
+{
+    assert(vals.size() == out.size());
+    kernel_stats::Record(kernel_stats::Kernel::SIPHASH, 32 * vals.size());
+    g_siphash_batch(k0, k1, vals, out);
+}
+
+std::string SipHashAutoDetect()
+{
+    std::string ret = "generic";
+    g_siphash_batch = SipHashUint256BatchGeneric;
+
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+    if (AVX2Supported()) {
+        g_siphash_batch = siphash_avx2::SipHashUint256Batch;
+        ret = "avx2-4way";
+    }
+#endif
+
+    return ret;
+}
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <span.h>
+#include <string>
 #include <uint256.h>
 
 /** SipHash-2-4 */
@@ -45,4 +46,19 @@ public:
 uint64_t SipHashUint256(uint64_t k0, uint64_t k1, const uint256& val);
 uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint32_t extra);
 
+/** Compute SipHash-2-4 of multiple uint256 inputs sharing one key.
+ *
+ *  Equivalent to out[i] = SipHashUint256(k0, k1, *vals[i]) for every i, but
+ *  may use a vectorized implementation that hashes several inputs per pass.
+ *  Intended for bulk callers such as compact block short ID matching, where
+ *  one key is applied to every transaction in the mempool.
+ *
+ *  vals and out must have the same size.
+ */
+void SipHashUint256Batch(uint64_t k0, uint64_t k1, Span<const uint256* const> vals, Span<uint64_t> out);
+
+/** Choose the best available SipHashUint256Batch implementation.
+ *  Returns the name of the implementation. */
+std::string SipHashAutoDetect();
+
 #endif // BITCOIN_CRYPTO_SIPHASH_H
@@ -0,0 +1,51 @@
+#include <crypto/tens_pow/tens_ctx_cache.h>
+
+#include <cstring>
+
+TensHashContextCache::ContextRef TensHashContextCache::Get(const uint8_t seed[32])
+{
+    Seed key;
+    std::memcpy(key.data(), seed, key.size());
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+            return it->second.first;
+        }
+    }
+
+    // Generate outside the lock: matrix generation takes tens of milliseconds
+    // and must not stall concurrent lookups. Two threads racing on the same
+    // seed at worst generate the context twice; the loser's copy is dropped.
+    ContextRef ctx;
+    bool loaded{false};
+    if (m_store_load) {
+        ctx = m_store_load(seed);
+        loaded = (ctx != nullptr);
+    }
+    if (!ctx) ctx = ContextRef(tens_hash_init(seed), tens_hash_free);
+    if (!ctx) return nullptr;
+    if (!loaded && m_store_save) m_store_save(seed, *ctx);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+        return it->second.first;
+    }
+    m_lru.push_front(key);
+    m_entries.emplace(key, std::make_pair(ctx, m_lru.begin()));
+    while (m_entries.size() > m_max_entries) {
+        m_entries.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+    return ctx;
+}
+
+TensHashContextCache& TensHashContexts()
+{
+    static TensHashContextCache cache;
+    return cache;
+}
@@ -0,0 +1,68 @@
+#ifndef BITCOIN_CRYPTO_TENS_POW_TENS_CTX_CACHE_H
+#define BITCOIN_CRYPTO_TENS_POW_TENS_CTX_CACHE_H
+
+#include <crypto/tens_pow/tens_hash.h>
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/** Thread-safe LRU cache of per-seed TensHash contexts.
+ *
+ * Generating a context derives ~67MB of ChaCha20 keystream and is by far the
+ * most expensive part of a single header verification. The seed is the
+ * header hash of the block being checked, so any path that hashes the same
+ * header more than once (header/block double validation, mining loops,
+ * submitblock) can reuse the matrices instead of regenerating them.
+ *
+ * Contexts are immutable after tens_hash_init(), so the returned shared_ptr
+ * may be used concurrently from any number of threads and stays valid even
+ * after the entry has been evicted.
+ */
+class TensHashContextCache
+{
+public:
+    using ContextRef = std::shared_ptr<TensHashContext>;
+
+    //! Default number of cached contexts (~17MB each with packed storage).
+    static constexpr size_t DEFAULT_MAX_ENTRIES{8};
+
+    explicit TensHashContextCache(size_t max_entries = DEFAULT_MAX_ENTRIES) : m_max_entries(max_entries) {}
+
+    /** Return the context for `seed`, generating and inserting it on a miss.
+     *  Returns nullptr only on allocation failure. */
+    ContextRef Get(const uint8_t seed[32]);
+
+    using StoreLoader = ContextRef (*)(const uint8_t seed[32]);
+    using StoreSaver = void (*)(const uint8_t seed[32], const TensHashContext& ctx);
+
+    /** Register an optional backing store, consulted on a cache miss before
+     *  generating and informed after each generation. Used by the node layer
+     *  to persist matrices across restarts (node/tens_ctx_store.cpp); the
+     *  crypto layer itself has no notion of a datadir. Call during startup,
+     *  before concurrent lookups begin. */
+    void SetStore(StoreLoader loader, StoreSaver saver)
+    {
+        m_store_load = loader;
+        m_store_save = saver;
+    }
+
+private:
+    using Seed = std::array<uint8_t, 32>;
+
+    std::mutex m_mutex;
+    const size_t m_max_entries;
+    //! Most recently used seeds at the front.
+    std::list<Seed> m_lru;
+    std::map<Seed, std::pair<ContextRef, std::list<Seed>::iterator>> m_entries;
+    StoreLoader m_store_load{nullptr};
+    StoreSaver m_store_save{nullptr};
+};
+
+/** Process-wide context cache shared by validation and mining. */
+TensHashContextCache& TensHashContexts();
+
+#endif // BITCOIN_CRYPTO_TENS_POW_TENS_CTX_CACHE_H
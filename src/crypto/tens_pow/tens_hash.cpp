@@ -2,18 +2,184 @@
 #include <stdlib.h>
 #include <string.h>
 #include <crypto/chacha20.h>
+#include <crypto/kernelstats.h>
+#include <util/allocprofile.h>
 #include <crypto/common.h>
+#include <compat/cpuid.h>
+#include <assert.h>
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <span>
 #include <logging.h>
 #include <util/strencodings.h>
 
 #define TENS_HIDDEN 1024             // Hidden layer size (number of neurons)
-#define NUM_HIDDEN_LAYERS 64         // Number of hidden layers
+#define TENS_MAX_HIDDEN_LAYERS 64    // Default (and maximum) number of hidden layers
+
+// Number of hidden layers actually evaluated. Consensus-parameter driven:
+// mainnet and the public test networks use the full 64, regtest runs a
+// reduced network so tests are not dominated by PoW evaluation. Set once at
+// startup via tens_hash_set_hidden_layers(), before any context exists.
+static int g_num_hidden_layers = TENS_MAX_HIDDEN_LAYERS;
 
 // INPUT_BITS is the number of bits in the input vector.
 #define INPUT_BITS (TENS_IN_SIZE * 8) // 256 bits
 
+#define INPUT_WORDS (INPUT_BITS / 64)   // 4 packed words per 256-bit vector
+#define HIDDEN_WORDS (TENS_HIDDEN / 64) // 16 packed words per 1024-bit vector
+
+// Signature of a bit-sliced layer kernel. `planes` holds out_dim rows, each
+// consisting of a "+1" bitplane followed by a "-1" bitplane of in_words words.
+// `x` is the packed input vector (bit set = +1, clear = -1). When `residual`
+// is set (hidden layers, in_dim == out_dim) the mapped input element is added
+// to each neuron's sum before thresholding.
+typedef void (*LayerForwardType)(const uint64_t* planes, const int16_t* bias,
+                                 int in_words, int out_dim,
+                                 const uint64_t* x, bool residual, int row_offset,
+                                 uint64_t* out);
+
+// Batched variant: `count` packed input vectors, each occupying a
+// TENS_HIDDEN/64-word slot in `xs` (upper words zero when in_dim is
+// smaller), producing `count` equally-spaced outputs in `outs`. The row
+// planes are loaded once per row and reused across the whole batch.
+typedef void (*LayerForwardBatchType)(const uint64_t* planes, const int16_t* bias,
+                                      int in_words, int out_dim,
+                                      const uint64_t* xs, size_t count,
+                                      bool residual, uint64_t* outs);
+
+namespace tens_hash_port {
+// Portable fallback: 64-bit AND + popcount per plane word.
+//
+// For a ternary row with "+1" plane P and "-1" plane M, and input X where a
+// set bit means +1 and a clear bit means -1:
+//   sum = 2*(popcount(P & X) - popcount(M & X)) + popcount(M) - popcount(P)
+// The constant popcount(M) - popcount(P) term is precomputed into bias[].
+void LayerForward(const uint64_t* planes, const int16_t* bias,
+                  int in_words, int out_dim,
+                  const uint64_t* x, bool residual, int row_offset,
+                  uint64_t* out)
+{
+    memset(out, 0, (out_dim / 64) * sizeof(uint64_t));
+    for (int j = 0; j < out_dim; j++) {
+        const uint64_t* plus = planes + (size_t)j * 2 * in_words;
+        const uint64_t* minus = plus + in_words;
+        // Pull the next row in while this one is being consumed; rows are
+        // only ever touched once per hash, so the hardware prefetcher gets
+        // no second chance.
+        __builtin_prefetch(plus + 2 * in_words);
+        int32_t acc = 0;
+        for (int i = 0; i < in_words; i++) {
+            acc += std::popcount(plus[i] & x[i]);
+            acc -= std::popcount(minus[i] & x[i]);
+        }
+        int32_t sum = 2 * acc + bias[j];
+        if (residual) {
+            int r = row_offset + j;
+            sum += ((x[r >> 6] >> (r & 63)) & 1) ? 1 : -1;
+        }
+        if (sum > 0) out[j >> 6] |= uint64_t{1} << (j & 63);
+    }
+}
+
+void LayerForwardBatch(const uint64_t* planes, const int16_t* bias,
+                       int in_words, int out_dim,
+                       const uint64_t* xs, size_t count,
+                       bool residual, uint64_t* outs)
+{
+    const int stride = TENS_HIDDEN / 64;
+    memset(outs, 0, count * stride * sizeof(uint64_t));
+    for (int j = 0; j < out_dim; j++) {
+        const uint64_t* plus = planes + (size_t)j * 2 * in_words;
+        const uint64_t* minus = plus + in_words;
+        const int16_t b = bias[j];
+        for (size_t n = 0; n < count; n++) {
+            const uint64_t* x = xs + n * stride;
+            int32_t acc = 0;
+            for (int i = 0; i < in_words; i++) {
+                acc += std::popcount(plus[i] & x[i]);
+                acc -= std::popcount(minus[i] & x[i]);
+            }
+            int32_t sum = 2 * acc + b;
+            if (residual) {
+                sum += ((x[j >> 6] >> (j & 63)) & 1) ? 1 : -1;
+            }
+            if (sum > 0) outs[n * stride + (j >> 6)] |= uint64_t{1} << (j & 63);
+        }
+    }
+}
+} // namespace tens_hash_port
+
+#if defined(ENABLE_AVX2)
+namespace tens_hash_avx2 {
+void LayerForward(const uint64_t* planes, const int16_t* bias,
+                  int in_words, int out_dim,
+                  const uint64_t* x, bool residual, int row_offset,
+                  uint64_t* out);
+void LayerForwardBatch(const uint64_t* planes, const int16_t* bias,
+                       int in_words, int out_dim,
+                       const uint64_t* xs, size_t count,
+                       bool residual, uint64_t* outs);
+} // namespace tens_hash_avx2
+#endif
+
+#if defined(ENABLE_AVX512)
+namespace tens_hash_avx512 {
+void LayerForward(const uint64_t* planes, const int16_t* bias,
+                  int in_words, int out_dim,
+                  const uint64_t* x, bool residual, int row_offset,
+                  uint64_t* out);
+void LayerForwardBatch(const uint64_t* planes, const int16_t* bias,
+                       int in_words, int out_dim,
+                       const uint64_t* xs, size_t count,
+                       bool residual, uint64_t* outs);
+} // namespace tens_hash_avx512
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+namespace tens_hash_neon {
+void LayerForward(const uint64_t* planes, const int16_t* bias,
+                  int in_words, int out_dim,
+                  const uint64_t* x, bool residual, int row_offset,
+                  uint64_t* out)
+{
+    memset(out, 0, (out_dim / 64) * sizeof(uint64_t));
+    for (int j = 0; j < out_dim; j++) {
+        const uint64_t* plus = planes + (size_t)j * 2 * in_words;
+        const uint64_t* minus = plus + in_words;
+        uint64x2_t accp = vdupq_n_u64(0);
+        uint64x2_t accm = vdupq_n_u64(0);
+        for (int i = 0; i < in_words; i += 2) {
+            uint8x16_t xv = vld1q_u8(reinterpret_cast<const uint8_t*>(x + i));
+            uint8x16_t pv = vld1q_u8(reinterpret_cast<const uint8_t*>(plus + i));
+            uint8x16_t mv = vld1q_u8(reinterpret_cast<const uint8_t*>(minus + i));
+            accp = vaddq_u64(accp, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vcntq_u8(vandq_u8(pv, xv))))));
+            accm = vaddq_u64(accm, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vcntq_u8(vandq_u8(mv, xv))))));
+        }
+        int32_t acc = (int32_t)(vgetq_lane_u64(accp, 0) + vgetq_lane_u64(accp, 1)) -
+                      (int32_t)(vgetq_lane_u64(accm, 0) + vgetq_lane_u64(accm, 1));
+        int32_t sum = 2 * acc + bias[j];
+        if (residual) {
+            int r = row_offset + j;
+            sum += ((x[r >> 6] >> (r & 63)) & 1) ? 1 : -1;
+        }
+        if (sum > 0) out[j >> 6] |= uint64_t{1} << (j & 63);
+    }
+}
+} // namespace tens_hash_neon
+#endif
+
+// Active layer kernels, set by TensHashAutoDetect(); default to the portable
+// implementations so the hash is usable before autodetection has run.
+static LayerForwardType LayerForward = tens_hash_port::LayerForward;
+static LayerForwardBatchType LayerForwardBatch = tens_hash_port::LayerForwardBatch;
+
 static uint64_t to_big_endian(uint64_t val) {
     return ((val & 0x00000000000000FFULL) << 56) |
            ((val & 0x000000000000FF00ULL) << 40) |
@@ -25,9 +191,14 @@ static uint64_t to_big_endian(uint64_t val) {
            ((val & 0xFF00000000000000ULL) >> 56);
 }
 
-static void generate_dense_matrix(int rows, int cols, const uint8_t* seed, uint64_t nonce_counter, int8_t* matrix)
+// Generate one matrix directly into its packed bitplane representation.
+// Each keystream byte maps to one ternary weight (mod 4: 0,1 → 0, 2 → +1,
+// 3 → -1), exactly as the dense int8 format did; only the storage changed.
+static void generate_packed_matrix(int rows, int cols, const uint8_t* seed, uint64_t nonce_counter,
+                                   uint64_t* planes, int16_t* bias)
 {
     int total = rows * cols;
+    alloc_profile::Record(alloc_profile::Tag::POW, total);
     std::vector<std::byte> keystream(total);
     std::vector<std::byte> key_bytes(32);
     std::memcpy(key_bytes.data(), seed, 32);
@@ -46,63 +217,121 @@ static void generate_dense_matrix(int rows, int cols, const uint8_t* seed, uint6
     chacha.Keystream(keystream_span);
 
     const uint8_t* bytes = reinterpret_cast<const uint8_t*>(keystream.data());
-    for (int i = 0; i < total; i++) {
-        uint8_t mod = bytes[i] % 4;
-        int8_t val;
-        if (mod == 0 || mod == 1)
-            val = 0;
-        else if (mod == 2)
-            val = 1;
-        else // mod == 3
-            val = -1;
-        matrix[i] = val;
+    int in_words = cols / 64;
+    for (int r = 0; r < rows; r++) {
+        uint64_t* plus = planes + (size_t)r * 2 * in_words;
+        uint64_t* minus = plus + in_words;
+        memset(plus, 0, 2 * in_words * sizeof(uint64_t));
+        const uint8_t* row = bytes + (size_t)r * cols;
+        int16_t b = 0;
+        for (int i = 0; i < cols; i++) {
+            uint8_t mod = row[i] % 4;
+            if (mod == 2) {
+                plus[i >> 6] |= uint64_t{1} << (i & 63);
+                b--;
+            } else if (mod == 3) {
+                minus[i >> 6] |= uint64_t{1} << (i & 63);
+                b++;
+            }
+        }
+        bias[r] = b;
+    }
+}
+
+// Pack a ternary int8 matrix into per-row bitplanes and fold the constant
+// plane popcounts into the per-row bias (see tens_hash_port::LayerForward).
+static void pack_matrix_planes(const int8_t* matrix, int rows, int in_dim,
+                               uint64_t* planes, int16_t* bias)
+{
+    int in_words = in_dim / 64;
+    for (int r = 0; r < rows; r++) {
+        uint64_t* plus = planes + (size_t)r * 2 * in_words;
+        uint64_t* minus = plus + in_words;
+        memset(plus, 0, 2 * in_words * sizeof(uint64_t));
+        const int8_t* row = matrix + (size_t)r * in_dim;
+        int16_t b = 0;
+        for (int i = 0; i < in_dim; i++) {
+            if (row[i] > 0) {
+                plus[i >> 6] |= uint64_t{1} << (i & 63);
+                b--;
+            } else if (row[i] < 0) {
+                minus[i >> 6] |= uint64_t{1} << (i & 63);
+                b++;
+            }
+        }
+        bias[r] = b;
     }
 }
 
-static void print_matrix(const int8_t* matrix, int num_to_print)
+// Total number of independent matrices: expansion + hidden layers + compression.
+#define NUM_MATRICES (g_num_hidden_layers + 2)
+
+// Generate and pack one matrix. Matrices are identified by their nonce
+// counter: 0 = expansion, 1..g_num_hidden_layers = hidden, last = compression.
+// Each matrix has its own ChaCha20 keystream, so they are independent.
+static void generate_matrix(TensHashContext* ctx, const uint8_t seed[32], int idx)
 {
-    printf("First %d elements of matrix: ", num_to_print);
-    for (int i = 0; i < num_to_print; i++) {
-         printf("%d ", matrix[i]);
+    if (idx == 0) {
+        // Expansion matrix: dimensions: TENS_HIDDEN x INPUT_BITS (1024 x 256)
+        generate_packed_matrix(TENS_HIDDEN, INPUT_BITS, seed, idx,
+                               ctx->expansion_planes, ctx->expansion_bias);
+    } else if (idx <= g_num_hidden_layers) {
+        // Hidden matrix: TENS_HIDDEN x TENS_HIDDEN (1024 x 1024)
+        int r = idx - 1;
+        generate_packed_matrix(TENS_HIDDEN, TENS_HIDDEN, seed, idx,
+                               ctx->hidden_planes + (size_t)r * TENS_HIDDEN * 2 * HIDDEN_WORDS,
+                               ctx->hidden_bias + r * TENS_HIDDEN);
+    } else {
+        // Compression matrix: dimensions: INPUT_BITS x TENS_HIDDEN (256 x 1024)
+        generate_packed_matrix(INPUT_BITS, TENS_HIDDEN, seed, idx,
+                               ctx->compression_planes, ctx->compression_bias);
     }
-    printf("\n");
 }
 
-// Generate all matrices (expansion, hidden layers, and compression) using the seed.
+// Generate all matrices (expansion, hidden layers, and compression) using the
+// seed. The per-matrix keystreams only differ in their nonce counter, so the
+// work is spread over a batch of worker threads pulling matrix indices from a
+// shared counter.
 static void generate_all_matrices(TensHashContext* ctx, const uint8_t seed[32])
 {
     if (!ctx || !seed) return;
-    uint64_t nonce_counter = 0;
-
-    // Expansion matrix: dimensions: TENS_HIDDEN x INPUT_BITS (1024 x 256)
-    generate_dense_matrix(TENS_HIDDEN, INPUT_BITS, seed, nonce_counter++, ctx->expansion_mat);
-    //print_matrix(ctx->expansion_mat, 16);
 
-    // Hidden matrices: NUM_HIDDEN_LAYERS matrices, each of size TENS_HIDDEN x TENS_HIDDEN (1024 x 1024)
-    for (int r = 0; r < NUM_HIDDEN_LAYERS; r++) {
-        generate_dense_matrix(TENS_HIDDEN, TENS_HIDDEN, seed, nonce_counter++,
-                              ctx->hidden_mats + r * TENS_HIDDEN * TENS_HIDDEN);
-        //print_matrix(ctx->hidden_mats + r * TENS_HIDDEN * TENS_HIDDEN, 16);
+    unsigned num_threads = std::min<unsigned>(std::thread::hardware_concurrency(), NUM_MATRICES);
+    if (num_threads <= 1) {
+        for (int idx = 0; idx < NUM_MATRICES; idx++) {
+            generate_matrix(ctx, seed, idx);
+        }
+        return;
     }
 
-    // Compression matrix: dimensions: INPUT_BITS x TENS_HIDDEN (256 x 1024)
-    generate_dense_matrix(INPUT_BITS, TENS_HIDDEN, seed, nonce_counter++, ctx->compression_mat);
-    //print_matrix(ctx->compression_mat, 16);
+    std::atomic<int> next_idx{0};
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads - 1);
+    auto work = [&] {
+        int idx;
+        while ((idx = next_idx.fetch_add(1, std::memory_order_relaxed)) < NUM_MATRICES) {
+            generate_matrix(ctx, seed, idx);
+        }
+    };
+    for (unsigned t = 1; t < num_threads; t++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& w : workers) w.join();
 }
 
-// Modified forward propagation for one layer.
+// Reference forward propagation for one layer (scalar int8 path).
 //  1. Map input: x_mapped[i] = 2*input[i] - 1  (i.e., 0 → -1, 1 → +1)
 //  2. For each output neuron, compute dot product with corresponding matrix row.
 //  3. For layers where in_dim == out_dim (hidden layers), add the residual connection:
 //     add the corresponding element of x_mapped.
 //  4. Apply threshold: if sum > 0 then output = 1, else output = 0.
+// Kept as the reference implementation the bit-sliced kernels are checked
+// against in TensHashAutoDetect().
 static void layer_forward(const int8_t* matrix, int in_dim, int out_dim, const int8_t* input, int8_t* output)
 {
-    int8_t* x_mapped = (int8_t*)malloc(in_dim * sizeof(int8_t));
-    if (!x_mapped) {
-        fprintf(stderr, "Memory allocation error in layer_forward\n");
-        exit(1);
-    }
+    alloc_profile::Record(alloc_profile::Tag::POW, in_dim);
+    std::vector<int8_t> x_mapped(in_dim);
     for (int i = 0; i < in_dim; i++) {
         x_mapped[i] = (int8_t)(2 * input[i] - 1);
     }
@@ -118,36 +347,104 @@ static void layer_forward(const int8_t* matrix, int in_dim, int out_dim, const i
         }
         output[j] = sum > 0 ? 1 : 0;
     }
-    free(x_mapped);
 }
 
-// Pack 256 bits (stored as int8_t with nonzero = 1) into 32 bytes.
-static void pack_bits(const int8_t* bits, uint8_t* out_bytes)
+// All context buffers live in one contiguous arena so a context costs a
+// single allocation, and retired arenas are recycled through a small pool:
+// every context has the same layout, so churn from parallel header
+// validation reuses warm slabs instead of hammering the allocator. (The
+// project's PoolResource is tuned for small map nodes, not ~17MB slabs,
+// hence the dedicated freelist.)
+static const size_t EXPANSION_PLANE_WORDS = (size_t)TENS_HIDDEN * 2 * INPUT_WORDS;
+static const size_t COMPRESSION_PLANE_WORDS = (size_t)INPUT_BITS * 2 * HIDDEN_WORDS;
+// The hidden-layer region (and with it the arena) scales with the configured
+// layer count, so these are functions rather than constants.
+static size_t hidden_plane_words() { return (size_t)g_num_hidden_layers * TENS_HIDDEN * 2 * HIDDEN_WORDS; }
+static size_t bias_count() { return TENS_HIDDEN + (size_t)g_num_hidden_layers * TENS_HIDDEN + INPUT_BITS; }
+static size_t arena_bytes()
 {
-    memset(out_bytes, 0, TENS_IN_SIZE);
-    for (int i = 0; i < INPUT_BITS; i++) {
-        if (bits[i])
-            out_bytes[i / 8] |= (1 << (7 - (i % 8)));
+    return (EXPANSION_PLANE_WORDS + hidden_plane_words() + COMPRESSION_PLANE_WORDS) * sizeof(uint64_t) +
+           bias_count() * sizeof(int16_t);
+}
+// Arenas are always allocated at the full 64-layer size even when a reduced
+// network is configured, so pooled arenas stay reusable if the layer count
+// changes between chain selections (unit tests switch networks in-process).
+static const size_t ARENA_BYTES_MAX =
+    (EXPANSION_PLANE_WORDS +
+     (size_t)TENS_MAX_HIDDEN_LAYERS * TENS_HIDDEN * 2 * HIDDEN_WORDS +
+     COMPRESSION_PLANE_WORDS) * sizeof(uint64_t) +
+    (TENS_HIDDEN + (size_t)TENS_MAX_HIDDEN_LAYERS * TENS_HIDDEN + INPUT_BITS) * sizeof(int16_t);
+
+namespace {
+std::mutex g_arena_mutex;
+std::vector<void*> g_arena_pool;
+constexpr size_t MAX_POOLED_ARENAS{8};
+
+void* AcquireArena()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_arena_mutex);
+        if (!g_arena_pool.empty()) {
+            void* arena = g_arena_pool.back();
+            g_arena_pool.pop_back();
+            return arena;
+        }
+    }
+    alloc_profile::Record(alloc_profile::Tag::POW, ARENA_BYTES_MAX);
+    return malloc(ARENA_BYTES_MAX);
+}
+
+void ReleaseArena(void* arena)
+{
+    if (!arena) return;
+    {
+        std::lock_guard<std::mutex> lock(g_arena_mutex);
+        if (g_arena_pool.size() < MAX_POOLED_ARENAS) {
+            g_arena_pool.push_back(arena);
+            return;
+        }
     }
+    free(arena);
+}
+} // namespace
+
+size_t tens_hash_arena_size(void)
+{
+    return arena_bytes();
+}
+
+void tens_hash_set_hidden_layers(int n)
+{
+    // Arenas are pooled at the maximum geometry (see ARENA_BYTES_MAX), so
+    // only the evaluated layer count changes here.
+    if (n < 1 || n > TENS_MAX_HIDDEN_LAYERS) return;
+    g_num_hidden_layers = n;
+}
+
+int tens_hash_hidden_layers(void)
+{
+    return g_num_hidden_layers;
+}
+
+// Carve the context buffers out of a single arena. The 64-bit plane regions
+// come first so everything stays naturally aligned.
+void tens_hash_context_carve(TensHashContext* ctx, void* arena)
+{
+    ctx->expansion_planes = (uint64_t*)arena;
+    ctx->hidden_planes = ctx->expansion_planes + EXPANSION_PLANE_WORDS;
+    ctx->compression_planes = ctx->hidden_planes + hidden_plane_words();
+    int16_t* bias = (int16_t*)(ctx->compression_planes + COMPRESSION_PLANE_WORDS);
+    ctx->expansion_bias = bias;
+    ctx->hidden_bias = ctx->expansion_bias + TENS_HIDDEN;
+    ctx->compression_bias = ctx->hidden_bias + (size_t)g_num_hidden_layers * TENS_HIDDEN;
 }
 
-// Allocate buffers inside the context.
 static bool alloc_context_buffers(TensHashContext* ctx)
 {
     if (!ctx) return false;
-    // Expansion matrix: TENS_HIDDEN x INPUT_BITS
-    ctx->expansion_mat = (int8_t*)malloc(TENS_HIDDEN * INPUT_BITS * sizeof(int8_t));
-    // Hidden matrices: NUM_HIDDEN_LAYERS matrices each of size TENS_HIDDEN x TENS_HIDDEN
-    ctx->hidden_mats = (int8_t*)malloc(NUM_HIDDEN_LAYERS * TENS_HIDDEN * TENS_HIDDEN * sizeof(int8_t));
-    // Compression matrix: INPUT_BITS x TENS_HIDDEN
-    ctx->compression_mat = (int8_t*)malloc(INPUT_BITS * TENS_HIDDEN * sizeof(int8_t));
-    // Allocate state buffers (using TENS_HIDDEN as working size)
-    ctx->state = (int8_t*)calloc(TENS_HIDDEN, sizeof(int8_t));
-    ctx->next_state = (int8_t*)calloc(TENS_HIDDEN, sizeof(int8_t));
-
-    if (!ctx->expansion_mat || !ctx->hidden_mats || !ctx->compression_mat || !ctx->state || !ctx->next_state) {
-        return false;
-    }
+    void* arena = AcquireArena();
+    if (!arena) return false;
+    tens_hash_context_carve(ctx, arena);
     return true;
 }
 
@@ -168,38 +465,153 @@ TensHashContext* tens_hash_init(const uint8_t seed[32])
         swapped_seed[i] = seed[31 - i];
     }
 
-    printf("tens_hash_init Seed (hex): ");
-    for (int i = 0; i < TENS_IN_SIZE; i++) {
-        printf("%02X", swapped_seed[i]);
+    if (LogAcceptCategory(BCLog::POW, BCLog::Level::Debug)) {
+        LogDebug(BCLog::POW, "tens_hash_init seed=%s\n", HexStr(swapped_seed));
     }
-    printf("\n");
 
     // Use the swapped seed for generating matrices.
     generate_all_matrices(ctx, swapped_seed);
     return ctx;
 }
 
+TensHashContext* tens_hash_clone(const TensHashContext* ctx)
+{
+    if (!ctx) return nullptr;
+    TensHashContext* copy = (TensHashContext*)malloc(sizeof(TensHashContext));
+    if (!copy) return nullptr;
+    memset(copy, 0, sizeof(TensHashContext));
+    // Fresh pages rather than a pooled arena: the memcpy below is the first
+    // touch, which is what places the replica on the calling thread's node.
+    alloc_profile::Record(alloc_profile::Tag::POW, ARENA_BYTES_MAX);
+    void* arena = malloc(ARENA_BYTES_MAX);
+    if (!arena) {
+        free(copy);
+        return nullptr;
+    }
+    tens_hash_context_carve(copy, arena);
+    memcpy(arena, ctx->expansion_planes, arena_bytes());
+    return copy;
+}
+
 void tens_hash_free(TensHashContext* ctx)
 {
     if (ctx) {
-        free(ctx->expansion_mat);
-        free(ctx->hidden_mats);
-        free(ctx->compression_mat);
-        free(ctx->state);
-        free(ctx->next_state);
+        // The expansion planes are the base of the single backing arena.
+        ReleaseArena(ctx->expansion_planes);
         free(ctx);
     }
 }
 
+// Number of worker threads used for a single trunk evaluation (1 = serial).
+static std::atomic<int> g_verify_threads{1};
+
+void tens_hash_set_verify_threads(int n)
+{
+    if (n <= 0) {
+        n = (int)std::min<unsigned>(4, std::max(1u, std::thread::hardware_concurrency()));
+    }
+    // Row ranges handed to each worker must stay 64-bit-word aligned, so
+    // round down to a power of two (at most 16 workers = 64 rows each).
+    int t = 1;
+    while (t * 2 <= n && t * 2 <= 16) t *= 2;
+    g_verify_threads.store(t, std::memory_order_relaxed);
+}
+
+// Parallel trunk evaluation: the 1024 output rows of each layer are split
+// into contiguous ranges, one per worker. Workers persist across all layers
+// and synchronize at layer boundaries; the ping-pong buffer choice is a pure
+// function of the layer parity so no shared pointer swap is needed.
+static void run_trunk_layers_mt(const uint8_t input_swapped[TENS_IN_SIZE], TensHashContext* ctx,
+                                uint64_t*& state, uint64_t*& next, int nthreads)
+{
+    uint64_t* buf_a = state;
+    uint64_t* buf_b = next;
+    memset(buf_a, 0, HIDDEN_WORDS * sizeof(uint64_t));
+    for (int i = 0; i < INPUT_BITS; i++) {
+        if ((input_swapped[i / 8] >> (7 - (i % 8))) & 1) {
+            buf_a[i >> 6] |= uint64_t{1} << (i & 63);
+        }
+    }
+
+    const int rows_per = TENS_HIDDEN / nthreads;
+    std::barrier sync(nthreads);
+    auto work = [&](int t) {
+        const int base = t * rows_per;
+        const int base_words = base / 64;
+        // Expansion layer: buf_a (packed 256-bit input) -> buf_b.
+        LayerForward(ctx->expansion_planes + (size_t)base * 2 * INPUT_WORDS,
+                     ctx->expansion_bias + base, INPUT_WORDS, rows_per,
+                     buf_a, false, 0, buf_b + base_words);
+        sync.arrive_and_wait();
+        for (int r = 0; r < g_num_hidden_layers; r++) {
+            uint64_t* src = (r % 2 == 0) ? buf_b : buf_a;
+            uint64_t* dst = (r % 2 == 0) ? buf_a : buf_b;
+            LayerForward(ctx->hidden_planes + ((size_t)r * TENS_HIDDEN + base) * 2 * HIDDEN_WORDS,
+                         ctx->hidden_bias + r * TENS_HIDDEN + base, HIDDEN_WORDS, rows_per,
+                         src, true, base, dst + base_words);
+            sync.arrive_and_wait();
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(nthreads - 1);
+    for (int t = 1; t < nthreads; t++) workers.emplace_back(work, t);
+    work(0);
+    for (auto& w : workers) w.join();
+
+    // Expansion lands in buf_b; each hidden layer flips the buffers.
+    if (g_num_hidden_layers % 2 == 0) {
+        state = buf_b;
+        next = buf_a;
+    } else {
+        state = buf_a;
+        next = buf_b;
+    }
+}
+
+// Pack the (already byte-swapped) input and run the expansion and hidden
+// layers. `state` and `next` are caller-provided HIDDEN_WORDS-sized buffers;
+// on return `state` points at the 1024-bit trunk state.
+static void run_trunk_layers(const uint8_t input_swapped[TENS_IN_SIZE], TensHashContext* ctx,
+                             uint64_t*& state, uint64_t*& next)
+{
+    int nthreads = g_verify_threads.load(std::memory_order_relaxed);
+    if (nthreads > 1) {
+        run_trunk_layers_mt(input_swapped, ctx, state, next, nthreads);
+        return;
+    }
+
+    memset(state, 0, HIDDEN_WORDS * sizeof(uint64_t));
+    for (int i = 0; i < INPUT_BITS; i++) {
+        if ((input_swapped[i / 8] >> (7 - (i % 8))) & 1) {
+            state[i >> 6] |= uint64_t{1} << (i & 63);
+        }
+    }
+
+    // --- Expansion layer: from INPUT_BITS (256) to TENS_HIDDEN (1024) ---
+    LayerForward(ctx->expansion_planes, ctx->expansion_bias, INPUT_WORDS, TENS_HIDDEN,
+                 state, false, 0, next);
+    std::swap(state, next);
+
+    // --- Hidden layers: g_num_hidden_layers rounds (each 1024→1024) with residual connections ---
+    for (int r = 0; r < g_num_hidden_layers; r++) {
+        LayerForward(ctx->hidden_planes + (size_t)r * TENS_HIDDEN * 2 * HIDDEN_WORDS,
+                     ctx->hidden_bias + r * TENS_HIDDEN, HIDDEN_WORDS, TENS_HIDDEN,
+                     state, true, 0, next);
+        std::swap(state, next);
+    }
+}
+
 // Precomputed hash: process the input using the matrices in the context.
 //   1. Convert the 32-byte input into 256 bits.
 //   2. Apply expansion layer (256→1024).
-//   3. Apply NUM_HIDDEN_LAYERS hidden layers (each 1024→1024) with residual connections.
+//   3. Apply the configured number of hidden layers (each 1024→1024) with residual connections.
 //   4. Apply compression layer (1024→256).
 //   5. Pack final 256 bits into 32 bytes.
+// All layers run through the bit-sliced kernel selected by TensHashAutoDetect().
 void tens_hash_precomputed(const uint8_t input[TENS_IN_SIZE], TensHashContext* ctx, uint8_t output[TENS_IN_SIZE])
 {
     if (!input || !ctx || !output) return;
+    kernel_stats::Record(kernel_stats::Kernel::TENSHASH, TENS_IN_SIZE);
 
     // Swap input: reverse the order (LSB-first -> MSB-first).
     uint8_t input_swapped[TENS_IN_SIZE];
@@ -207,59 +619,89 @@ void tens_hash_precomputed(const uint8_t input[TENS_IN_SIZE], TensHashContext* c
         input_swapped[i] = input[TENS_IN_SIZE - 1 - i];
     }
 
-    printf("tens_hash_precomputed Input: ");
-    for (int i = 0; i < TENS_IN_SIZE; i++) {
-        printf("%02X", input_swapped[i]);
-    }
-    printf("\n");
+    // Convert swapped input bytes to 256 packed bits (MSB-first within each byte,
+    // matching the scalar state layout: bit index i = byte i/8, bit 7-(i%8)).
+    // Working state lives on the stack so that a context can be shared by
+    // concurrent callers.
+    uint64_t buf_a[HIDDEN_WORDS], buf_b[HIDDEN_WORDS];
+    uint64_t* state = buf_a;
+    uint64_t* next = buf_b;
+    run_trunk_layers(input_swapped, ctx, state, next);
 
-    // Convert swapped input bytes to 256 bits.
-    memset(ctx->state, 0, TENS_HIDDEN); // clear working state
-    for (int i = 0; i < TENS_IN_SIZE; i++) {
-        for (int j = 0; j < 8; j++) {
-            ctx->state[i * 8 + j] = (input_swapped[i] >> (7 - j)) & 1;
+    // --- Compression layer: from TENS_HIDDEN (1024) to INPUT_BITS (256) ---
+    LayerForward(ctx->compression_planes, ctx->compression_bias, HIDDEN_WORDS, INPUT_BITS,
+                 state, false, 0, next);
+
+    // Pack the 256 bits into 32 bytes (already byte-reversed to LSB-first).
+    memset(output, 0, TENS_IN_SIZE);
+    for (int i = 0; i < INPUT_BITS; i++) {
+        if ((next[i >> 6] >> (i & 63)) & 1) {
+            output[TENS_IN_SIZE - 1 - (i / 8)] |= (1 << (7 - (i % 8)));
         }
     }
 
-    // --- Expansion layer: from INPUT_BITS (256) to TENS_HIDDEN (1024) ---
-    layer_forward(ctx->expansion_mat, INPUT_BITS, TENS_HIDDEN, ctx->state, ctx->next_state);
-    int8_t* temp = ctx->state;
-    ctx->state = ctx->next_state;
-    ctx->next_state = temp;
-
-    // --- Hidden layers: NUM_HIDDEN_LAYERS rounds (each 1024→1024) with residual connections ---
-    for (int r = 0; r < NUM_HIDDEN_LAYERS; r++) {
-        int8_t* matrix = ctx->hidden_mats + r * TENS_HIDDEN * TENS_HIDDEN;
-        layer_forward(matrix, TENS_HIDDEN, TENS_HIDDEN, ctx->state, ctx->next_state);
-        temp = ctx->state;
-        ctx->state = ctx->next_state;
-        ctx->next_state = temp;
+    // Hot path: only format the trace when the category is enabled.
+    if (LogAcceptCategory(BCLog::POW, BCLog::Level::Debug)) {
+        uint8_t output_swapped[TENS_IN_SIZE];
+        for (int i = 0; i < TENS_IN_SIZE; i++) {
+            output_swapped[i] = output[TENS_IN_SIZE - 1 - i];
+        }
+        LogDebug(BCLog::POW, "tens_hash input=%s output=%s\n",
+                 HexStr(input_swapped), HexStr(output_swapped));
     }
+}
 
-    // --- Compression layer: from TENS_HIDDEN (1024) to INPUT_BITS (256) ---
-    layer_forward(ctx->compression_mat, TENS_HIDDEN, INPUT_BITS, ctx->state, ctx->next_state);
-
-    // Final 256-element vector is in ctx->next_state.
-    int8_t final_state[INPUT_BITS];
-    memcpy(final_state, ctx->next_state, INPUT_BITS * sizeof(int8_t));
-
-    // Pack the 256 bits into 32 bytes.
-    pack_bits(final_state, output);
+// Target-aware hash check. The compression rows are evaluated in
+// most-significant-byte-first order (row i produces output bit i, and bits
+// 0..7 form the top byte of the final hash), so the comparison against the
+// big-endian target can abort the remaining compression rows as soon as a
+// byte differs. `output` is only produced on success.
+int tens_hash_precomputed_target(const uint8_t input[TENS_IN_SIZE], TensHashContext* ctx,
+                                 const uint8_t target_be[TENS_IN_SIZE], uint8_t output[TENS_IN_SIZE])
+{
+    if (!input || !ctx || !target_be) return 0;
+    kernel_stats::Record(kernel_stats::Kernel::TENSHASH, TENS_IN_SIZE);
 
-    uint8_t output_swapped[TENS_IN_SIZE];
+    uint8_t input_swapped[TENS_IN_SIZE];
     for (int i = 0; i < TENS_IN_SIZE; i++) {
-        output_swapped[i] = output[TENS_IN_SIZE - 1 - i];
+        input_swapped[i] = input[TENS_IN_SIZE - 1 - i];
     }
-    memcpy(output, output_swapped, TENS_IN_SIZE);
 
-    printf("tens_hash_precomputed Output: ");
-    for (int i = 0; i < TENS_IN_SIZE; i++) {
-        printf("%02X", output[TENS_IN_SIZE - 1 - i]);
+    uint64_t buf_a[HIDDEN_WORDS], buf_b[HIDDEN_WORDS];
+    uint64_t* state = buf_a;
+    uint64_t* next = buf_b;
+    run_trunk_layers(input_swapped, ctx, state, next);
+
+    // Evaluate the compression layer one output byte (8 rows) at a time.
+    uint8_t hash_be[TENS_IN_SIZE];
+    bool decided = false; // hash already known to be strictly below the target
+    for (int k = 0; k < TENS_IN_SIZE; k++) {
+        uint64_t chunk = 0;
+        LayerForward(ctx->compression_planes + (size_t)(8 * k) * 2 * HIDDEN_WORDS,
+                     ctx->compression_bias + 8 * k, HIDDEN_WORDS, 8, state, false, 0, &chunk);
+        uint8_t byte = 0;
+        for (int j = 0; j < 8; j++) {
+            byte |= ((chunk >> j) & 1) << (7 - j);
+        }
+        hash_be[k] = byte;
+        if (!decided) {
+            if (byte > target_be[k]) return 0; // exceeds target: skip the rest
+            if (byte < target_be[k]) {
+                if (!output) return 1;
+                decided = true; // keep going only to produce the full hash
+            }
+        }
     }
-    printf("\n");
+
+    if (output) {
+        for (int k = 0; k < TENS_IN_SIZE; k++) {
+            output[TENS_IN_SIZE - 1 - k] = hash_be[k];
+        }
+    }
+    return 1;
 }
 
-void tens_hash(const uint8_t input[TENS_IN_SIZE], const uint8_t seed[32], uint8_t output[TENS_IN_SIZE])
+void tens_hash(const uint8_t input[TENS_IN_SIZE], const uint8_t seed[TENS_IN_SIZE], uint8_t output[TENS_IN_SIZE])
 {
     if (!input || !seed || !output) return;
 
@@ -268,3 +710,310 @@ void tens_hash(const uint8_t input[TENS_IN_SIZE], const uint8_t seed[32], uint8_
     tens_hash_precomputed(input, ctx, output);
     tens_hash_free(ctx);
 }
+
+// Whether verification paths should prefer tens_hash_streaming() over a
+// materialized context (see tens_hash_set_low_memory()).
+static std::atomic<int> g_low_memory{0};
+
+void tens_hash_set_low_memory(int enable)
+{
+    g_low_memory.store(enable ? 1 : 0, std::memory_order_relaxed);
+}
+
+int tens_hash_low_memory(void)
+{
+    return g_low_memory.load(std::memory_order_relaxed);
+}
+
+// Low-memory evaluation: regenerate each matrix from its (seed, nonce)
+// keystream immediately before running its layer, instead of materializing
+// a full context. The working set is one packed hidden matrix (~256KB of
+// planes plus the transient keystream), at the cost of paying the full
+// ChaCha20 derivation on every hash — the trade small watch-only nodes want.
+void tens_hash_streaming(const uint8_t input[TENS_IN_SIZE], const uint8_t seed[TENS_IN_SIZE], uint8_t output[TENS_IN_SIZE])
+{
+    if (!input || !seed || !output) return;
+    kernel_stats::Record(kernel_stats::Kernel::TENSHASH, TENS_IN_SIZE);
+
+    // Swap the seed bytes from LSB-first to MSB-first, as tens_hash_init() does.
+    uint8_t swapped_seed[32];
+    for (int i = 0; i < 32; i++) {
+        swapped_seed[i] = seed[31 - i];
+    }
+
+    uint8_t input_swapped[TENS_IN_SIZE];
+    for (int i = 0; i < TENS_IN_SIZE; i++) {
+        input_swapped[i] = input[TENS_IN_SIZE - 1 - i];
+    }
+
+    // Scratch for one packed matrix; the hidden layers (1024x1024) are the
+    // largest, and the expansion/compression matrices reuse the same buffer.
+    std::vector<uint64_t> planes((size_t)TENS_HIDDEN * 2 * HIDDEN_WORDS);
+    std::vector<int16_t> bias(TENS_HIDDEN);
+
+    uint64_t buf_a[HIDDEN_WORDS], buf_b[HIDDEN_WORDS];
+    uint64_t* state = buf_a;
+    uint64_t* next = buf_b;
+    memset(buf_a, 0, sizeof(buf_a));
+    for (int i = 0; i < INPUT_BITS; i++) {
+        if ((input_swapped[i / 8] >> (7 - (i % 8))) & 1) {
+            state[i >> 6] |= uint64_t{1} << (i & 63);
+        }
+    }
+
+    generate_packed_matrix(TENS_HIDDEN, INPUT_BITS, swapped_seed, 0, planes.data(), bias.data());
+    LayerForward(planes.data(), bias.data(), INPUT_WORDS, TENS_HIDDEN, state, false, 0, next);
+    std::swap(state, next);
+
+    for (int r = 0; r < g_num_hidden_layers; r++) {
+        generate_packed_matrix(TENS_HIDDEN, TENS_HIDDEN, swapped_seed, r + 1, planes.data(), bias.data());
+        LayerForward(planes.data(), bias.data(), HIDDEN_WORDS, TENS_HIDDEN, state, true, 0, next);
+        std::swap(state, next);
+    }
+
+    generate_packed_matrix(INPUT_BITS, TENS_HIDDEN, swapped_seed, NUM_MATRICES - 1, planes.data(), bias.data());
+    LayerForward(planes.data(), bias.data(), HIDDEN_WORDS, INPUT_BITS, state, false, 0, next);
+
+    memset(output, 0, TENS_IN_SIZE);
+    for (int i = 0; i < INPUT_BITS; i++) {
+        if ((next[i >> 6] >> (i & 63)) & 1) {
+            output[TENS_IN_SIZE - 1 - (i / 8)] |= (1 << (7 - (i % 8)));
+        }
+    }
+}
+
+// Batched hashing: all inputs advance through the layers together so each
+// matrix row is loaded once per batch. Produces byte-identical results to
+// calling tens_hash_precomputed() on each input.
+void tens_hash_batch(const uint8_t* inputs, size_t count, TensHashContext* ctx, uint8_t* outputs)
+{
+    if (!inputs || !ctx || !outputs || count == 0) return;
+    kernel_stats::Record(kernel_stats::Kernel::TENSHASH, count * TENS_IN_SIZE);
+
+    std::vector<uint64_t> state(count * HIDDEN_WORDS, 0);
+    std::vector<uint64_t> next(count * HIDDEN_WORDS, 0);
+
+    for (size_t n = 0; n < count; n++) {
+        const uint8_t* input = inputs + n * TENS_IN_SIZE;
+        uint64_t* slot = state.data() + n * HIDDEN_WORDS;
+        for (int i = 0; i < INPUT_BITS; i++) {
+            // Input bytes are LSB-first; bit index i = swapped byte i/8, bit 7-(i%8).
+            if ((input[TENS_IN_SIZE - 1 - (i / 8)] >> (7 - (i % 8))) & 1) {
+                slot[i >> 6] |= uint64_t{1} << (i & 63);
+            }
+        }
+    }
+
+    LayerForwardBatch(ctx->expansion_planes, ctx->expansion_bias, INPUT_WORDS, TENS_HIDDEN,
+                      state.data(), count, false, next.data());
+    state.swap(next);
+
+    for (int r = 0; r < g_num_hidden_layers; r++) {
+        LayerForwardBatch(ctx->hidden_planes + (size_t)r * TENS_HIDDEN * 2 * HIDDEN_WORDS,
+                          ctx->hidden_bias + r * TENS_HIDDEN, HIDDEN_WORDS, TENS_HIDDEN,
+                          state.data(), count, true, next.data());
+        state.swap(next);
+    }
+
+    LayerForwardBatch(ctx->compression_planes, ctx->compression_bias, HIDDEN_WORDS, INPUT_BITS,
+                      state.data(), count, false, next.data());
+
+    for (size_t n = 0; n < count; n++) {
+        const uint64_t* slot = next.data() + n * HIDDEN_WORDS;
+        uint8_t* output = outputs + n * TENS_IN_SIZE;
+        memset(output, 0, TENS_IN_SIZE);
+        for (int i = 0; i < INPUT_BITS; i++) {
+            if ((slot[i >> 6] >> (i & 63)) & 1) {
+                output[TENS_IN_SIZE - 1 - (i / 8)] |= (1 << (7 - (i % 8)));
+            }
+        }
+    }
+}
+
+namespace {
+/** Check a candidate kernel against the scalar reference on a deterministic
+ *  pseudo-random hidden-size layer. */
+bool SelfTest(LayerForwardType candidate, LayerForwardBatchType batch_candidate)
+{
+    std::vector<int8_t> matrix(TENS_HIDDEN * TENS_HIDDEN);
+    std::vector<int8_t> input(TENS_HIDDEN), want(TENS_HIDDEN);
+    uint64_t s = 0x2545F4914F6CDD1DULL;
+    auto next_byte = [&s]() {
+        s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+        return (uint8_t)s;
+    };
+    for (auto& v : matrix) {
+        uint8_t mod = next_byte() % 4;
+        v = (mod == 2) ? 1 : (mod == 3) ? -1 : 0;
+    }
+    for (auto& v : input) v = next_byte() & 1;
+
+    layer_forward(matrix.data(), TENS_HIDDEN, TENS_HIDDEN, input.data(), want.data());
+
+    std::vector<uint64_t> planes(TENS_HIDDEN * 2 * HIDDEN_WORDS);
+    std::vector<int16_t> bias(TENS_HIDDEN);
+    pack_matrix_planes(matrix.data(), TENS_HIDDEN, TENS_HIDDEN, planes.data(), bias.data());
+
+    uint64_t x[HIDDEN_WORDS] = {0};
+    for (int i = 0; i < TENS_HIDDEN; i++) {
+        if (input[i]) x[i >> 6] |= uint64_t{1} << (i & 63);
+    }
+    uint64_t got[HIDDEN_WORDS];
+    candidate(planes.data(), bias.data(), HIDDEN_WORDS, TENS_HIDDEN, x, true, 0, got);
+
+    for (int i = 0; i < TENS_HIDDEN; i++) {
+        int8_t bit = (got[i >> 6] >> (i & 63)) & 1;
+        if (bit != want[i]) return false;
+    }
+
+    // The batch kernel must agree with the single-input kernel.
+    uint64_t xs[3 * HIDDEN_WORDS];
+    for (int n = 0; n < 3; n++) {
+        for (int i = 0; i < HIDDEN_WORDS; i++) {
+            xs[n * HIDDEN_WORDS + i] = x[i] ^ (0x9E3779B97F4A7C15ULL * n);
+        }
+    }
+    uint64_t batch_got[3 * HIDDEN_WORDS];
+    batch_candidate(planes.data(), bias.data(), HIDDEN_WORDS, TENS_HIDDEN, xs, 3, true, batch_got);
+    for (int n = 0; n < 3; n++) {
+        candidate(planes.data(), bias.data(), HIDDEN_WORDS, TENS_HIDDEN, xs + n * HIDDEN_WORDS, true, 0, got);
+        if (memcmp(got, batch_got + n * HIDDEN_WORDS, sizeof(got)) != 0) return false;
+    }
+    return true;
+}
+
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+/** Check whether the OS has enabled AVX registers. */
+bool AVXEnabled()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 6) == 6;
+}
+
+bool AVX2Supported()
+{
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    if (!(((ecx >> 27) & 1) && ((ecx >> 28) & 1) && AVXEnabled())) return false;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    return (ebx >> 5) & 1;
+}
+#endif
+
+#if defined(ENABLE_AVX512) && defined(HAVE_GETCPUID)
+/** Check whether the OS has enabled the AVX-512 register state (XMM/YMM
+ *  plus opmask and ZMM). */
+bool AVX512Enabled()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 0xE6) == 0xE6;
+}
+
+bool AVX512Supported()
+{
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    if (!(((ecx >> 27) & 1) && AVX512Enabled())) return false;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    // AVX512F plus VPOPCNTDQ.
+    return ((ebx >> 16) & 1) && ((ecx >> 14) & 1);
+}
+#endif
+} // namespace
+
+std::string TensHashAutoDetect()
+{
+    std::string ret = "portable";
+    LayerForward = tens_hash_port::LayerForward;
+    LayerForwardBatch = tens_hash_port::LayerForwardBatch;
+
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+    if (AVX2Supported()) {
+        LayerForward = tens_hash_avx2::LayerForward;
+        LayerForwardBatch = tens_hash_avx2::LayerForwardBatch;
+        ret = "avx2";
+    }
+#endif
+
+#if defined(ENABLE_AVX512) && defined(HAVE_GETCPUID)
+    if (AVX512Supported()) {
+        LayerForward = tens_hash_avx512::LayerForward;
+        LayerForwardBatch = tens_hash_avx512::LayerForwardBatch;
+        ret = "avx512-vpopcnt";
+    }
+#endif
+
+#if defined(__aarch64__)
+    LayerForward = tens_hash_neon::LayerForward;
+    ret = "neon";
+#endif
+
+    assert(SelfTest(LayerForward, LayerForwardBatch));
+    return ret;
+}
+
+namespace {
+//! Externally registered layer kernels (see TensHashRegisterBackend()).
+struct RegisteredBackend {
+    std::string name;
+    LayerForwardType single;
+    LayerForwardBatchType batch;
+};
+std::vector<RegisteredBackend> g_registered_backends;
+} // namespace
+
+bool TensHashRegisterBackend(const std::string& name, TensLayerForwardFn single, TensLayerForwardBatchFn batch)
+{
+    if (name.empty() || single == nullptr) return false;
+    // Reject the built-in names and duplicates.
+    if (name == "portable" || name == "avx2" || name == "avx512-vpopcnt" || name == "neon") return false;
+    for (const auto& backend : g_registered_backends) {
+        if (backend.name == name) return false;
+    }
+    if (!SelfTest(single, batch ? batch : tens_hash_port::LayerForwardBatch)) return false;
+    g_registered_backends.push_back({name, single, batch ? batch : tens_hash_port::LayerForwardBatch});
+    return true;
+}
+
+bool TensHashSelect(const std::string& name)
+{
+    LayerForwardType single{nullptr};
+    LayerForwardBatchType batch{nullptr};
+    if (name == "portable") {
+        single = tens_hash_port::LayerForward;
+        batch = tens_hash_port::LayerForwardBatch;
+    }
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+    else if (name == "avx2" && AVX2Supported()) {
+        single = tens_hash_avx2::LayerForward;
+        batch = tens_hash_avx2::LayerForwardBatch;
+    }
+#endif
+#if defined(ENABLE_AVX512) && defined(HAVE_GETCPUID)
+    else if (name == "avx512-vpopcnt" && AVX512Supported()) {
+        single = tens_hash_avx512::LayerForward;
+        batch = tens_hash_avx512::LayerForwardBatch;
+    }
+#endif
+#if defined(__aarch64__)
+    else if (name == "neon") {
+        single = tens_hash_neon::LayerForward;
+        batch = tens_hash_port::LayerForwardBatch;
+    }
+#endif
+    else {
+        for (const auto& backend : g_registered_backends) {
+            if (backend.name == name) {
+                single = backend.single;
+                batch = backend.batch;
+                break;
+            }
+        }
+    }
+    if (!single || !SelfTest(single, batch)) return false;
+    LayerForward = single;
+    LayerForwardBatch = batch;
+    return true;
+}
@@ -1,6 +1,7 @@
 #ifndef BITCOIN_CRYPTO_TENS_POW_TENS_HASH_H
 #define BITCOIN_CRYPTO_TENS_POW_TENS_HASH_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -9,23 +10,128 @@ extern "C" {
 
 #define TENS_IN_SIZE 32     // Input/output size
 
-// Combined structure for hash computation context
+// Combined structure for hash computation context. Immutable once
+// tens_hash_init() returns, so a single context may be shared by any number
+// of threads hashing under the same seed.
 typedef struct {
-    int8_t* expansion_mat;    // [TENS_HIDDEN x INPUT_BITS]
-    int8_t* hidden_mats;      // NUM_HIDDEN_LAYERS matrices, each [TENS_HIDDEN x TENS_HIDDEN]
-    int8_t* compression_mat;  // [INPUT_BITS x TENS_HIDDEN]
-    int8_t* state;            // working state (size: TENS_HIDDEN)
-    int8_t* next_state;       // working state (size: TENS_HIDDEN)
+    // Canonical storage of the ternary matrices: every row is stored as two
+    // bitplanes ("+1" plane followed by "-1" plane), each in_dim bits wide
+    // and packed into 64-bit words — 2 bits per weight instead of a full
+    // int8_t, ~17MB per context instead of ~67MB. The per-row bias folds the
+    // constant popcount terms of the planes so the kernel only needs two
+    // AND+popcount passes per row.
+    uint64_t* expansion_planes;   // [TENS_HIDDEN rows x 2 x (INPUT_BITS/64) words]
+    uint64_t* hidden_planes;      // NUM_HIDDEN_LAYERS x [TENS_HIDDEN rows x 2 x (TENS_HIDDEN/64) words]
+    uint64_t* compression_planes; // [INPUT_BITS rows x 2 x (TENS_HIDDEN/64) words]
+    int16_t* expansion_bias;      // [TENS_HIDDEN]
+    int16_t* hidden_bias;         // [NUM_HIDDEN_LAYERS x TENS_HIDDEN]
+    int16_t* compression_bias;    // [INPUT_BITS]
 } TensHashContext;
 
+// Size in bytes of the single contiguous arena backing a context's matrices
+// (planes first, then biases; expansion_planes is the arena base).
+size_t tens_hash_arena_size(void);
+
+// Point the context's plane and bias pointers into `arena`, which must be
+// tens_hash_arena_size() bytes, 8-byte aligned and laid out exactly like the
+// arena of a generated context. Used by callers that supply their own
+// backing storage, e.g. a memory-mapped matrix file; such contexts must not
+// be passed to tens_hash_free().
+void tens_hash_context_carve(TensHashContext* ctx, void* arena);
+
+// Configure the number of hidden layers evaluated per hash (default and
+// maximum 64). Driven by Consensus::Params::tenshash_hidden_layers: mainnet
+// and the public test networks keep the full 64, regtest runs a reduced
+// network so functional-test block generation is not dominated by PoW. Must
+// be called at startup, before any context or pooled arena exists; values
+// outside [1, 64] are ignored.
+void tens_hash_set_hidden_layers(int n);
+int tens_hash_hidden_layers(void);
+
 // Core functions
 TensHashContext* tens_hash_init(const uint8_t seed[32]);
+
+// Deep-copy a context into freshly allocated storage, bypassing the arena
+// pool. The copy is written by the calling thread, so on first-touch NUMA
+// systems the matrices land on the caller's node; mining loops use this to
+// keep one replica per node. Release with tens_hash_free().
+TensHashContext* tens_hash_clone(const TensHashContext* ctx);
 void tens_hash_free(TensHashContext* ctx);
 void tens_hash_precomputed(const uint8_t input[TENS_IN_SIZE], TensHashContext* ctx, uint8_t output[TENS_IN_SIZE]);
 void tens_hash(const uint8_t input[TENS_IN_SIZE], const uint8_t seed[TENS_IN_SIZE], uint8_t output[TENS_IN_SIZE]);
 
+// Low-memory variant of tens_hash(): regenerates each matrix from the seed
+// keystream immediately before its layer runs, so the working set is one
+// packed matrix (~256KB) instead of a full ~17MB context. Every hash pays
+// the complete ChaCha20 derivation; intended for memory-constrained
+// verification, never for mining.
+void tens_hash_streaming(const uint8_t input[TENS_IN_SIZE], const uint8_t seed[TENS_IN_SIZE], uint8_t output[TENS_IN_SIZE]);
+
+// Process-wide switch (default off) telling verification paths to prefer
+// tens_hash_streaming() over materialized contexts; wired to a startup
+// option for small nodes.
+void tens_hash_set_low_memory(int enable);
+int tens_hash_low_memory(void);
+
+// Target-aware variant of tens_hash_precomputed(): computes the compression
+// layer most-significant output byte first and aborts as soon as the
+// candidate provably exceeds `target_be` (big-endian, most significant byte
+// first). Returns 1 if hash <= target, else 0. `output` (optional, may be
+// NULL) is only filled in when the function returns 1.
+int tens_hash_precomputed_target(const uint8_t input[TENS_IN_SIZE], TensHashContext* ctx,
+                                 const uint8_t target_be[TENS_IN_SIZE], uint8_t output[TENS_IN_SIZE]);
+
+// Hash `count` inputs (each TENS_IN_SIZE bytes, contiguous) under one
+// context. All inputs advance through each layer together so every matrix
+// row is streamed from memory once per batch instead of once per input;
+// mining loops should prefer this over per-nonce tens_hash_precomputed().
+void tens_hash_batch(const uint8_t* inputs, size_t count, TensHashContext* ctx, uint8_t* outputs);
+
+// Split every layer of a single hash across `n` persistent worker threads
+// (each computes a contiguous range of the 1024 output rows, synchronizing
+// at layer boundaries). n is rounded down to a power of two, capped at 16;
+// n <= 0 selects a conservative automatic value. Default is 1 (serial).
+// Intended for latency-sensitive single-header verification, not mining
+// loops, which should use tens_hash_batch() instead.
+void tens_hash_set_verify_threads(int n);
+
 #ifdef __cplusplus
 }
+
+#include <string>
+
+/** Autodetect the best available TensHash layer kernel. Returns the name of
+ *  the implementation selected, mirroring SHA256AutoDetect(). */
+std::string TensHashAutoDetect();
+
+/** Force a specific layer kernel ("portable", "avx2", "avx512-vpopcnt",
+ *  "neon", or a name registered via TensHashRegisterBackend()) if it is
+ *  compiled in, supported on this machine and passes the self-test; returns
+ *  false and leaves the selection unchanged otherwise. Intended for
+ *  benchmarking kernel tiers against each other. */
+bool TensHashSelect(const std::string& name);
+
+/** Signature of a pluggable layer kernel; see the LayerForwardType
+ *  documentation in tens_hash.cpp for the plane layout. */
+typedef void (*TensLayerForwardFn)(const uint64_t* planes, const int16_t* bias,
+                                   int in_words, int out_dim,
+                                   const uint64_t* x, bool residual, int row_offset,
+                                   uint64_t* out);
+/** Batched variant of TensLayerForwardFn. */
+typedef void (*TensLayerForwardBatchFn)(const uint64_t* planes, const int16_t* bias,
+                                        int in_words, int out_dim,
+                                        const uint64_t* xs, size_t count,
+                                        bool residual, uint64_t* outs);
+
+/** Register an externally implemented layer kernel (e.g. one backed by an
+ *  inference runtime or NPU) under `name`, making it selectable through
+ *  TensHashSelect(). Registration runs the same self-test as the built-in
+ *  kernels, comparing against the portable C path, and rejects any kernel
+ *  that is not bit-identical - the consensus result cannot differ by
+ *  backend. The batch kernel may be null, in which case batching falls back
+ *  to the portable implementation. Returns false on a duplicate or reserved
+ *  name, a null single-input kernel, or a self-test failure. */
+bool TensHashRegisterBackend(const std::string& name, TensLayerForwardFn single, TensLayerForwardBatchFn batch);
 #endif
 
 #endif // BITCOIN_CRYPTO_TENS_POW_TENS_HASH_H
@@ -0,0 +1,101 @@
+// AVX2 bit-sliced layer kernel for TensHash.
+//
+// Each ternary matrix row is stored as two bitplanes ("+1" then "-1"), so a
+// 1024-wide dot product reduces to two 1024-bit AND + popcount passes. The
+// popcount uses the PSHUFB nibble-lookup technique with PSADBW to widen the
+// per-byte counts to 64-bit lanes.
+
+#ifdef ENABLE_AVX2
+
+#include <immintrin.h>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+inline __m256i Popcount64(__m256i v)
+{
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                  _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+inline int64_t HorizontalSum64(__m256i v)
+{
+    __m128i lo = _mm256_castsi256_si128(v);
+    __m128i hi = _mm256_extracti128_si256(v, 1);
+    __m128i s = _mm_add_epi64(lo, hi);
+    return _mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1);
+}
+} // namespace
+
+namespace tens_hash_avx2 {
+void LayerForward(const uint64_t* planes, const int16_t* bias,
+                  int in_words, int out_dim,
+                  const uint64_t* x, bool residual, int row_offset,
+                  uint64_t* out)
+{
+    std::memset(out, 0, (out_dim / 64) * sizeof(uint64_t));
+    for (int j = 0; j < out_dim; j++) {
+        const uint64_t* plus = planes + (size_t)j * 2 * in_words;
+        const uint64_t* minus = plus + in_words;
+        // Rows are streamed exactly once per hash; prefetch the next one.
+        _mm_prefetch(reinterpret_cast<const char*>(plus + 2 * in_words), _MM_HINT_T0);
+        __m256i accp = _mm256_setzero_si256();
+        __m256i accm = _mm256_setzero_si256();
+        for (int i = 0; i < in_words; i += 4) {
+            __m256i xv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+            __m256i pv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(plus + i));
+            __m256i mv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(minus + i));
+            accp = _mm256_add_epi64(accp, Popcount64(_mm256_and_si256(pv, xv)));
+            accm = _mm256_add_epi64(accm, Popcount64(_mm256_and_si256(mv, xv)));
+        }
+        int32_t acc = (int32_t)(HorizontalSum64(accp) - HorizontalSum64(accm));
+        int32_t sum = 2 * acc + bias[j];
+        if (residual) {
+            int r = row_offset + j;
+            sum += ((x[r >> 6] >> (r & 63)) & 1) ? 1 : -1;
+        }
+        if (sum > 0) out[j >> 6] |= uint64_t{1} << (j & 63);
+    }
+}
+
+void LayerForwardBatch(const uint64_t* planes, const int16_t* bias,
+                       int in_words, int out_dim,
+                       const uint64_t* xs, size_t count,
+                       bool residual, uint64_t* outs)
+{
+    constexpr int stride = 1024 / 64; // TENS_HIDDEN bits per input slot
+    std::memset(outs, 0, count * stride * sizeof(uint64_t));
+    for (int j = 0; j < out_dim; j++) {
+        const uint64_t* plus = planes + (size_t)j * 2 * in_words;
+        const uint64_t* minus = plus + in_words;
+        // The row planes stay in registers/L1 across the whole batch.
+        for (size_t n = 0; n < count; n++) {
+            const uint64_t* x = xs + n * stride;
+            __m256i accp = _mm256_setzero_si256();
+            __m256i accm = _mm256_setzero_si256();
+            for (int i = 0; i < in_words; i += 4) {
+                __m256i xv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+                __m256i pv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(plus + i));
+                __m256i mv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(minus + i));
+                accp = _mm256_add_epi64(accp, Popcount64(_mm256_and_si256(pv, xv)));
+                accm = _mm256_add_epi64(accm, Popcount64(_mm256_and_si256(mv, xv)));
+            }
+            int32_t acc = (int32_t)(HorizontalSum64(accp) - HorizontalSum64(accm));
+            int32_t sum = 2 * acc + bias[j];
+            if (residual) {
+                sum += ((x[j >> 6] >> (j & 63)) & 1) ? 1 : -1;
+            }
+            if (sum > 0) outs[n * stride + (j >> 6)] |= uint64_t{1} << (j & 63);
+        }
+    }
+}
+} // namespace tens_hash_avx2
+
+#endif // ENABLE_AVX2
@@ -0,0 +1,11 @@
+// Copyright (c) 2025-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Compiled into the standalone libtenshash shared library only.
+
+#include <util/translation.h>
+
+// Define G_TRANSLATION_FUN symbol in libtenshash library so users of the
+// library aren't required to export this symbol
+extern const TranslateFn G_TRANSLATION_FUN{nullptr};
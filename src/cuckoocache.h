@@ -9,11 +9,13 @@
 
 #include <algorithm> // std::find
 #include <array>
+#include <cassert>
 #include <atomic>
 #include <cmath>
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -482,6 +484,39 @@ public:
             }
         return false;
     }
+
+    /** prefetch issues software prefetches for every hash location of e,
+     * letting a caller that knows a lookup is imminent (for example while it
+     * still has to acquire a lock) overlap the DRAM accesses with other work.
+     *
+     * @param e the element whose candidate buckets to prefetch
+     */
+    inline void prefetch(const Element& e) const
+    {
+        for (const uint32_t loc : compute_hashes(e))
+            __builtin_prefetch(&table[loc]);
+    }
+
+    /** contains_batch checks a batch of elements, issuing prefetches for all
+     * candidate buckets of the whole batch before probing any of them, so
+     * the up-to-8 serial cache misses each lookup would eat in contains()
+     * overlap across the batch.
+     *
+     * The per-element semantics (including the garbage collect flag when
+     * erase is set) match contains().
+     *
+     * @param elems the elements to check
+     * @param out one result flag per element; must be the same length as elems
+     * @param erase whether to attempt setting the garbage collect flag on hits
+     */
+    inline void contains_batch(std::span<const Element> elems, std::span<bool> out, const bool erase) const
+    {
+        assert(elems.size() == out.size());
+        for (const Element& e : elems)
+            prefetch(e);
+        for (size_t i = 0; i < elems.size(); ++i)
+            out[i] = contains(elems[i], erase);
+    }
 };
 } // namespace CuckooCache
 
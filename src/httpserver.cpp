@@ -13,6 +13,7 @@
 #include <node/interface_ui.h>
 #include <rpc/protocol.h> // For HTTP status codes
 #include <sync.h>
+#include <util/allocprofile.h>
 #include <util/check.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
@@ -651,10 +652,35 @@ void HTTPRequest::WriteReply(int nStatus, std::span<const std::byte> reply)
     if (m_interrupt) {
         WriteHeader("Connection", "close");
     }
-    // Send event to main http thread to send reply message
     struct evbuffer* evb = evhttp_request_get_output_buffer(req);
     assert(evb);
+    alloc_profile::Record(alloc_profile::Tag::HTTP, reply.size());
     evbuffer_add(evb, reply.data(), reply.size());
+    SendReply(nStatus);
+}
+
+void HTTPRequest::WriteReply(int nStatus, std::string&& reply)
+{
+    assert(!replySent && req);
+    if (m_interrupt) {
+        WriteHeader("Connection", "close");
+    }
+    struct evbuffer* evb = evhttp_request_get_output_buffer(req);
+    assert(evb);
+    alloc_profile::Record(alloc_profile::Tag::HTTP, reply.size());
+    // Reference the reply body from the output buffer instead of copying it.
+    // Ownership is transferred to libevent, which frees it via the cleanup
+    // callback once the data has been written to the socket.
+    auto* body = new std::string(std::move(reply));
+    evbuffer_add_reference(
+        evb, body->data(), body->size(),
+        [](const void*, size_t, void* extra) { delete static_cast<std::string*>(extra); }, body);
+    SendReply(nStatus);
+}
+
+void HTTPRequest::SendReply(int nStatus)
+{
+    // Send event to main http thread to send reply message
     auto req_copy = req;
     HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]{
         evhttp_send_reply(req_copy, nStatus, nullptr, nullptr);
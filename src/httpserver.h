@@ -74,6 +74,9 @@ private:
     const util::SignalInterrupt& m_interrupt;
     bool replySent;
 
+    /** Hand the populated output buffer to the main http thread for sending. */
+    void SendReply(int nStatus);
+
 public:
     explicit HTTPRequest(struct evhttp_request* req, const util::SignalInterrupt& interrupt, bool replySent = false);
     ~HTTPRequest();
@@ -142,7 +145,18 @@ public:
     {
         WriteReply(nStatus, std::as_bytes(std::span{reply}));
     }
+    void WriteReply(int nStatus, const char* reply)
+    {
+        WriteReply(nStatus, std::string_view{reply});
+    }
     void WriteReply(int nStatus, std::span<const std::byte> reply);
+    /** Write HTTP reply, taking ownership of the reply body.
+     *
+     * The body is handed to libevent by reference instead of being copied
+     * into the output buffer, avoiding a second copy of large replies
+     * (e.g. getblock verbosity=2 on a full block).
+     */
+    void WriteReply(int nStatus, std::string&& reply);
 };
 
 /** Get the query parameter value from request uri for a specified key, or std::nullopt if the key
@@ -13,6 +13,7 @@
 #include <node/context.h>
 #include <node/database_args.h>
 #include <node/interface_ui.h>
+#include <streams.h>
 #include <tinyformat.h>
 #include <util/string.h>
 #include <util/thread.h>
@@ -20,6 +21,7 @@
 #include <validation.h> // For g_chainman
 
 #include <string>
+#include <thread>
 #include <utility>
 
 constexpr uint8_t DB_BEST_BLOCK{'B'};
@@ -147,9 +149,38 @@ void BaseIndex::Sync()
     if (!m_synced) {
         std::chrono::steady_clock::time_point last_log_time{0s};
         std::chrono::steady_clock::time_point last_locator_write_time{0s};
+
+        // Read blocks without the proof-of-work recheck done by ReadBlock():
+        // the block's identity is pinned by the block index, so a header hash
+        // comparison gives the same corruption protection at a fraction of
+        // the cost during a long backfill.
+        const auto read_block_raw{[&](const CBlockIndex* block_index, CBlock& block) {
+            const FlatFilePos pos{WITH_LOCK(::cs_main, return block_index->GetBlockPos())};
+            std::vector<uint8_t> data;
+            if (!m_chainstate->m_blockman.ReadRawBlock(data, pos)) return false;
+            try {
+                SpanReader{data} >> TX_WITH_WITNESS(block);
+            } catch (const std::exception&) {
+                return false;
+            }
+            return block.GetHash() == block_index->GetBlockHash();
+        }};
+
+        // One block of read-ahead: the disk read and deserialization of the
+        // next expected block proceed on a helper thread while the current
+        // block is appended to the index.
+        const CBlockIndex* prefetch_index{nullptr};
+        CBlock prefetch_block;
+        bool prefetch_ok{false};
+        std::thread prefetch_thread;
+        const auto join_prefetch{[&] {
+            if (prefetch_thread.joinable()) prefetch_thread.join();
+        }};
+
         while (true) {
             if (m_interrupt) {
                 LogPrintf("%s: m_interrupt set; exiting ThreadSync\n", GetName());
+                join_prefetch();
 
                 SetBestBlockIndex(pindex);
                 // No need to handle errors in Commit. If it fails, the error will be already be
@@ -180,6 +211,7 @@ void BaseIndex::Sync()
                 }
             }
             if (pindex_next->pprev != pindex && !Rewind(pindex, pindex_next->pprev)) {
+                join_prefetch();
                 FatalErrorf("%s: Failed to rewind index %s to a previous chain tip", __func__, GetName());
                 return;
             }
@@ -188,14 +220,24 @@ void BaseIndex::Sync()
 
             CBlock block;
             interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex);
-            if (!m_chainstate->m_blockman.ReadBlock(block, *pindex)) {
+            join_prefetch();
+            if (prefetch_index == pindex && prefetch_ok) {
+                block = std::move(prefetch_block);
+            } else if (!read_block_raw(pindex, block)) {
                 FatalErrorf("%s: Failed to read block %s from disk",
                            __func__, pindex->GetBlockHash().ToString());
                 return;
-            } else {
-                block_info.data = &block;
+            }
+            block_info.data = &block;
+            prefetch_index = WITH_LOCK(::cs_main, return m_chainstate->m_chain.Next(pindex));
+            if (prefetch_index) {
+                prefetch_thread = std::thread([&, block_index = prefetch_index] {
+                    prefetch_block.SetNull();
+                    prefetch_ok = read_block_raw(block_index, prefetch_block);
+                });
             }
             if (!CustomAppend(block_info)) {
+                join_prefetch();
                 FatalErrorf("%s: Failed to write block %s to index database",
                            __func__, pindex->GetBlockHash().ToString());
                 return;
@@ -215,6 +257,7 @@ void BaseIndex::Sync()
                 Commit();
             }
         }
+        join_prefetch();
     }
 
     if (pindex) {
@@ -77,6 +77,14 @@ private:
     /// The last block in the chain that the index is in sync with.
     std::atomic<const CBlockIndex*> m_best_block_index{nullptr};
 
+protected:
+    /// Whether the index is in sync with the main chain. Derived classes may
+    /// defer work during the initial sync (e.g. buffer database writes until
+    /// CustomCommit) that has to be done immediately once synced.
+    bool IsSynced() const { return m_synced.load(); }
+
+private:
+
     std::thread m_thread_sync;
     CThreadInterrupt m_interrupt;
 
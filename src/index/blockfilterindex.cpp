@@ -43,6 +43,10 @@ constexpr unsigned int FLTR_FILE_CHUNK_SIZE = 0x100000; // 1 MiB
  *  is big enough for a 2,000,000 length block chain, which
  *  we should be enough until ~2047. */
 constexpr size_t CF_HEADERS_CACHE_MAX_SZ{2000};
+/** Maximum number of filters kept in the in-memory serving cache. One full
+ *  BIP 157 getcfilters range; with typical filter sizes this bounds the cache
+ *  to a few tens of MB per filter type. */
+constexpr size_t CF_FILTER_CACHE_MAX_SZ{1000};
 
 namespace {
 
@@ -416,6 +420,18 @@ static bool LookupRange(CDBWrapper& db, const std::string& index_name, int start
     return true;
 }
 
+void BlockFilterIndex::CacheFilter(const uint256& filter_hash, const BlockFilter& filter) const
+{
+    AssertLockHeld(m_cs_filter_cache);
+    while (m_filter_cache.size() >= CF_FILTER_CACHE_MAX_SZ) {
+        m_filter_cache.erase(m_filter_cache_order.front());
+        m_filter_cache_order.pop_front();
+    }
+    if (m_filter_cache.emplace(filter_hash, filter).second) {
+        m_filter_cache_order.push_back(filter_hash);
+    }
+}
+
 bool BlockFilterIndex::LookupFilter(const CBlockIndex* block_index, BlockFilter& filter_out) const
 {
     DBVal entry;
@@ -423,7 +439,16 @@ bool BlockFilterIndex::LookupFilter(const CBlockIndex* block_index, BlockFilter&
         return false;
     }
 
-    return ReadFilterFromDisk(entry.pos, entry.hash, filter_out);
+    LOCK(m_cs_filter_cache);
+    if (auto it{m_filter_cache.find(entry.hash)}; it != m_filter_cache.end()) {
+        filter_out = it->second;
+        return true;
+    }
+    if (!ReadFilterFromDisk(entry.pos, entry.hash, filter_out)) {
+        return false;
+    }
+    CacheFilter(entry.hash, filter_out);
+    return true;
 }
 
 bool BlockFilterIndex::LookupFilterHeader(const CBlockIndex* block_index, uint256& header_out)
@@ -465,10 +490,18 @@ bool BlockFilterIndex::LookupFilterRange(int start_height, const CBlockIndex* st
     }
 
     filters_out.resize(entries.size());
+    // Holding the cache lock across the disk reads is fine: all BIP 157
+    // serving happens on the single message handler thread.
+    LOCK(m_cs_filter_cache);
     auto filter_pos_it = filters_out.begin();
     for (const auto& entry : entries) {
-        if (!ReadFilterFromDisk(entry.pos, entry.hash, *filter_pos_it)) {
-            return false;
+        if (auto it{m_filter_cache.find(entry.hash)}; it != m_filter_cache.end()) {
+            *filter_pos_it = it->second;
+        } else {
+            if (!ReadFilterFromDisk(entry.pos, entry.hash, *filter_pos_it)) {
+                return false;
+            }
+            CacheFilter(entry.hash, *filter_pos_it);
         }
         ++filter_pos_it;
     }
@@ -12,6 +12,7 @@
 #include <index/base.h>
 #include <util/hasher.h>
 
+#include <deque>
 #include <unordered_map>
 
 static const char* const DEFAULT_BLOCKFILTERINDEX = "0";
@@ -42,6 +43,18 @@ private:
     /** cache of block hash to filter header, to avoid disk access when responding to getcfcheckpt. */
     std::unordered_map<uint256, uint256, FilterHeaderHasher> m_headers_cache GUARDED_BY(m_cs_headers_cache);
 
+    /** Cache of recently served filters, keyed by filter hash, so that
+     *  light-client-heavy peers repeatedly asking for the same recent ranges
+     *  are answered from memory instead of re-reading the flat files. A
+     *  filter is immutable once written, so entries never go stale; they are
+     *  only evicted FIFO to bound memory. */
+    mutable Mutex m_cs_filter_cache;
+    mutable std::unordered_map<uint256, BlockFilter, FilterHeaderHasher> m_filter_cache GUARDED_BY(m_cs_filter_cache);
+    /** Insertion order of m_filter_cache entries, for eviction. */
+    mutable std::deque<uint256> m_filter_cache_order GUARDED_BY(m_cs_filter_cache);
+
+    void CacheFilter(const uint256& filter_hash, const BlockFilter& filter) const EXCLUSIVE_LOCKS_REQUIRED(m_cs_filter_cache);
+
     // Last computed header to avoid disk reads on every new block.
     uint256 m_last_header{};
 
@@ -70,14 +83,14 @@ public:
     BlockFilterType GetFilterType() const { return m_filter_type; }
 
     /** Get a single filter by block. */
-    bool LookupFilter(const CBlockIndex* block_index, BlockFilter& filter_out) const;
+    bool LookupFilter(const CBlockIndex* block_index, BlockFilter& filter_out) const EXCLUSIVE_LOCKS_REQUIRED(!m_cs_filter_cache);
 
     /** Get a single filter header by block. */
     bool LookupFilterHeader(const CBlockIndex* block_index, uint256& header_out) EXCLUSIVE_LOCKS_REQUIRED(!m_cs_headers_cache);
 
     /** Get a range of filters between two heights on a chain. */
     bool LookupFilterRange(int start_height, const CBlockIndex* stop_index,
-                           std::vector<BlockFilter>& filters_out) const;
+                           std::vector<BlockFilter>& filters_out) const EXCLUSIVE_LOCKS_REQUIRED(!m_cs_filter_cache);
 
     /** Get a range of filter hashes between two heights on a chain. */
     bool LookupFilterHashRange(int start_height, const CBlockIndex* stop_index,
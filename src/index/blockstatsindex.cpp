@@ -0,0 +1,50 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chain.h>
+#include <common/args.h>
+#include <index/blockstatsindex.h>
+#include <interfaces/chain.h>
+#include <node/blockstorage.h>
+#include <undo.h>
+#include <util/check.h>
+#include <validation.h>
+
+std::unique_ptr<BlockStatsIndex> g_blockstats_index;
+
+BlockStatsIndex::BlockStatsIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory, bool f_wipe)
+    : BaseIndex(std::move(chain), "blockstatsindex")
+{
+    fs::path path{gArgs.GetDataDirNet() / "indexes" / "blockstats"};
+    fs::create_directories(path);
+
+    m_db = std::make_unique<BlockStatsIndex::DB>(path / "db", n_cache_size, f_memory, f_wipe);
+}
+
+bool BlockStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
+{
+    const CBlock& block_data{*Assert(block.data)};
+
+    // Use the undo data handed down with the block notification when present,
+    // otherwise read it from disk (the genesis block has none).
+    CBlockUndo block_undo;
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return m_chainstate->m_blockman.LookupBlockIndex(block.hash));
+    if (block.height > 0 && !block.undo_data) {
+        if (!m_chainstate->m_blockman.ReadBlockUndo(block_undo, *pindex)) {
+            return false;
+        }
+    }
+
+    const BlockStats stats{ComputeBlockStats(block_data, block.undo_data ? *block.undo_data : block_undo, *pindex)};
+    return m_db->Write(block.hash, stats);
+}
+
+std::optional<BlockStats> BlockStatsIndex::LookUpStats(const CBlockIndex& block_index) const
+{
+    BlockStats stats;
+    if (!m_db->Read(block_index.GetBlockHash(), stats)) {
+        return std::nullopt;
+    }
+    return stats;
+}
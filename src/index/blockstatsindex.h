@@ -0,0 +1,48 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INDEX_BLOCKSTATSINDEX_H
+#define BITCOIN_INDEX_BLOCKSTATSINDEX_H
+
+#include <index/base.h>
+#include <rpc/blockchain.h>
+
+#include <memory>
+#include <optional>
+
+class CBlockIndex;
+
+static constexpr bool DEFAULT_BLOCKSTATSINDEX{false};
+
+/**
+ * BlockStatsIndex stores the per-block statistics served by getblockstats,
+ * computed once when the block is connected, so any historical stats query is
+ * a single point lookup instead of a block read plus a full recompute.
+ * Entries are keyed by block hash and are pure functions of the block, so
+ * they stay valid across reorgs and after the block files are pruned.
+ */
+class BlockStatsIndex final : public BaseIndex
+{
+private:
+    std::unique_ptr<BaseIndex::DB> m_db;
+
+    bool AllowPrune() const override { return true; }
+
+protected:
+    bool CustomAppend(const interfaces::BlockInfo& block) override;
+
+    BaseIndex::DB& GetDB() const override { return *m_db; }
+
+public:
+    // Constructs the index, which becomes available to be queried.
+    explicit BlockStatsIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Look up the stored stats for a specific block.
+    std::optional<BlockStats> LookUpStats(const CBlockIndex& block_index) const;
+};
+
+/// The global block stats index. May be null.
+extern std::unique_ptr<BlockStatsIndex> g_blockstats_index;
+
+#endif // BITCOIN_INDEX_BLOCKSTATSINDEX_H
@@ -11,8 +11,14 @@
 #include <node/blockstorage.h>
 #include <validation.h>
 
+#include <algorithm>
+
 constexpr uint8_t DB_TXINDEX{'t'};
 
+/** Number of buffered transaction positions at which CustomAppend flushes to
+ *  the database during the initial sync. */
+constexpr size_t TXINDEX_WRITE_BATCH_SIZE{250'000};
+
 std::unique_ptr<TxIndex> g_txindex;
 
 
@@ -26,8 +32,8 @@ public:
     /// transaction hash is not indexed.
     bool ReadTxPos(const uint256& txid, CDiskTxPos& pos) const;
 
-    /// Write a batch of transaction positions to the DB.
-    [[nodiscard]] bool WriteTxs(const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos);
+    /// Write a batch of transaction positions to the DB, sorted by txid.
+    [[nodiscard]] bool WriteTxs(std::vector<std::pair<uint256, CDiskTxPos>>& v_pos);
 };
 
 TxIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
@@ -39,8 +45,14 @@ bool TxIndex::DB::ReadTxPos(const uint256 &txid, CDiskTxPos& pos) const
     return Read(std::make_pair(DB_TXINDEX, txid), pos);
 }
 
-bool TxIndex::DB::WriteTxs(const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos)
+bool TxIndex::DB::WriteTxs(std::vector<std::pair<uint256, CDiskTxPos>>& v_pos)
 {
+    // Writing the keys in ascending order improves memtable insertion
+    // locality and lets LevelDB's block-level key prefix compression kick in
+    // as early as possible. stable_sort keeps the write order of any
+    // duplicate txids (BIP30-era coinbases) intact.
+    std::stable_sort(v_pos.begin(), v_pos.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
     CDBBatch batch(*this);
     for (const auto& tuple : v_pos) {
         batch.Write(std::make_pair(DB_TXINDEX, tuple.first), tuple.second);
@@ -61,13 +73,35 @@ bool TxIndex::CustomAppend(const interfaces::BlockInfo& block)
 
     assert(block.data);
     CDiskTxPos pos({block.file_number, block.data_pos}, GetSizeOfCompactSize(block.data->vtx.size()));
-    std::vector<std::pair<uint256, CDiskTxPos>> vPos;
-    vPos.reserve(block.data->vtx.size());
+    m_pos_buffer.reserve(m_pos_buffer.size() + block.data->vtx.size());
     for (const auto& tx : block.data->vtx) {
-        vPos.emplace_back(tx->GetHash(), pos);
+        m_pos_buffer.emplace_back(tx->GetHash(), pos);
         pos.nTxOffset += ::GetSerializeSize(TX_WITH_WITNESS(*tx));
     }
-    return m_db->WriteTxs(vPos);
+
+    // During the initial sync, accumulate positions across blocks and land
+    // them in large sorted batches; lookups do not expect the index to cover
+    // a block before the best-block locator does. Once synced, every block
+    // must be queryable as soon as it is appended, so flush immediately.
+    if (!IsSynced() && m_pos_buffer.size() < TXINDEX_WRITE_BATCH_SIZE) return true;
+
+    if (!m_db->WriteTxs(m_pos_buffer)) return false;
+    m_pos_buffer.clear();
+    return true;
+}
+
+bool TxIndex::CustomCommit(CDBBatch& batch)
+{
+    // Flush any buffered positions into the same atomic batch as the
+    // best-block locator, so a crash can never lose entries the locator
+    // claims to cover.
+    std::stable_sort(m_pos_buffer.begin(), m_pos_buffer.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& tuple : m_pos_buffer) {
+        batch.Write(std::make_pair(DB_TXINDEX, tuple.first), tuple.second);
+    }
+    m_pos_buffer.clear();
+    return true;
 }
 
 BaseIndex::DB& TxIndex::GetDB() const { return *m_db; }
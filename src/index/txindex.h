@@ -6,6 +6,10 @@
 #define BITCOIN_INDEX_TXINDEX_H
 
 #include <index/base.h>
+#include <index/disktxpos.h>
+
+#include <utility>
+#include <vector>
 
 static constexpr bool DEFAULT_TXINDEX{false};
 
@@ -22,11 +26,18 @@ protected:
 private:
     const std::unique_ptr<DB> m_db;
 
+    /// Transaction positions buffered across blocks; flushed sorted by txid
+    /// once large enough, and unconditionally (into the same atomic batch as
+    /// the best-block locator) by CustomCommit().
+    std::vector<std::pair<uint256, CDiskTxPos>> m_pos_buffer;
+
     bool AllowPrune() const override { return false; }
 
 protected:
     bool CustomAppend(const interfaces::BlockInfo& block) override;
 
+    bool CustomCommit(CDBBatch& batch) override;
+
     BaseIndex::DB& GetDB() const override;
 
 public:
@@ -19,11 +19,13 @@
 #include <common/args.h>
 #include <common/system.h>
 #include <consensus/amount.h>
+#include <crypto/tens_pow/tens_hash.h>
 #include <deploymentstatus.h>
 #include <hash.h>
 #include <httprpc.h>
 #include <httpserver.h>
 #include <index/blockfilterindex.h>
+#include <index/blockstatsindex.h>
 #include <index/coinstatsindex.h>
 #include <index/txindex.h>
 #include <init/common.h>
@@ -47,6 +49,7 @@
 #include <node/caches.h>
 #include <node/chainstate.h>
 #include <node/chainstatemanager_args.h>
+#include <node/coins_warmstart.h>
 #include <node/context.h>
 #include <node/interface_ui.h>
 #include <node/kernel_notifications.h>
@@ -55,11 +58,13 @@
 #include <node/mempool_persist_args.h>
 #include <node/miner.h>
 #include <node/peerman_args.h>
+#include <node/tens_ctx_store.h>
 #include <policy/feerate.h>
 #include <policy/fees.h>
 #include <policy/fees_args.h>
 #include <policy/policy.h>
 #include <policy/settings.h>
+#include <powcache.h>
 #include <protocol.h>
 #include <rpc/blockchain.h>
 #include <rpc/register.h>
@@ -71,6 +76,7 @@
 #include <torcontrol.h>
 #include <txdb.h>
 #include <txmempool.h>
+#include <util/allocprofile.h>
 #include <util/asmap.h>
 #include <util/batchpriority.h>
 #include <util/chaintype.h>
@@ -97,7 +103,9 @@
 #include <cstdio>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <set>
+#include <string_view>
 #include <string>
 #include <thread>
 #include <vector>
@@ -125,9 +133,12 @@ using node::BlockManager;
 using node::CalculateCacheSizes;
 using node::ChainstateLoadResult;
 using node::ChainstateLoadStatus;
+using node::COINS_WARM_FILENAME;
+using node::DEFAULT_COINS_WARM_START;
 using node::DEFAULT_PERSIST_MEMPOOL;
 using node::DEFAULT_PRINT_MODIFIED_FEE;
 using node::DEFAULT_STOPATHEIGHT;
+using node::DumpCoinsCacheKeys;
 using node::DumpMempool;
 using node::ImportBlocks;
 using node::KernelNotifications;
@@ -137,6 +148,7 @@ using node::MempoolPath;
 using node::NodeContext;
 using node::ShouldPersistMempool;
 using node::VerifyLoadedChainstate;
+using node::WarmCoinsCache;
 using util::Join;
 using util::ReplaceAll;
 using util::ToString;
@@ -145,6 +157,8 @@ static constexpr bool DEFAULT_PROXYRANDOMIZE{true};
 static constexpr bool DEFAULT_REST_ENABLE{false};
 static constexpr bool DEFAULT_I2P_ACCEPT_INCOMING{true};
 static constexpr bool DEFAULT_STOPAFTERBLOCKIMPORT{false};
+static constexpr int DEFAULT_POW_VERIFY_THREADS{1};
+static constexpr bool DEFAULT_POW_LOW_MEMORY{false};
 
 #ifdef WIN32
 // Win32 LevelDB doesn't use filedescriptors, and the ones used for
@@ -323,17 +337,28 @@ void Shutdown(NodeContext& node)
     node.addrman.reset();
     node.netgroupman.reset();
 
+    // The mempool dump, the fee estimate flush and the chainstate flush below
+    // write to independent files and databases, so run the file dumps in the
+    // background while the chainstate flush (which dominates shutdown with a
+    // large dbcache) proceeds, and join them at the barrier further down.
+    std::vector<std::future<void>> flush_tasks;
     if (node.mempool && node.mempool->GetLoadTried() && ShouldPersistMempool(*node.args)) {
-        DumpMempool(*node.mempool, MempoolPath(*node.args));
+        flush_tasks.emplace_back(std::async(std::launch::async, [&node] {
+            DumpMempool(*node.mempool, MempoolPath(*node.args));
+        }));
     }
 
-    // Drop transactions we were still watching, record fee estimations and unregister
-    // fee estimator from validation interface.
+    // Drop transactions we were still watching and record fee estimations; the
+    // estimator is unregistered from the validation interface after the barrier.
     if (node.fee_estimator) {
-        node.fee_estimator->Flush();
-        if (node.validation_signals) {
-            node.validation_signals->UnregisterValidationInterface(node.fee_estimator.get());
-        }
+        flush_tasks.emplace_back(std::async(std::launch::async, [&node] {
+            node.fee_estimator->Flush();
+        }));
+    }
+
+    // Record the coins cache working set before the flushes below empty it.
+    if (node.chainman && node.args->GetBoolArg("-coinswarmstart", DEFAULT_COINS_WARM_START)) {
+        DumpCoinsCacheKeys(*node.chainman, node.args->GetDataDirNet() / COINS_WARM_FILENAME);
     }
 
     // FlushStateToDisk generates a ChainStateFlushed callback, which we should avoid missing
@@ -346,6 +371,14 @@ void Shutdown(NodeContext& node)
         }
     }
 
+    // Synchronization barrier: the background dumps must have finished before
+    // the fee estimator is unregistered and the modules below are torn down.
+    for (auto& task : flush_tasks) task.get();
+    flush_tasks.clear();
+    if (node.fee_estimator && node.validation_signals) {
+        node.validation_signals->UnregisterValidationInterface(node.fee_estimator.get());
+    }
+
     // After there are no more peers/RPC left to give us new data which may generate
     // CValidationInterface callbacks, flush them...
     if (node.validation_signals) node.validation_signals->FlushBackgroundCallbacks();
@@ -354,6 +387,7 @@ void Shutdown(NodeContext& node)
     for (auto* index : node.indexes) index->Stop();
     if (g_txindex) g_txindex.reset();
     if (g_coin_stats_index) g_coin_stats_index.reset();
+    if (g_blockstats_index) g_blockstats_index.reset();
     DestroyAllBlockFilterIndexes();
     node.indexes.clear(); // all instances are nullptr now
 
@@ -460,7 +494,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
 
     // Hidden Options
     std::vector<std::string> hidden_args = {
-        "-dbcrashratio", "-forcecompactdb",
+        "-coinsdbblocksize", "-dbcrashratio", "-forcecompactdb",
         // GUI args. These will be overwritten by SetupUIArgs for the GUI
         "-choosedatadir", "-lang=<lang>", "-min", "-resetguisettings", "-splash", "-uiplatform"};
 
@@ -469,6 +503,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-alertnotify=<cmd>", "Execute command when an alert is raised (%s in cmd is replaced by message)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
     argsman.AddArg("-assumevalid=<hex>", strprintf("If this block is in the chain assume that it and its ancestors are valid and potentially skip their script verification (0 to verify all, default: %s, testnet3: %s, testnet4: %s, signet: %s)", defaultChainParams->GetConsensus().defaultAssumeValid.GetHex(), testnetChainParams->GetConsensus().defaultAssumeValid.GetHex(), testnet4ChainParams->GetConsensus().defaultAssumeValid.GetHex(), signetChainParams->GetConsensus().defaultAssumeValid.GetHex()), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-assumevalidpow=<hex>", "Until this block's header has been accepted, fully verify the proof-of-work hash of only a random one in 20 new headers. Difficulty transitions and chainwork accounting are still enforced for every header (0 to verify all, default: 0)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksdir=<dir>", "Specify directory to hold blocks subdirectory for *.dat files (default: <datadir>)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksxor",
                    strprintf("Whether an XOR-key applies to blocksdir *.dat files. "
@@ -483,7 +518,9 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
 #endif
     argsman.AddArg("-blockreconstructionextratxn=<n>", strprintf("Extra transactions to keep in memory for compact block reconstructions (default: %u)", DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksonly", strprintf("Whether to reject transactions from network peers. Disables automatic broadcast and rebroadcast of transactions, unless the source peer has the 'forcerelay' permission. RPC transactions are not affected. (default: %u)", DEFAULT_BLOCKSONLY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-blockstatsindex", strprintf("Maintain an index of per-block statistics used by the getblockstats RPC (default: %u)", DEFAULT_BLOCKSTATSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-coinstatsindex", strprintf("Maintain coinstats index used by the gettxoutsetinfo RPC (default: %u)", DEFAULT_COINSTATSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-coinswarmstart", strprintf("Save the keys of the coins cache working set on shutdown and reload those coins from the database on startup, so the cache is warm before the node syncs to tip (default: %u)", DEFAULT_COINS_WARM_START), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-conf=<file>", strprintf("Specify path to read-only configuration file. Relative paths will be prefixed by datadir location (only useable from command line, not configuration file) (default: %s)", BITCOIN_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-datadir=<dir>", "Specify data directory", ArgsManager::ALLOW_ANY | ArgsManager::DISALLOW_NEGATION, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbbatchsize", strprintf("Maximum database write batch size in bytes (default: %u)", nDefaultDbBatchSize), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
@@ -504,6 +541,9 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
                              DEFAULT_PERSIST_V1_DAT),
                    ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-pid=<file>", strprintf("Specify pid file. Relative paths will be prefixed by a net-specific datadir location. (default: %s)", BITCOIN_PID_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-powcachesize=<n>", strprintf("Limit size of proof-of-work verification cache to <n> MiB (0 to disable, default: %u)", DEFAULT_POW_CACHE_BYTES >> 20), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-powlowmem", strprintf("Verify proof of work by streaming the matrices layer-by-layer instead of keeping full per-seed contexts in memory. Caps the PoW working set at roughly 1 MiB at a large CPU cost per header; for memory-constrained nodes (default: %u)", DEFAULT_POW_LOW_MEMORY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-powverifythreads=<n>", strprintf("Set the number of threads used to verify a single proof-of-work hash (0 = auto, rounded down to a power of two, up to 16, default: %d)", DEFAULT_POW_VERIFY_THREADS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-prune=<n>", strprintf("Reduce storage requirements by enabling pruning (deleting) of old blocks. This allows the pruneblockchain RPC to be called to delete specific blocks and enables automatic pruning of old blocks if a target size in MiB is provided. This mode is incompatible with -txindex. "
             "Warning: Reverting this setting requires re-downloading the entire blockchain. "
             "(default: 0 = disable pruning blocks, 1 = allow manual pruning via RPC, >=%u = automatically prune block files to stay under the specified target size in MiB)", MIN_DISK_SPACE_FOR_BLOCK_FILES / 1024 / 1024), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -579,11 +619,13 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     g_wallet_init_interface.AddWalletOptions(argsman);
 
 #ifdef ENABLE_ZMQ
+    argsman.AddArg("-zmqpubblockpos=<address>", "Enable publish block flat-file position (hash, file number, offset) in <address>. Lets co-located consumers read connected blocks directly from the blocks/ directory instead of receiving the serialized block. Incompatible with -prune.", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashblock=<address>", "Enable publish hash block in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashtx=<address>", "Enable publish hash transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawblock=<address>", "Enable publish raw block in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawtx=<address>", "Enable publish raw transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubsequence=<address>", "Enable publish hash block and tx sequence in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubblockposhwm=<n>", strprintf("Set publish block position outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashblockhwm=<n>", strprintf("Set publish hash block outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashtxhwm=<n>", strprintf("Set publish hash transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawblockhwm=<n>", strprintf("Set publish raw block outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
@@ -609,6 +651,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-checkmempool=<n>", strprintf("Run mempool consistency checks every <n> transactions. Use 0 to disable. (default: %u, regtest: %u)", defaultChainParams->DefaultConsistencyChecks(), regtestChainParams->DefaultConsistencyChecks()), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-checkpoints", strprintf("Enable rejection of any forks from the known historical chain until block %s (default: %u)", defaultChainParams->Checkpoints().GetHeight(), DEFAULT_CHECKPOINTS_ENABLED), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-deprecatedrpc=<method>", "Allows deprecated RPC method(s) to be used", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-mempooltrace=<file>", "Append every transaction accepted to the mempool, with arrival time and spent coins, to <file> for replay with bench_bitcoin -mempool-replay", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-stopafterblockimport", strprintf("Stop running after importing blocks from disk (default: %u)", DEFAULT_STOPAFTERBLOCKIMPORT), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-stopatheight", strprintf("Stop running after reaching the given height in the main chain (default: %u)", DEFAULT_STOPATHEIGHT), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-limitancestorcount=<n>", strprintf("Do not accept transactions if number of in-mempool ancestors is <n> or more (default: %u)", DEFAULT_ANCESTOR_LIMIT), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
@@ -655,6 +698,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-rpcallowip=<ip>", "Allow JSON-RPC connections from specified source. Valid values for <ip> are a single IP (e.g. 1.2.3.4), a network/netmask (e.g. 1.2.3.4/255.255.255.0), a network/CIDR (e.g. 1.2.3.4/24), all ipv4 (0.0.0.0/0), or all ipv6 (::/0). This option can be specified multiple times", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcauth=<userpw>", "Username and HMAC-SHA-256 hashed password for JSON-RPC connections. The field <userpw> comes in the format: <USERNAME>:<SALT>$<HASH>. A canonical python script is included in share/rpcauth. The client then connects normally using the rpcuser=<USERNAME>/rpcpassword=<PASSWORD> pair of arguments. This option can be specified multiple times", ArgsManager::ALLOW_ANY | ArgsManager::SENSITIVE, OptionsCategory::RPC);
     argsman.AddArg("-rpcbind=<addr>[:port]", "Bind to given address to listen for JSON-RPC connections. Do not expose the RPC server to untrusted networks such as the public internet! This option is ignored unless -rpcallowip is also passed. Port is optional and overrides -rpcport. Use [host]:port notation for IPv6. This option can be specified multiple times (default: 127.0.0.1 and ::1 i.e., localhost)", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
+    argsman.AddArg("-rpccachesize=<n>", strprintf("Memory budget for caching rendered getblock RPC responses, in MiB of raw block data (the JSON form uses a small multiple of this). Set to 0 to disable caching (default: %d)", DEFAULT_RPC_CACHE_SIZE_MB), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcdoccheck", strprintf("Throw a non-fatal error at runtime if the documentation for an RPC is incorrect (default: %u)", DEFAULT_RPC_DOC_CHECK), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::RPC);
     argsman.AddArg("-rpccookiefile=<loc>", "Location of the auth cookie. Relative paths will be prefixed by a net-specific datadir location. (default: data dir)", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpccookieperms=<readable-by>", strprintf("Set permissions on the RPC auth cookie file so that it is readable by [owner|group|all] (default: owner [via umask 0077])"), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
@@ -947,6 +991,11 @@ bool AppInitParameterInteraction(const ArgsManager& args)
         if (args.GetBoolArg("-reindex-chainstate", false)) {
             return InitError(_("Prune mode is incompatible with -reindex-chainstate. Use full -reindex instead."));
         }
+#ifdef ENABLE_ZMQ
+        if (!args.GetArgs("-zmqpubblockpos").empty()) {
+            return InitError(_("Prune mode is incompatible with -zmqpubblockpos: the referenced block files could be deleted."));
+        }
+#endif
     }
 
     // If -forcednsseed is set to true, ensure -dnsseed has not been set to false
@@ -1069,6 +1118,10 @@ bool AppInitParameterInteraction(const ArgsManager& args)
         }
     }
 
+    tens_hash_set_verify_threads(args.GetIntArg("-powverifythreads", DEFAULT_POW_VERIFY_THREADS));
+    tens_hash_set_low_memory(args.GetBoolArg("-powlowmem", DEFAULT_POW_LOW_MEMORY));
+    InitPoWCache(std::max<int64_t>(0, args.GetIntArg("-powcachesize", DEFAULT_POW_CACHE_BYTES >> 20)) << 20);
+
     return true;
 }
 
@@ -1272,6 +1325,15 @@ static ChainstateLoadResult InitAndLoadChainstate(
     return {status, error};
 };
 
+//! Log how long an init stage took and return a fresh start point for the
+//! next one, so restart time can be attributed per stage on each host.
+static SteadyClock::time_point LogInitStageTime(std::string_view stage, SteadyClock::time_point stage_start)
+{
+    const auto now{SteadyClock::now()};
+    LogInfo("Init: %s completed (%.2fms)", stage, Ticks<MillisecondsDouble>(now - stage_start));
+    return now;
+}
+
 bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 {
     const ArgsManager& args = *Assert(node.args);
@@ -1315,6 +1377,13 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         RandAddPeriodic();
     }, std::chrono::minutes{1});
 
+    // Report hot-path allocation counters once per minute under -debug=alloc.
+    if (LogInstance().WillLogCategory(BCLog::ALLOC)) {
+        scheduler.scheduleEvery([]{
+            alloc_profile::LogStats();
+        }, std::chrono::minutes{1});
+    }
+
     // Check disk space every 5 minutes to avoid db corruption.
     scheduler.scheduleEvery([&args, &node]{
         constexpr uint64_t min_disk_space = 50 << 20; // 50 MB
@@ -1374,11 +1443,13 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     }
 
     // ********************************************************* Step 5: verify wallet database integrity
+    auto stage_start{SteadyClock::now()};
     for (const auto& client : node.chain_clients) {
         if (!client->verify()) {
             return false;
         }
     }
+    stage_start = LogInitStageTime("wallet database verification", stage_start);
 
     // ********************************************************* Step 6: network initialization
     // Note that we absolutely cannot open any actual connections
@@ -1392,6 +1463,8 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     PeerManager::Options peerman_opts{};
     ApplyArgsManOptions(args, peerman_opts);
 
+    std::future<util::Result<std::unique_ptr<AddrMan>>> addrman_load;
+
     {
 
         // Read asmap file if configured
@@ -1420,22 +1493,18 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         assert(!node.netgroupman);
         node.netgroupman = std::make_unique<NetGroupManager>(std::move(asmap));
 
-        // Initialize addrman
+        // Parse peers.dat in the background: it only depends on the netgroup
+        // manager, so the (potentially long) block index and chainstate load
+        // below overlaps with it instead of queueing behind it. The result is
+        // collected right before the networking objects that need it are
+        // constructed.
         assert(!node.addrman);
         uiInterface.InitMessage(_("Loading P2P addresses…"));
-        auto addrman{LoadAddrman(*node.netgroupman, args)};
-        if (!addrman) return InitError(util::ErrorString(addrman));
-        node.addrman = std::move(*addrman);
+        addrman_load = std::async(std::launch::async, [&netgroupman = *node.netgroupman, &args] {
+            return LoadAddrman(netgroupman, args);
+        });
     }
 
-    FastRandomContext rng;
-    assert(!node.banman);
-    node.banman = std::make_unique<BanMan>(args.GetDataDirNet() / "banlist", &uiInterface, args.GetIntArg("-bantime", DEFAULT_MISBEHAVING_BANTIME));
-    assert(!node.connman);
-    node.connman = std::make_unique<CConnman>(rng.rand64(),
-                                              rng.rand64(),
-                                              *node.addrman, *node.netgroupman, chainparams, args.GetBoolArg("-networkactive", true));
-
     assert(!node.fee_estimator);
     // Don't initialize fee estimation with old data if we don't relay transactions,
     // as they would never get updated.
@@ -1448,7 +1517,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 
         // Flush estimates to disk periodically
         CBlockPolicyEstimator* fee_estimator = node.fee_estimator.get();
-        scheduler.scheduleEvery([fee_estimator] { fee_estimator->FlushFeeEstimates(); }, FEE_FLUSH_INTERVAL);
+        scheduler.scheduleEvery([fee_estimator] { fee_estimator->FlushFeeEstimates(); }, FEE_FLUSH_INTERVAL, CScheduler::Priority::BACKGROUND);
         validation_signals.RegisterValidationInterface(fee_estimator);
     }
 
@@ -1599,8 +1668,14 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     }
 #endif
 
+    stage_start = LogInitStageTime("network initialization", stage_start);
+
     // ********************************************************* Step 7: load block chain
 
+    // Persist generated proof-of-work matrices next to the block data so a
+    // restarted node resumes hashing without regeneration cost.
+    node::InitTensMatrixStore(args.GetDataDirNet() / "powmatrices");
+
     node.notifications = std::make_unique<KernelNotifications>(Assert(node.shutdown_request), node.exit_status, *Assert(node.warnings));
     auto& kernel_notifications{*node.notifications};
     ReadNotificationArgs(args, kernel_notifications);
@@ -1665,6 +1740,24 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 
     ChainstateManager& chainman = *Assert(node.chainman);
 
+    stage_start = LogInitStageTime("block index and chainstate load", stage_start);
+
+    // Collect the address manager loaded in the background during Step 6.
+    {
+        auto addrman{addrman_load.get()};
+        if (!addrman) return InitError(util::ErrorString(addrman));
+        node.addrman = std::move(*addrman);
+    }
+    stage_start = LogInitStageTime("P2P address load (residual wait)", stage_start);
+
+    FastRandomContext rng;
+    assert(!node.banman);
+    node.banman = std::make_unique<BanMan>(args.GetDataDirNet() / "banlist", &uiInterface, args.GetIntArg("-bantime", DEFAULT_MISBEHAVING_BANTIME));
+    assert(!node.connman);
+    node.connman = std::make_unique<CConnman>(rng.rand64(),
+                                              rng.rand64(),
+                                              *node.addrman, *node.netgroupman, chainparams, args.GetBoolArg("-networkactive", true));
+
     assert(!node.peerman);
     node.peerman = PeerManager::make(*node.connman, *node.addrman,
                                      node.banman.get(), chainman,
@@ -1689,8 +1782,18 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         node.indexes.emplace_back(g_coin_stats_index.get());
     }
 
-    // Init indexes
-    for (auto index : node.indexes) if (!index->Init()) return false;
+    if (args.GetBoolArg("-blockstatsindex", DEFAULT_BLOCKSTATSINDEX)) {
+        g_blockstats_index = std::make_unique<BlockStatsIndex>(interfaces::MakeChain(node), /*n_cache_size=*/0, false, do_reindex);
+        node.indexes.emplace_back(g_blockstats_index.get());
+    }
+
+    // Init indexes. Index Init() only opens the index databases and finds the
+    // sync start point, touching files disjoint from the wallets, so it runs
+    // alongside the wallet load below.
+    auto indexes_init = std::async(std::launch::async, [&node] {
+        for (auto index : node.indexes) if (!index->Init()) return false;
+        return true;
+    });
 
     // ********************************************************* Step 9: load wallet
     for (const auto& client : node.chain_clients) {
@@ -1698,6 +1801,8 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
             return false;
         }
     }
+    if (!indexes_init.get()) return false;
+    stage_start = LogInitStageTime("index init and wallet load", stage_start);
 
     // ********************************************************* Step 10: data directory maintenance
 
@@ -1773,8 +1878,17 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 
     node.background_init_thread = std::thread(&util::TraceThread, "initload", [=, &chainman, &args, &node] {
         ScheduleBatchPriority();
+        // Warm the coins cache with the previous run's working set, so the
+        // blocks connected below (and early mempool/net traffic) mostly hit
+        // the cache. Pointless during a reindex, which rebuilds the coins
+        // database from scratch.
+        if (!chainman.m_blockman.LoadingBlocks() && args.GetBoolArg("-coinswarmstart", DEFAULT_COINS_WARM_START)) {
+            WarmCoinsCache(chainman, args.GetDataDirNet() / COINS_WARM_FILENAME);
+        }
+        auto load_stage_start{SteadyClock::now()};
         // Import blocks and ActivateBestChain()
         ImportBlocks(chainman, vImportFiles);
+        load_stage_start = LogInitStageTime("block import and chain activation", load_stage_start);
         if (args.GetBoolArg("-stopafterblockimport", DEFAULT_STOPAFTERBLOCKIMPORT)) {
             LogPrintf("Stopping after block import\n");
             if (!(Assert(node.shutdown_request))()) {
@@ -1793,6 +1907,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         if (auto* pool{chainman.ActiveChainstate().GetMempool()}) {
             LoadMempool(*pool, ShouldPersistMempool(args) ? MempoolPath(args) : fs::path{}, chainman.ActiveChainstate(), {});
             pool->SetLoadTried(!chainman.m_interrupt);
+            LogInitStageTime("mempool load", load_stage_start);
         }
     });
 
@@ -2012,7 +2127,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     BanMan* banman = node.banman.get();
     scheduler.scheduleEvery([banman]{
         banman->DumpBanlist();
-    }, DUMP_BANS_INTERVAL);
+    }, DUMP_BANS_INTERVAL, CScheduler::Priority::BACKGROUND);
 
     if (node.peerman) node.peerman->StartScheduledTasks(scheduler);
 
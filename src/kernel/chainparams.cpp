@@ -121,6 +121,13 @@ public:
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].nTimeout = 1628640000; // August 11th, 2021
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].min_activation_height = 709632; // Approximately November 12th, 2021
 
+        // Epoch-based TensHash seed schedule; see Consensus::Params::tenshash_epoch_length
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].bit = 3;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nStartTime = Consensus::BIP9Deployment::NEVER_ACTIVE;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].min_activation_height = 0; // No activation delay
+        consensus.tenshash_epoch_length = 2016;
+
         //consensus.nMinimumChainWork = uint256{"000000000000000000000000000000000000000088e186b70e0862c193ec44d6"};
         consensus.nMinimumChainWork = uint256{"0000000000000000000000000000000000000000000000000000000000000001"}; // XXX
 
@@ -257,6 +264,13 @@ public:
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].nTimeout = 1628640000; // August 11th, 2021
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].min_activation_height = 0; // No activation delay
 
+        // Epoch-based TensHash seed schedule; see Consensus::Params::tenshash_epoch_length
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].bit = 3;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nStartTime = Consensus::BIP9Deployment::NEVER_ACTIVE;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].min_activation_height = 0; // No activation delay
+        consensus.tenshash_epoch_length = 2016;
+
         consensus.nMinimumChainWork = uint256{"000000000000000000000000000000000000000000000f209695166be8b61fa9"};
         consensus.defaultAssumeValid = uint256{"000000000000000465b1a66c9f386308e8c75acef9201f3f577811da09fc90ad"}; // 2873500
 
@@ -356,6 +370,13 @@ public:
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].min_activation_height = 0; // No activation delay
 
+        // Epoch-based TensHash seed schedule; see Consensus::Params::tenshash_epoch_length
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].bit = 3;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nStartTime = Consensus::BIP9Deployment::NEVER_ACTIVE;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].min_activation_height = 0; // No activation delay
+        consensus.tenshash_epoch_length = 2016;
+
         consensus.nMinimumChainWork = uint256{"00000000000000000000000000000000000000000000005faa15d02e6202f3ba"};
         consensus.defaultAssumeValid = uint256{"000000005be348057db991fa5d89fe7c4695b667cfb311391a8db374b6f681fd"}; // 39550
 
@@ -496,6 +517,13 @@ public:
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].min_activation_height = 0; // No activation delay
 
+        // Epoch-based TensHash seed schedule; see Consensus::Params::tenshash_epoch_length
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].bit = 3;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nStartTime = Consensus::BIP9Deployment::NEVER_ACTIVE;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].min_activation_height = 0; // No activation delay
+        consensus.tenshash_epoch_length = 2016;
+
         // message start is defined as the first 4 bytes of the sha256d of the block script
         HashWriter h{};
         h << consensus.signet_challenge;
@@ -560,6 +588,7 @@ public:
         consensus.fPowAllowMinDifficultyBlocks = true;
         consensus.enforce_BIP94 = opts.enforce_bip94;
         consensus.fPowNoRetargeting = true;
+        consensus.tenshash_hidden_layers = 4; // Reduced TensHash network; full PoW would dominate test block generation
         consensus.nRuleChangeActivationThreshold = 108; // 75% for testchains
         consensus.nMinerConfirmationWindow = 144; // Faster than normal for regtest (144 instead of 2016)
 
@@ -573,6 +602,13 @@ public:
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
         consensus.vDeployments[Consensus::DEPLOYMENT_TAPROOT].min_activation_height = 0; // No activation delay
 
+        // Epoch-based TensHash seed schedule; see Consensus::Params::tenshash_epoch_length
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].bit = 3;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nStartTime = Consensus::BIP9Deployment::NEVER_ACTIVE;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].nTimeout = Consensus::BIP9Deployment::NO_TIMEOUT;
+        consensus.vDeployments[Consensus::DEPLOYMENT_POW_EPOCH].min_activation_height = 0; // No activation delay
+        consensus.tenshash_epoch_length = 144;   // One epoch per retarget window
+
         consensus.nMinimumChainWork = uint256{};
         consensus.defaultAssumeValid = uint256{};
 
@@ -40,6 +40,10 @@ struct ChainstateManagerOpts {
     std::optional<arith_uint256> minimum_chain_work{};
     //! If set, it will override the block hash whose ancestors we will assume to have valid scripts without checking them.
     std::optional<uint256> assumed_valid_block{};
+    //! If set and non-null, until this block's header has been accepted, new headers
+    //! only have their proof-of-work hash verified for a random sample; difficulty
+    //! transitions and chainwork accounting remain enforced for every header.
+    std::optional<uint256> assumed_valid_pow_block{};
     //! If the tip is older than this, the node is considered to be in initial block download.
     std::chrono::seconds max_tip_age{DEFAULT_MAX_TIP_AGE};
     DBOptions block_tree_db{};
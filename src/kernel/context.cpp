@@ -4,7 +4,11 @@
 
 #include <kernel/context.h>
 
+#include <crypto/chacha20.h>
+#include <crypto/hex_base.h>
 #include <crypto/sha256.h>
+#include <crypto/siphash.h>
+#include <crypto/tens_pow/tens_hash.h>
 #include <logging.h>
 #include <random.h>
 
@@ -18,6 +22,14 @@ Context::Context()
     std::call_once(globals_initialized, []() {
         std::string sha256_algo = SHA256AutoDetect();
         LogInfo("Using the '%s' SHA256 implementation\n", sha256_algo);
+        std::string tens_hash_algo = TensHashAutoDetect();
+        LogInfo("Using the '%s' TensHash implementation\n", tens_hash_algo);
+        std::string siphash_algo = SipHashAutoDetect();
+        LogInfo("Using the '%s' SipHash batch implementation\n", siphash_algo);
+        std::string hexstr_algo = HexStrAutoDetect();
+        LogInfo("Using the '%s' HexStr implementation\n", hexstr_algo);
+        std::string chacha20_algo = ChaCha20AutoDetect();
+        LogInfo("Using the '%s' ChaCha20 implementation\n", chacha20_algo);
         RandomInit();
     });
 }
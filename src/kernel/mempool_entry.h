@@ -17,6 +17,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <set>
 #include <stddef.h>
 #include <stdint.h>
@@ -89,6 +90,11 @@ private:
     const int64_t sigOpCost;        //!< Total sigop cost
     CAmount m_modified_fee;         //!< Used for determining the priority of the transaction for mining in a block
     mutable LockPoints lockPoints;  //!< Track the height and time at which tx was final
+    //! Script verification flags this transaction's input scripts were fully
+    //! validated against on mempool acceptance, if recorded. Lets block
+    //! connection skip re-verifying scripts for transactions mined with
+    //! identical flags.
+    mutable std::optional<unsigned int> m_validated_script_flags;
 
     // Information about descendants of this transaction that are in the
     // mempool; if we remove this transaction we must remove all of these
@@ -168,6 +174,13 @@ public:
         lockPoints = lp;
     }
 
+    std::optional<unsigned int> GetValidatedScriptFlags() const { return m_validated_script_flags; }
+    // Record the script verification flags the input scripts passed on acceptance
+    void UpdateValidatedScriptFlags(unsigned int flags) const
+    {
+        m_validated_script_flags = flags;
+    }
+
     uint64_t GetCountWithDescendants() const { return m_count_with_descendants; }
     int64_t GetSizeWithDescendants() const { return nSizeWithDescendants; }
     CAmount GetModFeesWithDescendants() const { return nModFeesWithDescendants; }
@@ -8,6 +8,7 @@
 
 #include <policy/feerate.h>
 #include <policy/policy.h>
+#include <util/fs.h>
 
 #include <chrono>
 #include <cstdint>
@@ -54,6 +55,12 @@ struct MemPoolOptions {
     bool permit_bare_multisig{DEFAULT_PERMIT_BAREMULTISIG};
     bool require_standard{true};
     bool persist_v1_dat{DEFAULT_PERSIST_V1_DAT};
+    /**
+     * If non-empty, append every transaction accepted to the mempool, with
+     * its arrival time and the coins it spends, to this file. The trace can
+     * be replayed with `bench_bitcoin -mempool-replay` (see -mempooltrace).
+     */
+    fs::path trace_file{};
     MemPoolLimits limits{};
 
     ValidationSignals* signals{nullptr};
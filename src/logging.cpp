@@ -90,11 +90,22 @@ bool BCLog::Logger::StartLogging()
     m_cur_buffer_memusage = 0;
     if (m_print_to_console) fflush(stdout);
 
+    if (m_print_to_file) {
+        // From here on, file writes happen on a dedicated flusher thread so
+        // that hot threads never block on log disk I/O.
+        m_async = true;
+        m_flusher_thread = std::thread([this] {
+            util::ThreadRename("logflusher");
+            FlusherThread();
+        });
+    }
+
     return true;
 }
 
 void BCLog::Logger::DisconnectTestLogger()
 {
+    StopFlusher(); // drains any queued lines before the file is closed
     StdLockGuard scoped_lock(m_cs);
     m_buffering = true;
     if (m_fileout != nullptr) fclose(m_fileout);
@@ -199,6 +210,8 @@ static const std::map<std::string, BCLog::LogFlags, std::less<>> LOG_CATEGORIES_
     {"txreconciliation", BCLog::TXRECONCILIATION},
     {"scan", BCLog::SCAN},
     {"txpackages", BCLog::TXPACKAGES},
+    {"pow", BCLog::POW},
+    {"alloc", BCLog::ALLOC},
 };
 
 static const std::unordered_map<BCLog::LogFlags, std::string> LOG_CATEGORIES_BY_FLAG{
@@ -437,6 +450,19 @@ void BCLog::Logger::LogPrintStr_(std::string_view str, std::string_view logging_
     if (m_print_to_file) {
         assert(m_fileout != nullptr);
 
+        if (m_async) {
+            // Hand the formatted line to the flusher thread; the producer
+            // never blocks on disk I/O. Bounded: drop and count on overflow.
+            if (m_async_queue_memusage + str_prefixed.size() > DEFAULT_MAX_ASYNC_LOG_BUFFER) {
+                ++m_async_lines_dropped;
+            } else {
+                m_async_queue_memusage += str_prefixed.size();
+                m_async_queue.push_back(std::move(str_prefixed));
+            }
+            m_flush_cv.notify_one();
+            return;
+        }
+
         // reopen the log file, if requested
         if (m_reopen_file) {
             m_reopen_file = false;
@@ -451,6 +477,57 @@ void BCLog::Logger::LogPrintStr_(std::string_view str, std::string_view logging_
     }
 }
 
+void BCLog::Logger::FlusherThread()
+{
+    std::unique_lock lock{m_cs};
+    while (true) {
+        while (m_async_queue.empty() && m_async) {
+            m_flush_cv.wait(lock);
+        }
+        if (m_async_queue.empty()) return; // stopped and fully drained
+
+        std::deque<std::string> batch;
+        batch.swap(m_async_queue);
+        m_async_queue_memusage = 0;
+        const size_t dropped{m_async_lines_dropped};
+        m_async_lines_dropped = 0;
+
+        // Handle a requested reopen here, under the lock, so m_fileout only
+        // changes while the writer is idle.
+        if (m_reopen_file) {
+            m_reopen_file = false;
+            FILE* new_fileout = fsbridge::fopen(m_file_path, "a");
+            if (new_fileout) {
+                setbuf(new_fileout, nullptr); // unbuffered
+                fclose(m_fileout);
+                m_fileout = new_fileout;
+            }
+        }
+        FILE* fileout{m_fileout};
+        lock.unlock();
+
+        // Batched writes outside the lock: producers keep logging (into the
+        // next batch) while this thread is blocked on disk.
+        for (const std::string& line : batch) {
+            FileWriteStr(line, fileout);
+        }
+        if (dropped > 0) {
+            FileWriteStr(strprintf("Async log buffer overflowed, %d log lines dropped.\n", dropped), fileout);
+        }
+        lock.lock();
+    }
+}
+
+void BCLog::Logger::StopFlusher()
+{
+    {
+        StdLockGuard scoped_lock(m_cs);
+        m_async = false;
+    }
+    m_flush_cv.notify_all();
+    if (m_flusher_thread.joinable()) m_flusher_thread.join();
+}
+
 void BCLog::Logger::ShrinkDebugFile()
 {
     // Amount of debug.log to save at end when shrinking (must fit in memory)
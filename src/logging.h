@@ -13,11 +13,14 @@
 #include <util/time.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <list>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -71,6 +74,8 @@ namespace BCLog {
         TXRECONCILIATION = (CategoryMask{1} << 26),
         SCAN        = (CategoryMask{1} << 27),
         TXPACKAGES  = (CategoryMask{1} << 28),
+        POW         = (CategoryMask{1} << 29),
+        ALLOC       = (CategoryMask{1} << 30),
         ALL         = ~NONE,
     };
     enum class Level {
@@ -82,6 +87,7 @@ namespace BCLog {
     };
     constexpr auto DEFAULT_LOG_LEVEL{Level::Debug};
     constexpr size_t DEFAULT_MAX_LOG_BUFFER{1'000'000}; // buffer up to 1MB of log data prior to StartLogging
+    constexpr size_t DEFAULT_MAX_ASYNC_LOG_BUFFER{1'000'000}; // bound on formatted log data queued for the flusher thread
 
     class Logger
     {
@@ -128,7 +134,26 @@ namespace BCLog {
 
         std::string GetLogPrefix(LogFlags category, Level level) const;
 
+        //! Formatted lines queued for the flusher thread, bounded by
+        //! DEFAULT_MAX_ASYNC_LOG_BUFFER; once full, lines are dropped and
+        //! counted so hot threads never block on log disk I/O.
+        std::deque<std::string> m_async_queue GUARDED_BY(m_cs);
+        size_t m_async_queue_memusage GUARDED_BY(m_cs){0};
+        size_t m_async_lines_dropped GUARDED_BY(m_cs){0};
+        //! Whether the flusher thread is running and file writes go through
+        //! m_async_queue. Only toggled by StartLogging()/StopFlusher().
+        bool m_async GUARDED_BY(m_cs){false};
+        std::condition_variable_any m_flush_cv;
+        std::thread m_flusher_thread;
+
+        //! Thread safety analysis cannot follow the std::unique_lock handoff
+        //! around the batched writes.
+        void FlusherThread() NO_THREAD_SAFETY_ANALYSIS;
+        void StopFlusher() EXCLUSIVE_LOCKS_REQUIRED(!m_cs);
+
     public:
+        ~Logger() { StopFlusher(); }
+
         bool m_print_to_console = false;
         bool m_print_to_file = false;
 
@@ -28,6 +28,7 @@
 #include <protocol.h>
 #include <random.h>
 #include <scheduler.h>
+#include <util/allocprofile.h>
 #include <util/fs.h>
 #include <util/sock.h>
 #include <util/strencodings.h>
@@ -121,6 +122,11 @@ GlobalMutex g_maplocalhost_mutex;
 std::map<CNetAddr, LocalServiceInfo> mapLocalHost GUARDED_BY(g_maplocalhost_mutex);
 std::string strSubVersion;
 
+void CSerializedNetMsg::PrecomputeHash()
+{
+    if (!m_hash) m_hash = Hash(data);
+}
+
 size_t CSerializedNetMsg::GetMemoryUsage() const noexcept
 {
     return sizeof(*this) + memusage::DynamicUsage(m_type) + memusage::DynamicUsage(data);
@@ -422,7 +428,7 @@ CNode* CConnman::ConnectNode(CAddress addrConnect, const char *pszDest, bool fCo
     if (pszDest) {
         std::vector<CService> resolved{Lookup(pszDest, default_port, fNameLookup && !HaveNameProxy(), 256)};
         if (!resolved.empty()) {
-            std::shuffle(resolved.begin(), resolved.end(), FastRandomContext());
+            std::shuffle(resolved.begin(), resolved.end(), ThreadLocalRng());
             // If the connection is made by name, it can be the case that the name resolves to more than one address.
             // We don't want to connect any more of them if we are already connected to one
             for (const auto& r : resolved) {
@@ -541,6 +547,8 @@ CNode* CConnman::ConnectNode(CAddress addrConnect, const char *pszDest, bool fCo
                                     .i2p_sam_session = std::move(i2p_transient_session),
                                     .recv_flood_size = nReceiveFloodSize,
                                     .use_v2transport = use_v2transport,
+                                    .netgroup = m_netgroupman.GetGroup(target_addr),
+                                    .mapped_as = m_netgroupman.GetMappedAS(target_addr),
                                 });
         pnode->AddRef();
 
@@ -643,6 +651,8 @@ void CNode::CopyStats(CNodeStats& stats)
 
     X(m_last_ping_time);
     X(m_min_ping_time);
+    X(m_smoothed_ping_time);
+    X(m_ping_time_jitter);
 
     // Leave string empty if addrLocal invalid (not filled in yet)
     CService addrLocalUnlocked = GetAddrLocal();
@@ -834,8 +844,9 @@ bool V1Transport::SetMessageToSend(CSerializedNetMsg& msg) noexcept
     LOCK(m_send_mutex);
     if (m_sending_header || m_bytes_sent < m_message_to_send.data.size()) return false;
 
-    // create dbl-sha256 checksum
-    uint256 hash = Hash(msg.data);
+    // create dbl-sha256 checksum (reuse a precomputed one when fanning the
+    // same payload out to many peers)
+    uint256 hash = msg.m_hash ? *msg.m_hash : Hash(msg.data);
 
     // create header
     CMessageHeader hdr(m_magic_bytes, msg.m_type.c_str(), msg.data.size());
@@ -847,6 +858,16 @@ bool V1Transport::SetMessageToSend(CSerializedNetMsg& msg) noexcept
 
     // update state
     m_message_to_send = std::move(msg);
+    // Small payloads are appended to the header buffer so that header and
+    // payload leave in one send() call instead of two; inv/headers fan-out
+    // otherwise costs two small syscalls per message. Large payloads are not
+    // copied and are sent straight from the message buffer.
+    static constexpr size_t SEND_COALESCE_LIMIT{1024};
+    if (m_message_to_send.data.size() <= SEND_COALESCE_LIMIT) {
+        m_header_to_send.insert(m_header_to_send.end(),
+                                m_message_to_send.data.begin(), m_message_to_send.data.end());
+        ClearShrink(m_message_to_send.data);
+    }
     m_sending_header = true;
     m_bytes_sent = 0;
     return true;
@@ -1445,7 +1466,7 @@ CNetMessage V2Transport::GetReceivedMessage(std::chrono::microseconds time, bool
     if (m_recv_state == RecvState::V1) return m_v1_fallback.GetReceivedMessage(time, reject_message);
 
     Assume(m_recv_state == RecvState::APP_READY);
-    Span<const uint8_t> contents{m_recv_decode_buffer};
+    Span<const uint8_t> contents{MakeUCharSpan(m_recv_decode_buffer)};
     auto msg_type = GetMessageType(contents);
     CNetMessage msg{DataStream{}};
     // Note that BIP324Cipher::EXPANSION also includes the length descriptor size.
@@ -1455,8 +1476,11 @@ CNetMessage V2Transport::GetReceivedMessage(std::chrono::microseconds time, bool
         msg.m_type = std::move(*msg_type);
         msg.m_time = time;
         msg.m_message_size = contents.size();
-        msg.m_recv.resize(contents.size());
-        std::copy(contents.begin(), contents.end(), UCharCast(msg.m_recv.data()));
+        // Hand the decode buffer over to the message and skip the message type
+        // prefix, instead of copying the payload out.
+        const size_t type_prefix_len{m_recv_decode_buffer.size() - contents.size()};
+        msg.m_recv = DataStream{std::move(m_recv_decode_buffer)};
+        msg.m_recv.ignore(type_prefix_len);
     } else {
         LogDebug(BCLog::NET, "V2 transport error: invalid message type (%u bytes contents), peer=%d\n", m_recv_decode_buffer.size(), m_nodeid);
         reject_message = true;
@@ -1825,6 +1849,8 @@ void CConnman::CreateNodeFromAcceptedSocket(std::unique_ptr<Sock>&& sock,
                                  .prefer_evict = discouraged,
                                  .recv_flood_size = nReceiveFloodSize,
                                  .use_v2transport = use_v2transport,
+                                 .netgroup = m_netgroupman.GetGroup(addr),
+                                 .mapped_as = m_netgroupman.GetMappedAS(addr),
                              });
     pnode->AddRef();
     m_msgproc->InitializeNode(*pnode, local_services);
@@ -2074,7 +2100,12 @@ void CConnman::SocketHandler()
         // select(2)). If none are ready, wait for a short while and return
         // empty sets.
         events_per_sock = GenerateWaitSockets(snap.Nodes());
-        if (events_per_sock.empty() || !events_per_sock.begin()->first->WaitMany(timeout, events_per_sock)) {
+        if (events_per_sock.empty()) {
+            interruptNet.sleep_for(timeout);
+        } else if (!m_socket_events.WaitMany(timeout, events_per_sock) &&
+                   !events_per_sock.begin()->first->WaitMany(timeout, events_per_sock)) {
+            // The epoll engine declined (unsupported platform or mocked
+            // sockets) and the generic poll/select wait failed too.
             interruptNet.sleep_for(timeout);
         }
 
@@ -2275,10 +2306,11 @@ void CConnman::ThreadDNSAddressSeed()
         // * If we continue having problems, eventually query all the
         //   DNS seeds, and if that fails too, also try the fixed seeds.
         //   (done in ThreadOpenConnections)
-        int found = 0;
+        std::atomic<int> found{0};
         const std::chrono::seconds seeds_wait_time = (addrman.Size() >= DNSSEEDS_DELAY_PEER_THRESHOLD ? DNSSEEDS_DELAY_MANY_PEERS : DNSSEEDS_DELAY_FEW_PEERS);
 
-        for (const std::string& seed : seeds) {
+        size_t seed_idx{0};
+        while (seed_idx < seeds.size()) {
             if (seeds_right_now == 0) {
                 seeds_right_now += DNSSEEDS_TO_QUERY_AT_ONCE;
 
@@ -2295,7 +2327,7 @@ void CConnman::ThreadDNSAddressSeed()
 
                         if (GetFullOutboundConnCount() >= SEED_OUTBOUND_CONNECTION_THRESHOLD) {
                             if (found > 0) {
-                                LogPrintf("%d addresses found from DNS seeds\n", found);
+                                LogPrintf("%d addresses found from DNS seeds\n", found.load());
                                 LogPrintf("P2P peers available. Finished DNS seeding.\n");
                             } else {
                                 LogPrintf("P2P peers available. Skipped DNS seeding.\n");
@@ -2316,43 +2348,56 @@ void CConnman::ThreadDNSAddressSeed()
                 } while (!fNetworkActive);
             }
 
-            LogPrintf("Loading addresses from DNS seed %s\n", seed);
-            // If -proxy is in use, we make an ADDR_FETCH connection to the DNS resolved peer address
-            // for the base dns seed domain in chainparams
-            if (HaveNameProxy()) {
-                AddAddrFetch(seed);
-            } else {
-                std::vector<CAddress> vAdd;
-                constexpr ServiceFlags requiredServiceBits{SeedsServiceFlags()};
-                std::string host = strprintf("x%x.%s", requiredServiceBits, seed);
-                CNetAddr resolveSource;
-                if (!resolveSource.SetInternal(host)) {
+            // Resolve the current batch of seeds in parallel. Each seed's
+            // addresses are added to addrman as soon as its resolution
+            // returns, so a single slow or unresponsive seed does not delay
+            // the other results from being used for connections.
+            std::vector<std::thread> seed_threads;
+            while (seed_idx < seeds.size() && seeds_right_now > 0) {
+                const std::string& seed{seeds[seed_idx++]};
+                --seeds_right_now;
+
+                LogPrintf("Loading addresses from DNS seed %s\n", seed);
+                // If -proxy is in use, we make an ADDR_FETCH connection to the DNS resolved peer address
+                // for the base dns seed domain in chainparams
+                if (HaveNameProxy()) {
+                    AddAddrFetch(seed);
                     continue;
                 }
-                // Limit number of IPs learned from a single DNS seed. This limit exists to prevent the results from
-                // one DNS seed from dominating AddrMan. Note that the number of results from a UDP DNS query is
-                // bounded to 33 already, but it is possible for it to use TCP where a larger number of results can be
-                // returned.
-                unsigned int nMaxIPs = 32;
-                const auto addresses{LookupHost(host, nMaxIPs, true)};
-                if (!addresses.empty()) {
-                    for (const CNetAddr& ip : addresses) {
-                        CAddress addr = CAddress(CService(ip, m_params.GetDefaultPort()), requiredServiceBits);
-                        addr.nTime = rng.rand_uniform_delay(Now<NodeSeconds>() - 3 * 24h, -4 * 24h); // use a random age between 3 and 7 days old
-                        vAdd.push_back(addr);
-                        found++;
+                seed_threads.emplace_back([this, seed, &found] {
+                    FastRandomContext rng;
+                    std::vector<CAddress> vAdd;
+                    constexpr ServiceFlags requiredServiceBits{SeedsServiceFlags()};
+                    std::string host = strprintf("x%x.%s", requiredServiceBits, seed);
+                    CNetAddr resolveSource;
+                    if (!resolveSource.SetInternal(host)) {
+                        return;
                     }
-                    addrman.Add(vAdd, resolveSource);
-                } else {
-                    // If the seed does not support a subdomain with our desired service bits,
-                    // we make an ADDR_FETCH connection to the DNS resolved peer address for the
-                    // base dns seed domain in chainparams
-                    AddAddrFetch(seed);
-                }
+                    // Limit number of IPs learned from a single DNS seed. This limit exists to prevent the results from
+                    // one DNS seed from dominating AddrMan. Note that the number of results from a UDP DNS query is
+                    // bounded to 33 already, but it is possible for it to use TCP where a larger number of results can be
+                    // returned.
+                    unsigned int nMaxIPs = 32;
+                    const auto addresses{LookupHost(host, nMaxIPs, true)};
+                    if (!addresses.empty()) {
+                        for (const CNetAddr& ip : addresses) {
+                            CAddress addr = CAddress(CService(ip, m_params.GetDefaultPort()), requiredServiceBits);
+                            addr.nTime = rng.rand_uniform_delay(Now<NodeSeconds>() - 3 * 24h, -4 * 24h); // use a random age between 3 and 7 days old
+                            vAdd.push_back(addr);
+                        }
+                        found += vAdd.size();
+                        addrman.Add(vAdd, resolveSource);
+                    } else {
+                        // If the seed does not support a subdomain with our desired service bits,
+                        // we make an ADDR_FETCH connection to the DNS resolved peer address for the
+                        // base dns seed domain in chainparams
+                        AddAddrFetch(seed);
+                    }
+                });
             }
-            --seeds_right_now;
+            for (auto& thread : seed_threads) thread.join();
         }
-        LogPrintf("%d addresses found from DNS seeds\n", found);
+        LogPrintf("%d addresses found from DNS seeds\n", found.load());
     } else {
         LogPrintf("Skipping DNS seeds. Enough peers have been found\n");
     }
@@ -2475,7 +2520,7 @@ bool CConnman::MultipleManualOrFullOutboundConns(Network net) const
 bool CConnman::MaybePickPreferredNetwork(std::optional<Network>& network)
 {
     std::array<Network, 5> nets{NET_IPV4, NET_IPV6, NET_ONION, NET_I2P, NET_CJDNS};
-    std::shuffle(nets.begin(), nets.end(), FastRandomContext());
+    std::shuffle(nets.begin(), nets.end(), ThreadLocalRng());
 
     LOCK(m_nodes_mutex);
     for (const auto net : nets) {
@@ -2612,6 +2657,27 @@ void CConnman::ThreadOpenConnections(const std::vector<std::string> connect, Spa
         int nOutboundBlockRelay = 0;
         int outbound_privacy_network_peers = 0;
         std::set<std::vector<unsigned char>> outbound_ipv46_peer_netgroups;
+        std::set<CService> pending_dial_services;
+
+        // Dials that are queued or in flight on the dialer threads have not
+        // produced a CNode yet, so account for them here the same way as
+        // established connections to avoid over-connecting or selecting a
+        // duplicate address/netgroup.
+        {
+            LOCK(m_dial_mutex);
+            for (const PendingDial& pending : m_pending_dials) {
+                if (pending.conn_type == ConnectionType::OUTBOUND_FULL_RELAY) nOutboundFullRelay++;
+                if (pending.conn_type == ConnectionType::BLOCK_RELAY) nOutboundBlockRelay++;
+                if (pending.conn_type != ConnectionType::FEELER) {
+                    if (pending.netgroup.empty()) {
+                        ++outbound_privacy_network_peers;
+                    } else {
+                        outbound_ipv46_peer_netgroups.insert(pending.netgroup);
+                    }
+                }
+                pending_dial_services.insert(pending.service);
+            }
+        }
 
         {
             LOCK(m_nodes_mutex);
@@ -2644,7 +2710,7 @@ void CConnman::ThreadOpenConnections(const std::vector<std::string> connect, Spa
                             // these networks.
                             ++outbound_privacy_network_peers;
                         } else {
-                            outbound_ipv46_peer_netgroups.insert(m_netgroupman.GetGroup(address));
+                            outbound_ipv46_peer_netgroups.insert(pnode->m_netgroup);
                         }
                 } // no default case, so the compiler can warn about missing cases
             }
@@ -2740,7 +2806,8 @@ void CConnman::ThreadOpenConnections(const std::vector<std::string> connect, Spa
                 m_anchors.pop_back();
                 if (!addr.IsValid() || IsLocal(addr) || !g_reachable_nets.Contains(addr) ||
                     !m_msgproc->HasAllDesirableServiceFlags(addr.nServices) ||
-                    outbound_ipv46_peer_netgroups.count(m_netgroupman.GetGroup(addr))) continue;
+                    outbound_ipv46_peer_netgroups.count(m_netgroupman.GetGroup(addr)) ||
+                    pending_dial_services.count(addr)) continue;
                 addrConnect = addr;
                 LogDebug(BCLog::NET, "Trying to make an anchor connection to %s\n", addrConnect.ToStringAddrPort());
                 break;
@@ -2790,6 +2857,11 @@ void CConnman::ThreadOpenConnections(const std::vector<std::string> connect, Spa
                 continue;
             }
 
+            // Skip addresses a dialer thread is already connecting to.
+            if (pending_dial_services.count(addr)) {
+                continue;
+            }
+
             // if we selected an invalid or local address, restart
             if (!addr.IsValid() || IsLocal(addr)) {
                 break;
@@ -2851,7 +2923,61 @@ void CConnman::ThreadOpenConnections(const std::vector<std::string> connect, Spa
             const bool count_failures{((int)outbound_ipv46_peer_netgroups.size() + outbound_privacy_network_peers) >= std::min(m_max_automatic_connections - 1, 2)};
             // Use BIP324 transport when both us and them have NODE_V2_P2P set.
             const bool use_v2transport(addrConnect.nServices & GetLocalServices() & NODE_P2P_V2);
-            OpenNetworkConnection(addrConnect, count_failures, std::move(grant), /*strDest=*/nullptr, conn_type, use_v2transport);
+
+            // Hand the dial off to a dialer thread, so a slow or timing-out
+            // connect does not stall the selection of further outbound
+            // connections. The semaphore grant travels with the job, keeping
+            // the total of established plus in-flight outbound connections
+            // bounded by semOutbound.
+            {
+                LOCK(m_dial_mutex);
+                const CAddress& address{addrConnect};
+                std::vector<unsigned char> netgroup;
+                if (!address.IsTor() && !address.IsI2P() && !address.IsCJDNS()) {
+                    netgroup = m_netgroupman.GetGroup(address);
+                }
+                m_pending_dials.push_back(PendingDial{
+                    .service = addrConnect,
+                    .netgroup = std::move(netgroup),
+                    .conn_type = conn_type,
+                });
+                m_dial_queue.push_back(DialJob{
+                    .addr = addrConnect,
+                    .count_failures = count_failures,
+                    .grant = std::move(grant),
+                    .conn_type = conn_type,
+                    .use_v2transport = use_v2transport,
+                });
+            }
+            m_dial_cv.notify_one();
+        }
+    }
+}
+
+void CConnman::ThreadOpenConnectionsDialer()
+{
+    AssertLockNotHeld(m_unused_i2p_sessions_mutex);
+    while (!interruptNet) {
+        DialJob job;
+        {
+            WAIT_LOCK(m_dial_mutex, lock);
+            m_dial_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_dial_mutex) {
+                return interruptNet || !m_dial_queue.empty();
+            });
+            if (interruptNet) return;
+            job = std::move(m_dial_queue.front());
+            m_dial_queue.pop_front();
+        }
+
+        OpenNetworkConnection(job.addr, job.count_failures, std::move(job.grant), /*strDest=*/nullptr, job.conn_type, job.use_v2transport);
+
+        // Whether the connect succeeded or failed, the dial is no longer
+        // pending: on success the new CNode is in m_nodes and counted there.
+        {
+            LOCK(m_dial_mutex);
+            m_pending_dials.erase(std::remove_if(m_pending_dials.begin(), m_pending_dials.end(),
+                                                 [&](const PendingDial& pending) { return pending.service == static_cast<const CService&>(job.addr); }),
+                                  m_pending_dials.end());
         }
     }
 }
@@ -3284,7 +3410,7 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
     // Randomize the order in which we may query seednode to potentially prevent connecting to the same one every restart (and signal that we have restarted)
     std::vector<std::string> seed_nodes = connOptions.vSeedNodes;
     if (!seed_nodes.empty()) {
-        std::shuffle(seed_nodes.begin(), seed_nodes.end(), FastRandomContext{});
+        std::shuffle(seed_nodes.begin(), seed_nodes.end(), ThreadLocalRng());
     }
 
     if (m_use_addrman_outgoing) {
@@ -3346,6 +3472,12 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
         threadOpenConnections = std::thread(
             &util::TraceThread, "opencon",
             [this, connect = connOptions.m_specified_outgoing, seed_nodes = std::move(seed_nodes)] { ThreadOpenConnections(connect, seed_nodes); });
+        // Dialer threads performing the blocking connects for automatic
+        // outbound connections, so several can be in flight at once.
+        const int num_dialers{std::clamp(m_max_automatic_outbound, 1, 4)};
+        for (int i = 0; i < num_dialers; ++i) {
+            m_dialer_threads.emplace_back(&util::TraceThread, strprintf("dialer%i", i), [this] { ThreadOpenConnectionsDialer(); });
+        }
     }
 
     // Process messages
@@ -3357,7 +3489,7 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
     }
 
     // Dump network addresses
-    scheduler.scheduleEvery([this] { DumpAddresses(); }, DUMP_PEERS_INTERVAL);
+    scheduler.scheduleEvery([this] { DumpAddresses(); }, DUMP_PEERS_INTERVAL, CScheduler::Priority::BACKGROUND);
 
     // Run the ASMap Health check once and then schedule it to run every 24h.
     if (m_netgroupman.UsingASMap()) {
@@ -3393,6 +3525,7 @@ void CConnman::Interrupt()
 
     interruptNet();
     g_socks5_interrupt();
+    m_dial_cv.notify_all();
 
     if (semOutbound) {
         for (int i=0; i<m_max_automatic_outbound; i++) {
@@ -3416,6 +3549,10 @@ void CConnman::StopThreads()
         threadMessageHandler.join();
     if (threadOpenConnections.joinable())
         threadOpenConnections.join();
+    for (auto& dialer_thread : m_dialer_threads) {
+        if (dialer_thread.joinable()) dialer_thread.join();
+    }
+    m_dialer_threads.clear();
     if (threadOpenAddedConnections.joinable())
         threadOpenAddedConnections.join();
     if (threadDNSAddressSeed.joinable())
@@ -3522,11 +3659,24 @@ std::vector<CAddress> CConnman::GetAddresses(CNode& requestor, size_t max_addres
         // max. 24 hours of "penalty" due to cache shouldn't make any meaningful difference
         // in terms of the freshness of the response.
         cache_entry.m_cache_entry_expiration = current_time +
-            21h + FastRandomContext().randrange<std::chrono::microseconds>(6h);
+            21h + ThreadLocalRng().randrange<std::chrono::microseconds>(6h);
     }
     return cache_entry.m_addrs_response_cache;
 }
 
+std::vector<CAddress> CConnman::GetAddressesSnapshot(std::optional<Network> network) const
+{
+    static constexpr auto ADDR_SNAPSHOT_LIFETIME{1min};
+    const auto current_time = GetTime<std::chrono::microseconds>();
+    LOCK(m_addr_snapshot_mutex);
+    CachedAddrResponse& snapshot = m_addr_snapshots[network];
+    if (snapshot.m_cache_entry_expiration < current_time) { // A newly inserted entry has expiration 0.
+        snapshot.m_addrs_response_cache = GetAddresses(/*max_addresses=*/0, /*max_pct=*/0, network);
+        snapshot.m_cache_entry_expiration = current_time + ADDR_SNAPSHOT_LIFETIME;
+    }
+    return snapshot.m_addrs_response_cache;
+}
+
 bool CConnman::AddNode(const AddedNodeParams& add)
 {
     const CService resolved(LookupNumeric(add.m_added_node, GetDefaultPort(add.m_added_node)));
@@ -3595,12 +3745,16 @@ uint32_t CConnman::GetMappedAS(const CNetAddr& addr) const
 void CConnman::GetNodeStats(std::vector<CNodeStats>& vstats) const
 {
     vstats.clear();
-    LOCK(m_nodes_mutex);
-    vstats.reserve(m_nodes.size());
-    for (CNode* pnode : m_nodes) {
+    // Take a snapshot of the nodes (holding m_nodes_mutex only for the copy of
+    // the pointer vector) and gather the per-peer stats outside the lock, so
+    // that stats collection over a large peer count does not stall the socket
+    // and message handler threads.
+    const NodesSnapshot snap{*this, /*shuffle=*/false};
+    vstats.reserve(snap.Nodes().size());
+    for (CNode* pnode : snap.Nodes()) {
         vstats.emplace_back();
         pnode->CopyStats(vstats.back());
-        vstats.back().m_mapped_as = GetMappedAS(pnode->addr);
+        vstats.back().m_mapped_as = pnode->m_mapped_as;
     }
 }
 
@@ -3782,6 +3936,8 @@ CNode::CNode(NodeId idIn,
       m_inbound_onion{inbound_onion},
       m_prefer_evict{node_opts.prefer_evict},
       nKeyedNetGroup{nKeyedNetGroupIn},
+      m_netgroup{std::move(node_opts.netgroup)},
+      m_mapped_as{node_opts.mapped_as},
       m_conn_type{conn_type_in},
       id{idIn},
       nLocalHostNonce{nLocalHostNonceIn},
@@ -3842,6 +3998,7 @@ void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
 {
     AssertLockNotHeld(m_total_bytes_sent_mutex);
     size_t nMessageSize = msg.data.size();
+    alloc_profile::Record(alloc_profile::Tag::NET, nMessageSize);
     LogDebug(BCLog::NET, "sending %s (%d bytes) peer=%d\n", msg.m_type, nMessageSize, pnode->GetId());
     if (gArgs.GetBoolArg("-capturemessages", false)) {
         CaptureMessage(pnode->addr, msg.m_type, msg.data, /*is_incoming=*/false);
@@ -124,11 +124,19 @@ struct CSerializedNetMsg {
         CSerializedNetMsg copy;
         copy.data = data;
         copy.m_type = m_type;
+        copy.m_hash = m_hash;
         return copy;
     }
 
+    /** Compute and remember the payload hash, so that fanning the same
+     *  message out to many peers does not recompute the V1 wire checksum per
+     *  peer. Copies made afterwards share the result. */
+    void PrecomputeHash();
+
     std::vector<unsigned char> data;
     std::string m_type;
+    /** Double-SHA256 of data, if already computed (see PrecomputeHash()). */
+    std::optional<uint256> m_hash;
 
     /** Compute total memory usage of this object (own memory + any dynamic memory). */
     size_t GetMemoryUsage() const noexcept;
@@ -206,6 +214,8 @@ public:
     NetPermissionFlags m_permission_flags;
     std::chrono::microseconds m_last_ping_time;
     std::chrono::microseconds m_min_ping_time;
+    std::chrono::microseconds m_smoothed_ping_time;
+    std::chrono::microseconds m_ping_time_jitter;
     // Our address, as reported by the peer
     std::string addrLocal;
     // Address of this peer
@@ -590,8 +600,10 @@ private:
     std::vector<uint8_t> m_recv_buffer GUARDED_BY(m_recv_mutex);
     /** AAD expected in next received packet (currently used only for garbage). */
     std::vector<uint8_t> m_recv_aad GUARDED_BY(m_recv_mutex);
-    /** Buffer to put decrypted contents in, for converting to CNetMessage. */
-    std::vector<uint8_t> m_recv_decode_buffer GUARDED_BY(m_recv_mutex);
+    /** Buffer to put decrypted contents in. Stored as SerializeData so that a
+     *  complete application message can be handed to the CNetMessage without
+     *  copying the payload. */
+    SerializeData m_recv_decode_buffer GUARDED_BY(m_recv_mutex);
     /** Current receiver state. */
     RecvState m_recv_state GUARDED_BY(m_recv_mutex);
 
@@ -666,6 +678,8 @@ struct CNodeOptions
     bool prefer_evict = false;
     size_t recv_flood_size{DEFAULT_MAXRECEIVEBUFFER * 1000};
     bool use_v2transport = false;
+    std::vector<unsigned char> netgroup{};
+    uint32_t mapped_as{0};
 };
 
 /** Information about a peer */
@@ -733,6 +747,12 @@ public:
     std::atomic<int> nRefCount{0};
 
     const uint64_t nKeyedNetGroup;
+    /** Netgroup (asmap-aware) of this peer's address, computed once at
+     *  connect time so hot paths don't repeat the asmap trie walk. */
+    const std::vector<unsigned char> m_netgroup;
+    /** Mapped AS of this peer's address. 0 when no asmap is loaded or the
+     *  address is not mappable (e.g. Tor). */
+    const uint32_t m_mapped_as;
     std::atomic_bool fPauseRecv{false};
     std::atomic_bool fPauseSend{false};
 
@@ -878,6 +898,15 @@ public:
      * criterium in CConnman::AttemptToEvictConnection. */
     std::atomic<std::chrono::microseconds> m_min_ping_time{std::chrono::microseconds::max()};
 
+    /** Exponentially weighted round-trip time estimate (TCP SRTT, new
+     * samples weighted 1/8). Zero until the first pong. Used to scale the
+     * block-download stalling deadline to the peer's latency. */
+    std::atomic<std::chrono::microseconds> m_smoothed_ping_time{0us};
+
+    /** Mean deviation of the round-trip time around m_smoothed_ping_time
+     * (TCP RTTVAR, new samples weighted 1/4). */
+    std::atomic<std::chrono::microseconds> m_ping_time_jitter{0us};
+
     CNode(NodeId id,
           std::shared_ptr<Sock> sock,
           const CAddress& addrIn,
@@ -963,10 +992,24 @@ public:
      */
     std::string DisconnectMsg(bool log_ip) const;
 
-    /** A ping-pong round trip has completed successfully. Update latest and minimum ping times. */
+    /** A ping-pong round trip has completed successfully. Update latest, minimum and smoothed ping times. */
     void PongReceived(std::chrono::microseconds ping_time) {
         m_last_ping_time = ping_time;
         m_min_ping_time = std::min(m_min_ping_time.load(), ping_time);
+        // Jacobson/Karels smoothing, as in TCP: srtt += (rtt - srtt) / 8,
+        // rttvar += (|rtt - srtt| - rttvar) / 4. Only the message handler
+        // thread writes these; readers may see srtt and jitter from
+        // different samples, which is fine for timeout scaling.
+        const auto srtt{m_smoothed_ping_time.load()};
+        if (srtt == 0us) {
+            m_smoothed_ping_time = ping_time;
+            m_ping_time_jitter = ping_time / 2;
+        } else {
+            const auto err{ping_time - srtt};
+            m_smoothed_ping_time = srtt + err / 8;
+            const auto jitter{m_ping_time_jitter.load()};
+            m_ping_time_jitter = jitter + ((err < 0us ? -err : err) - jitter) / 4;
+        }
     }
 
 private:
@@ -1183,6 +1226,13 @@ public:
      * call the function without a parameter to avoid using the cache.
      */
     std::vector<CAddress> GetAddresses(CNode& requestor, size_t max_addresses, size_t max_pct);
+    /**
+     * Return all known addresses for a network from a periodically refreshed
+     * snapshot. Meant for frequent local callers (e.g. the getnodeaddresses
+     * RPC) so polling does not contend with address relay for addrman's lock;
+     * results may be up to the snapshot lifetime stale.
+     */
+    std::vector<CAddress> GetAddressesSnapshot(std::optional<Network> network) const;
 
     // This allows temporarily exceeding m_max_outbound_full_relay, with the goal of finding
     // a peer that is better than all our current peers.
@@ -1297,7 +1347,8 @@ private:
     void ThreadOpenAddedConnections() EXCLUSIVE_LOCKS_REQUIRED(!m_added_nodes_mutex, !m_unused_i2p_sessions_mutex, !m_reconnections_mutex);
     void AddAddrFetch(const std::string& strDest) EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex);
     void ProcessAddrFetch() EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_unused_i2p_sessions_mutex);
-    void ThreadOpenConnections(std::vector<std::string> connect, Span<const std::string> seed_nodes) EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_added_nodes_mutex, !m_nodes_mutex, !m_unused_i2p_sessions_mutex, !m_reconnections_mutex);
+    void ThreadOpenConnections(std::vector<std::string> connect, Span<const std::string> seed_nodes) EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_added_nodes_mutex, !m_nodes_mutex, !m_unused_i2p_sessions_mutex, !m_reconnections_mutex, !m_dial_mutex);
+    void ThreadOpenConnectionsDialer() EXCLUSIVE_LOCKS_REQUIRED(!m_unused_i2p_sessions_mutex, !m_dial_mutex);
     void ThreadMessageHandler() EXCLUSIVE_LOCKS_REQUIRED(!mutexMsgProc);
     void ThreadI2PAcceptIncoming();
     void AcceptConnection(const ListenSocket& hListenSocket);
@@ -1327,6 +1378,14 @@ private:
      */
     Sock::EventsPerSock GenerateWaitSockets(Span<CNode* const> nodes);
 
+    /**
+     * Persistent epoll-backed event engine used by SocketHandler(); keeps the
+     * steady-state wait O(active sockets) instead of re-submitting the whole
+     * interest set to poll(2) every iteration. Only touched by the socket
+     * handler thread.
+     */
+    EpollSocketEvents m_socket_events;
+
     /**
      * Check connected and listening sockets for IO readiness and process them accordingly.
      */
@@ -1478,6 +1537,15 @@ private:
      */
     std::map<uint64_t, CachedAddrResponse> m_addr_response_caches;
 
+    /**
+     * Per-network address snapshots served to local callers through
+     * GetAddressesSnapshot(). Unlike m_addr_response_caches this is not a
+     * privacy measure, only a way to keep frequent monitoring queries off
+     * addrman's lock, so the lifetime is short.
+     */
+    mutable Mutex m_addr_snapshot_mutex;
+    mutable std::map<std::optional<Network>, CachedAddrResponse> m_addr_snapshots GUARDED_BY(m_addr_snapshot_mutex);
+
     /**
      * Services this node offers.
      *
@@ -1555,12 +1623,42 @@ private:
      */
     std::unique_ptr<i2p::sam::Session> m_i2p_sam_session;
 
+    /** A dial job: one automatic outbound connection for a dialer thread to
+     *  establish. Holds its semOutbound grant, so the number of queued plus
+     *  in-flight dials never exceeds the outbound semaphore. */
+    struct DialJob {
+        CAddress addr;
+        bool count_failures{false};
+        CSemaphoreGrant grant;
+        ConnectionType conn_type{ConnectionType::OUTBOUND_FULL_RELAY};
+        bool use_v2transport{false};
+    };
+
+    /** Bookkeeping for a dial that is queued or in progress, so that the
+     *  address selection loop does not pick the same address or netgroup a
+     *  second time while the connect is still in flight. */
+    struct PendingDial {
+        CService service;
+        std::vector<unsigned char> netgroup; //!< empty for Tor/I2P/CJDNS peers
+        ConnectionType conn_type{ConnectionType::OUTBOUND_FULL_RELAY};
+    };
+
+    std::condition_variable m_dial_cv;
+    Mutex m_dial_mutex;
+    /** Dials queued by ThreadOpenConnections, consumed by the dialer threads. */
+    std::deque<DialJob> m_dial_queue GUARDED_BY(m_dial_mutex);
+    /** Entries cover both queued jobs and dials currently being connected. */
+    std::vector<PendingDial> m_pending_dials GUARDED_BY(m_dial_mutex);
+
     std::thread threadDNSAddressSeed;
     std::thread threadSocketHandler;
     std::thread threadOpenAddedConnections;
     std::thread threadOpenConnections;
     std::thread threadMessageHandler;
     std::thread threadI2PAcceptIncoming;
+    /** Dialer threads running the blocking connects for automatic outbound
+     *  connections, so several can be established in parallel. */
+    std::vector<std::thread> m_dialer_threads;
 
     /** flag for deciding to connect to an extra outbound peer,
      *  in excess of m_max_outbound_full_relay
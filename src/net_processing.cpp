@@ -23,6 +23,7 @@
 #include <netbase.h>
 #include <netmessagemaker.h>
 #include <node/blockstorage.h>
+#include <node/blockview.h>
 #include <node/timeoffsets.h>
 #include <node/txdownloadman.h>
 #include <node/txreconciliation.h>
@@ -41,6 +42,7 @@
 #include <txorphanage.h>
 #include <txrequest.h>
 #include <util/check.h>
+#include <util/hasher.h>
 #include <util/strencodings.h>
 #include <util/time.h>
 #include <util/trace.h>
@@ -48,11 +50,14 @@
 
 #include <algorithm>
 #include <atomic>
+#include <deque>
 #include <future>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <set>
 #include <typeinfo>
+#include <unordered_set>
 #include <utility>
 
 using namespace util::hex_literals;
@@ -65,6 +70,19 @@ static constexpr auto HEADERS_DOWNLOAD_TIMEOUT_BASE = 15min;
 static constexpr auto HEADERS_DOWNLOAD_TIMEOUT_PER_HEADER = 1ms;
 /** How long to wait for a peer to respond to a getheaders request */
 static constexpr auto HEADERS_RESPONSE_TIME{2min};
+/** How long a header hash stays in the recently-verified-PoW set, during which
+ *  duplicate announcements of the same header skip the TensHash evaluation. */
+static constexpr auto RECENT_POW_HEADERS_TTL{1min};
+/** Maximum number of entries in the recently-verified-PoW set. */
+static constexpr size_t MAX_RECENT_POW_HEADERS{10000};
+/** Number of successor blocks hinted for OS read-ahead when serving a block
+ *  from disk, since syncing peers request blocks in height order. */
+static constexpr int GETDATA_BLOCK_READAHEAD{8};
+/** Number of peers to actively sync headers from during initial headers
+ *  download. Each runs its own presync/redownload state machine, so a single
+ *  slow peer cannot stall the headers phase; the redundant bandwidth and
+ *  (pooled) proof-of-work verification are bounded by this factor. */
+static constexpr int MAX_CONCURRENT_HEADERS_SYNC_PEERS{3};
 /** Protect at least this many outbound peers from disconnection due to slow/
  * behind headers chain.
  */
@@ -87,6 +105,12 @@ static constexpr int STALE_RELAY_AGE_LIMIT = 30 * 24 * 60 * 60;
 static constexpr int HISTORICAL_BLOCK_AGE = 7 * 24 * 60 * 60;
 /** Time between pings automatically sent out for latency probing and keepalive */
 static constexpr auto PING_INTERVAL{2min};
+/** Sentinel for Peer::m_next_send_wake while a full SendMessages() pass is
+ *  recomputing the peer's wake time */
+static constexpr std::chrono::microseconds SEND_WAKE_RECOMPUTE{1};
+/** Upper bound on how long SendMessages() may skip a quiescent peer, so that
+ *  state only examined by a full pass is still checked regularly */
+static constexpr auto MAX_SEND_WAKE_INTERVAL{1s};
 /** The maximum number of entries in a locator */
 static const unsigned int MAX_LOCATOR_SZ = 101;
 /** The maximum number of entries in an 'inv' protocol message */
@@ -95,14 +119,24 @@ static const unsigned int MAX_INV_SZ = 50000;
 static const unsigned int MAX_GETDATA_SZ = 1000;
 /** Number of blocks that can be requested at any given time from a single peer. */
 static const int MAX_BLOCKS_IN_TRANSIT_PER_PEER = 16;
+/** Weight of each new sample in the per-peer block delivery rate EWMA. */
+static constexpr double BLOCK_DELIVERY_EWMA_WEIGHT{0.25};
+/** Minimum number of in-flight blocks granted to a peer measured much slower than our best peer. */
+static constexpr int MIN_BLOCKS_IN_TRANSIT_SLOW_PEER{2};
 /** Default time during which a peer must stall block download progress before being disconnected.
  * the actual timeout is increased temporarily if peers are disconnected for hitting the timeout */
 static constexpr auto BLOCK_STALLING_TIMEOUT_DEFAULT{2s};
 /** Maximum timeout for stalling block download. */
 static constexpr auto BLOCK_STALLING_TIMEOUT_MAX{64s};
+/** Floor for the per-peer stalling timeout when a peer's measured round-trip
+ *  time supports a deadline tighter than the default. */
+static constexpr auto BLOCK_STALLING_TIMEOUT_MIN{500ms};
 /** Maximum depth of blocks we're willing to serve as compact blocks to peers
  *  when requested. For older blocks, a regular BLOCK response will be sent. */
 static const int MAX_CMPCTBLOCK_DEPTH = 5;
+/** Maximum number of extra transaction bytes to prefill in an outbound compact
+ *  block for transactions the receiving peer likely lacks. */
+static const unsigned int MAX_CMPCTBLOCK_PREFILL_BYTES = 10000;
 /** Maximum depth of blocks we're willing to respond to GETBLOCKTXN requests for. */
 static const int MAX_BLOCKTXN_DEPTH = 10;
 static_assert(MAX_BLOCKTXN_DEPTH <= MIN_BLOCKS_TO_KEEP, "MAX_BLOCKTXN_DEPTH too high");
@@ -173,6 +207,8 @@ struct QueuedBlock {
     const CBlockIndex* pindex;
     /** Optional, used for CMPCTBLOCK downloads */
     std::unique_ptr<PartiallyDownloadedBlock> partialBlock;
+    /** When this block was requested, used to measure the peer's delivery rate. */
+    std::chrono::microseconds m_requested_at{0us};
 };
 
 /**
@@ -245,6 +281,15 @@ struct Peer {
     /** Whether a ping has been requested by the user */
     std::atomic<bool> m_ping_queued{false};
 
+    /** Earliest time at which SendMessages() may again have timer-driven work
+     *  for this peer, as computed by its last full pass, or a time in the
+     *  past to force a full pass. Cleared by any thread that queues send-side
+     *  work for this peer; lets the message handler skip idle peers. */
+    std::atomic<std::chrono::microseconds> m_next_send_wake{0us};
+    /** Value of PeerManagerImpl::m_send_event_counter observed by this peer's
+     *  last full SendMessages() pass */
+    uint64_t m_send_events_seen GUARDED_BY(NetEventsInterface::g_msgproc_mutex){0};
+
     /** Whether this peer relays txs via wtxid */
     std::atomic<bool> m_wtxid_relay{false};
     /** The feerate in the most recent BIP133 `feefilter` message sent to the peer.
@@ -339,6 +384,9 @@ struct Peer {
     /** Whether the peer has signaled support for receiving ADDRv2 (BIP155)
      *  messages, indicating a preference to receive ADDRv2 instead of ADDR ones. */
     std::atomic_bool m_wants_addrv2{false};
+    /** Whether the peer has signaled support for receiving getheaders
+     *  responses in the compressed "hdrscomp" encoding. */
+    std::atomic_bool m_wants_hdrs_comp{false};
     /** Whether this peer has already sent us a getaddr message. */
     bool m_getaddr_recvd GUARDED_BY(NetEventsInterface::g_msgproc_mutex){false};
     /** Number of addresses that can be processed from this peer. Start at 1 to
@@ -359,6 +407,10 @@ struct Peer {
     /** Work queue of items requested by this peer **/
     std::deque<CInv> m_getdata_requests GUARDED_BY(m_getdata_requests_mutex);
 
+    /** Highest block height already hinted for OS read-ahead while serving
+     *  this peer's sequential block requests. */
+    int m_block_prefetch_height GUARDED_BY(NetEventsInterface::g_msgproc_mutex){0};
+
     /** Time of the last getheaders message to this peer */
     NodeClock::time_point m_last_getheaders_timestamp GUARDED_BY(NetEventsInterface::g_msgproc_mutex){};
 
@@ -418,6 +470,8 @@ struct CNodeState {
     std::list<QueuedBlock> vBlocksInFlight;
     //! When the first entry in vBlocksInFlight started downloading. Don't care when vBlocksInFlight is empty.
     std::chrono::microseconds m_downloading_since{0us};
+    //! EWMA of this peer's block delivery rate in bytes per second, 0 until the first delivered block.
+    double m_block_bytes_per_sec{0.0};
     //! Whether we consider this a preferred download peer.
     bool fPreferredDownload{false};
     /** Whether this peer wants invs or cmpctblocks (when possible) for block announcements. */
@@ -567,12 +621,12 @@ private:
     bool MaybeDiscourageAndDisconnect(CNode& pnode, Peer& peer);
 
     /** Handle a transaction whose result was not MempoolAcceptResult::ResultType::VALID.
-     * @param[in]   first_time_failure            Whether we should consider inserting into vExtraTxnForCompact, adding
+     * @param[in]   first_time_failure            Whether we should consider inserting into m_extra_txn_for_compact, adding
      *                                            a new orphan to resolve, or looking for a package to submit.
      *                                            Set to true for transactions just received over p2p.
      *                                            Set to false if the tx has already been rejected before,
      *                                            e.g. is already in the orphanage, to avoid adding duplicate entries.
-     * Updates m_txrequest, m_lazy_recent_rejects, m_lazy_recent_rejects_reconsiderable, m_orphanage, and vExtraTxnForCompact.
+     * Updates m_txrequest, m_lazy_recent_rejects, m_lazy_recent_rejects_reconsiderable, m_orphanage, and m_extra_txn_for_compact.
      *
      * @returns a PackageToValidate if this transaction has a reconsiderable failure and an eligible package was found,
      * or std::nullopt otherwise.
@@ -582,7 +636,7 @@ private:
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, g_msgproc_mutex, m_tx_download_mutex);
 
     /** Handle a transaction whose result was MempoolAcceptResult::ResultType::VALID.
-     * Updates m_txrequest, m_orphanage, and vExtraTxnForCompact. Also queues the tx for relay. */
+     * Updates m_txrequest, m_orphanage, and m_extra_txn_for_compact. Also queues the tx for relay. */
     void ProcessValidTx(NodeId nodeid, const CTransactionRef& tx, const std::list<CTransactionRef>& replaced_transactions)
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, g_msgproc_mutex, m_tx_download_mutex);
 
@@ -619,7 +673,7 @@ private:
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_headers_presync_mutex, g_msgproc_mutex);
     /** Various helpers for headers processing, invoked by ProcessHeadersMessage() */
     /** Return true if headers are continuous and have valid proof-of-work (DoS points assigned on failure) */
-    bool CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer);
+    bool CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer) EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex);
     /** Calculate an anti-DoS work threshold for headers chains */
     arith_uint256 GetAntiDoSWorkThreshold();
     /** Deal with state tracking and headers sync for peers that send
@@ -772,6 +826,11 @@ private:
      */
     std::map<NodeId, PeerRef> m_peer_map GUARDED_BY(m_peer_mutex);
 
+    /** Incremented on node-wide events (tip updates) that can create
+     *  send-side work for every peer; invalidates all cached
+     *  Peer::m_next_send_wake times. */
+    std::atomic<uint64_t> m_send_event_counter{1};
+
     /** Map maintaining per-node state. */
     std::map<NodeId, CNodeState> m_node_states GUARDED_BY(cs_main);
 
@@ -790,6 +849,20 @@ private:
     /** Hash of the last block we received via INV */
     uint256 m_last_block_inv_triggering_headers_sync GUARDED_BY(g_msgproc_mutex){};
 
+    /** Header hashes whose proof-of-work was verified within
+     *  RECENT_POW_HEADERS_TTL. A block announced by many peers at once leads
+     *  each announcement through CheckHeadersPoW() before the duplicate is
+     *  detected under cs_main; this set lets the repeats skip the expensive
+     *  TensHash evaluation. The header hash commits to the entire header, so
+     *  an exact-match hit cannot have different proof-of-work. */
+    std::unordered_set<uint256, BlockHasher> m_recent_pow_headers GUARDED_BY(g_msgproc_mutex);
+    /** Insertion-ordered queue used to expire m_recent_pow_headers entries. */
+    std::deque<std::pair<SteadyClock::time_point, uint256>> m_recent_pow_headers_order GUARDED_BY(g_msgproc_mutex);
+    /** Number of headers whose proof-of-work was evaluated. */
+    uint64_t m_pow_headers_checked GUARDED_BY(g_msgproc_mutex){0};
+    /** Number of headers skipped as recently verified. */
+    uint64_t m_pow_headers_deduped GUARDED_BY(g_msgproc_mutex){0};
+
     /**
      * Sources of received blocks, saved to be able punish them when processing
      * happens afterwards.
@@ -863,6 +936,11 @@ private:
      */
     void RemoveBlockRequest(const uint256& hash, std::optional<NodeId> from_peer) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+    /** Fold a delivered block into the peer's block delivery rate EWMA, if the
+     * block was in flight from that peer. Must be called before the request is
+     * removed from mapBlocksInFlight. */
+    void RecordBlockDelivery(NodeId nodeid, const uint256& hash, size_t block_bytes) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
     /* Mark a block as in flight
      * Returns false, still setting pit, if the block was already in flight from the same peer
      * pit will only be valid as long as the same cs_main lock is being held
@@ -938,6 +1016,15 @@ private:
      */
     void MaybeSetPeerAsAnnouncingHeaderAndIDs(NodeId nodeid) EXCLUSIVE_LOCKS_REQUIRED(cs_main, !m_peer_mutex);
 
+    /**
+     * Pick block transactions worth prefilling in a compact block announcement
+     * to the given peer, because the peer has probably never seen them and a
+     * short ID would just earn us a GETBLOCKTXN round trip. Returns sorted
+     * indexes into block.vtx, never including the coinbase, with the total
+     * transaction size capped at MAX_CMPCTBLOCK_PREFILL_BYTES.
+     */
+    std::vector<uint16_t> SelectCompactBlockPrefill(const CBlock& block, NodeId nodeid) EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
+
     /** Stack of nodes which we have set to announce using compact blocks */
     std::list<NodeId> lNodesAnnouncingHeaderAndIDs GUARDED_BY(cs_main);
 
@@ -946,12 +1033,17 @@ private:
 
     void AddToCompactExtraTransactions(const CTransactionRef& tx) EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex);
 
-    /** Orphan/conflicted/etc transactions that are kept for compact block reconstruction.
-     *  The last -blockreconstructionextratxn/DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN of
-     *  these are kept in a ring buffer */
-    std::vector<CTransactionRef> vExtraTxnForCompact GUARDED_BY(g_msgproc_mutex);
-    /** Offset into vExtraTxnForCompact to insert the next tx */
-    size_t vExtraTxnForCompactIt GUARDED_BY(g_msgproc_mutex) = 0;
+    /** Orphan/conflicted/etc transactions that are kept for compact block
+     *  reconstruction, oldest first. Deduplicated by wtxid and bounded by
+     *  total dynamic memory usage (-blockreconstructionextratxn scaled by
+     *  EXTRA_TXN_TYPICAL_USAGE) rather than by transaction count, so a few
+     *  large transactions cannot blow up the pool's footprint and small ones
+     *  do not waste budget. */
+    std::deque<CTransactionRef> m_extra_txn_for_compact GUARDED_BY(g_msgproc_mutex);
+    /** Wtxids of the transactions in m_extra_txn_for_compact. */
+    std::set<Wtxid> m_extra_txn_wtxids GUARDED_BY(g_msgproc_mutex);
+    /** Total dynamic usage of the transactions in m_extra_txn_for_compact. */
+    size_t m_extra_txn_usage GUARDED_BY(g_msgproc_mutex){0};
 
     /** Check whether the last unknown block a peer advertised is not yet known. */
     void ProcessBlockAvailability(NodeId nodeid) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
@@ -1083,6 +1175,7 @@ void PeerManagerImpl::PushAddress(Peer& peer, const CAddress& addr)
         } else {
             peer.m_addrs_to_send.push_back(addr);
         }
+        peer.m_next_send_wake = 0us;
     }
 }
 
@@ -1180,6 +1273,23 @@ void PeerManagerImpl::RemoveBlockRequest(const uint256& hash, std::optional<Node
     }
 }
 
+void PeerManagerImpl::RecordBlockDelivery(NodeId nodeid, const uint256& hash, size_t block_bytes)
+{
+    for (auto range = mapBlocksInFlight.equal_range(hash); range.first != range.second; range.first++) {
+        auto [node_id, list_it] = range.first->second;
+        if (node_id != nodeid) continue;
+        CNodeState& state = *Assert(State(node_id));
+        const auto elapsed{std::max(GetTime<std::chrono::microseconds>() - list_it->m_requested_at, std::chrono::microseconds{1ms})};
+        const double sample{block_bytes / std::chrono::duration<double>(elapsed).count()};
+        if (state.m_block_bytes_per_sec == 0.0) {
+            state.m_block_bytes_per_sec = sample;
+        } else {
+            state.m_block_bytes_per_sec += BLOCK_DELIVERY_EWMA_WEIGHT * (sample - state.m_block_bytes_per_sec);
+        }
+        return;
+    }
+}
+
 bool PeerManagerImpl::BlockRequested(NodeId nodeid, const CBlockIndex& block, std::list<QueuedBlock>::iterator** pit)
 {
     const uint256& hash{block.GetBlockHash()};
@@ -1203,7 +1313,8 @@ bool PeerManagerImpl::BlockRequested(NodeId nodeid, const CBlockIndex& block, st
     RemoveBlockRequest(hash, nodeid);
 
     std::list<QueuedBlock>::iterator it = state->vBlocksInFlight.insert(state->vBlocksInFlight.end(),
-            {&block, std::unique_ptr<PartiallyDownloadedBlock>(pit ? new PartiallyDownloadedBlock(&m_mempool) : nullptr)});
+            {&block, std::unique_ptr<PartiallyDownloadedBlock>(pit ? new PartiallyDownloadedBlock(&m_mempool) : nullptr),
+             GetTime<std::chrono::microseconds>()});
     if (state->vBlocksInFlight.size() == 1) {
         // We're starting a block download (batch) from this peer.
         state->m_downloading_since = GetTime<std::chrono::microseconds>();
@@ -1558,7 +1669,7 @@ void PeerManagerImpl::ReattemptInitialBroadcast(CScheduler& scheduler)
 
     // Schedule next run for 10-15 minutes in the future.
     // We add randomness on every cycle to avoid the possibility of P2P fingerprinting.
-    const auto delta = 10min + FastRandomContext().randrange<std::chrono::milliseconds>(5min);
+    const auto delta = 10min + ThreadLocalRng().randrange<std::chrono::milliseconds>(5min);
     scheduler.scheduleFromNow([&] { ReattemptInitialBroadcast(scheduler); }, delta);
 }
 
@@ -1701,6 +1812,7 @@ bool PeerManagerImpl::GetNodeStateStats(NodeId nodeid, CNodeStateStats& stats) c
     if (auto tx_relay = peer->GetTxRelay(); tx_relay != nullptr) {
         stats.m_relay_txs = WITH_LOCK(tx_relay->m_bloom_filter_mutex, return tx_relay->m_relay_txs);
         stats.m_fee_filter_received = tx_relay->m_fee_filter_received.load();
+        stats.m_tx_announcements_queued = WITH_LOCK(tx_relay->m_tx_inventory_mutex, return tx_relay->m_tx_inventory_to_send.size());
     } else {
         stats.m_relay_txs = false;
         stats.m_fee_filter_received = 0;
@@ -1735,14 +1847,29 @@ PeerManagerInfo PeerManagerImpl::GetInfo() const
     };
 }
 
+/** Assumed dynamic usage of a typical transaction kept for compact block
+ *  reconstruction; -blockreconstructionextratxn is multiplied by this to
+ *  form the pool's memory budget, preserving the option's "number of
+ *  ordinary transactions" intuition while accounting in bytes. */
+static constexpr size_t EXTRA_TXN_TYPICAL_USAGE{1000};
+
 void PeerManagerImpl::AddToCompactExtraTransactions(const CTransactionRef& tx)
 {
     if (m_opts.max_extra_txs <= 0)
         return;
-    if (!vExtraTxnForCompact.size())
-        vExtraTxnForCompact.resize(m_opts.max_extra_txs);
-    vExtraTxnForCompact[vExtraTxnForCompactIt] = tx;
-    vExtraTxnForCompactIt = (vExtraTxnForCompactIt + 1) % m_opts.max_extra_txs;
+    // A transaction already in the pool would previously occupy a second
+    // ring slot; with wtxid deduplication re-announcements cost nothing.
+    if (!m_extra_txn_wtxids.insert(tx->GetWitnessHash()).second) return;
+    m_extra_txn_usage += RecursiveDynamicUsage(*tx);
+    m_extra_txn_for_compact.push_back(tx);
+
+    const size_t budget{m_opts.max_extra_txs * EXTRA_TXN_TYPICAL_USAGE};
+    while (m_extra_txn_usage > budget && !m_extra_txn_for_compact.empty()) {
+        const CTransactionRef& oldest{m_extra_txn_for_compact.front()};
+        m_extra_txn_usage -= RecursiveDynamicUsage(*oldest);
+        m_extra_txn_wtxids.erase(oldest->GetWitnessHash());
+        m_extra_txn_for_compact.pop_front();
+    }
 }
 
 void PeerManagerImpl::Misbehaving(Peer& peer, const std::string& message)
@@ -1751,6 +1878,7 @@ void PeerManagerImpl::Misbehaving(Peer& peer, const std::string& message)
 
     const std::string message_prefixed = message.empty() ? "" : (": " + message);
     peer.m_should_discourage = true;
+    peer.m_next_send_wake = 0us;
     LogDebug(BCLog::NET, "Misbehaving: peer=%d%s\n", peer.m_id, message_prefixed);
 }
 
@@ -1910,7 +2038,7 @@ void PeerManagerImpl::StartScheduledTasks(CScheduler& scheduler)
     scheduler.scheduleEvery([this] { this->CheckForStaleTipAndEvictPeers(); }, std::chrono::seconds{EXTRA_PEER_CHECK_INTERVAL});
 
     // schedule next run for 10-15 minutes in the future
-    const auto delta = 10min + FastRandomContext().randrange<std::chrono::milliseconds>(5min);
+    const auto delta = 10min + ThreadLocalRng().randrange<std::chrono::milliseconds>(5min);
     scheduler.scheduleFromNow([&] { ReattemptInitialBroadcast(scheduler); }, delta);
 }
 
@@ -1974,9 +2102,36 @@ void PeerManagerImpl::BlockDisconnected(const std::shared_ptr<const CBlock> &blo
  * Maintain state about the best-seen block and fast-announce a compact block
  * to compatible peers.
  */
+std::vector<uint16_t> PeerManagerImpl::SelectCompactBlockPrefill(const CBlock& block, NodeId nodeid)
+{
+    std::vector<uint16_t> prefill;
+    PeerRef peer{GetPeerRef(nodeid)};
+    if (!peer) return prefill;
+    auto* tx_relay{peer->GetTxRelay()};
+    if (!tx_relay) return prefill;
+
+    LOCK(tx_relay->m_tx_inventory_mutex);
+    unsigned int prefill_bytes{0};
+    const size_t tx_count{std::min<size_t>(block.vtx.size(), std::numeric_limits<uint16_t>::max())};
+    for (size_t i = 1; i < tx_count; i++) {
+        const CTransaction& tx{*block.vtx[i]};
+        // The filter tracks everything announced to or received from the peer,
+        // by txid or wtxid; a transaction in neither was probably never
+        // relayed to them.
+        if (tx_relay->m_tx_inventory_known_filter.contains(tx.GetWitnessHash().ToUint256()) ||
+            tx_relay->m_tx_inventory_known_filter.contains(tx.GetHash().ToUint256())) {
+            continue;
+        }
+        if (prefill_bytes + tx.GetTotalSize() > MAX_CMPCTBLOCK_PREFILL_BYTES) break;
+        prefill_bytes += tx.GetTotalSize();
+        prefill.push_back(static_cast<uint16_t>(i));
+    }
+    return prefill;
+}
+
 void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& pblock)
 {
-    auto pcmpctblock = std::make_shared<const CBlockHeaderAndShortTxIDs>(*pblock, FastRandomContext().rand64());
+    auto pcmpctblock = std::make_shared<const CBlockHeaderAndShortTxIDs>(*pblock, ThreadLocalRng().rand64());
 
     LOCK(cs_main);
 
@@ -1988,7 +2143,13 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
 
     uint256 hashBlock(pblock->GetHash());
     const std::shared_future<CSerializedNetMsg> lazy_ser{
-        std::async(std::launch::deferred, [&] { return NetMsg::Make(NetMsgType::CMPCTBLOCK, *pcmpctblock); })};
+        std::async(std::launch::deferred, [&] {
+            CSerializedNetMsg msg{NetMsg::Make(NetMsgType::CMPCTBLOCK, *pcmpctblock)};
+            // Hash once; every per-peer copy below reuses it for its wire
+            // checksum instead of re-hashing the whole payload.
+            msg.PrecomputeHash();
+            return msg;
+        })};
 
     {
         auto most_recent_block_txs = std::make_unique<std::map<uint256, CTransactionRef>>();
@@ -2004,7 +2165,7 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
         m_most_recent_block_txs = std::move(most_recent_block_txs);
     }
 
-    m_connman.ForEachNode([this, pindex, &lazy_ser, &hashBlock](CNode* pnode) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
+    m_connman.ForEachNode([this, pindex, &pblock, &lazy_ser, &hashBlock](CNode* pnode) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
         AssertLockHeld(::cs_main);
 
         if (pnode->GetCommonVersion() < INVALID_CB_NO_BAN_VERSION || pnode->fDisconnect)
@@ -2018,8 +2179,17 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
             LogDebug(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", "PeerManager::NewPoWValidBlock",
                     hashBlock.ToString(), pnode->GetId());
 
-            const CSerializedNetMsg& ser_cmpctblock{lazy_ser.get()};
-            PushMessage(*pnode, ser_cmpctblock.Copy());
+            // Prefill transactions this peer has likely never seen so they can
+            // reconstruct the block without a GETBLOCKTXN round trip; peers
+            // expected to know every transaction get the shared
+            // pre-serialized announcement.
+            const std::vector<uint16_t> prefill{SelectCompactBlockPrefill(*pblock, pnode->GetId())};
+            if (prefill.empty()) {
+                const CSerializedNetMsg& ser_cmpctblock{lazy_ser.get()};
+                PushMessage(*pnode, ser_cmpctblock.Copy());
+            } else {
+                MakeAndPushMessage(*pnode, NetMsgType::CMPCTBLOCK, CBlockHeaderAndShortTxIDs{*pblock, ThreadLocalRng().rand64(), prefill});
+            }
             state.pindexBestHeaderSent = pindex;
         }
     });
@@ -2033,6 +2203,10 @@ void PeerManagerImpl::UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlock
 {
     SetBestBlock(pindexNew->nHeight, std::chrono::seconds{pindexNew->GetBlockTime()});
 
+    // A new tip can create send-side work (announcements, block requests) for
+    // every peer.
+    m_send_event_counter.fetch_add(1, std::memory_order_relaxed);
+
     // Don't relay inventory during initial block download.
     if (fInitialDownload) return;
 
@@ -2111,7 +2285,10 @@ bool PeerManagerImpl::AlreadyHaveBlock(const uint256& block_hash)
 void PeerManagerImpl::SendPings()
 {
     LOCK(m_peer_mutex);
-    for(auto& it : m_peer_map) it.second->m_ping_queued = true;
+    for (auto& it : m_peer_map) {
+        it.second->m_ping_queued = true;
+        it.second->m_next_send_wake = 0us;
+    }
 }
 
 void PeerManagerImpl::RelayTransaction(const uint256& txid, const uint256& wtxid)
@@ -2133,6 +2310,7 @@ void PeerManagerImpl::RelayTransaction(const uint256& txid, const uint256& wtxid
         const uint256& hash{peer.m_wtxid_relay ? wtxid : txid};
         if (!tx_relay->m_tx_inventory_known_filter.contains(hash)) {
             tx_relay->m_tx_inventory_to_send.insert(hash);
+            peer.m_next_send_wake = 0us;
         }
     };
 }
@@ -2223,6 +2401,7 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
     const CBlockIndex* tip{nullptr};
     bool can_direct_fetch{false};
     FlatFilePos block_pos{};
+    std::vector<FlatFilePos> prefetch_positions;
     {
         LOCK(cs_main);
         pindex = m_chainman.m_blockman.LookupBlockIndex(inv.hash);
@@ -2259,6 +2438,30 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
         }
         can_direct_fetch = CanDirectFetch();
         block_pos = pindex->GetBlockPos();
+
+        // Syncing peers request blocks in height order, so collect the
+        // positions of the likely-next blocks to hint the OS to read them
+        // into the page cache before they are requested.
+        if (m_chainman.ActiveChain().Contains(pindex)) {
+            int start{pindex->nHeight + 1};
+            if (peer.m_block_prefetch_height >= start && peer.m_block_prefetch_height < start + GETDATA_BLOCK_READAHEAD) {
+                // Extend the window already hinted for this peer.
+                start = peer.m_block_prefetch_height + 1;
+            }
+            const int until{std::min(pindex->nHeight + GETDATA_BLOCK_READAHEAD, tip->nHeight)};
+            for (int height{start}; height <= until; ++height) {
+                const CBlockIndex* next{m_chainman.ActiveChain()[height]};
+                if (!next || !(next->nStatus & BLOCK_HAVE_DATA)) break;
+                prefetch_positions.push_back(next->GetBlockPos());
+            }
+            if (until >= start) peer.m_block_prefetch_height = until;
+        }
+    }
+
+    // Issue the read-ahead hints outside cs_main. posix_fadvise is
+    // asynchronous, so this does not block the message handler thread.
+    for (const FlatFilePos& prefetch_pos : prefetch_positions) {
+        m_chainman.m_blockman.PrefetchBlock(prefetch_pos);
     }
 
     std::shared_ptr<const CBlock> pblock;
@@ -2277,12 +2480,72 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
             pfrom.fDisconnect = true;
             return;
         }
-        MakeAndPushMessage(pfrom, NetMsgType::BLOCK, Span{block_data});
+        // The raw bytes are already in network format, so move them into the
+        // message rather than copying them through the serializer.
+        CSerializedNetMsg msg;
+        msg.m_type = NetMsgType::BLOCK;
+        msg.data = std::move(block_data);
+        m_connman.PushMessage(&pfrom, std::move(msg));
+        // Don't set pblock as we've sent the block
+    } else if (inv.IsMsgBlk()) {
+        // Serve legacy non-witness block requests by splicing the witness
+        // data out of the raw on-disk bytes instead of materializing the
+        // transaction graph. As above, comparing the cheap header hash
+        // against the block index pins the block's identity.
+        std::vector<uint8_t> block_data;
+        bool read_ok{m_chainman.m_blockman.ReadRawBlock(block_data, block_pos)};
+        std::vector<uint8_t> stripped;
+        if (read_ok) {
+            const node::BlockView view{block_data};
+            if (!view.IsValid() || view.GetHeader().GetHash() != pindex->GetBlockHash()) {
+                LogError("%s: Block data doesn't match index at %s\n", __func__, block_pos.ToString());
+                read_ok = false;
+            } else {
+                stripped.reserve(block_data.size());
+                const auto prefix{view.PrefixBytes()};
+                stripped.insert(stripped.end(), prefix.begin(), prefix.end());
+                for (size_t i = 0; i < view.TxCount(); ++i) {
+                    view.AppendTxWithoutWitness(i, stripped);
+                }
+            }
+        }
+        if (!read_ok) {
+            if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
+                LogDebug(BCLog::NET, "Block was pruned before it could be read, %s\n", pfrom.DisconnectMsg(fLogIPs));
+            } else {
+                LogError("Cannot load block from disk, %s\n", pfrom.DisconnectMsg(fLogIPs));
+            }
+            pfrom.fDisconnect = true;
+            return;
+        }
+        CSerializedNetMsg msg;
+        msg.m_type = NetMsgType::BLOCK;
+        msg.data = std::move(stripped);
+        m_connman.PushMessage(&pfrom, std::move(msg));
         // Don't set pblock as we've sent the block
     } else {
-        // Send block from disk
+        // Send block from disk. Read the raw block and deserialize it here
+        // rather than through ReadBlock(): the block's identity is pinned by
+        // the block index, so comparing the (cheap) header hash against the
+        // index entry gives the same corruption protection as ReadBlock()'s
+        // proof-of-work recheck without re-running the expensive PoW hash on
+        // the message handler thread for every block served.
         std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
-        if (!m_chainman.m_blockman.ReadBlock(*pblockRead, block_pos)) {
+        std::vector<uint8_t> block_data;
+        bool read_ok{m_chainman.m_blockman.ReadRawBlock(block_data, block_pos)};
+        if (read_ok) {
+            try {
+                SpanReader{block_data} >> TX_WITH_WITNESS(*pblockRead);
+            } catch (const std::exception& e) {
+                LogError("%s: Deserialize error - %s at %s\n", __func__, e.what(), block_pos.ToString());
+                read_ok = false;
+            }
+            if (read_ok && pblockRead->GetHash() != pindex->GetBlockHash()) {
+                LogError("%s: Block hash doesn't match index at %s\n", __func__, block_pos.ToString());
+                read_ok = false;
+            }
+        }
+        if (!read_ok) {
             if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
                 LogDebug(BCLog::NET, "Block was pruned before it could be read, %s\n", pfrom.DisconnectMsg(fLogIPs));
             } else {
@@ -2467,12 +2730,128 @@ void PeerManagerImpl::SendBlockTransactions(CNode& pfrom, Peer& peer, const CBlo
     MakeAndPushMessage(pfrom, NetMsgType::BLOCKTXN, resp);
 }
 
+/** Flag bits of the per-header byte in the compressed headers encoding. */
+static constexpr uint8_t HDRS_COMP_VERSION_SAME{1 << 0};
+static constexpr uint8_t HDRS_COMP_TIME_DELTA{1 << 1};
+static constexpr uint8_t HDRS_COMP_BITS_SAME{1 << 2};
+
+/** (Un)serializer for a headers batch in the compressed encoding negotiated
+ *  via NetMsgType::SENDHDRSCOMP. The first header is carried in full; every
+ *  later header omits hashPrevBlock (implied by its predecessor in the
+ *  batch), carries nVersion and nBits only when they differ from the
+ *  predecessor's, and encodes nTime as a 16-bit signed delta when it fits.
+ *  This shrinks a typical in-sync batch from 80 to ~38 bytes per header. */
+struct CompressedHeaders {
+    std::vector<CBlockHeader>& m_headers;
+    //! Batches above this size fail to deserialize.
+    const uint64_t m_max_count;
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        WriteCompactSize(s, m_headers.size());
+        for (size_t i = 0; i < m_headers.size(); ++i) {
+            const CBlockHeader& header{m_headers[i]};
+            if (i == 0) {
+                s << header;
+                continue;
+            }
+            const CBlockHeader& prev{m_headers[i - 1]};
+            const int64_t time_delta{int64_t{header.nTime} - int64_t{prev.nTime}};
+            uint8_t flags{0};
+            if (header.nVersion == prev.nVersion) flags |= HDRS_COMP_VERSION_SAME;
+            if (time_delta >= std::numeric_limits<int16_t>::min() && time_delta <= std::numeric_limits<int16_t>::max()) flags |= HDRS_COMP_TIME_DELTA;
+            if (header.nBits == prev.nBits) flags |= HDRS_COMP_BITS_SAME;
+            s << flags;
+            if (!(flags & HDRS_COMP_VERSION_SAME)) s << header.nVersion;
+            s << header.hashMerkleRoot;
+            if (flags & HDRS_COMP_TIME_DELTA) {
+                s << static_cast<uint16_t>(static_cast<int16_t>(time_delta));
+            } else {
+                s << header.nTime;
+            }
+            if (!(flags & HDRS_COMP_BITS_SAME)) s << header.nBits;
+            s << header.nNonce;
+        }
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint64_t count{ReadCompactSize(s)};
+        if (count > m_max_count) {
+            throw std::ios_base::failure("compressed headers batch too large");
+        }
+        m_headers.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            CBlockHeader& header{m_headers[i]};
+            if (i == 0) {
+                s >> header;
+                continue;
+            }
+            const CBlockHeader& prev{m_headers[i - 1]};
+            uint8_t flags;
+            s >> flags;
+            if (flags & HDRS_COMP_VERSION_SAME) {
+                header.nVersion = prev.nVersion;
+            } else {
+                s >> header.nVersion;
+            }
+            header.hashPrevBlock = prev.GetHash();
+            s >> header.hashMerkleRoot;
+            if (flags & HDRS_COMP_TIME_DELTA) {
+                uint16_t raw;
+                s >> raw;
+                header.nTime = static_cast<uint32_t>(int64_t{prev.nTime} + static_cast<int16_t>(raw));
+            } else {
+                s >> header.nTime;
+            }
+            if (flags & HDRS_COMP_BITS_SAME) {
+                header.nBits = prev.nBits;
+            } else {
+                s >> header.nBits;
+            }
+            s >> header.nNonce;
+        }
+    }
+};
+
 bool PeerManagerImpl::CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer)
 {
-    // Do these headers have proof-of-work matching what's claimed?
-    if (!HasValidProofOfWork(headers, consensusParams)) {
-        Misbehaving(peer, "header with invalid proof of work");
-        return false;
+    AssertLockHeld(g_msgproc_mutex);
+
+    // Expire old entries from the recently-verified set.
+    const auto now{SteadyClock::now()};
+    while (!m_recent_pow_headers_order.empty() &&
+           (now - m_recent_pow_headers_order.front().first > RECENT_POW_HEADERS_TTL ||
+            m_recent_pow_headers_order.size() > MAX_RECENT_POW_HEADERS)) {
+        m_recent_pow_headers.erase(m_recent_pow_headers_order.front().second);
+        m_recent_pow_headers_order.pop_front();
+    }
+
+    // If every header in the message was verified recently (the common case
+    // when a new block is announced by many peers in quick succession), skip
+    // re-evaluating the proof of work.
+    const bool all_recently_verified{std::all_of(headers.begin(), headers.end(),
+        [&](const CBlockHeader& header) EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex) { return m_recent_pow_headers.count(header.GetHash()) > 0; })};
+    if (all_recently_verified) {
+        m_pow_headers_deduped += headers.size();
+        LogDebug(BCLog::NET, "skipping PoW check for %u recently verified header(s), %u of %u deduped total\n",
+                 headers.size(), m_pow_headers_deduped, m_pow_headers_deduped + m_pow_headers_checked);
+    } else {
+        // Do these headers have proof-of-work matching what's claimed? Verified
+        // on the dedicated pool so a large HEADERS message does not stall the
+        // message-handler thread for the full serial hashing time.
+        if (!HasValidProofOfWork(headers, consensusParams, &m_chainman.GetPoWCheckQueue())) {
+            Misbehaving(peer, "header with invalid proof of work");
+            return false;
+        }
+        m_pow_headers_checked += headers.size();
+        for (const CBlockHeader& header : headers) {
+            if (m_recent_pow_headers.insert(header.GetHash()).second) {
+                m_recent_pow_headers_order.emplace_back(now, header.GetHash());
+            }
+        }
     }
 
     // Are these headers connected to each other?
@@ -3044,7 +3423,7 @@ void PeerManagerImpl::ProcessPackageResult(const node::PackageToValidate& packag
                 case MempoolAcceptResult::ResultType::INVALID:
                 case MempoolAcceptResult::ResultType::DIFFERENT_WITNESS:
                 {
-                    // Don't add to vExtraTxnForCompact, as these transactions should have already been
+                    // Don't add to m_extra_txn_for_compact, as these transactions should have already been
                     // added there when added to the orphanage or rejected for TX_RECONSIDERABLE.
                     // This should be updated if package submission is ever used for transactions
                     // that haven't already been validated before.
@@ -3067,10 +3446,14 @@ void PeerManagerImpl::ProcessPackageResult(const node::PackageToValidate& packag
 bool PeerManagerImpl::ProcessOrphanTx(Peer& peer)
 {
     AssertLockHeld(g_msgproc_mutex);
+    // The common case in the per-peer message loop is that there are no
+    // orphans ready for reconsideration; check that without touching
+    // cs_main so that idle peers do not contend with validation.
+    if (!WITH_LOCK(m_tx_download_mutex, return m_txdownloadman.HaveMoreWork(peer.m_id))) {
+        return false;
+    }
     LOCK2(::cs_main, m_tx_download_mutex);
 
-    CTransactionRef porphanTx = nullptr;
-
     while (CTransactionRef porphanTx = m_txdownloadman.GetTxToReconsider(peer.m_id)) {
         const MempoolAcceptResult result = m_chainman.ProcessTransaction(porphanTx);
         const TxValidationState& state = result.m_state;
@@ -3273,6 +3656,7 @@ void PeerManagerImpl::ProcessBlock(CNode& node, const std::shared_ptr<const CBlo
         // from, we can erase the block request now anyway (as we just stored
         // this block to disk).
         LOCK(cs_main);
+        RecordBlockDelivery(node.GetId(), block->GetHash(), GetSerializeSize(TX_WITH_WITNESS(*block)));
         RemoveBlockRequest(block->GetHash(), std::nullopt);
     } else {
         LOCK(cs_main);
@@ -3475,6 +3859,9 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
             // it to nodes with a version before 70016, as no software is known to support
             // BIP155 that doesn't announce at least that protocol version number.
             MakeAndPushMessage(pfrom, NetMsgType::SENDADDRV2);
+            // Signal that we are happy to receive getheaders responses in
+            // the compressed encoding.
+            MakeAndPushMessage(pfrom, NetMsgType::SENDHDRSCOMP);
         }
 
         pfrom.m_has_all_wanted_services = HasAllDesirableServiceFlags(nServices);
@@ -3724,6 +4111,19 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         return;
     }
 
+    // Feature negotiation of compressed headers batches; like the other
+    // negotiation messages this must happen between VERSION and VERACK.
+    if (msg_type == NetMsgType::SENDHDRSCOMP) {
+        if (pfrom.fSuccessfullyConnected) {
+            // Disconnect peers that send a SENDHDRSCOMP message after VERACK.
+            LogDebug(BCLog::NET, "sendhdrscomp received after verack, %s\n", pfrom.DisconnectMsg(fLogIPs));
+            pfrom.fDisconnect = true;
+            return;
+        }
+        peer->m_wants_hdrs_comp = true;
+        return;
+    }
+
     // Received from a peer demonstrating readiness to announce transactions via reconciliations.
     // This feature negotiation must happen between VERSION and VERACK to avoid relay problems
     // from switching announcement protocols after the connection is up.
@@ -4199,7 +4599,16 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         // will re-announce the new block via headers (or compact blocks again)
         // in the SendMessages logic.
         nodestate->pindexBestHeaderSent = pindex ? pindex : m_chainman.ActiveChain().Tip();
-        MakeAndPushMessage(pfrom, NetMsgType::HEADERS, TX_WITH_WITNESS(vHeaders));
+        if (peer->m_wants_hdrs_comp) {
+            std::vector<CBlockHeader> compact_headers;
+            compact_headers.reserve(vHeaders.size());
+            for (const CBlock& block_header : vHeaders) {
+                compact_headers.emplace_back(block_header.GetBlockHeader());
+            }
+            MakeAndPushMessage(pfrom, NetMsgType::HDRSCOMP, CompressedHeaders{compact_headers, m_opts.max_headers_result});
+        } else {
+            MakeAndPushMessage(pfrom, NetMsgType::HEADERS, TX_WITH_WITNESS(vHeaders));
+        }
         return;
     }
 
@@ -4400,7 +4809,7 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
                 }
 
                 PartiallyDownloadedBlock& partialBlock = *(*queuedBlockIt)->partialBlock;
-                ReadStatus status = partialBlock.InitData(cmpctblock, vExtraTxnForCompact);
+                ReadStatus status = partialBlock.InitData(cmpctblock, m_extra_txn_for_compact);
                 if (status == READ_STATUS_INVALID) {
                     RemoveBlockRequest(pindex->GetBlockHash(), pfrom.GetId()); // Reset in-flight state in case Misbehaving does not result in a disconnect
                     Misbehaving(*peer, "invalid compact block");
@@ -4451,7 +4860,7 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
                 // Optimistically try to reconstruct anyway since we might be
                 // able to without any round trips.
                 PartiallyDownloadedBlock tempBlock(&m_mempool);
-                ReadStatus status = tempBlock.InitData(cmpctblock, vExtraTxnForCompact);
+                ReadStatus status = tempBlock.InitData(cmpctblock, m_extra_txn_for_compact);
                 if (status != READ_STATUS_OK) {
                     // TODO: don't ignore failures
                     return;
@@ -4576,6 +4985,41 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         return;
     }
 
+    if (msg_type == NetMsgType::HDRSCOMP) {
+        // Ignore headers received while importing
+        if (m_chainman.m_blockman.LoadingBlocks()) {
+            LogDebug(BCLog::NET, "Unexpected hdrscomp message received from peer %d\n", pfrom.GetId());
+            return;
+        }
+
+        std::vector<CBlockHeader> headers;
+        try {
+            CompressedHeaders compressed{headers, m_opts.max_headers_result};
+            vRecv >> compressed;
+        } catch (const std::ios_base::failure&) {
+            Misbehaving(*peer, "invalid compressed headers message");
+            return;
+        }
+
+        ProcessHeadersMessage(pfrom, *peer, std::move(headers), /*via_compact_block=*/false);
+
+        // Check if the headers presync progress needs to be reported to validation.
+        // This needs to be done without holding the m_headers_presync_mutex lock.
+        if (m_headers_presync_should_signal.exchange(false)) {
+            HeadersPresyncStats stats;
+            {
+                LOCK(m_headers_presync_mutex);
+                auto it = m_headers_presync_stats.find(m_headers_presync_bestpeer);
+                if (it != m_headers_presync_stats.end()) stats = it->second;
+            }
+            if (stats.second) {
+                m_chainman.ReportHeadersPresync(stats.first, stats.second->first, stats.second->second);
+            }
+        }
+
+        return;
+    }
+
     if (msg_type == NetMsgType::BLOCK)
     {
         // Ignore block received while importing
@@ -4968,6 +5412,10 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
     CNetMessage& msg{poll_result->first};
     bool fMoreWork = poll_result->second;
 
+    // Any incoming message can change what SendMessages() has to do for this
+    // peer, so force its next send-side pass to run in full.
+    peer->m_next_send_wake = 0us;
+
     TRACEPOINT(net, inbound_message,
         pfrom->GetId(),
         pfrom->m_addr_name.c_str(),
@@ -5227,7 +5675,7 @@ void PeerManagerImpl::MaybeSendPing(CNode& node_to, Peer& peer, std::chrono::mic
     if (pingSend) {
         uint64_t nonce;
         do {
-            nonce = FastRandomContext().rand64();
+            nonce = ThreadLocalRng().rand64();
         } while (nonce == 0);
         peer.m_ping_queued = false;
         peer.m_ping_start = now;
@@ -5367,27 +5815,6 @@ void PeerManagerImpl::MaybeSendFeefilter(CNode& pto, Peer& peer, std::chrono::mi
     }
 }
 
-namespace {
-class CompareInvMempoolOrder
-{
-    CTxMemPool* mp;
-    bool m_wtxid_relay;
-public:
-    explicit CompareInvMempoolOrder(CTxMemPool *_mempool, bool use_wtxid)
-    {
-        mp = _mempool;
-        m_wtxid_relay = use_wtxid;
-    }
-
-    bool operator()(std::set<uint256>::iterator a, std::set<uint256>::iterator b)
-    {
-        /* As std::make_heap produces a max-heap, we want the entries with the
-         * fewest ancestors/highest fee to sort later. */
-        return mp->CompareDepthAndScore(*b, *a, m_wtxid_relay);
-    }
-};
-} // namespace
-
 bool PeerManagerImpl::RejectIncomingTxs(const CNode& peer) const
 {
     // block-relay-only peers may never send txs to us
@@ -5446,6 +5873,20 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
         return true;
     }
 
+    // Fast path: skip the full send-side pass while this peer has no due
+    // deadline. Anything that can create send work for the peer - an incoming
+    // message, queued invs/addrs/pings, misbehavior, a tip update - clears the
+    // cached wake time or bumps the event counter, forcing a full pass.
+    {
+        const uint64_t send_events{m_send_event_counter.load(std::memory_order_relaxed)};
+        if (peer->m_send_events_seen == send_events) {
+            const auto wake{peer->m_next_send_wake.load(std::memory_order_relaxed)};
+            if (wake > SEND_WAKE_RECOMPUTE && current_time < wake) return true;
+        }
+        peer->m_send_events_seen = send_events;
+        peer->m_next_send_wake.store(SEND_WAKE_RECOMPUTE, std::memory_order_relaxed);
+    }
+
     MaybeSendPing(*pto, *peer, current_time);
 
     // MaybeSendPing may have marked peer for disconnection
@@ -5455,6 +5896,11 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
 
     MaybeSendSendHeaders(*pto, *peer);
 
+    // Whether this peer may be skipped until a deadline or event, decided by
+    // the block-download and tx-request state examined under cs_main below.
+    bool quiescent{false};
+    bool tx_requests_pending{false};
+
     {
         LOCK(cs_main);
 
@@ -5487,8 +5933,10 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
         }
 
         if (!state.fSyncStarted && CanServeBlocks(*peer) && !m_chainman.m_blockman.LoadingBlocks()) {
-            // Only actively request headers from a single peer, unless we're close to today.
-            if ((nSyncStarted == 0 && sync_blocks_and_headers_from_peer) || m_chainman.m_best_header->Time() > NodeClock::now() - 24h) {
+            // Actively request headers from a few peers at once, so that initial
+            // headers sync is not bottlenecked on one peer's latency; beyond that,
+            // only request headers when we're close to today.
+            if ((nSyncStarted < MAX_CONCURRENT_HEADERS_SYNC_PEERS && sync_blocks_and_headers_from_peer) || m_chainman.m_best_header->Time() > NodeClock::now() - 24h) {
                 const CBlockIndex* pindexStart = m_chainman.m_best_header;
                 /* If possible, start at the block preceding the currently
                    best known header.  This ensures that we always get a
@@ -5588,20 +6036,30 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                     LogDebug(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", __func__,
                             vHeaders.front().GetHash().ToString(), pto->GetId());
 
-                    std::optional<CSerializedNetMsg> cached_cmpctblock_msg;
+                    std::shared_ptr<const CBlock> most_recent_block;
+                    std::shared_ptr<const CBlockHeaderAndShortTxIDs> most_recent_compact_block;
                     {
                         LOCK(m_most_recent_block_mutex);
                         if (m_most_recent_block_hash == pBestIndex->GetBlockHash()) {
-                            cached_cmpctblock_msg = NetMsg::Make(NetMsgType::CMPCTBLOCK, *m_most_recent_compact_block);
+                            most_recent_block = m_most_recent_block;
+                            most_recent_compact_block = m_most_recent_compact_block;
                         }
                     }
-                    if (cached_cmpctblock_msg.has_value()) {
-                        PushMessage(*pto, std::move(cached_cmpctblock_msg.value()));
+                    // Prefill transactions the peer has likely never seen (see
+                    // SelectCompactBlockPrefill); otherwise reuse the shared
+                    // coinbase-only encoding of the most recent block.
+                    if (most_recent_block) {
+                        const std::vector<uint16_t> prefill{SelectCompactBlockPrefill(*most_recent_block, pto->GetId())};
+                        if (prefill.empty()) {
+                            MakeAndPushMessage(*pto, NetMsgType::CMPCTBLOCK, *most_recent_compact_block);
+                        } else {
+                            MakeAndPushMessage(*pto, NetMsgType::CMPCTBLOCK, CBlockHeaderAndShortTxIDs{*most_recent_block, m_rng.rand64(), prefill});
+                        }
                     } else {
                         CBlock block;
                         const bool ret{m_chainman.m_blockman.ReadBlock(block, *pBestIndex)};
                         assert(ret);
-                        CBlockHeaderAndShortTxIDs cmpctblock{block, m_rng.rand64()};
+                        CBlockHeaderAndShortTxIDs cmpctblock{block, m_rng.rand64(), SelectCompactBlockPrefill(block, pto->GetId())};
                         MakeAndPushMessage(*pto, NetMsgType::CMPCTBLOCK, cmpctblock);
                     }
                     state.pindexBestHeaderSent = pBestIndex;
@@ -5721,46 +6179,78 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
 
                 // Determine transactions to relay
                 if (fSendTrickle) {
-                    // Produce a vector with all candidates for sending
-                    std::vector<std::set<uint256>::iterator> vInvTx;
-                    vInvTx.reserve(tx_relay->m_tx_inventory_to_send.size());
-                    for (std::set<uint256>::iterator it = tx_relay->m_tx_inventory_to_send.begin(); it != tx_relay->m_tx_inventory_to_send.end(); it++) {
-                        vInvTx.push_back(it);
-                    }
                     const CFeeRate filterrate{tx_relay->m_fee_filter_received.load()};
-                    // Topologically and fee-rate sort the inventory we send for privacy and priority reasons.
-                    // A heap is used so that not all items need sorting if only a few are being sent.
-                    CompareInvMempoolOrder compareInvMempoolOrder(&m_mempool, peer->m_wtxid_relay);
-                    std::make_heap(vInvTx.begin(), vInvTx.end(), compareInvMempoolOrder);
+                    // Gather everything needed to order and filter the candidates
+                    // in one pass under the mempool lock. Ordering the heap through
+                    // the mempool directly would instead take the lock and perform
+                    // two entry lookups for every comparison, for every peer, every
+                    // round.
+                    struct InvCandidate {
+                        std::set<uint256>::iterator it;
+                        CTransactionRef tx;
+                        CAmount fee;
+                        int32_t vsize;
+                        uint64_t ancestor_count;
+                    };
+                    std::vector<InvCandidate> candidates;
+                    candidates.reserve(tx_relay->m_tx_inventory_to_send.size());
+                    {
+                        LOCK(m_mempool.cs);
+                        auto it = tx_relay->m_tx_inventory_to_send.begin();
+                        while (it != tx_relay->m_tx_inventory_to_send.end()) {
+                            auto txinfo = m_mempool.info(peer->m_wtxid_relay ? GenTxid::Wtxid(*it) : GenTxid::Txid(*it));
+                            if (!txinfo.tx) {
+                                // Not in the mempool anymore? don't bother sending it.
+                                it = tx_relay->m_tx_inventory_to_send.erase(it);
+                                continue;
+                            }
+                            const CTxMemPoolEntry* entry{Assert(m_mempool.GetEntry(txinfo.tx->GetHash()))};
+                            candidates.push_back({it, std::move(txinfo.tx), txinfo.fee, txinfo.vsize,
+                                                  entry->GetCountWithAncestors()});
+                            ++it;
+                        }
+                    }
+                    // Topologically and fee-rate sort the inventory we send for privacy and priority reasons:
+                    // fewest ancestors first, then highest feerate (based on the unmodified fee, to avoid
+                    // leaking prioritization information). A heap is used so that not all items need sorting
+                    // if only a few are being sent.
+                    const auto sooner = [](const InvCandidate& a, const InvCandidate& b) {
+                        if (a.ancestor_count != b.ancestor_count) return a.ancestor_count < b.ancestor_count;
+                        const double f1 = (double)a.fee * b.vsize;
+                        const double f2 = (double)b.fee * a.vsize;
+                        if (f1 == f2) return b.tx->GetHash() < a.tx->GetHash();
+                        return f1 > f2;
+                    };
+                    // As std::make_heap produces a max-heap, we want the entries to be sent
+                    // soonest to sort later.
+                    const auto heap_cmp = [&sooner](const InvCandidate& a, const InvCandidate& b) {
+                        return sooner(b, a);
+                    };
+                    std::make_heap(candidates.begin(), candidates.end(), heap_cmp);
                     // No reason to drain out at many times the network's capacity,
                     // especially since we have many peers and some will draw much shorter delays.
                     unsigned int nRelayedTransactions = 0;
                     LOCK(tx_relay->m_bloom_filter_mutex);
                     size_t broadcast_max{INVENTORY_BROADCAST_TARGET + (tx_relay->m_tx_inventory_to_send.size()/1000)*5};
                     broadcast_max = std::min<size_t>(INVENTORY_BROADCAST_MAX, broadcast_max);
-                    while (!vInvTx.empty() && nRelayedTransactions < broadcast_max) {
+                    while (!candidates.empty() && nRelayedTransactions < broadcast_max) {
                         // Fetch the top element from the heap
-                        std::pop_heap(vInvTx.begin(), vInvTx.end(), compareInvMempoolOrder);
-                        std::set<uint256>::iterator it = vInvTx.back();
-                        vInvTx.pop_back();
-                        uint256 hash = *it;
+                        std::pop_heap(candidates.begin(), candidates.end(), heap_cmp);
+                        InvCandidate cand{std::move(candidates.back())};
+                        candidates.pop_back();
+                        const uint256 hash{*cand.it};
                         CInv inv(peer->m_wtxid_relay ? MSG_WTX : MSG_TX, hash);
                         // Remove it from the to-be-sent set
-                        tx_relay->m_tx_inventory_to_send.erase(it);
+                        tx_relay->m_tx_inventory_to_send.erase(cand.it);
                         // Check if not in the filter already
                         if (tx_relay->m_tx_inventory_known_filter.contains(hash)) {
                             continue;
                         }
-                        // Not in the mempool anymore? don't bother sending it.
-                        auto txinfo = m_mempool.info(ToGenTxid(inv));
-                        if (!txinfo.tx) {
-                            continue;
-                        }
                         // Peer told you to not send transactions at that feerate? Don't bother sending it.
-                        if (txinfo.fee < filterrate.GetFee(txinfo.vsize)) {
+                        if (cand.fee < filterrate.GetFee(cand.vsize)) {
                             continue;
                         }
-                        if (tx_relay->m_bloom_filter && !tx_relay->m_bloom_filter->IsRelevantAndUpdate(*txinfo.tx)) continue;
+                        if (tx_relay->m_bloom_filter && !tx_relay->m_bloom_filter->IsRelevantAndUpdate(*cand.tx)) continue;
                         // Send
                         vInv.push_back(inv);
                         nRelayedTransactions++;
@@ -5781,7 +6271,25 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
 
         // Detect whether we're stalling
         auto stalling_timeout = m_block_stalling_timeout.load();
-        if (state.m_stalling_since.count() && state.m_stalling_since < current_time - stalling_timeout) {
+        // The global timeout adapts to our own bandwidth; additionally scale
+        // the deadline for this peer with its measured latency, once ping
+        // samples are available.
+        std::chrono::microseconds effective_timeout{stalling_timeout};
+        if (const auto srtt{pto->m_smoothed_ping_time.load()}; srtt > 0us) {
+            const std::chrono::microseconds rtt_based{4 * srtt + 8 * pto->m_ping_time_jitter.load()};
+            if (rtt_based > effective_timeout) {
+                // A distant peer needs several round trips to move the
+                // download window; don't punish it for the speed of light.
+                effective_timeout = std::min<std::chrono::microseconds>(rtt_based, BLOCK_STALLING_TIMEOUT_MAX);
+            } else if (stalling_timeout == BLOCK_STALLING_TIMEOUT_DEFAULT) {
+                // A nearby peer that cannot move the window within a few round
+                // trips is better replaced quickly. Only tighten while the
+                // global timeout is unescalated: escalation signals that our
+                // own link, not the peer, may be the bottleneck.
+                effective_timeout = std::max<std::chrono::microseconds>(rtt_based, BLOCK_STALLING_TIMEOUT_MIN);
+            }
+        }
+        if (state.m_stalling_since.count() && state.m_stalling_since < current_time - effective_timeout) {
             // Stalling only triggers when the block download window cannot move. During normal steady state,
             // the download window should be much larger than the to-be-downloaded set of blocks, so disconnection
             // should only happen during initial block download.
@@ -5853,8 +6361,25 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
         if (CanServeBlocks(*peer) && ((sync_blocks_and_headers_from_peer && !IsLimitedPeer(*peer)) || !m_chainman.IsInitialBlockDownload()) && state.vBlocksInFlight.size() < MAX_BLOCKS_IN_TRANSIT_PER_PEER) {
             std::vector<const CBlockIndex*> vToDownload;
             NodeId staller = -1;
-            auto get_inflight_budget = [&state]() {
-                return std::max(0, MAX_BLOCKS_IN_TRANSIT_PER_PEER - static_cast<int>(state.vBlocksInFlight.size()));
+            auto get_inflight_budget = [&]() EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
+                // Scale the in-flight cap by the peer's measured delivery rate
+                // relative to the best connected peer, so 16-block batches are
+                // not parked on peers that deliver far slower than the rest.
+                // Peers without a measurement yet get the full window; slow
+                // peers keep a small budget so they continue producing samples
+                // and can earn the window back.
+                int max_in_flight{MAX_BLOCKS_IN_TRANSIT_PER_PEER};
+                if (state.m_block_bytes_per_sec > 0.0) {
+                    double best_rate{0.0};
+                    for (const auto& [id, other] : m_node_states) {
+                        best_rate = std::max(best_rate, other.m_block_bytes_per_sec);
+                    }
+                    if (best_rate > 0.0) {
+                        max_in_flight = std::clamp<int>(MAX_BLOCKS_IN_TRANSIT_PER_PEER * (state.m_block_bytes_per_sec / best_rate) * 4,
+                                                        MIN_BLOCKS_IN_TRANSIT_SLOW_PEER, MAX_BLOCKS_IN_TRANSIT_PER_PEER);
+                    }
+                }
+                return std::max(0, max_in_flight - static_cast<int>(state.vBlocksInFlight.size()));
             };
 
             // If a snapshot chainstate is in use, we want to find its next blocks
@@ -5890,6 +6415,7 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
         //
         {
             LOCK(m_tx_download_mutex);
+            tx_requests_pending = m_txdownloadman.Count(pto->GetId()) > 0;
             for (const GenTxid& gtxid : m_txdownloadman.GetRequestsToSend(pto->GetId(), current_time)) {
                 vGetData.emplace_back(gtxid.IsWtxid() ? MSG_WTX : (MSG_TX | GetFetchFlags(*peer)), gtxid.GetHash());
                 if (vGetData.size() >= MAX_GETDATA_SZ) {
@@ -5901,7 +6427,34 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
 
         if (!vGetData.empty())
             MakeAndPushMessage(*pto, NetMsgType::GETDATA, vGetData);
+
+        // The peer can be skipped until its next deadline only if no block
+        // download, headers sync or tx request work can come due for it
+        // without an external event.
+        quiescent = state.vBlocksInFlight.empty() && !m_chainman.IsInitialBlockDownload() &&
+                    (!state.fSyncStarted || peer->m_headers_sync_timeout == std::chrono::microseconds::max());
     } // release cs_main
     MaybeSendFeefilter(*pto, *peer, current_time);
+
+    // Compute when this peer must next be examined: the earliest of its
+    // timer-driven deadlines, capped so state only reachable through a full
+    // pass is still checked regularly. Publish it only if no event cleared
+    // the wake time while this pass ran.
+    if (quiescent && !tx_requests_pending) {
+        auto wake{current_time + MAX_SEND_WAKE_INTERVAL};
+        if (peer->m_ping_nonce_sent == 0) {
+            wake = std::min(wake, peer->m_ping_start.load() + PING_INTERVAL);
+        }
+        if (const auto next_addr{WITH_LOCK(peer->m_addr_send_times_mutex, return peer->m_next_addr_send;)}; next_addr > 0us) {
+            wake = std::min(wake, next_addr);
+        }
+        if (auto tx_relay = peer->GetTxRelay(); tx_relay != nullptr) {
+            if (const auto next_inv{WITH_LOCK(tx_relay->m_tx_inventory_mutex, return tx_relay->m_next_inv_send_time;)}; next_inv > 0us) {
+                wake = std::min(wake, next_inv);
+            }
+        }
+        std::chrono::microseconds expected{SEND_WAKE_RECOMPUTE};
+        peer->m_next_send_wake.compare_exchange_strong(expected, std::max(wake, current_time), std::memory_order_relaxed);
+    }
     return true;
 }
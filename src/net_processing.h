@@ -46,6 +46,7 @@ struct CNodeStateStats {
     CAmount m_fee_filter_received;
     uint64_t m_addr_processed = 0;
     uint64_t m_addr_rate_limited = 0;
+    uint64_t m_tx_announcements_queued = 0;
     bool m_addr_relay_enabled{false};
     ServiceFlags their_services;
     int64_t presync_height{-1};
@@ -5,7 +5,9 @@
 #include <node/blockstorage.h>
 
 #include <arith_uint256.h>
+#include <consensus/consensus.h>
 #include <chain.h>
+#include <common/system.h>
 #include <consensus/params.h>
 #include <consensus/validation.h>
 #include <dbwrapper.h>
@@ -33,13 +35,21 @@
 #include <util/fs.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
+#include <util/thread.h>
 #include <util/translation.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <ranges>
+#include <thread>
 #include <unordered_map>
 
+#ifndef WIN32
+#include <fcntl.h>
+#endif
+
 namespace kernel {
 static constexpr uint8_t DB_BLOCK_FILES{'f'};
 static constexpr uint8_t DB_BLOCK_INDEX{'b'};
@@ -77,15 +87,26 @@ bool BlockTreeDB::ReadLastBlockFile(int& nFile)
 
 bool BlockTreeDB::WriteBatchSync(const std::vector<std::pair<int, const CBlockFileInfo*>>& fileInfo, int nLastFile, const std::vector<const CBlockIndex*>& blockinfo)
 {
-    CDBBatch batch(*this);
+    auto batch{MakeBlockIndexBatch(fileInfo, nLastFile, blockinfo)};
+    return WriteBatch(*batch, true);
+}
+
+std::unique_ptr<CDBBatch> BlockTreeDB::MakeBlockIndexBatch(const std::vector<std::pair<int, const CBlockFileInfo*>>& fileInfo, int nLastFile, std::vector<const CBlockIndex*> blockinfo)
+{
+    auto batch{std::make_unique<CDBBatch>(*this)};
     for (const auto& [file, info] : fileInfo) {
-        batch.Write(std::make_pair(DB_BLOCK_FILES, file), *info);
-    }
-    batch.Write(DB_LAST_BLOCK, nLastFile);
+        batch->Write(std::make_pair(DB_BLOCK_FILES, file), *info);
+    }
+    batch->Write(DB_LAST_BLOCK, nLastFile);
+    // The dirty set comes ordered by memory address; order the records by key
+    // instead so the memtable insertions walk forward.
+    std::sort(blockinfo.begin(), blockinfo.end(), [](const CBlockIndex* a, const CBlockIndex* b) {
+        return a->GetBlockHash() < b->GetBlockHash();
+    });
     for (const CBlockIndex* bi : blockinfo) {
-        batch.Write(std::make_pair(DB_BLOCK_INDEX, bi->GetBlockHash()), CDiskBlockIndex{bi});
+        batch->Write(std::make_pair(DB_BLOCK_INDEX, bi->GetBlockHash()), CDiskBlockIndex{bi});
     }
-    return WriteBatch(batch, true);
+    return batch;
 }
 
 bool BlockTreeDB::WriteFlag(const std::string& name, bool fValue)
@@ -109,7 +130,11 @@ bool BlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, s
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
     pcursor->Seek(std::make_pair(DB_BLOCK_INDEX, uint256()));
 
-    // Load m_block_index
+    // Load m_block_index. Proof of work verification is deferred: the TensHash
+    // forward pass per header dwarfs the deserialization work, so the checks
+    // are batched up here and run across threads once the (serial, map-mutating)
+    // cursor walk is done.
+    std::vector<const CBlockIndex*> to_verify;
     while (pcursor->Valid()) {
         if (interrupt) return false;
         std::pair<uint8_t, uint256> key;
@@ -131,10 +156,7 @@ bool BlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, s
                 pindexNew->nStatus        = diskindex.nStatus;
                 pindexNew->nTx            = diskindex.nTx;
 
-                if (!CheckProofOfWork(pindexNew->GetPoWHash(), pindexNew->nBits, consensusParams)) {
-                    LogError("%s: CheckProofOfWork failed: %s\n", __func__, pindexNew->ToString());
-                    return false;
-                }
+                to_verify.push_back(pindexNew);
 
                 pcursor->Next();
             } else {
@@ -146,7 +168,32 @@ bool BlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, s
         }
     }
 
-    return true;
+    std::atomic<bool> all_valid{true};
+    std::atomic<size_t> next_index{0};
+    const size_t num_threads{std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4)};
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&] {
+            while (all_valid.load(std::memory_order_relaxed)) {
+                const size_t i{next_index.fetch_add(1, std::memory_order_relaxed)};
+                if (i >= to_verify.size()) return;
+                if (interrupt) {
+                    all_valid = false;
+                    return;
+                }
+                const CBlockIndex* pindex{to_verify[i]};
+                if (!CheckProofOfWork(pindex->GetPoWHash(), pindex->nBits, consensusParams)) {
+                    LogError("%s: CheckProofOfWork failed: %s\n", __func__, pindex->ToString());
+                    all_valid = false;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    if (interrupt) return false;
+
+    return all_valid;
 }
 } // namespace kernel
 
@@ -230,7 +277,7 @@ CBlockIndex* BlockManager::AddToBlockIndex(const CBlockHeader& block, CBlockInde
         best_header = pindexNew;
     }
 
-    m_dirty_blockindex.insert(pindexNew);
+    MarkBlockIndexDirty(pindexNew);
 
     return pindexNew;
 }
@@ -248,7 +295,7 @@ void BlockManager::PruneOneBlockFile(const int fileNumber)
             pindex->nFile = 0;
             pindex->nDataPos = 0;
             pindex->nUndoPos = 0;
-            m_dirty_blockindex.insert(pindex);
+            MarkBlockIndexDirty(pindex);
 
             // Prune from m_blocks_unlinked -- any block we prune would have
             // to be downloaded again in order to consider its chain, at which
@@ -463,7 +510,7 @@ bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockha
         }
         if (!(pindex->nStatus & BLOCK_FAILED_MASK) && pindex->pprev && (pindex->pprev->nStatus & BLOCK_FAILED_MASK)) {
             pindex->nStatus |= BLOCK_FAILED_CHILD;
-            m_dirty_blockindex.insert(pindex);
+            MarkBlockIndexDirty(pindex);
         }
         if (pindex->pprev) {
             pindex->BuildSkip();
@@ -476,6 +523,7 @@ bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockha
 bool BlockManager::WriteBlockIndexDB()
 {
     AssertLockHeld(::cs_main);
+    if (!WaitForBlockIndexWrite()) return false;
     std::vector<std::pair<int, const CBlockFileInfo*>> vFiles;
     vFiles.reserve(m_dirty_fileinfo.size());
     for (std::set<int>::iterator it = m_dirty_fileinfo.begin(); it != m_dirty_fileinfo.end();) {
@@ -489,12 +537,25 @@ bool BlockManager::WriteBlockIndexDB()
         m_dirty_blockindex.erase(it++);
     }
     int max_blockfile = WITH_LOCK(cs_LastBlockFile, return this->MaxBlockfileNum());
-    if (!m_block_tree_db->WriteBatchSync(vFiles, max_blockfile, vBlocks)) {
-        return false;
-    }
+    // Serialization happens here, under cs_main, so the batch is immutable by
+    // the time the background thread commits it. At most one write is in
+    // flight at a time: a new one is only queued once its predecessor has
+    // completed (and succeeded).
+    auto batch{m_block_tree_db->MakeBlockIndexBatch(vFiles, max_blockfile, std::move(vBlocks))};
+    BlockTreeDB* db{m_block_tree_db.get()};
+    m_block_index_write = std::async(std::launch::async, [db, batch = std::move(batch)] {
+        return db->WriteBatch(*batch, /*fSync=*/true);
+    });
     return true;
 }
 
+bool BlockManager::WaitForBlockIndexWrite()
+{
+    AssertLockHeld(::cs_main);
+    if (!m_block_index_write.valid()) return true;
+    return m_block_index_write.get();
+}
+
 bool BlockManager::LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash)
 {
     if (!LoadBlockIndex(snapshot_blockhash)) {
@@ -672,7 +733,11 @@ CBlockFileInfo* BlockManager::GetBlockFileInfo(size_t n)
 bool BlockManager::ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index) const
 {
     const FlatFilePos pos{WITH_LOCK(::cs_main, return index.GetUndoPos())};
+    return ReadBlockUndo(blockundo, pos, index.pprev->GetBlockHash());
+}
 
+bool BlockManager::ReadBlockUndo(CBlockUndo& blockundo, const FlatFilePos& pos, const uint256& prev_block_hash) const
+{
     // Open history file to read
     AutoFile filein{OpenUndoFile(pos, true)};
     if (filein.IsNull()) {
@@ -684,7 +749,7 @@ bool BlockManager::ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index
     uint256 hashChecksum;
     HashVerifier verifier{filein}; // Use HashVerifier as reserializing may lose data, c.f. commit d342424301013ec47dc146a4beb49d5c9319d80a
     try {
-        verifier << index.pprev->GetBlockHash();
+        verifier << prev_block_hash;
         verifier >> blockundo;
         filein >> hashChecksum;
     } catch (const std::exception& e) {
@@ -786,6 +851,21 @@ void BlockManager::UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const
     }
 }
 
+void BlockManager::UnlinkPrunedFilesInBackground(const std::set<int>& setFilesToPrune)
+{
+    AssertLockHeld(::cs_main);
+    m_prune_unlink_queue.insert(setFilesToPrune.begin(), setFilesToPrune.end());
+    if (m_prune_unlink_task.valid() &&
+        m_prune_unlink_task.wait_for(std::chrono::seconds::zero()) != std::future_status::ready) {
+        return;
+    }
+    std::set<int> batch;
+    batch.swap(m_prune_unlink_queue);
+    m_prune_unlink_task = std::async(std::launch::async, [this, batch = std::move(batch)] {
+        UnlinkPrunedFiles(batch);
+    });
+}
+
 AutoFile BlockManager::OpenBlockFile(const FlatFilePos& pos, bool fReadOnly) const
 {
     return AutoFile{m_block_file_seq.Open(pos, fReadOnly), m_xor_key};
@@ -936,7 +1016,7 @@ bool BlockManager::FindUndoPos(BlockValidationState& state, int nFile, FlatFileP
     return true;
 }
 
-bool BlockManager::WriteBlockUndo(const CBlockUndo& blockundo, BlockValidationState& state, CBlockIndex& block)
+bool BlockManager::WriteBlockUndo(const DataStream& undo_data, const uint256& checksum, BlockValidationState& state, CBlockIndex& block)
 {
     AssertLockHeld(::cs_main);
     const BlockfileType type = BlockfileTypeForHeight(block.nHeight);
@@ -945,7 +1025,7 @@ bool BlockManager::WriteBlockUndo(const CBlockUndo& blockundo, BlockValidationSt
     // Write undo information to disk
     if (block.GetUndoPos().IsNull()) {
         FlatFilePos pos;
-        const unsigned int blockundo_size{static_cast<unsigned int>(GetSerializeSize(blockundo))};
+        const unsigned int blockundo_size{static_cast<unsigned int>(undo_data.size())};
         if (!FindUndoPos(state, block.nFile, pos, blockundo_size + UNDO_DATA_DISK_OVERHEAD)) {
             LogError("FindUndoPos failed");
             return false;
@@ -957,17 +1037,11 @@ bool BlockManager::WriteBlockUndo(const CBlockUndo& blockundo, BlockValidationSt
             return FatalError(m_opts.notifications, state, _("Failed to write undo data."));
         }
 
-        // Write index header
+        // Write index header, undo data, and checksum
         fileout << GetParams().MessageStart() << blockundo_size;
-        // Write undo data
         pos.nPos += BLOCK_SERIALIZATION_HEADER_SIZE;
-        fileout << blockundo;
-
-        // Calculate & write checksum
-        HashWriter hasher{};
-        hasher << block.pprev->GetBlockHash();
-        hasher << blockundo;
-        fileout << hasher.GetHash();
+        fileout.write(undo_data);
+        fileout << checksum;
 
         // rev files are written in block height order, whereas blk files are written as blocks come in (often out of order)
         // we want to flush the rev (undo) file once we've written the last block, which is indicated by the last height
@@ -989,7 +1063,7 @@ bool BlockManager::WriteBlockUndo(const CBlockUndo& blockundo, BlockValidationSt
         // update nUndoPos in block index
         block.nUndoPos = pos.nPos;
         block.nStatus |= BLOCK_HAVE_UNDO;
-        m_dirty_blockindex.insert(&block);
+        MarkBlockIndexDirty(&block);
     }
 
     return true;
@@ -1088,6 +1162,36 @@ bool BlockManager::ReadRawBlock(std::vector<uint8_t>& block, const FlatFilePos&
     return true;
 }
 
+void BlockManager::PrefetchBlock(const FlatFilePos& pos) const
+{
+#ifdef POSIX_FADV_WILLNEED
+    // As in ReadRawBlock, nPos < 8 means a null position.
+    if (pos.IsNull() || pos.nPos < 8) return;
+    FlatFilePos hpos{pos.nFile, pos.nPos - 8};
+    AutoFile file{OpenBlockFile(hpos, true)};
+    if (file.IsNull()) return;
+    std::FILE* raw_file{file.release()};
+    // Cover the meta header plus the largest possible block; advising past
+    // the end of the file is harmless.
+    posix_fadvise(fileno(raw_file), hpos.nPos, MAX_BLOCK_SERIALIZED_SIZE + 8, POSIX_FADV_WILLNEED);
+    std::fclose(raw_file);
+#endif
+}
+
+void BlockManager::PrefetchBlockUndo(const FlatFilePos& pos) const
+{
+#ifdef POSIX_FADV_WILLNEED
+    if (pos.IsNull()) return;
+    AutoFile file{OpenUndoFile(pos, true)};
+    if (file.IsNull()) return;
+    std::FILE* raw_file{file.release()};
+    // Undo data is much smaller than the block itself; the block size is a
+    // safe upper bound, and advising past the end of the file is harmless.
+    posix_fadvise(fileno(raw_file), pos.nPos, MAX_BLOCK_SERIALIZED_SIZE, POSIX_FADV_WILLNEED);
+    std::fclose(raw_file);
+#endif
+}
+
 FlatFilePos BlockManager::WriteBlock(const CBlock& block, int nHeight)
 {
     const unsigned int block_size{static_cast<unsigned int>(GetSerializeSize(TX_WITH_WITNESS(block)))};
@@ -1103,11 +1207,14 @@ FlatFilePos BlockManager::WriteBlock(const CBlock& block, int nHeight)
         return FlatFilePos();
     }
 
-    // Write index header
-    fileout << GetParams().MessageStart() << block_size;
-    // Write block
+    // Serialize the index header and block into one buffer so the record
+    // reaches the file as a single large write rather than one buffered
+    // write per serialized field.
+    DataStream block_data{};
+    block_data.reserve(block_size + BLOCK_SERIALIZATION_HEADER_SIZE);
+    block_data << GetParams().MessageStart() << block_size << TX_WITH_WITNESS(block);
+    fileout.write(block_data);
     pos.nPos += BLOCK_SERIALIZATION_HEADER_SIZE;
-    fileout << TX_WITH_WITNESS(block);
     return pos;
 }
 
@@ -1194,26 +1301,45 @@ void ImportBlocks(ChainstateManager& chainman, std::span<const fs::path> import_
 
     // -reindex
     if (!chainman.m_blockman.m_blockfiles_indexed) {
-        int nFile = 0;
+        int num_files = 0;
+        while (fs::exists(chainman.m_blockman.GetBlockPosFilename(FlatFilePos(num_files, 0)))) {
+            num_files++;
+        }
         // Map of disk positions for blocks with unknown parent (only used for reindex);
         // parent hash -> child disk position, multiple children can have the same parent.
+        // Shared between the import threads; only accessed under cs_main.
         std::multimap<uint256, FlatFilePos> blocks_with_unknown_parent;
-        while (true) {
-            FlatFilePos pos(nFile, 0);
-            if (!fs::exists(chainman.m_blockman.GetBlockPosFilename(pos))) {
-                break; // No block files left to reindex
-            }
-            AutoFile file{chainman.m_blockman.OpenBlockFile(pos, true)};
-            if (file.IsNull()) {
-                break; // This error is logged in OpenBlockFile
-            }
-            LogPrintf("Reindexing block file blk%05u.dat...\n", (unsigned int)nFile);
-            chainman.LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent);
-            if (chainman.m_interrupt) {
-                LogPrintf("Interrupt requested. Exit %s\n", __func__);
-                return;
-            }
-            nFile++;
+        // Scan the block files on several threads: finding block starts,
+        // reading and deserializing happen in parallel, while index updates
+        // (AcceptBlock) stay serialized under cs_main. Files are handed out
+        // in order, but any cross-file ordering this loses is already handled
+        // by the unknown-parent stash, the same way out-of-order blocks
+        // within one file are.
+        std::atomic<int> next_file{0};
+        const int num_threads{std::clamp(GetNumCores() - 1, 1, 8)};
+        std::vector<std::thread> import_threads;
+        import_threads.reserve(num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            import_threads.emplace_back(&util::TraceThread, strprintf("import%i", i), [&] {
+                while (!chainman.m_interrupt) {
+                    const int file_num{next_file.fetch_add(1)};
+                    if (file_num >= num_files) return;
+                    FlatFilePos pos(file_num, 0);
+                    AutoFile file{chainman.m_blockman.OpenBlockFile(pos, true)};
+                    if (file.IsNull()) {
+                        return; // This error is logged in OpenBlockFile
+                    }
+                    LogPrintf("Reindexing block file blk%05u.dat...\n", (unsigned int)file_num);
+                    chainman.LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent);
+                }
+            });
+        }
+        for (auto& thread : import_threads) {
+            thread.join();
+        }
+        if (chainman.m_interrupt) {
+            LogPrintf("Interrupt requested. Exit %s\n", __func__);
+            return;
         }
         WITH_LOCK(::cs_main, chainman.m_blockman.m_block_tree_db->WriteReindexing(false));
         chainman.m_blockman.m_blockfiles_indexed = true;
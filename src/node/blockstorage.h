@@ -15,6 +15,7 @@
 #include <kernel/messagestartchars.h>
 #include <primitives/block.h>
 #include <streams.h>
+#include <support/allocators/pool.h>
 #include <sync.h>
 #include <uint256.h>
 #include <util/fs.h>
@@ -24,6 +25,7 @@
 #include <atomic>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <limits>
 #include <map>
 #include <memory>
@@ -53,6 +55,12 @@ class BlockTreeDB : public CDBWrapper
 public:
     using CDBWrapper::CDBWrapper;
     bool WriteBatchSync(const std::vector<std::pair<int, const CBlockFileInfo*>>& fileInfo, int nLastFile, const std::vector<const CBlockIndex*>& blockinfo);
+    /** Serialize dirty block index entries and file info records into a
+     *  batch. Block index entries are added in ascending key order, which
+     *  keeps LevelDB's memtable inserts on their sequential fast path. The
+     *  returned batch holds only already-serialized data, so it may be
+     *  committed (WriteBatch) from another thread. */
+    std::unique_ptr<CDBBatch> MakeBlockIndexBatch(const std::vector<std::pair<int, const CBlockFileInfo*>>& fileInfo, int nLastFile, std::vector<const CBlockIndex*> blockinfo);
     bool ReadBlockFileInfo(int nFile, CBlockFileInfo& info);
     bool ReadLastBlockFile(int& nFile);
     bool WriteReindexing(bool fReindexing);
@@ -84,7 +92,21 @@ static constexpr size_t UNDO_DATA_DISK_OVERHEAD{BLOCK_SERIALIZATION_HEADER_SIZE
 // we ever switch to another associative container, we need to either use a
 // container that has stable addressing (true of all std associative
 // containers), or make the key a `std::unique_ptr<CBlockIndex>`
-using BlockMap = std::unordered_map<uint256, CBlockIndex, BlockHasher>;
+//
+// The nodes are allocated from a PoolResource (same scheme as CCoinsMap):
+// the index holds one entry per header ever seen and never erases, so
+// arena-style pages keep the chain-walk working set dense and drop the
+// per-node malloc overhead that a million individually allocated
+// CBlockIndex objects would otherwise carry. See CCoinsMap for the
+// MAX_BLOCK_SIZE_BYTES rationale (node overhead of up to 4 pointers).
+using BlockMapEntry = std::pair<const uint256, CBlockIndex>;
+using BlockMap = std::unordered_map<uint256,
+                                    CBlockIndex,
+                                    BlockHasher,
+                                    std::equal_to<uint256>,
+                                    PoolAllocator<BlockMapEntry,
+                                                  sizeof(BlockMapEntry) + sizeof(void*) * 4>>;
+using BlockMapMemoryResource = BlockMap::allocator_type::ResourceType;
 
 struct CBlockIndexWorkComparator {
     bool operator()(const CBlockIndex* pa, const CBlockIndex* pb) const;
@@ -240,6 +262,20 @@ private:
     /** Dirty block index entries. */
     std::set<CBlockIndex*> m_dirty_blockindex;
 
+    /** Block index entries modified since the last CheckBlockIndex() pass.
+     *  Unlike m_dirty_blockindex this is not drained by flushing;
+     *  ChainstateManager::CheckBlockIndex() consumes it to validate only
+     *  what changed. */
+    std::set<CBlockIndex*> m_modified_since_check;
+
+    /** Mark a block index entry as modified: queue it for the next index
+     *  write and record it for incremental consistency checking. */
+    void MarkBlockIndexDirty(CBlockIndex* pindex)
+    {
+        m_dirty_blockindex.insert(pindex);
+        m_modified_since_check.insert(pindex);
+    }
+
     /** Dirty block file entries. */
     std::set<int> m_dirty_fileinfo;
 
@@ -274,7 +310,9 @@ public:
      */
     std::atomic_bool m_blockfiles_indexed{true};
 
-    BlockMap m_block_index GUARDED_BY(cs_main);
+    //! Declared before m_block_index so the arena outlives the map.
+    BlockMapMemoryResource m_block_index_memory_resource;
+    BlockMap m_block_index GUARDED_BY(cs_main){0, BlockHasher{}, std::equal_to<uint256>{}, &m_block_index_memory_resource};
 
     /**
      * The height of the base block of an assumeutxo snapshot, if one is in use.
@@ -300,7 +338,32 @@ public:
 
     std::unique_ptr<BlockTreeDB> m_block_tree_db GUARDED_BY(::cs_main);
 
+    //! Outstanding background block index write started by
+    //! WriteBlockIndexDB(), if any. Declared after m_block_tree_db so its
+    //! destructor (which blocks on the async task) runs before the database
+    //! is torn down.
+    std::future<bool> m_block_index_write GUARDED_BY(::cs_main);
+
+    //! Block file numbers identified for pruning whose on-disk unlink is
+    //! still pending. Filled at flush time and drained in background batches
+    //! so multi-file unlinks never ride the validation critical path. Files
+    //! left behind by a crash before the unlink ran are cleaned up by
+    //! ScanAndUnlinkAlreadyPrunedFiles() on the next start.
+    std::set<int> m_prune_unlink_queue GUARDED_BY(::cs_main);
+    //! At most one unlink batch runs at a time; the future's destructor
+    //! joins any remaining work on shutdown.
+    std::future<void> m_prune_unlink_task GUARDED_BY(::cs_main);
+
+    //! Serialize the dirty block index entries and file info records under
+    //! cs_main, then commit them to the database on a background thread so
+    //! the write overlaps with validation. Returns false if a previously
+    //! started write failed.
     bool WriteBlockIndexDB() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    //! Wait for any background write started by WriteBlockIndexDB() and
+    //! return whether it succeeded (true if none is outstanding). Must be
+    //! called before any state that refers to block index entries is flushed
+    //! (the chainstate) and before pruned block files are unlinked.
+    bool WaitForBlockIndexWrite() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     bool LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
@@ -324,7 +387,16 @@ public:
     /** Get block file info entry for one block file */
     CBlockFileInfo* GetBlockFileInfo(size_t n);
 
-    bool WriteBlockUndo(const CBlockUndo& blockundo, BlockValidationState& state, CBlockIndex& block)
+    /** Store a block's undo data on disk and update the block index.
+     *
+     * The undo data is passed pre-serialized together with its checksum so
+     * the caller can compute both off the critical path (ConnectBlock
+     * overlaps them with the script verification wait).
+     *
+     * @param[in]  undo_data    the serialized CBlockUndo record
+     * @param[in]  checksum     Hash(pprev block hash || undo_data)
+     */
+    bool WriteBlockUndo(const DataStream& undo_data, const uint256& checksum, BlockValidationState& state, CBlockIndex& block)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
     /** Store block on disk and update block file statistics.
@@ -413,12 +485,32 @@ public:
      */
     void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const;
 
+    /**
+     * Queue the specified files for unlinking and start a background batch
+     * for them unless one is already running (the next call picks up
+     * whatever is left). Callers must ensure the block index write recording
+     * the files as pruned has been committed to disk first.
+     */
+    void UnlinkPrunedFilesInBackground(const std::set<int>& setFilesToPrune) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     /** Functions for disk access for blocks */
     bool ReadBlock(CBlock& block, const FlatFilePos& pos) const;
     bool ReadBlock(CBlock& block, const CBlockIndex& index) const;
     bool ReadRawBlock(std::vector<uint8_t>& block, const FlatFilePos& pos) const;
 
+    /** Hint the OS to load a block's raw data into the page cache. Advisory
+     *  and asynchronous (a no-op where posix_fadvise is unavailable); any
+     *  failure is ignored. */
+    void PrefetchBlock(const FlatFilePos& pos) const;
+
+    //! Counterpart of PrefetchBlock for undo (rev) files.
+    void PrefetchBlockUndo(const FlatFilePos& pos) const;
+
     bool ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index) const;
+    //! Read undo data from the given position, verifying its checksum against
+    //! the hash of the previous block. Takes no locks, so it is usable from a
+    //! background reader while cs_main is held elsewhere.
+    bool ReadBlockUndo(CBlockUndo& blockundo, const FlatFilePos& pos, const uint256& prev_block_hash) const;
 
     void CleanupBlockRevFiles() const;
 };
@@ -0,0 +1,90 @@
+// Copyright (c) 2024-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockview.h>
+
+#include <serialize.h>
+#include <streams.h>
+
+#include <ios>
+
+namespace node {
+BlockView::BlockView(std::span<const uint8_t> data) : m_data{data}
+{
+    try {
+        SpanReader reader{data};
+        const auto tell{[&]() -> size_t { return data.size() - reader.size(); }};
+        const auto skip{[&](size_t n) {
+            if (n > reader.size()) throw std::ios_base::failure("BlockView: end of data");
+            reader.ignore(n);
+        }};
+
+        reader >> m_header;
+        const uint64_t tx_count{ReadCompactSize(reader)};
+        m_txs_offset = tell();
+        if (tx_count > reader.size()) throw std::ios_base::failure("BlockView: tx count exceeds data");
+        m_txs.reserve(tx_count);
+
+        for (uint64_t t = 0; t < tx_count; ++t) {
+            const size_t tx_begin{tell()};
+            skip(4); // nVersion
+            uint64_t vin_count{ReadCompactSize(reader)};
+            bool segwit{false};
+            if (vin_count == 0) {
+                // BIP144 marker: the next byte is the flag, followed by the
+                // real input count.
+                uint8_t flag;
+                reader >> flag;
+                if (flag != 1) throw std::ios_base::failure("BlockView: invalid segwit flag");
+                segwit = true;
+                vin_count = ReadCompactSize(reader);
+            }
+            for (uint64_t in = 0; in < vin_count; ++in) {
+                skip(36); // prevout
+                skip(ReadCompactSize(reader)); // scriptSig
+                skip(4); // nSequence
+            }
+            const uint64_t vout_count{ReadCompactSize(reader)};
+            for (uint64_t out_n = 0; out_n < vout_count; ++out_n) {
+                skip(8); // nValue
+                skip(ReadCompactSize(reader)); // scriptPubKey
+            }
+            size_t witness_offset{0};
+            if (segwit) {
+                witness_offset = tell();
+                for (uint64_t in = 0; in < vin_count; ++in) {
+                    const uint64_t stack_size{ReadCompactSize(reader)};
+                    for (uint64_t item = 0; item < stack_size; ++item) {
+                        skip(ReadCompactSize(reader));
+                    }
+                }
+            }
+            skip(4); // nLockTime
+            m_txs.push_back({/*offset=*/static_cast<uint32_t>(tx_begin),
+                             /*size=*/static_cast<uint32_t>(tell() - tx_begin),
+                             /*witness_offset=*/static_cast<uint32_t>(witness_offset)});
+        }
+        if (!reader.empty()) throw std::ios_base::failure("BlockView: trailing data");
+        m_valid = true;
+    } catch (const std::ios_base::failure&) {
+        m_txs.clear();
+        m_valid = false;
+    }
+}
+
+void BlockView::AppendTxWithoutWitness(size_t i, std::vector<uint8_t>& out) const
+{
+    const TxRange& range{m_txs.at(i)};
+    const auto tx{m_data.subspan(range.offset, range.size)};
+    if (range.witness_offset == 0) {
+        out.insert(out.end(), tx.begin(), tx.end());
+        return;
+    }
+    // nVersion, then everything between the BIP144 marker/flag bytes and the
+    // witness section, then nLockTime.
+    out.insert(out.end(), tx.begin(), tx.begin() + 4);
+    out.insert(out.end(), tx.begin() + 6, tx.begin() + (range.witness_offset - range.offset));
+    out.insert(out.end(), tx.end() - 4, tx.end());
+}
+} // namespace node
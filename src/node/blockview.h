@@ -0,0 +1,68 @@
+// Copyright (c) 2024-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_BLOCKVIEW_H
+#define BITCOIN_NODE_BLOCKVIEW_H
+
+#include <primitives/block.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace node {
+/** Non-owning view over a block in serialized (disk/network) form.
+ *
+ * Per-transaction byte offsets are computed once on construction, so
+ * consumers that only need raw transaction bytes (relay, publishing) can
+ * slice them straight out of the buffer without materializing a CBlock
+ * object graph. A parse failure leaves the view invalid instead of throwing;
+ * callers must check IsValid() before any other accessor. The view does not
+ * own the buffer, which must outlive it.
+ */
+class BlockView
+{
+private:
+    struct TxRange {
+        //! Start of the serialized transaction within the block buffer.
+        uint32_t offset;
+        //! Total serialized size, including any witness data.
+        uint32_t size;
+        //! Offset of the witness section within the block buffer, or 0 for
+        //! transactions serialized without witness data.
+        uint32_t witness_offset;
+    };
+
+    std::span<const uint8_t> m_data;
+    CBlockHeader m_header;
+    std::vector<TxRange> m_txs;
+    //! Offset of the first transaction (end of header + tx count).
+    size_t m_txs_offset{0};
+    bool m_valid{false};
+
+public:
+    explicit BlockView(std::span<const uint8_t> data);
+
+    bool IsValid() const { return m_valid; }
+    const CBlockHeader& GetHeader() const { return m_header; }
+    size_t TxCount() const { return m_txs.size(); }
+
+    //! Raw bytes of transaction i, as serialized in the block.
+    std::span<const uint8_t> TxBytes(size_t i) const
+    {
+        const TxRange& range{m_txs.at(i)};
+        return m_data.subspan(range.offset, range.size);
+    }
+
+    //! Serialized header followed by the transaction count, i.e. everything
+    //! preceding the first transaction.
+    std::span<const uint8_t> PrefixBytes() const { return m_data.first(m_txs_offset); }
+
+    //! Append transaction i to out in non-witness serialization.
+    void AppendTxWithoutWitness(size_t i, std::vector<uint8_t>& out) const;
+};
+} // namespace node
+
+#endif // BITCOIN_NODE_BLOCKVIEW_H
@@ -47,10 +47,19 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& args, ChainstateManage
         }
     }
 
+    if (auto value{args.GetArg("-assumevalidpow")}) {
+        if (auto block_hash{uint256::FromUserHex(*value)}) {
+            opts.assumed_valid_pow_block = *block_hash;
+        } else {
+            return util::Error{Untranslated(strprintf("Invalid assumevalidpow block hash specified (%s), must be up to %d hex digits (or 0 to disable)", *value, uint256::size() * 2))};
+        }
+    }
+
     if (auto value{args.GetIntArg("-maxtipage")}) opts.max_tip_age = std::chrono::seconds{*value};
 
     ReadDatabaseArgs(args, opts.block_tree_db);
     ReadDatabaseArgs(args, opts.coins_db);
+    if (auto value{args.GetIntArg("-coinsdbblocksize")}) opts.coins_db.block_size = *value;
     ReadCoinsViewArgs(args, opts.coins_view);
 
     int script_threads = args.GetIntArg("-par", DEFAULT_SCRIPTCHECK_THREADS);
@@ -0,0 +1,126 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or https://opensource.org/license/mit/.
+
+#include <node/coins_warmstart.h>
+
+#include <coins.h>
+#include <kernel/cs_main.h>
+#include <logging.h>
+#include <primitives/transaction.h>
+#include <streams.h>
+#include <sync.h>
+#include <tinyformat.h>
+#include <util/fs.h>
+#include <util/fs_helpers.h>
+#include <util/signalinterrupt.h>
+#include <util/time.h>
+#include <validation.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+namespace node {
+
+static const uint64_t COINS_WARM_VERSION{1};
+
+//! Number of coins fetched per cs_main acquisition while warming the cache.
+static constexpr size_t COINS_WARM_BATCH{1024};
+
+bool DumpCoinsCacheKeys(ChainstateManager& chainman, const fs::path& dump_path)
+{
+    const auto start{SteadyClock::now()};
+
+    std::vector<COutPoint> keys;
+    {
+        LOCK(cs_main);
+        if (chainman.GetAll().empty()) return false;
+        Chainstate& chainstate{chainman.ActiveChainstate()};
+        if (!chainstate.CanFlushToDisk()) return false;
+        keys = chainstate.CoinsTip().GetCachedCoinKeys();
+    }
+
+    AutoFile file{fsbridge::fopen(dump_path + ".new", "wb")};
+    if (file.IsNull()) {
+        return false;
+    }
+
+    try {
+        file << COINS_WARM_VERSION;
+        file << uint64_t{keys.size()};
+        for (const COutPoint& outpoint : keys) {
+            file << outpoint;
+        }
+
+        if (!file.Commit()) throw std::runtime_error("Commit failed");
+        file.fclose();
+        if (!RenameOver(dump_path + ".new", dump_path)) {
+            throw std::runtime_error("Rename failed");
+        }
+
+        LogInfo("Dumped %u coins cache keys to file in %.3fs\n", keys.size(),
+                Ticks<SecondsDouble>(SteadyClock::now() - start));
+    } catch (const std::exception& e) {
+        LogInfo("Failed to dump coins cache keys: %s. Continuing anyway.\n", e.what());
+        return false;
+    }
+    return true;
+}
+
+void WarmCoinsCache(ChainstateManager& chainman, const fs::path& load_path)
+{
+    AutoFile file{fsbridge::fopen(load_path, "rb")};
+    if (file.IsNull()) return;
+
+    const auto start{SteadyClock::now()};
+
+    std::vector<COutPoint> keys;
+    try {
+        uint64_t version;
+        file >> version;
+        if (version != COINS_WARM_VERSION) {
+            throw std::runtime_error(strprintf("unknown version %u", version));
+        }
+        uint64_t count;
+        file >> count;
+        keys.reserve(count);
+        for (uint64_t i{0}; i < count; ++i) {
+            COutPoint outpoint;
+            file >> outpoint;
+            keys.push_back(outpoint);
+        }
+    } catch (const std::exception& e) {
+        LogInfo("Failed to read coins cache keys: %s. Continuing anyway.\n", e.what());
+        fs::remove(load_path);
+        return;
+    }
+    // One-shot: a stale working set should not be replayed on a later start.
+    fs::remove(load_path);
+
+    // Sorted keys keep the coins database reads mostly sequential.
+    std::sort(keys.begin(), keys.end());
+
+    size_t loaded{0};
+    for (size_t batch_start{0}; batch_start < keys.size(); batch_start += COINS_WARM_BATCH) {
+        if (chainman.m_interrupt) return;
+
+        LOCK(cs_main);
+        Chainstate& chainstate{chainman.ActiveChainstate()};
+        if (chainstate.GetCoinsCacheSizeState() != CoinsCacheSizeState::OK) break;
+        CCoinsViewCache& cache{chainstate.CoinsTip()};
+        const size_t batch_end{std::min(batch_start + COINS_WARM_BATCH, keys.size())};
+        for (size_t i{batch_start}; i < batch_end; ++i) {
+            // Pulls the coin from the backing view into the cache; coins
+            // spent since the dump was taken simply fail to resolve.
+            if (cache.GetCoin(keys[i])) ++loaded;
+        }
+    }
+
+    LogInfo("Warmed coins cache with %u of %u coins in %.3fs\n", loaded, keys.size(),
+            Ticks<SecondsDouble>(SteadyClock::now() - start));
+}
+
+} // namespace node
@@ -0,0 +1,42 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or https://opensource.org/license/mit/.
+
+#ifndef BITCOIN_NODE_COINS_WARMSTART_H
+#define BITCOIN_NODE_COINS_WARMSTART_H
+
+#include <util/fs.h>
+
+class ChainstateManager;
+
+namespace node {
+
+static constexpr bool DEFAULT_COINS_WARM_START{true};
+
+//! Name of the coins cache working-set file, relative to the datadir.
+const fs::path COINS_WARM_FILENAME{"coinswarm.dat"};
+
+/**
+ * Persist the outpoint keys (not the coins themselves) of every unspent
+ * entry in the active coins tip cache to dump_path, so that the next start
+ * can re-fetch the same working set from the coins database.
+ *
+ * Must run before the cache is flushed at shutdown, since Flush() empties it.
+ *
+ * @return true if the file was written.
+ */
+bool DumpCoinsCacheKeys(ChainstateManager& chainman, const fs::path& dump_path);
+
+/**
+ * Stream the coins whose keys were saved by DumpCoinsCacheKeys() from the
+ * coins database back into the active coins tip cache, in sorted batches so
+ * that leveldb reads stay mostly sequential. cs_main is only held per batch,
+ * and loading stops early if the node is interrupted or the cache fills up.
+ *
+ * The file is removed once read, whether or not loading completes.
+ */
+void WarmCoinsCache(ChainstateManager& chainman, const fs::path& load_path);
+
+} // namespace node
+
+#endif // BITCOIN_NODE_COINS_WARMSTART_H
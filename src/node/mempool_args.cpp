@@ -94,6 +94,8 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& argsman, const CChainP
 
     mempool_opts.persist_v1_dat = argsman.GetBoolArg("-persistmempoolv1", mempool_opts.persist_v1_dat);
 
+    mempool_opts.trace_file = argsman.GetPathArg("-mempooltrace", mempool_opts.trace_file);
+
     ApplyArgsManOptions(argsman, mempool_opts.limits);
 
     return {};
@@ -55,6 +55,19 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
     int64_t unbroadcast = 0;
     const auto now{NodeClock::now()};
 
+    // A persisted transaction, parsed but not yet admitted.
+    struct PersistedTx {
+        CTransactionRef tx;
+        int64_t time;
+        int64_t fee_delta;
+    };
+    std::vector<PersistedTx> persisted;
+    std::map<uint256, CAmount> mapDeltas;
+    std::set<uint256> unbroadcast_txids;
+
+    // Parse the whole file up front, without taking any validation locks:
+    // deserialization is cheap compared to admission, this releases the file
+    // promptly, and a corrupt dump is rejected before any entry is admitted.
     try {
         uint64_t version;
         file >> version;
@@ -69,30 +82,45 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
         file.SetXor(xor_key);
         uint64_t total_txns_to_load;
         file >> total_txns_to_load;
-        uint64_t txns_tried = 0;
         LogInfo("Loading %u mempool transactions from file...\n", total_txns_to_load);
+        // The count is untrusted file data; cap the speculative allocation.
+        persisted.reserve(std::min<uint64_t>(total_txns_to_load, 10'000));
+        for (uint64_t i = 0; i < total_txns_to_load; ++i) {
+            PersistedTx entry;
+            file >> TX_WITH_WITNESS(entry.tx);
+            file >> entry.time;
+            file >> entry.fee_delta;
+            persisted.push_back(std::move(entry));
+        }
+        file >> mapDeltas;
+        file >> unbroadcast_txids;
+    } catch (const std::exception& e) {
+        LogInfo("Failed to deserialize mempool data on file: %s. Continuing anyway.\n", e.what());
+        return false;
+    }
+    file.fclose();
+
+    // Admit the parsed entries. The dump was written in the mempool's
+    // depth-and-score order, so parents precede children and the
+    // best-feerate transactions of each generation are admitted (and
+    // relayable) first. cs_main is taken per transaction so block
+    // connection and relay interleave with the load.
+    try {
+        uint64_t txns_tried = 0;
         int next_tenth_to_report = 0;
-        while (txns_tried < total_txns_to_load) {
-            const int percentage_done(100.0 * txns_tried / total_txns_to_load);
+        for (const PersistedTx& entry : persisted) {
+            const int percentage_done(100.0 * txns_tried / persisted.size());
             if (next_tenth_to_report < percentage_done / 10) {
                 LogInfo("Progress loading mempool transactions from file: %d%% (tried %u, %u remaining)\n",
-                        percentage_done, txns_tried, total_txns_to_load - txns_tried);
+                        percentage_done, txns_tried, persisted.size() - txns_tried);
                 next_tenth_to_report = percentage_done / 10;
             }
             ++txns_tried;
 
-            CTransactionRef tx;
-            int64_t nTime;
-            int64_t nFeeDelta;
-            file >> TX_WITH_WITNESS(tx);
-            file >> nTime;
-            file >> nFeeDelta;
+            const CTransactionRef& tx = entry.tx;
+            const int64_t nTime = opts.use_current_time ? TicksSinceEpoch<std::chrono::seconds>(now) : entry.time;
 
-            if (opts.use_current_time) {
-                nTime = TicksSinceEpoch<std::chrono::seconds>(now);
-            }
-
-            CAmount amountdelta = nFeeDelta;
+            CAmount amountdelta = entry.fee_delta;
             if (amountdelta && opts.apply_fee_delta_priority) {
                 pool.PrioritiseTransaction(tx->GetHash(), amountdelta);
             }
@@ -118,8 +146,6 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
             if (active_chainstate.m_chainman.m_interrupt)
                 return false;
         }
-        std::map<uint256, CAmount> mapDeltas;
-        file >> mapDeltas;
 
         if (opts.apply_fee_delta_priority) {
             for (const auto& i : mapDeltas) {
@@ -127,8 +153,6 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
             }
         }
 
-        std::set<uint256> unbroadcast_txids;
-        file >> unbroadcast_txids;
         if (opts.apply_unbroadcast_set) {
             unbroadcast = unbroadcast_txids.size();
             for (const auto& txid : unbroadcast_txids) {
@@ -138,7 +162,7 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
             }
         }
     } catch (const std::exception& e) {
-        LogInfo("Failed to deserialize mempool data on file: %s. Continuing anyway.\n", e.what());
+        LogInfo("Failed to import mempool data: %s. Continuing anyway.\n", e.what());
         return false;
     }
 
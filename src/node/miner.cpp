@@ -7,6 +7,7 @@
 
 #include <chain.h>
 #include <chainparams.h>
+#include <cluster_linearize.h>
 #include <coins.h>
 #include <common/args.h>
 #include <consensus/amount.h>
@@ -20,11 +21,14 @@
 #include <policy/policy.h>
 #include <pow.h>
 #include <primitives/transaction.h>
+#include <util/bitset.h>
 #include <util/moneystr.h>
 #include <util/time.h>
 #include <validation.h>
 
 #include <algorithm>
+#include <numeric>
+#include <unordered_map>
 #include <utility>
 
 namespace node {
@@ -137,6 +141,13 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock()
     int nDescendantsUpdated = 0;
     if (m_mempool) {
         addPackageTxs(nPackagesSelected, nDescendantsUpdated);
+        // Remember this selection to seed the next build against the same tip.
+        m_last_template_tip = pindexPrev->GetBlockHash();
+        m_last_template_txids.clear();
+        m_last_template_txids.reserve(pblock->vtx.size() - 1);
+        for (size_t i = 1; i < pblock->vtx.size(); ++i) {
+            m_last_template_txids.push_back(pblock->vtx[i]->GetHash());
+        }
     }
 
     const auto time_1{SteadyClock::now()};
@@ -275,6 +286,75 @@ void BlockAssembler::SortForBlock(const CTxMemPool::setEntries& package, std::ve
     std::sort(sortedEntries.begin(), sortedEntries.end(), CompareTxIterByAncestorCount());
 }
 
+int BlockAssembler::AddPackagePrefix(CTxMemPool::txiter iter, indexed_modified_transaction_set& mapModifiedTx, int& nDescendantsUpdated)
+{
+    // The cluster linearization engine works on fixed-capacity bitsets; this
+    // bounds the package size it can handle. Larger packages are simply
+    // skipped, as the legacy behavior (dropping the whole package) remains
+    // correct.
+    using ClusterSet = BitSet<64>;
+    //! Search budget for Linearize(); the ancestor-set-based fallback keeps
+    //! the result valid (and no worse than the input order) if it runs out.
+    constexpr uint64_t MAX_LINEARIZE_ITERS{5000};
+
+    const auto& mempool{*Assert(m_mempool)};
+    auto ancestors{mempool.AssumeCalculateMemPoolAncestors(__func__, *iter, CTxMemPool::Limits::NoLimits(), /*fSearchForParents=*/false)};
+    onlyUnconfirmed(ancestors);
+    ancestors.insert(iter);
+    if (ancestors.size() < 2 || ancestors.size() > ClusterSet::Size()) return 0;
+    if (!TestPackageTransactions(ancestors)) return 0;
+
+    // Feed the package into a dependency graph, in a valid block order so the
+    // insertion order doubles as the initial linearization.
+    std::vector<CTxMemPool::txiter> sortedEntries;
+    SortForBlock(ancestors, sortedEntries);
+    cluster_linearize::DepGraph<ClusterSet> depgraph;
+    std::unordered_map<Txid, cluster_linearize::ClusterIndex, SaltedTxidHasher> tx_index;
+    tx_index.reserve(sortedEntries.size());
+    for (CTxMemPool::txiter it : sortedEntries) {
+        const auto idx{depgraph.AddTransaction(FeeFrac{it->GetModifiedFee(), it->GetTxSize()})};
+        tx_index.emplace(it->GetSharedTx()->GetHash(), idx);
+    }
+    for (cluster_linearize::ClusterIndex idx = 0; idx < sortedEntries.size(); ++idx) {
+        ClusterSet parents;
+        for (const CTxMemPoolEntry& parent : sortedEntries[idx]->GetMemPoolParentsConst()) {
+            const auto it{tx_index.find(parent.GetSharedTx()->GetHash())};
+            if (it != tx_index.end()) parents.Set(it->second);
+        }
+        if (parents.Any()) depgraph.AddDependencies(parents, idx);
+    }
+
+    std::vector<cluster_linearize::ClusterIndex> old_linearization(sortedEntries.size());
+    std::iota(old_linearization.begin(), old_linearization.end(), cluster_linearize::ClusterIndex{0});
+    auto linearization{cluster_linearize::Linearize(depgraph, MAX_LINEARIZE_ITERS, /*rng_seed=*/0, old_linearization).first};
+    cluster_linearize::PostLinearize(depgraph, linearization);
+
+    // Add whole chunks, in order, while they fit; later chunks may depend on
+    // earlier ones, so stop at the first one that does not.
+    cluster_linearize::LinearizationChunking chunking(depgraph, linearization);
+    int added{0};
+    CTxMemPool::setEntries included;
+    for (cluster_linearize::ClusterIndex n = 0; n < chunking.NumChunksLeft(); ++n) {
+        const auto& chunk{chunking.GetChunk(n)};
+        if (chunk.feerate.fee < m_options.blockMinFeeRate.GetFee(chunk.feerate.size)) break;
+        int64_t chunk_sigops{0};
+        for (auto idx : chunk.transactions) chunk_sigops += sortedEntries[idx]->GetSigOpCost();
+        if (!TestPackage(chunk.feerate.size, chunk_sigops)) break;
+        for (auto idx : linearization) {
+            if (!chunk.transactions[idx]) continue;
+            AddToBlock(sortedEntries[idx]);
+            mapModifiedTx.erase(sortedEntries[idx]);
+            included.insert(sortedEntries[idx]);
+            ++added;
+        }
+        pblocktemplate->m_package_feerates.emplace_back(chunk.feerate);
+    }
+    if (!included.empty()) {
+        nDescendantsUpdated += UpdatePackagesForAdded(mempool, included, mapModifiedTx);
+    }
+    return added;
+}
+
 // This transaction selection algorithm orders the mempool based
 // on feerate of a transaction including all unconfirmed ancestors.
 // Since we don't remove transactions from the mempool as we select them
@@ -296,6 +376,36 @@ void BlockAssembler::addPackageTxs(int& nPackagesSelected, int& nDescendantsUpda
     // Keep track of entries that failed inclusion, to avoid duplicate work
     std::set<Txid> failedTx;
 
+    // Replay the previous template's selection when the tip is unchanged and
+    // all of it is still in the mempool. The cached order is a valid block
+    // order, and finality cannot regress against the same tip, so the entries
+    // can be added wholesale. A single missing (evicted or replaced)
+    // transaction invalidates the whole cached selection, since later entries
+    // may have depended on it.
+    if (m_last_template_tip == m_chainstate.m_chain.Tip()->GetBlockHash() && !m_last_template_txids.empty()) {
+        std::vector<CTxMemPool::txiter> cached_iters;
+        cached_iters.reserve(m_last_template_txids.size());
+        for (const Txid& txid : m_last_template_txids) {
+            if (const auto it{mempool.GetIter(txid)}) {
+                cached_iters.push_back(*it);
+            } else {
+                cached_iters.clear();
+                break;
+            }
+        }
+        if (!cached_iters.empty()) {
+            CTxMemPool::setEntries preseeded;
+            for (CTxMemPool::txiter it : cached_iters) {
+                AddToBlock(it);
+                preseeded.insert(it);
+            }
+            // Make sure the not-yet-selected descendants see their ancestors
+            // as already included.
+            nDescendantsUpdated += UpdatePackagesForAdded(mempool, preseeded, mapModifiedTx);
+            LogDebug(BCLog::BENCH, "addPackageTxs(): reused %u transactions from previous template\n", cached_iters.size());
+        }
+    }
+
     CTxMemPool::indexed_transaction_set::index<ancestor_score>::type::iterator mi = mempool.mapTx.get<ancestor_score>().begin();
     CTxMemPool::txiter iter;
 
@@ -373,6 +483,12 @@ void BlockAssembler::addPackageTxs(int& nPackagesSelected, int& nDescendantsUpda
         }
 
         if (!TestPackage(packageSize, packageSigOpsCost)) {
+            // The package no longer fits as a whole, but its best-feerate
+            // chunks may still fit on their own.
+            if (AddPackagePrefix(iter, mapModifiedTx, nDescendantsUpdated) > 0) {
+                ++nPackagesSelected;
+                nConsecutiveFailed = 0;
+            }
             if (fUsingModified) {
                 // Since we always look at the best entry in mapModifiedTx,
                 // we must erase failed entries so that we can consider the
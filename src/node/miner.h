@@ -6,6 +6,7 @@
 #ifndef BITCOIN_NODE_MINER_H
 #define BITCOIN_NODE_MINER_H
 
+#include <kernel/cs_main.h>
 #include <node/types.h>
 #include <policy/policy.h>
 #include <primitives/block.h>
@@ -182,6 +183,13 @@ public:
 private:
     const Options m_options;
 
+    // Selection from the most recently built template, used to seed the next
+    // build against the same tip so only packages that arrived since then need
+    // a full evaluation. CreateNewBlock holds cs_main throughout, which
+    // serializes all access.
+    inline static uint256 m_last_template_tip GUARDED_BY(::cs_main){};
+    inline static std::vector<Txid> m_last_template_txids GUARDED_BY(::cs_main){};
+
     // utility functions
     /** Clear the block's state and prepare for assembling a new block */
     void resetBlock();
@@ -193,9 +201,26 @@ private:
       * Increments nPackagesSelected / nDescendantsUpdated with corresponding
       * statistics from the package selection (for logging statistics).
       *
+      * When the tip is unchanged since the previous build and every
+      * transaction selected for it is still in the mempool, the previous
+      * selection is replayed wholesale before the ancestor-score walk, so only
+      * packages that arrived in the meantime are evaluated from scratch.
+      *
       * @pre BlockAssembler::m_mempool must not be nullptr
     */
-    void addPackageTxs(int& nPackagesSelected, int& nDescendantsUpdated) EXCLUSIVE_LOCKS_REQUIRED(!m_mempool->cs);
+    void addPackageTxs(int& nPackagesSelected, int& nDescendantsUpdated) EXCLUSIVE_LOCKS_REQUIRED(!m_mempool->cs, ::cs_main);
+
+    /** Try to salvage part of a package that no longer fits in the block as a
+      * whole. The package is run through the cluster linearization engine,
+      * which partitions it into connected chunks of monotonically
+      * non-increasing feerate; any prefix of those chunks is topologically
+      * valid on its own, so the highest-feerate chunks that still fit (and
+      * clear blockMinFeeRate) are added. Returns the number of transactions
+      * added to the block.
+      *
+      * @pre BlockAssembler::m_mempool must not be nullptr
+      */
+    int AddPackagePrefix(CTxMemPool::txiter iter, indexed_modified_transaction_set& mapModifiedTx, int& nDescendantsUpdated) EXCLUSIVE_LOCKS_REQUIRED(m_mempool->cs);
 
     // helper functions for addPackageTxs()
     /** Remove confirmed (inBlock) entries from given set */
@@ -0,0 +1,195 @@
+// Copyright (c) 2025-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/pow_search.h>
+
+#include <crypto/tens_pow/tens_ctx_cache.h>
+#include <crypto/tens_pow/tens_hash.h>
+#include <logging.h>
+#include <pow.h>
+#include <uint256.h>
+#include <util/signalinterrupt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <cstdlib>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#endif
+
+namespace node {
+
+//! Nonces claimed by a worker per trip to the shared counter. One batch of
+//! this size streams the matrices once, so it should stay a multiple of the
+//! kernel-friendly batch width.
+static constexpr uint64_t POW_SEARCH_CHUNK{256};
+
+#ifdef __linux__
+namespace {
+//! Parse a sysfs cpulist like "0-15,32-47" into a cpu set.
+bool ParseCpuList(const std::string& list, cpu_set_t& set)
+{
+    size_t pos = 0;
+    while (pos < list.size()) {
+        char* end{nullptr};
+        long lo = strtol(list.c_str() + pos, &end, 10);
+        if (end == list.c_str() + pos) return false;
+        long hi = lo;
+        pos = end - list.c_str();
+        if (pos < list.size() && list[pos] == '-') {
+            hi = strtol(list.c_str() + pos + 1, &end, 10);
+            pos = end - list.c_str();
+        }
+        for (long c = lo; c <= hi && c < CPU_SETSIZE; c++) CPU_SET(c, &set);
+        if (pos < list.size() && list[pos] == ',') {
+            pos++;
+        } else {
+            break;
+        }
+    }
+    return true;
+}
+
+//! CPU sets of the NUMA nodes that have any CPUs, read from sysfs. Returns
+//! an empty vector on non-NUMA systems or when sysfs is unavailable.
+std::vector<cpu_set_t> NumaNodeCpuSets()
+{
+    std::vector<cpu_set_t> nodes;
+    for (int n = 0;; n++) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(n) + "/cpulist");
+        if (!file.is_open()) break;
+        std::string list;
+        std::getline(file, list);
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        // Memory-only nodes have an empty cpulist; skip them.
+        if (!ParseCpuList(list, set) || CPU_COUNT(&set) == 0) continue;
+        nodes.push_back(set);
+    }
+    return nodes;
+}
+} // namespace
+#endif // __linux__
+
+std::optional<uint32_t> FindProofOfWorkNonce(const CBlockHeader& header,
+                                             uint32_t nonce_start,
+                                             uint64_t max_tries,
+                                             int num_threads,
+                                             const Consensus::Params& params,
+                                             const util::SignalInterrupt* interrupt,
+                                             uint64_t* tries_used)
+{
+    if (tries_used) *tries_used = 0;
+    if (max_tries == 0) return std::nullopt;
+
+    // The seed ignores the nonce, so one context covers the whole search.
+    const uint256 seed{header.GetHash()};
+    auto ctx = TensHashContexts().Get(seed.begin());
+    if (!ctx) return std::nullopt;
+
+    const uint64_t range_end = std::min<uint64_t>(
+        (uint64_t)nonce_start + max_tries,
+        std::numeric_limits<uint32_t>::max());
+
+    unsigned workers = num_threads > 0 ? (unsigned)num_threads
+                                       : std::max(1u, std::thread::hardware_concurrency());
+
+    // One matrix replica per NUMA node: each worker is bound to its node's
+    // CPUs and hashes against a local copy, keeping the ~17MB matrix stream
+    // off the socket interconnect. Replicas are cloned lazily by the first
+    // bound worker of each node, so first-touch places the pages locally.
+    size_t groups{1};
+#ifdef __linux__
+    std::vector<cpu_set_t> node_cpus;
+    if (workers > 1) {
+        node_cpus = NumaNodeCpuSets();
+        if (node_cpus.size() > 1 && workers >= node_cpus.size()) groups = node_cpus.size();
+    }
+#endif
+    std::vector<TensHashContextCache::ContextRef> replicas(groups);
+    replicas[0] = ctx;
+    auto replica_once = std::make_unique<std::once_flag[]>(groups);
+    auto local_ctx = [&](size_t group) -> TensHashContext* {
+        std::call_once(replica_once[group], [&] {
+            if (!replicas[group]) {
+                replicas[group] = TensHashContextCache::ContextRef(tens_hash_clone(ctx.get()), tens_hash_free);
+            }
+        });
+        // Fall back to the shared context if cloning failed.
+        return (replicas[group] ? replicas[group] : ctx).get();
+    };
+
+    std::atomic<uint64_t> next_nonce{nonce_start};
+    std::atomic<uint64_t> tries{0};
+    // Lowest satisfying nonce found so far; workers racing on different
+    // chunks keep the minimum so the result is deterministic.
+    std::atomic<uint64_t> best_found{std::numeric_limits<uint64_t>::max()};
+
+    // The calling thread joins as a worker but keeps its own affinity; only
+    // spawned workers are pinned to their node.
+    auto work = [&](size_t group, [[maybe_unused]] bool bind) {
+#ifdef __linux__
+        if (bind && groups > 1) {
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &node_cpus[group]);
+        }
+#endif
+        TensHashContext* local = local_ctx(group);
+        uint8_t inputs[POW_SEARCH_CHUNK * TENS_IN_SIZE];
+        uint8_t hashes[POW_SEARCH_CHUNK * TENS_IN_SIZE];
+        for (;;) {
+            if (interrupt && *interrupt) return;
+            uint64_t chunk_start = next_nonce.fetch_add(POW_SEARCH_CHUNK, std::memory_order_relaxed);
+            if (chunk_start >= range_end) return;
+            // Stop claiming work beyond a nonce another worker already found.
+            if (chunk_start > best_found.load(std::memory_order_relaxed)) return;
+            size_t batch = std::min<uint64_t>(POW_SEARCH_CHUNK, range_end - chunk_start);
+
+            memset(inputs, 0, batch * TENS_IN_SIZE);
+            for (size_t i = 0; i < batch; i++) {
+                uint32_t nonce = (uint32_t)(chunk_start + i);
+                memcpy(inputs + i * TENS_IN_SIZE, &nonce, sizeof(nonce));
+            }
+            tens_hash_batch(inputs, batch, local, hashes);
+            tries.fetch_add(batch, std::memory_order_relaxed);
+
+            for (size_t i = 0; i < batch; i++) {
+                uint256 pow_hash;
+                memcpy(pow_hash.begin(), hashes + i * TENS_IN_SIZE, TENS_IN_SIZE);
+                if (CheckProofOfWork(pow_hash, header.nBits, params)) {
+                    uint64_t candidate = chunk_start + i;
+                    uint64_t prev = best_found.load(std::memory_order_relaxed);
+                    while (candidate < prev &&
+                           !best_found.compare_exchange_weak(prev, candidate, std::memory_order_relaxed)) {
+                    }
+                    break;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned t = 1; t < workers; t++) pool.emplace_back(work, t % groups, /*bind=*/true);
+    work(0, /*bind=*/false);
+    for (auto& w : pool) w.join();
+
+    if (tries_used) *tries_used = tries.load();
+    uint64_t found = best_found.load();
+    if (found == std::numeric_limits<uint64_t>::max()) return std::nullopt;
+    LogDebug(BCLog::POW, "pow search found nonce=%u after %u tries (%u workers)\n",
+             (uint32_t)found, (unsigned)tries.load(), workers);
+    return (uint32_t)found;
+}
+
+} // namespace node
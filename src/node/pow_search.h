@@ -0,0 +1,41 @@
+// Copyright (c) 2025-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_POW_SEARCH_H
+#define BITCOIN_NODE_POW_SEARCH_H
+
+#include <consensus/params.h>
+#include <primitives/block.h>
+
+#include <cstdint>
+#include <optional>
+
+namespace util {
+class SignalInterrupt;
+} // namespace util
+
+namespace node {
+
+/** Multi-threaded TensHash proof-of-work search.
+ *
+ * Partitions the nonce space [nonce_start, nonce_start + max_tries) over a
+ * pool of worker threads that share one per-seed TensHashContext and evaluate
+ * nonces through the batch hashing API. Returns the first nonce whose PoW
+ * hash satisfies `nBits`, or std::nullopt if the range is exhausted or
+ * `interrupt` fires. `tries_used` (if non-null) receives the number of nonces
+ * evaluated.
+ *
+ * `num_threads <= 0` uses all hardware threads.
+ */
+std::optional<uint32_t> FindProofOfWorkNonce(const CBlockHeader& header,
+                                             uint32_t nonce_start,
+                                             uint64_t max_tries,
+                                             int num_threads,
+                                             const Consensus::Params& params,
+                                             const util::SignalInterrupt* interrupt,
+                                             uint64_t* tries_used = nullptr);
+
+} // namespace node
+
+#endif // BITCOIN_NODE_POW_SEARCH_H
@@ -0,0 +1,175 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/tens_ctx_store.h>
+
+#include <crypto/tens_pow/tens_ctx_cache.h>
+#include <crypto/tens_pow/tens_hash.h>
+#include <logging.h>
+#include <span.h>
+#include <streams.h>
+#include <util/fs.h>
+#include <util/strencodings.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace node {
+namespace {
+
+//! File layout: 8-byte magic, 32-byte seed, zero padding to HEADER_BYTES,
+//! then the raw context arena (planes followed by biases, exactly as laid
+//! out in memory). The 64-byte header keeps the mapped planes aligned.
+constexpr uint8_t MATRIX_FILE_MAGIC[8] = {'T', 'E', 'N', 'S', 'M', 'A', 'T', '1'};
+constexpr size_t HEADER_BYTES{64};
+
+fs::path g_store_dir;
+size_t g_max_files{DEFAULT_TENS_MATRIX_FILES};
+
+fs::path MatrixPath(const uint8_t seed[32])
+{
+    return g_store_dir / fs::u8path(HexStr(std::span{seed, 32}) + ".mat");
+}
+
+//! Delete the oldest matrix files until at most g_max_files remain.
+void PruneMatrixFiles()
+{
+    std::vector<std::pair<fs::file_time_type, fs::path>> files;
+    for (const auto& entry : fs::directory_iterator(g_store_dir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".mat") {
+            files.emplace_back(entry.last_write_time(), entry.path());
+        }
+    }
+    if (files.size() <= g_max_files) return;
+    std::sort(files.begin(), files.end());
+    for (size_t i = 0; i < files.size() - g_max_files; i++) {
+        fs::remove(files[i].second);
+    }
+}
+
+TensHashContextCache::ContextRef LoadMatrixContext(const uint8_t seed[32])
+{
+    const fs::path path{MatrixPath(seed)};
+    const size_t arena_bytes{tens_hash_arena_size()};
+    const size_t file_bytes{HEADER_BYTES + arena_bytes};
+    try {
+        if (!fs::exists(path) || fs::file_size(path) != file_bytes) return nullptr;
+    } catch (const fs::filesystem_error&) {
+        return nullptr;
+    }
+
+    TensHashContextCache::ContextRef ctx;
+#ifndef WIN32
+    const int fd{open(fs::PathToString(path).c_str(), O_RDONLY)};
+    if (fd < 0) return nullptr;
+    void* map{mmap(nullptr, file_bytes, PROT_READ, MAP_PRIVATE, fd, 0)};
+    close(fd);
+    if (map == MAP_FAILED) return nullptr;
+    auto* base = static_cast<uint8_t*>(map);
+    if (memcmp(base, MATRIX_FILE_MAGIC, sizeof(MATRIX_FILE_MAGIC)) != 0 ||
+        memcmp(base + sizeof(MATRIX_FILE_MAGIC), seed, 32) != 0) {
+        munmap(map, file_bytes);
+        return nullptr;
+    }
+    ctx = TensHashContextCache::ContextRef(new TensHashContext{}, [map, file_bytes](TensHashContext* c) {
+        munmap(map, file_bytes);
+        delete c;
+    });
+    tens_hash_context_carve(ctx.get(), base + HEADER_BYTES);
+#else
+    // No mmap on Windows; read the arena into anonymous memory instead,
+    // which still skips regeneration.
+    AutoFile file{fsbridge::fopen(path, "rb")};
+    if (file.IsNull()) return nullptr;
+    uint8_t header[HEADER_BYTES];
+    try {
+        file.read(std::as_writable_bytes(std::span{header}));
+    } catch (const std::ios_base::failure&) {
+        return nullptr;
+    }
+    if (memcmp(header, MATRIX_FILE_MAGIC, sizeof(MATRIX_FILE_MAGIC)) != 0 ||
+        memcmp(header + sizeof(MATRIX_FILE_MAGIC), seed, 32) != 0) {
+        return nullptr;
+    }
+    void* arena{malloc(arena_bytes)};
+    if (!arena) return nullptr;
+    try {
+        file.read(std::span{static_cast<std::byte*>(arena), arena_bytes});
+    } catch (const std::ios_base::failure&) {
+        free(arena);
+        return nullptr;
+    }
+    ctx = TensHashContextCache::ContextRef(new TensHashContext{}, [arena](TensHashContext* c) {
+        free(arena);
+        delete c;
+    });
+    tens_hash_context_carve(ctx.get(), arena);
+#endif
+
+    // Bump the write time so pruning keeps recently used seeds (best effort).
+    try {
+        fs::last_write_time(path, fs::file_time_type::clock::now());
+    } catch (const fs::filesystem_error&) {
+    }
+    LogDebug(BCLog::POW, "Loaded TensHash matrices for seed %s from %s\n",
+             HexStr(std::span{seed, 32}), fs::PathToString(path));
+    return ctx;
+}
+
+void SaveMatrixContext(const uint8_t seed[32], const TensHashContext& ctx)
+{
+    const fs::path path{MatrixPath(seed)};
+    const fs::path tmp_path{path + ".tmp"};
+    try {
+        {
+            AutoFile file{fsbridge::fopen(tmp_path, "wb")};
+            if (file.IsNull()) return;
+            uint8_t header[HEADER_BYTES] = {0};
+            memcpy(header, MATRIX_FILE_MAGIC, sizeof(MATRIX_FILE_MAGIC));
+            memcpy(header + sizeof(MATRIX_FILE_MAGIC), seed, 32);
+            file.write(std::as_bytes(std::span{header}));
+            // expansion_planes is the base of the contiguous arena.
+            file.write(std::span{reinterpret_cast<const std::byte*>(ctx.expansion_planes), tens_hash_arena_size()});
+        }
+        fs::rename(tmp_path, path);
+        PruneMatrixFiles();
+    } catch (const std::exception& e) {
+        LogWarning("Failed to persist TensHash matrices to %s: %s\n", fs::PathToString(tmp_path), e.what());
+        try {
+            fs::remove(tmp_path);
+        } catch (const fs::filesystem_error&) {
+        }
+    }
+}
+
+} // namespace
+
+void InitTensMatrixStore(const fs::path& dir, size_t max_files)
+{
+    try {
+        fs::create_directories(dir);
+    } catch (const fs::filesystem_error& e) {
+        LogWarning("Cannot create TensHash matrix store at %s (%s); persistence disabled\n",
+                   fs::PathToString(dir), e.what());
+        return;
+    }
+    g_store_dir = dir;
+    g_max_files = max_files;
+    TensHashContexts().SetStore(LoadMatrixContext, SaveMatrixContext);
+    LogPrintf("Using TensHash matrix store at %s (keeping up to %u seeds)\n",
+              fs::PathToString(dir), (unsigned)max_files);
+}
+
+} // namespace node
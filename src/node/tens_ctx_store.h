@@ -0,0 +1,30 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_TENS_CTX_STORE_H
+#define BITCOIN_NODE_TENS_CTX_STORE_H
+
+#include <util/fs.h>
+
+#include <cstddef>
+
+namespace node {
+
+//! Default number of persisted matrix files kept on disk (~17MB each).
+static constexpr size_t DEFAULT_TENS_MATRIX_FILES{4};
+
+/** Enable the on-disk TensHash matrix store rooted at `dir`.
+ *
+ * Generated per-seed contexts are persisted there and memory-mapped back in
+ * on later cache misses, so a restarted node resumes hashing under a
+ * recently-seen seed without paying matrix regeneration. Registers the
+ * load/save hooks on the global TensHashContextCache; call once during init.
+ * Files beyond `max_files` are pruned oldest-first, mirroring how blk files
+ * are pruned by BlockManager.
+ */
+void InitTensMatrixStore(const fs::path& dir, size_t max_files = DEFAULT_TENS_MATRIX_FILES);
+
+} // namespace node
+
+#endif // BITCOIN_NODE_TENS_CTX_STORE_H
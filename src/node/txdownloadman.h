@@ -142,6 +142,10 @@ public:
     /** Get getdata requests to send. */
     std::vector<GenTxid> GetRequestsToSend(NodeId nodeid, std::chrono::microseconds current_time);
 
+    /** Number of transaction announcements from this peer (pending or in
+     * flight), i.e. whether GetRequestsToSend may have work now or later. */
+    size_t Count(NodeId nodeid) const;
+
     /** Should be called when a notfound for a tx has been received. */
     void ReceivedNotFound(NodeId nodeid, const std::vector<uint256>& txhashes);
 
@@ -47,6 +47,10 @@ std::vector<GenTxid> TxDownloadManager::GetRequestsToSend(NodeId nodeid, std::ch
 {
     return m_impl->GetRequestsToSend(nodeid, current_time);
 }
+size_t TxDownloadManager::Count(NodeId nodeid) const
+{
+    return m_impl->m_txrequest.Count(nodeid);
+}
 void TxDownloadManager::ReceivedNotFound(NodeId nodeid, const std::vector<uint256>& txhashes)
 {
     m_impl->ReceivedNotFound(nodeid, txhashes);
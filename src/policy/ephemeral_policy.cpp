@@ -30,7 +30,7 @@ bool PreCheckEphemeralTx(const CTransaction& tx, CFeeRate dust_relay_rate, CAmou
     return true;
 }
 
-bool CheckEphemeralSpends(const Package& package, CFeeRate dust_relay_rate, const CTxMemPool& tx_pool, TxValidationState& out_child_state, Txid& out_child_txid)
+bool CheckEphemeralSpends(const Package& package, CFeeRate dust_relay_rate, const CTxMemPool& tx_pool, TxValidationState& out_child_state, Txid& out_child_txid, const AncestorTxRefs* ancestor_txs)
 {
     if (!Assume(std::ranges::all_of(package, [](const auto& tx){return tx != nullptr;}))) {
         // Bail out of spend checks if caller gave us an invalid package
@@ -55,6 +55,13 @@ bool CheckEphemeralSpends(const Package& package, CFeeRate dust_relay_rate, cons
             CTransactionRef parent_ref = nullptr;
             if (auto it = map_txid_ref.find(parent_txid); it != map_txid_ref.end()) {
                 parent_ref = it->second;
+            } else if (ancestor_txs) {
+                // The caller already computed the in-mempool ancestor set; a
+                // parent absent from it is confirmed or unknown, so there is
+                // no need to query the mempool.
+                if (auto anc_it = ancestor_txs->find(parent_txid); anc_it != ancestor_txs->end()) {
+                    parent_ref = anc_it->second;
+                }
             } else {
                 parent_ref = tx_pool.get(parent_txid);
             }
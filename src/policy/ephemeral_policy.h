@@ -9,6 +9,7 @@
 #include <policy/packages.h>
 #include <primitives/transaction.h>
 
+#include <map>
 #include <optional>
 
 class CFeeRate;
@@ -47,12 +48,21 @@ class TxValidationState;
  */
 bool PreCheckEphemeralTx(const CTransaction& tx, CFeeRate dust_relay_rate, CAmount base_fee, CAmount mod_fee, TxValidationState& state);
 
+/** Transactions of the in-mempool ancestors already computed by the caller
+ * (e.g. from the workspace ancestor sets filled in by PreChecks), keyed by
+ * txid. Lets the dust checks resolve parent transactions without re-querying
+ * the mempool. */
+using AncestorTxRefs = std::map<Txid, CTransactionRef>;
+
 /** Must be called for each transaction(package) if any dust is in the package.
  *  Checks that each transaction's parents have their dust spent by the child,
  *  where parents are either in the mempool or in the package itself.
  *  Sets out_child_state and out_child_txid on failure.
+ *  If ancestor_txs is non-null, it must contain every in-mempool ancestor of
+ *  every package transaction; parents are then resolved from it instead of
+ *  querying tx_pool per input.
  *  @returns true if all dust is properly spent.
  */
-bool CheckEphemeralSpends(const Package& package, CFeeRate dust_relay_rate, const CTxMemPool& tx_pool, TxValidationState& out_child_state, Txid& out_child_txid);
+bool CheckEphemeralSpends(const Package& package, CFeeRate dust_relay_rate, const CTxMemPool& tx_pool, TxValidationState& out_child_state, Txid& out_child_txid, const AncestorTxRefs* ancestor_txs = nullptr);
 
 #endif // BITCOIN_POLICY_EPHEMERAL_POLICY_H
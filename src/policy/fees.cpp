@@ -712,6 +712,8 @@ void CBlockPolicyEstimator::processBlock(const std::vector<RemovedMempoolTransac
 
     trackedTxs = 0;
     untrackedTxs = 0;
+
+    m_stats_version.fetch_add(1, std::memory_order_release);
 }
 
 CFeeRate CBlockPolicyEstimator::estimateFee(int confTarget) const
@@ -868,6 +870,31 @@ double CBlockPolicyEstimator::estimateConservativeFee(unsigned int doubleTarget,
  * longer time horizons also.
  */
 CFeeRate CBlockPolicyEstimator::estimateSmartFee(int confTarget, FeeCalculation *feeCalc, bool conservative) const
+{
+    // Estimates only change when the tracking stats do, so frequent pollers
+    // are served from a per-(target, conservative) cache tagged with the
+    // stats version, and do not contend with the relay path for
+    // m_cs_fee_estimator between blocks.
+    const uint32_t stats_version{m_stats_version.load(std::memory_order_acquire)};
+    const std::pair<int, bool> cache_key{confTarget, conservative};
+    {
+        LOCK(m_cache_mutex);
+        auto it{m_smart_fee_cache.find(cache_key)};
+        if (it != m_smart_fee_cache.end() && it->second.version == stats_version) {
+            if (feeCalc) *feeCalc = it->second.calc;
+            return it->second.fee;
+        }
+    }
+
+    FeeCalculation calc;
+    const CFeeRate fee{estimateSmartFeeUncached(confTarget, &calc, conservative)};
+    if (feeCalc) *feeCalc = calc;
+    LOCK(m_cache_mutex);
+    m_smart_fee_cache[cache_key] = {fee, calc, stats_version};
+    return fee;
+}
+
+CFeeRate CBlockPolicyEstimator::estimateSmartFeeUncached(int confTarget, FeeCalculation* feeCalc, bool conservative) const
 {
     LOCK(m_cs_fee_estimator);
 
@@ -1038,6 +1065,8 @@ bool CBlockPolicyEstimator::Read(AutoFile& filein)
             nBestSeenHeight = nFileBestSeenHeight;
             historicalFirst = nFileHistoricalFirst;
             historicalBest = nFileHistoricalBest;
+
+            m_stats_version.fetch_add(1, std::memory_order_release);
         }
     }
     catch (const std::exception& e) {
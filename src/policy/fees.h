@@ -15,11 +15,13 @@
 #include <validationinterface.h>
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -307,6 +309,23 @@ private:
     double estimateCombinedFee(unsigned int confTarget, double successThreshold, bool checkShorterHorizon, EstimationResult *result) const EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator);
     /** Helper for estimateSmartFee */
     double estimateConservativeFee(unsigned int doubleTarget, EstimationResult *result) const EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator);
+    /** Helper for estimateSmartFee: the uncached computation */
+    CFeeRate estimateSmartFeeUncached(int confTarget, FeeCalculation* feeCalc, bool conservative) const EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator);
+
+    /** Bumped whenever a processed block (or loading estimates from file)
+     * changes the tracking stats; tags cached estimateSmartFee results. */
+    std::atomic<uint32_t> m_stats_version{0};
+    struct CachedSmartFee {
+        CFeeRate fee;
+        FeeCalculation calc;
+        uint32_t version;
+    };
+    /** Cache of estimateSmartFee results keyed by (target, conservative).
+     * Estimates only change when the stats do, so frequent fee estimate
+     * polling is served from here instead of contending with the relay path
+     * for m_cs_fee_estimator. */
+    mutable Mutex m_cache_mutex;
+    mutable std::map<std::pair<int, bool>, CachedSmartFee> m_smart_fee_cache GUARDED_BY(m_cache_mutex);
     /** Number of blocks of data recorded while fee estimates have been running */
     unsigned int BlockSpan() const EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator);
     /** Number of blocks of recorded fee estimate data represented in saved data file */
@@ -78,8 +78,10 @@ std::optional<std::string> GetEntriesForConflicts(const CTransaction& tx,
         }
     }
     // Calculate the set of all transactions that would have to be evicted.
+    // Memoized: RBF-heavy traffic re-evaluates the same conflicts across
+    // package contexts and resubmissions.
     for (CTxMemPool::txiter it : iters_conflicting) {
-        pool.CalculateDescendants(it, all_conflicts);
+        pool.CalculateDescendantsCached(it, all_conflicts);
     }
     return std::nullopt;
 }
@@ -7,10 +7,17 @@
 
 #include <arith_uint256.h>
 #include <chain.h>
+#include <crypto/tens_pow/tens_ctx_cache.h>
+#include <crypto/tens_pow/tens_hash.h>
+#include <hash.h>
+#include <powcache.h>
 #include <primitives/block.h>
 #include <uint256.h>
 #include <util/check.h>
 
+#include <algorithm>
+#include <cstring>
+
 unsigned int GetNextWorkRequired(const CBlockIndex* pindexLast, const CBlockHeader *pblock, const Consensus::Params& params)
 {
     assert(pindexLast != nullptr);
@@ -184,3 +191,118 @@ bool CheckProofOfWorkImpl(uint256 hash, unsigned int nBits, const Consensus::Par
     //LogPrintf("  Success: Valid proof of work\n");
     return true;
 }
+
+bool CheckHeaderProofOfWork(const CBlockHeader& header, const Consensus::Params& params)
+{
+    auto bnTarget{DeriveTarget(header.nBits, params.powLimit)};
+    if (!bnTarget) {
+        return false;
+    }
+
+    // Big-endian target bytes, most significant first, for the byte-wise
+    // early-exit comparison inside the compression layer.
+    const uint256 target{ArithToUint256(*bnTarget)};
+    uint8_t target_be[TENS_IN_SIZE];
+    for (int i = 0; i < TENS_IN_SIZE; i++) {
+        target_be[i] = *(target.begin() + TENS_IN_SIZE - 1 - i);
+    }
+
+    const uint256 seed{header.GetHash()};
+
+    // Proofs we have already verified (reorgs, restart re-validation, block
+    // following its header) are answered from the salted result cache. The
+    // seed excludes the nonce, so the entry commits to it separately.
+    PoWCache* pow_cache{GetPoWCache()};
+    uint256 cache_entry;
+    if (pow_cache) {
+        pow_cache->ComputeEntry(cache_entry, seed, header.nNonce, header.nBits);
+        if (pow_cache->Get(cache_entry)) return true;
+    }
+
+    bool valid;
+    if (tens_hash_low_memory()) {
+        // Low-memory nodes trade CPU for memory: stream the matrices layer
+        // by layer instead of materializing (and caching) a full context.
+        uint8_t nonce_bytes[TENS_IN_SIZE] = {0};
+        memcpy(nonce_bytes, &header.nNonce, sizeof(header.nNonce));
+        uint256 pow_hash;
+        tens_hash_streaming(nonce_bytes, seed.begin(), pow_hash.begin());
+        valid = UintToArith256(pow_hash) <= *bnTarget;
+    } else {
+        auto ctx = TensHashContexts().Get(seed.begin());
+        if (!ctx) return false;
+
+        uint8_t nonce_bytes[TENS_IN_SIZE] = {0};
+        memcpy(nonce_bytes, &header.nNonce, sizeof(header.nNonce));
+        valid = tens_hash_precomputed_target(nonce_bytes, ctx.get(), target_be, nullptr) == 1;
+    }
+
+    if (valid && pow_cache) pow_cache->Set(cache_entry);
+    return valid;
+}
+
+uint256 GetPoWEpochSeed(const CBlockIndex* pindexPrev, const Consensus::Params& params)
+{
+    assert(pindexPrev != nullptr);
+    assert(params.tenshash_epoch_length > 0);
+    const int height{pindexPrev->nHeight + 1};
+    const int anchor_height{std::max(0, height - height % static_cast<int>(params.tenshash_epoch_length) - 1)};
+    const CBlockIndex* anchor{pindexPrev->GetAncestor(anchor_height)};
+    assert(anchor != nullptr);
+    return anchor->GetBlockHash();
+}
+
+bool CheckHeaderProofOfWorkEpoch(const CBlockHeader& header, const uint256& epoch_seed, const Consensus::Params& params)
+{
+    auto bnTarget{DeriveTarget(header.nBits, params.powLimit)};
+    if (!bnTarget) {
+        return false;
+    }
+
+    const uint256 target{ArithToUint256(*bnTarget)};
+    uint8_t target_be[TENS_IN_SIZE];
+    for (int i = 0; i < TENS_IN_SIZE; i++) {
+        target_be[i] = *(target.begin() + TENS_IN_SIZE - 1 - i);
+    }
+
+    // With a per-epoch seed the matrices no longer commit to the header, so
+    // the hashed input must: it folds the (nonce-zeroed) header hash and the
+    // nonce into the 32-byte kernel input.
+    const uint256 input{(HashWriter{} << header.GetHash() << header.nNonce).GetHash()};
+
+    PoWCache* pow_cache{GetPoWCache()};
+    uint256 cache_entry;
+    if (pow_cache) {
+        pow_cache->ComputeEntry(cache_entry, input, header.nNonce, header.nBits);
+        if (pow_cache->Get(cache_entry)) return true;
+    }
+
+    bool valid;
+    if (tens_hash_low_memory()) {
+        uint256 pow_hash;
+        tens_hash_streaming(input.begin(), epoch_seed.begin(), pow_hash.begin());
+        valid = UintToArith256(pow_hash) <= *bnTarget;
+    } else {
+        // One pooled context serves every block of the epoch.
+        auto ctx = TensHashContexts().Get(epoch_seed.begin());
+        if (!ctx) return false;
+        valid = tens_hash_precomputed_target(input.begin(), ctx.get(), target_be, nullptr) == 1;
+    }
+
+    if (valid && pow_cache) pow_cache->Set(cache_entry);
+    return valid;
+}
+
+std::vector<bool> CheckProofOfWorkBatch(std::span<const CBlockHeader> headers, const Consensus::Params& params)
+{
+    std::vector<bool> valid(headers.size(), false);
+    for (size_t i = 0; i < headers.size(); i++) {
+        // Redundant announcements of the same header collapse to one check.
+        if (i > 0 && headers[i].GetHash() == headers[i - 1].GetHash()) {
+            valid[i] = valid[i - 1];
+            continue;
+        }
+        valid[i] = CheckHeaderProofOfWork(headers[i], params);
+    }
+    return valid;
+}
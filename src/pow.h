@@ -10,6 +10,9 @@
 
 #include <stdint.h>
 
+#include <span>
+#include <vector>
+
 class CBlockHeader;
 class CBlockIndex;
 class uint256;
@@ -33,6 +36,33 @@ unsigned int CalculateNextWorkRequired(const CBlockIndex* pindexLast, int64_t nF
 bool CheckProofOfWork(uint256 hash, unsigned int nBits, const Consensus::Params&);
 bool CheckProofOfWorkImpl(uint256 hash, unsigned int nBits, const Consensus::Params&);
 
+/** Check a header's TensHash proof of work against its nBits target.
+ *  Equivalent to CheckProofOfWork(header.GetPoWHash(), header.nBits, params)
+ *  but evaluates the hash most-significant byte first and aborts the
+ *  remaining compression work once the candidate provably exceeds the
+ *  target. */
+bool CheckHeaderProofOfWork(const CBlockHeader& header, const Consensus::Params&);
+
+/** Seed of the TensHash matrices for the block at height pindexPrev->nHeight+1
+ *  under the DEPLOYMENT_POW_EPOCH rule: the hash of the last block before the
+ *  epoch containing that height (the genesis block for the first epoch). Only
+ *  meaningful when tenshash_epoch_length is nonzero and the deployment is
+ *  active after pindexPrev. */
+uint256 GetPoWEpochSeed(const CBlockIndex* pindexPrev, const Consensus::Params&);
+
+/** Epoch-rule counterpart of CheckHeaderProofOfWork(): the matrices derive
+ *  from epoch_seed, which every block of the epoch shares, and the hashed
+ *  input is the double-SHA256 of the header hash and nonce so the proof
+ *  still commits to the header contents. */
+bool CheckHeaderProofOfWorkEpoch(const CBlockHeader& header, const uint256& epoch_seed, const Consensus::Params&);
+
+/** Check proof of work for a contiguous range of headers, returning one flag
+ *  per header (true = valid). Matrix contexts are keyed by the header hash,
+ *  so runs of identical headers collapse to a single check and every context
+ *  lookup goes through the shared cache; distinct headers necessarily derive
+ *  distinct matrix sets, so their hashes cannot share a kernel invocation. */
+std::vector<bool> CheckProofOfWorkBatch(std::span<const CBlockHeader> headers, const Consensus::Params&);
+
 /**
  * Return false if the proof-of-work requirement specified by new_nbits at a
  * given height is not possible, given the proof-of-work on the prior block as
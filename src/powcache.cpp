@@ -0,0 +1,62 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <powcache.h>
+
+#include <crypto/common.h>
+#include <logging.h>
+#include <random.h>
+#include <uint256.h>
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+PoWCache::PoWCache(const size_t max_size_bytes)
+{
+    uint256 nonce = GetRandHash();
+    // A 64-byte salt block keeps later entry computations on whole SHA256
+    // chunks, mirroring the signature cache.
+    static constexpr unsigned char PADDING_POW[32] = {'P'};
+    m_salted_hasher.Write(nonce.begin(), 32);
+    m_salted_hasher.Write(PADDING_POW, 32);
+
+    const auto [num_elems, approx_size_bytes] = setValid.setup_bytes(max_size_bytes);
+    LogPrintf("Using %zu MiB out of %zu MiB requested for proof-of-work cache, able to store %zu elements\n",
+              approx_size_bytes >> 20, max_size_bytes >> 20, num_elems);
+}
+
+void PoWCache::ComputeEntry(uint256& entry, const uint256& header_hash, const uint32_t nonce, const uint32_t nbits) const
+{
+    unsigned char suffix[8];
+    WriteLE32(suffix, nonce);
+    WriteLE32(suffix + 4, nbits);
+    CSHA256 hasher = m_salted_hasher;
+    hasher.Write(header_hash.begin(), 32).Write(suffix, sizeof(suffix)).Finalize(entry.begin());
+}
+
+bool PoWCache::Get(const uint256& entry)
+{
+    std::shared_lock<std::shared_mutex> lock(cs_powcache);
+    return setValid.contains(entry, /*erase=*/false);
+}
+
+void PoWCache::Set(const uint256& entry)
+{
+    std::unique_lock<std::shared_mutex> lock(cs_powcache);
+    setValid.insert(entry);
+}
+
+static std::unique_ptr<PoWCache> g_pow_cache;
+
+void InitPoWCache(size_t max_size_bytes)
+{
+    if (max_size_bytes == 0) return;
+    g_pow_cache = std::make_unique<PoWCache>(max_size_bytes);
+}
+
+PoWCache* GetPoWCache()
+{
+    return g_pow_cache.get();
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_POWCACHE_H
+#define BITCOIN_POWCACHE_H
+
+#include <crypto/sha256.h>
+#include <cuckoocache.h>
+#include <uint256.h>
+#include <util/hasher.h>
+
+#include <cstddef>
+#include <shared_mutex>
+
+//! Default proof-of-work cache size. An entry is one uint256, so 2 MiB holds
+//! ~65000 verified headers — enough to absorb a deep reorg storm in one pass.
+static constexpr size_t DEFAULT_POW_CACHE_BYTES{2 << 20};
+
+/**
+ * Cache of headers whose TensHash proof of work has already been verified,
+ * so reorgs and restart-triggered re-validation skip the (multi-millisecond)
+ * hash. Same salted CuckooCache construction as the signature cache in
+ * script/sigcache.cpp; only successful checks are stored. The entry commits
+ * to the header hash, nonce and nBits, so a header re-announced with a
+ * different nonce or claimed target can never hit.
+ */
+class PoWCache
+{
+private:
+    //! Entries are SHA256(salt || header hash || nNonce || nBits).
+    CSHA256 m_salted_hasher;
+    typedef CuckooCache::cache<uint256, SignatureCacheHasher> map_type;
+    map_type setValid;
+    std::shared_mutex cs_powcache;
+
+public:
+    PoWCache(size_t max_size_bytes);
+
+    PoWCache(const PoWCache&) = delete;
+    PoWCache& operator=(const PoWCache&) = delete;
+
+    void ComputeEntry(uint256& entry, const uint256& header_hash, uint32_t nonce, uint32_t nbits) const;
+
+    bool Get(const uint256& entry);
+
+    void Set(const uint256& entry);
+};
+
+/** Create the global PoW verification cache; call once during init. A size
+ *  of zero disables caching. */
+void InitPoWCache(size_t max_size_bytes);
+
+/** The global PoW verification cache, or nullptr when not initialized.
+ *  Global rather than ChainstateManager state because header PoW is checked
+ *  from free functions (CheckHeaderProofOfWork) that carry no validation
+ *  context. */
+PoWCache* GetPoWCache();
+
+#endif // BITCOIN_POWCACHE_H
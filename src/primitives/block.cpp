@@ -4,6 +4,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <primitives/block.h>
+#include <crypto/tens_pow/tens_ctx_cache.h>
 #include <crypto/tens_pow/tens_hash.h>
 
 #include <hash.h>
@@ -32,7 +33,11 @@ uint256 CBlockHeader::GetPoWHash() const {
     uint256 seed = GetHash();
     uint8_t nonce_bytes[32] = {0};
     memcpy(nonce_bytes, &nNonce, sizeof(nNonce));
-    tens_hash(nonce_bytes, seed.begin(), thash.begin());
+    // Contexts are pooled by seed so re-validating the same header (e.g.
+    // header message followed by the full block) skips matrix generation.
+    auto ctx = TensHashContexts().Get(seed.begin());
+    if (!ctx) return thash;
+    tens_hash_precomputed(nonce_bytes, ctx.get(), thash.begin());
     return thash;
 }
 
@@ -30,6 +30,11 @@ public:
     uint32_t nBits;
     uint32_t nNonce;
 
+    //! Exact serialized size of a block header; headers have no variable
+    //! length fields, so callers sizing buffers or sanity-checking sizes can
+    //! use this instead of a mock serialization pass.
+    static constexpr size_t SERIALIZED_SIZE{4 + 32 + 32 + 4 + 4 + 4};
+
     CBlockHeader()
     {
         SetNull();
@@ -92,8 +92,18 @@ Wtxid CTransaction::ComputeWitnessHash() const
     return Wtxid::FromUint256((HashWriter{} << TX_WITH_WITNESS(*this)).GetHash());
 }
 
-CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
-CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
+unsigned int CTransaction::ComputeTotalSize() const
+{
+    return ::GetSerializeSize(TX_WITH_WITNESS(*this));
+}
+
+unsigned int CTransaction::ComputeStrippedSize() const
+{
+    return ::GetSerializeSize(TX_NO_WITNESS(*this));
+}
+
+CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()}, m_total_size{ComputeTotalSize()}, m_stripped_size{ComputeStrippedSize()} {}
+CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()}, m_total_size{ComputeTotalSize()}, m_stripped_size{ComputeStrippedSize()} {}
 
 CAmount CTransaction::GetValueOut() const
 {
@@ -107,11 +117,6 @@ CAmount CTransaction::GetValueOut() const
     return nValueOut;
 }
 
-unsigned int CTransaction::GetTotalSize() const
-{
-    return ::GetSerializeSize(TX_WITH_WITNESS(*this));
-}
-
 std::string CTransaction::ToString() const
 {
     std::string str;
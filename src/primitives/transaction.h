@@ -32,6 +32,8 @@ public:
     uint32_t n;
 
     static constexpr uint32_t NULL_INDEX = std::numeric_limits<uint32_t>::max();
+    //! Exact serialized size of an outpoint (txid + index).
+    static constexpr size_t SERIALIZED_SIZE{32 + 4};
 
     COutPoint(): n(NULL_INDEX) { }
     COutPoint(const Txid& hashIn, uint32_t nIn): hash(hashIn), n(nIn) { }
@@ -313,11 +315,19 @@ private:
     const bool m_has_witness;
     const Txid hash;
     const Wtxid m_witness_hash;
+    //! Serialized size with witness data, cached at construction so hot
+    //! callers (mempool vsize, relay, block assembly) never re-run the mock
+    //! serialization pass of GetSerializeSize.
+    const unsigned int m_total_size;
+    //! Serialized size without witness data ("stripped size" in BIP141).
+    const unsigned int m_stripped_size;
 
     Txid ComputeHash() const;
     Wtxid ComputeWitnessHash() const;
 
     bool ComputeHasWitness() const;
+    unsigned int ComputeTotalSize() const;
+    unsigned int ComputeStrippedSize() const;
 
 public:
     /** Convert a CMutableTransaction into a CTransaction. */
@@ -351,7 +361,13 @@ public:
      * "Total Size" defined in BIP141 and BIP144.
      * @return Total transaction size in bytes
      */
-    unsigned int GetTotalSize() const;
+    unsigned int GetTotalSize() const { return m_total_size; }
+
+    /**
+     * Get the transaction size in bytes with witness data stripped.
+     * "Base Size" defined in BIP141 and BIP144.
+     */
+    unsigned int GetStrippedSize() const { return m_stripped_size; }
 
     bool IsCoinBase() const
     {
@@ -264,6 +264,17 @@ inline constexpr const char* WTXIDRELAY{"wtxidrelay"};
  * txreconciliation, as described by BIP 330.
  */
 inline constexpr const char* SENDTXRCNCL{"sendtxrcncl"};
+/**
+ * The sendhdrscomp message signals support for receiving getheaders responses
+ * as HDRSCOMP messages instead of HEADERS. Sent between VERSION and VERACK.
+ */
+inline constexpr const char* SENDHDRSCOMP{"sendhdrscomp"};
+/**
+ * The hdrscomp message carries a batch of block headers in a compressed
+ * encoding that omits fields derivable from the preceding header in the
+ * batch. Only sent to peers that negotiated it with SENDHDRSCOMP.
+ */
+inline constexpr const char* HDRSCOMP{"hdrscomp"};
 }; // namespace NetMsgType
 
 /** All known message types (see above). Keep this in the same order as the list of messages above. */
@@ -303,6 +314,8 @@ inline const std::array ALL_NET_MESSAGE_TYPES{std::to_array<std::string>({
     NetMsgType::CFCHECKPT,
     NetMsgType::WTXIDRELAY,
     NetMsgType::SENDTXRCNCL,
+    NetMsgType::SENDHDRSCOMP,
+    NetMsgType::HDRSCOMP,
 })};
 
 /** nServices flags */
@@ -4,12 +4,16 @@
 
 #include <psbt.h>
 
+#include <common/system.h>
 #include <node/types.h>
 #include <policy/policy.h>
 #include <script/signingprovider.h>
 #include <util/check.h>
 #include <util/strencodings.h>
 
+#include <atomic>
+#include <thread>
+
 PartiallySignedTransaction::PartiallySignedTransaction(const CMutableTransaction& tx) : tx(tx)
 {
     inputs.resize(tx.vin.size());
@@ -485,8 +489,31 @@ bool FinalizePSBT(PartiallySignedTransaction& psbtx)
     //   script.
     bool complete = true;
     const PrecomputedTransactionData txdata = PrecomputePSBTData(psbtx);
-    for (unsigned int i = 0; i < psbtx.tx->vin.size(); ++i) {
-        complete &= SignPSBTInput(DUMMY_SIGNING_PROVIDER, psbtx, i, &txdata, SIGHASH_ALL, nullptr, true);
+    const size_t num_inputs{psbtx.tx->vin.size()};
+    if (num_inputs >= PSBT_PARALLEL_SIGN_THRESHOLD && GetNumCores() > 1) {
+        // Large transactions: combine/verify the input signatures on all
+        // cores. Each worker touches only its own inputs; the transaction and
+        // the sighash cache are shared read-only.
+        const size_t num_threads{std::min(num_inputs, size_t(std::clamp(GetNumCores(), 2, 16)))};
+        std::atomic<size_t> next_input{0};
+        std::atomic<bool> all_complete{true};
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&] {
+                for (size_t i = next_input.fetch_add(1); i < num_inputs; i = next_input.fetch_add(1)) {
+                    if (!SignPSBTInput(DUMMY_SIGNING_PROVIDER, psbtx, i, &txdata, SIGHASH_ALL, nullptr, true)) {
+                        all_complete = false;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        complete = all_complete;
+    } else {
+        for (unsigned int i = 0; i < num_inputs; ++i) {
+            complete &= SignPSBTInput(DUMMY_SIGNING_PROVIDER, psbtx, i, &txdata, SIGHASH_ALL, nullptr, true);
+        }
     }
 
     return complete;
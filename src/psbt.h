@@ -24,6 +24,12 @@ enum class TransactionError;
 // Magic bytes
 static constexpr uint8_t PSBT_MAGIC_BYTES[5] = {'p', 's', 'b', 't', 0xff};
 
+/** Minimum number of signable inputs before PSBT signing/finalization fans
+ *  out to worker threads. Inputs are independent (each SignPSBTInput call
+ *  only mutates its own PSBTInput and reads the shared transaction and
+ *  sighash cache), but threads aren't worth spawning for small spends. */
+static constexpr size_t PSBT_PARALLEL_SIGN_THRESHOLD{16};
+
 // Global types
 static constexpr uint8_t PSBT_GLOBAL_UNSIGNED_TX = 0x00;
 static constexpr uint8_t PSBT_GLOBAL_XPUB = 0x01;
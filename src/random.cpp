@@ -713,6 +713,20 @@ void FastRandomContext::Reseed(const uint256& seed) noexcept
     rng = {MakeByteSpan(seed)};
 }
 
+/** Number of accesses after which a thread-local RNG is reseeded from the global PRNG. */
+static constexpr uint64_t THREAD_RNG_RESEED_ACCESSES{1 << 20};
+
+FastRandomContext& ThreadLocalRng() noexcept
+{
+    thread_local FastRandomContext rng;
+    thread_local uint64_t accesses{0};
+    if (++accesses >= THREAD_RNG_RESEED_ACCESSES) [[unlikely]] {
+        accesses = 0;
+        rng.Reseed(GetRandHash());
+    }
+    return rng;
+}
+
 bool Random_SanityCheck()
 {
     uint64_t start = GetPerformanceCounter();
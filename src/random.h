@@ -388,7 +388,7 @@ public:
     /** Initialize with explicit seed (only for testing) */
     explicit FastRandomContext(const uint256& seed) noexcept;
 
-    /** Reseed with explicit seed (only for testing). */
+    /** Reseed with explicit seed (for testing and periodic thread-local reseeding). */
     void Reseed(const uint256& seed) noexcept;
 
     /** Generate a random 64-bit integer. */
@@ -458,6 +458,23 @@ inline uint256 GetRandHash() noexcept
     return hash;
 }
 
+/**
+ * Return a reference to a thread-local FastRandomContext.
+ *
+ * This avoids the cost of constructing a fresh FastRandomContext (a draw
+ * from the locked global PRNG state) for every few random bytes needed,
+ * which is what ad-hoc `FastRandomContext().rand64()`-style call sites do.
+ * The returned context is reseeded from the global PRNG after a fixed number
+ * of accesses, so long-lived threads do not run on a single key forever.
+ *
+ * Use its fillrand() to bulk-fill caller-provided buffers; large requests
+ * are served directly from the ChaCha20 keystream without per-call locking.
+ *
+ * The reference must not be shared with other threads, and (like any
+ * FastRandomContext) its output is deterministic in test mode.
+ */
+FastRandomContext& ThreadLocalRng() noexcept;
+
 /* ============================= MISCELLANEOUS TEST-ONLY FUNCTIONS ============================= */
 
 /** Check that OS randomness is available and returning the requested number
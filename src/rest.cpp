@@ -42,7 +42,11 @@ using node::NodeContext;
 using util::SplitString;
 
 static const size_t MAX_GETUTXOS_OUTPOINTS = 15; //allow a max of 15 outpoints to be queried at once
+//! Larger outpoint budget for getutxos queries posted as serialized binary/hex data, for bulk consumers
+static const size_t MAX_GETUTXOS_OUTPOINTS_BINARY = 5000;
 static constexpr unsigned int MAX_REST_HEADERS_RESULTS = 2000;
+//! Binary/hex header ranges are one compact serialized header per entry, so allow larger batches
+static constexpr unsigned int MAX_REST_HEADERS_RESULTS_BINARY = 20000;
 
 static const struct {
     RESTResponseFormat rf;
@@ -212,9 +216,10 @@ static bool rest_headers(const std::any& context,
         return RESTERR(req, HTTP_BAD_REQUEST, "Invalid URI format. Expected /rest/headers/<hash>.<ext>?count=<count>");
     }
 
+    const unsigned int max_count{rf == RESTResponseFormat::JSON ? MAX_REST_HEADERS_RESULTS : MAX_REST_HEADERS_RESULTS_BINARY};
     const auto parsed_count{ToIntegral<size_t>(raw_count)};
-    if (!parsed_count.has_value() || *parsed_count < 1 || *parsed_count > MAX_REST_HEADERS_RESULTS) {
-        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Header count is invalid or out of acceptable range (1-%u): %s", MAX_REST_HEADERS_RESULTS, raw_count));
+    if (!parsed_count.has_value() || *parsed_count < 1 || *parsed_count > max_count) {
+        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Header count is invalid or out of acceptable range (1-%u): %s", max_count, raw_count));
     }
 
     auto hash{uint256::FromHex(hashStr)};
@@ -262,7 +267,7 @@ static bool rest_headers(const std::any& context,
 
         std::string strHex = HexStr(ssHeader) + "\n";
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
     case RESTResponseFormat::JSON: {
@@ -272,7 +277,7 @@ static bool rest_headers(const std::any& context,
         }
         std::string strJSON = jsonHeaders.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -333,7 +338,7 @@ static bool rest_block(const std::any& context,
     case RESTResponseFormat::HEX: {
         const std::string strHex{HexStr(block_data) + "\n"};
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
 
@@ -344,7 +349,7 @@ static bool rest_block(const std::any& context,
         UniValue objBlock = blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, tx_verbosity, chainman.GetConsensus().powLimit);
         std::string strJSON = objBlock.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
 
@@ -466,7 +471,7 @@ static bool rest_filter_header(const std::any& context, HTTPRequest* req, const
 
         std::string strHex = HexStr(ssHeader) + "\n";
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
     case RESTResponseFormat::JSON: {
@@ -477,7 +482,7 @@ static bool rest_filter_header(const std::any& context, HTTPRequest* req, const
 
         std::string strJSON = jsonHeaders.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -560,7 +565,7 @@ static bool rest_block_filter(const std::any& context, HTTPRequest* req, const s
 
         std::string strHex = HexStr(ssResp) + "\n";
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
     case RESTResponseFormat::JSON: {
@@ -568,7 +573,7 @@ static bool rest_block_filter(const std::any& context, HTTPRequest* req, const s
         ret.pushKV("filter", HexStr(filter.GetEncodedFilter()));
         std::string strJSON = ret.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -595,7 +600,7 @@ static bool rest_chaininfo(const std::any& context, HTTPRequest* req, const std:
         UniValue chainInfoObject = getblockchaininfo().HandleRequest(jsonRequest);
         std::string strJSON = chainInfoObject.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -693,7 +698,7 @@ static bool rest_mempool(const std::any& context, HTTPRequest* req, const std::s
         }
 
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, str_json);
+        req->WriteReply(HTTP_OK, std::move(str_json));
         return true;
     }
     default: {
@@ -742,7 +747,7 @@ static bool rest_tx(const std::any& context, HTTPRequest* req, const std::string
 
         std::string strHex = HexStr(ssTx) + "\n";
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
 
@@ -751,7 +756,7 @@ static bool rest_tx(const std::any& context, HTTPRequest* req, const std::string
         TxToUniv(*tx, /*block_hash=*/hashBlock, /*entry=*/ objTx);
         std::string strJSON = objTx.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
 
@@ -852,9 +857,11 @@ static bool rest_getutxos(const std::any& context, HTTPRequest* req, const std::
     }
     }
 
-    // limit max outpoints
-    if (vOutPoints.size() > MAX_GETUTXOS_OUTPOINTS)
-        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Error: max outpoints exceeded (max: %d, tried: %d)", MAX_GETUTXOS_OUTPOINTS, vOutPoints.size()));
+    // limit max outpoints: requests posted as serialized data get a larger
+    // budget than URI-scheme/JSON requests, whose responses are far bigger
+    const size_t max_outpoints{fInputParsed || rf == RESTResponseFormat::JSON ? MAX_GETUTXOS_OUTPOINTS : MAX_GETUTXOS_OUTPOINTS_BINARY};
+    if (vOutPoints.size() > max_outpoints)
+        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Error: max outpoints exceeded (max: %d, tried: %d)", max_outpoints, vOutPoints.size()));
 
     // check spentness and form a bitmap (as well as a JSON capable human-readable string representation)
     std::vector<unsigned char> bitmap;
@@ -916,7 +923,7 @@ static bool rest_getutxos(const std::any& context, HTTPRequest* req, const std::
         std::string strHex = HexStr(ssGetUTXOResponse) + "\n";
 
         req->WriteHeader("Content-Type", "text/plain");
-        req->WriteReply(HTTP_OK, strHex);
+        req->WriteReply(HTTP_OK, std::move(strHex));
         return true;
     }
 
@@ -946,7 +953,7 @@ static bool rest_getutxos(const std::any& context, HTTPRequest* req, const std::
         // return json string
         std::string strJSON = objGetUTXOResponse.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        req->WriteReply(HTTP_OK, std::move(strJSON));
         return true;
     }
     default: {
@@ -21,6 +21,7 @@
 #include <flatfile.h>
 #include <hash.h>
 #include <index/blockfilterindex.h>
+#include <index/blockstatsindex.h>
 #include <index/coinstatsindex.h>
 #include <interfaces/mining.h>
 #include <kernel/coinstats.h>
@@ -45,6 +46,7 @@
 #include <undo.h>
 #include <univalue.h>
 #include <util/check.h>
+#include <util/hasher.h>
 #include <util/fs.h>
 #include <util/strencodings.h>
 #include <util/translation.h>
@@ -55,10 +57,15 @@
 #include <stdint.h>
 
 #include <condition_variable>
+#include <deque>
 #include <iterator>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 using kernel::CCoinsStats;
@@ -673,6 +680,69 @@ static CBlockUndo GetUndoChecked(BlockManager& blockman, const CBlockIndex& bloc
     return blockUndo;
 }
 
+namespace {
+/** LRU cache of rendered getblock responses.
+ *
+ * Explorer-style frontends tend to request the same few recent blocks over
+ * and over, and each verbosity>=2 call costs a disk read plus a full JSON
+ * render of every transaction. Entries are keyed by (block hash, verbosity,
+ * tip hash): the tip is part of the key because confirmations and
+ * nextblockhash depend on it, so a cached entry is valid for as long as it
+ * is reachable — no invalidation hooks needed. Entries rendered against an
+ * old tip simply stop being requested and age out.
+ *
+ * Memory is bounded by -rpccachesize, accounted in raw (serialized) block
+ * bytes. The JSON representation is a small multiple of that; the option
+ * documents the approximation.
+ */
+class GetBlockResponseCache
+{
+private:
+    //! (block hash, verbosity, tip hash)
+    using Key = std::tuple<uint256, int, uint256>;
+    struct Entry {
+        UniValue response;
+        size_t weight;
+        std::list<Key>::iterator lru_it;
+    };
+
+    Mutex m_mutex;
+    //! Most recently used entries at the front
+    std::list<Key> m_lru GUARDED_BY(m_mutex);
+    std::map<Key, Entry> m_entries GUARDED_BY(m_mutex);
+    size_t m_total_weight GUARDED_BY(m_mutex){0};
+
+public:
+    std::optional<UniValue> Get(const uint256& block_hash, int verbosity, const uint256& tip_hash) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto it{m_entries.find({block_hash, verbosity, tip_hash})};
+        if (it == m_entries.end()) return std::nullopt;
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru_it);
+        return it->second.response;
+    }
+
+    void Insert(const uint256& block_hash, int verbosity, const uint256& tip_hash, const UniValue& response, size_t weight, size_t max_weight) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        if (weight > max_weight) return;
+        LOCK(m_mutex);
+        const Key key{block_hash, verbosity, tip_hash};
+        if (m_entries.count(key)) return;
+        m_lru.push_front(key);
+        m_entries.emplace(key, Entry{response, weight, m_lru.begin()});
+        m_total_weight += weight;
+        while (m_total_weight > max_weight) {
+            auto evict{m_entries.find(m_lru.back())};
+            m_total_weight -= evict->second.weight;
+            m_entries.erase(evict);
+            m_lru.pop_back();
+        }
+    }
+};
+
+GetBlockResponseCache g_getblock_cache;
+} // namespace
+
 const RPCResult getblock_vin{
     RPCResult::Type::ARR, "vin", "",
     {
@@ -786,26 +856,39 @@ static RPCHelpMan getblock()
         }
     }
 
-    const std::vector<uint8_t> block_data{GetRawBlockChecked(chainman.m_blockman, *pblockindex)};
-
-    if (verbosity <= 0) {
-        return HexStr(block_data);
+    // Parsed once after args are available; 0 disables caching.
+    static const size_t max_cache_bytes{static_cast<size_t>(std::max<int64_t>(0, gArgs.GetIntArg("-rpccachesize", DEFAULT_RPC_CACHE_SIZE_MB))) * 1024 * 1024};
+    const uint256 tip_hash{tip->GetBlockHash()};
+    if (max_cache_bytes > 0) {
+        if (auto cached{g_getblock_cache.Get(hash, verbosity, tip_hash)}) return std::move(*cached);
     }
 
-    DataStream block_stream{block_data};
-    CBlock block{};
-    block_stream >> TX_WITH_WITNESS(block);
+    const std::vector<uint8_t> block_data{GetRawBlockChecked(chainman.m_blockman, *pblockindex)};
 
-    TxVerbosity tx_verbosity;
-    if (verbosity == 1) {
-        tx_verbosity = TxVerbosity::SHOW_TXID;
-    } else if (verbosity == 2) {
-        tx_verbosity = TxVerbosity::SHOW_DETAILS;
+    UniValue result;
+    if (verbosity <= 0) {
+        result = HexStr(block_data);
     } else {
-        tx_verbosity = TxVerbosity::SHOW_DETAILS_AND_PREVOUT;
+        DataStream block_stream{block_data};
+        CBlock block{};
+        block_stream >> TX_WITH_WITNESS(block);
+
+        TxVerbosity tx_verbosity;
+        if (verbosity == 1) {
+            tx_verbosity = TxVerbosity::SHOW_TXID;
+        } else if (verbosity == 2) {
+            tx_verbosity = TxVerbosity::SHOW_DETAILS;
+        } else {
+            tx_verbosity = TxVerbosity::SHOW_DETAILS_AND_PREVOUT;
+        }
+
+        result = blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, tx_verbosity, chainman.GetConsensus().powLimit);
     }
 
-    return blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, tx_verbosity, chainman.GetConsensus().powLimit);
+    if (max_cache_bytes > 0) {
+        g_getblock_cache.Insert(hash, verbosity, tip_hash, result, block_data.size(), max_cache_bytes);
+    }
+    return result;
 },
     };
 }
@@ -1788,6 +1871,64 @@ static RPCHelpMan getchaintxstats()
     };
 }
 
+static RPCHelpMan getblockconnectionstats()
+{
+    return RPCHelpMan{"getblockconnectionstats",
+                "\nReturns cumulative wall-clock time spent in each stage of block connection since startup.\n"
+                "The per-stage totals are monotonic counters; sample them periodically and take differences\n"
+                "to attribute block-connect latency to a stage. For a per-block breakdown use the\n"
+                "validation:block_connect_stages and validation:connect_tip_stages tracepoints.\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::NUM, "blocks", "The number of blocks connected since startup"},
+                        {RPCResult::Type::OBJ, "stage_totals_ms", "Cumulative time per stage, in milliseconds",
+                        {
+                            {RPCResult::Type::NUM, "check", "Block sanity checks (CheckBlock)"},
+                            {RPCResult::Type::NUM, "forks", "Fork and deployment checks"},
+                            {RPCResult::Type::NUM, "connect", "Input fetching and applying the block to the coins cache"},
+                            {RPCResult::Type::NUM, "verify", "Script verification (includes the connect stage, which runs while parallel script checks are queued)"},
+                            {RPCResult::Type::NUM, "undo", "Undo data write"},
+                            {RPCResult::Type::NUM, "index", "Block index update"},
+                            {RPCResult::Type::NUM, "connect_total", "Total time in ConnectBlock"},
+                            {RPCResult::Type::NUM, "flush", "Flushing the per-block coins view into the tip cache"},
+                            {RPCResult::Type::NUM, "chainstate", "Writing the chainstate to disk, when needed"},
+                            {RPCResult::Type::NUM, "postconnect", "Mempool removal and tip update"},
+                            {RPCResult::Type::NUM, "total", "Total time connecting blocks"},
+                        }},
+                    }},
+                RPCExamples{
+                    HelpExampleCli("getblockconnectionstats", "")
+            + HelpExampleRpc("getblockconnectionstats", "")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+
+    const auto timings{WITH_LOCK(cs_main, return chainman.GetConnectBlockTimings())};
+
+    UniValue stages(UniValue::VOBJ);
+    stages.pushKV("check", Ticks<MillisecondsDouble>(timings.check));
+    stages.pushKV("forks", Ticks<MillisecondsDouble>(timings.forks));
+    stages.pushKV("connect", Ticks<MillisecondsDouble>(timings.connect));
+    stages.pushKV("verify", Ticks<MillisecondsDouble>(timings.verify));
+    stages.pushKV("undo", Ticks<MillisecondsDouble>(timings.undo));
+    stages.pushKV("index", Ticks<MillisecondsDouble>(timings.index));
+    stages.pushKV("connect_total", Ticks<MillisecondsDouble>(timings.connect_total));
+    stages.pushKV("flush", Ticks<MillisecondsDouble>(timings.flush));
+    stages.pushKV("chainstate", Ticks<MillisecondsDouble>(timings.chainstate));
+    stages.pushKV("postconnect", Ticks<MillisecondsDouble>(timings.post_connect));
+    stages.pushKV("total", Ticks<MillisecondsDouble>(timings.total));
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("blocks", timings.num_blocks);
+    ret.pushKV("stage_totals_ms", std::move(stages));
+    return ret;
+},
+    };
+}
+
 template<typename T>
 static T CalculateTruncatedMedian(std::vector<T>& scores)
 {
@@ -1833,17 +1974,108 @@ void CalculatePercentilesByWeight(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES],
     }
 }
 
-template<typename T>
-static inline bool SetHasKeys(const std::set<T>& set) {return false;}
-template<typename T, typename Tk, typename... Args>
-static inline bool SetHasKeys(const std::set<T>& set, const Tk& key, const Args&... args)
-{
-    return (set.count(key) != 0) || SetHasKeys(set, args...);
-}
-
 // outpoint (needed for the utxo index) + nHeight + fCoinBase
 static constexpr size_t PER_UTXO_OVERHEAD = sizeof(COutPoint) + sizeof(uint32_t) + sizeof(bool);
 
+BlockStats ComputeBlockStats(const CBlock& block, const CBlockUndo& block_undo, const CBlockIndex& pindex)
+{
+    BlockStats stats;
+    CAmount maxfee = 0;
+    CAmount maxfeerate = 0;
+    CAmount minfee = MAX_MONEY;
+    CAmount minfeerate = MAX_MONEY;
+    int64_t maxtxsize = 0;
+    int64_t mintxsize = MAX_BLOCK_SERIALIZED_SIZE;
+    int64_t utxos = 0;
+    std::vector<CAmount> fee_array;
+    std::vector<std::pair<CAmount, int64_t>> feerate_array;
+    std::vector<int64_t> txsize_array;
+
+    stats.txs = block.vtx.size();
+
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        const auto& tx = block.vtx.at(i);
+        stats.outputs += tx->vout.size();
+
+        CAmount tx_total_out = 0;
+        for (const CTxOut& out : tx->vout) {
+            tx_total_out += out.nValue;
+
+            size_t out_size = GetSerializeSize(out) + PER_UTXO_OVERHEAD;
+            stats.utxo_size_inc += out_size;
+
+            // The Genesis block and the repeated BIP30 block coinbases don't change the UTXO
+            // set counts, so they have to be excluded from the statistics
+            if (pindex.nHeight == 0 || (IsBIP30Repeat(pindex) && tx->IsCoinBase())) continue;
+            // Skip unspendable outputs since they are not included in the UTXO set
+            if (out.scriptPubKey.IsUnspendable()) continue;
+
+            ++utxos;
+            stats.utxo_size_inc_actual += out_size;
+        }
+
+        if (tx->IsCoinBase()) {
+            continue;
+        }
+
+        stats.inputs += tx->vin.size(); // Don't count coinbase's fake input
+        stats.total_out += tx_total_out; // Don't count coinbase reward
+
+        const int64_t tx_size = tx->GetTotalSize();
+        txsize_array.push_back(tx_size);
+        maxtxsize = std::max(maxtxsize, tx_size);
+        mintxsize = std::min(mintxsize, tx_size);
+        stats.total_size += tx_size;
+
+        const int64_t weight = GetTransactionWeight(*tx);
+        stats.total_weight += weight;
+
+        if (tx->HasWitness()) {
+            ++stats.swtxs;
+            stats.swtotal_size += tx_size;
+            stats.swtotal_weight += weight;
+        }
+
+        CAmount tx_total_in = 0;
+        const auto& txundo = block_undo.vtxundo.at(i - 1);
+        for (const Coin& coin: txundo.vprevout) {
+            const CTxOut& prevoutput = coin.out;
+
+            tx_total_in += prevoutput.nValue;
+            size_t prevout_size = GetSerializeSize(prevoutput) + PER_UTXO_OVERHEAD;
+            stats.utxo_size_inc -= prevout_size;
+            stats.utxo_size_inc_actual -= prevout_size;
+        }
+
+        CAmount txfee = tx_total_in - tx_total_out;
+        CHECK_NONFATAL(MoneyRange(txfee));
+        fee_array.push_back(txfee);
+        maxfee = std::max(maxfee, txfee);
+        minfee = std::min(minfee, txfee);
+        stats.totalfee += txfee;
+
+        // New feerate uses satoshis per virtual byte instead of per serialized byte
+        CAmount feerate = weight ? (txfee * WITNESS_SCALE_FACTOR) / weight : 0;
+        feerate_array.emplace_back(feerate, weight);
+        maxfeerate = std::max(maxfeerate, feerate);
+        minfeerate = std::min(minfeerate, feerate);
+    }
+
+    CalculatePercentilesByWeight(stats.feerate_percentiles, feerate_array, stats.total_weight);
+
+    stats.maxfee = maxfee;
+    stats.maxfeerate = maxfeerate;
+    stats.minfee = (minfee == MAX_MONEY) ? 0 : minfee;
+    stats.minfeerate = (minfeerate == MAX_MONEY) ? 0 : minfeerate;
+    stats.maxtxsize = maxtxsize;
+    stats.mintxsize = (mintxsize == MAX_BLOCK_SERIALIZED_SIZE) ? 0 : mintxsize;
+    stats.medianfee = CalculateTruncatedMedian(fee_array);
+    stats.mediantxsize = CalculateTruncatedMedian(txsize_array);
+    stats.utxo_increase_actual = utxos - stats.inputs;
+
+    return stats;
+}
+
 static RPCHelpMan getblockstats()
 {
     return RPCHelpMan{"getblockstats",
@@ -1924,170 +2156,61 @@ static RPCHelpMan getblockstats()
         }
     }
 
-    const CBlock& block = GetBlockChecked(chainman.m_blockman, pindex);
-    const CBlockUndo& blockUndo = GetUndoChecked(chainman.m_blockman, pindex);
-
-    const bool do_all = stats.size() == 0; // Calculate everything if nothing selected (default)
-    const bool do_mediantxsize = do_all || stats.count("mediantxsize") != 0;
-    const bool do_medianfee = do_all || stats.count("medianfee") != 0;
-    const bool do_feerate_percentiles = do_all || stats.count("feerate_percentiles") != 0;
-    const bool loop_inputs = do_all || do_medianfee || do_feerate_percentiles ||
-        SetHasKeys(stats, "utxo_increase", "utxo_increase_actual", "utxo_size_inc", "utxo_size_inc_actual", "totalfee", "avgfee", "avgfeerate", "minfee", "maxfee", "minfeerate", "maxfeerate");
-    const bool loop_outputs = do_all || loop_inputs || stats.count("total_out");
-    const bool do_calculate_size = do_mediantxsize ||
-        SetHasKeys(stats, "total_size", "avgtxsize", "mintxsize", "maxtxsize", "swtotal_size");
-    const bool do_calculate_weight = do_all || SetHasKeys(stats, "total_weight", "avgfeerate", "swtotal_weight", "avgfeerate", "feerate_percentiles", "minfeerate", "maxfeerate");
-    const bool do_calculate_sw = do_all || SetHasKeys(stats, "swtxs", "swtotal_size", "swtotal_weight");
-
-    CAmount maxfee = 0;
-    CAmount maxfeerate = 0;
-    CAmount minfee = MAX_MONEY;
-    CAmount minfeerate = MAX_MONEY;
-    CAmount total_out = 0;
-    CAmount totalfee = 0;
-    int64_t inputs = 0;
-    int64_t maxtxsize = 0;
-    int64_t mintxsize = MAX_BLOCK_SERIALIZED_SIZE;
-    int64_t outputs = 0;
-    int64_t swtotal_size = 0;
-    int64_t swtotal_weight = 0;
-    int64_t swtxs = 0;
-    int64_t total_size = 0;
-    int64_t total_weight = 0;
-    int64_t utxos = 0;
-    int64_t utxo_size_inc = 0;
-    int64_t utxo_size_inc_actual = 0;
-    std::vector<CAmount> fee_array;
-    std::vector<std::pair<CAmount, int64_t>> feerate_array;
-    std::vector<int64_t> txsize_array;
-
-    for (size_t i = 0; i < block.vtx.size(); ++i) {
-        const auto& tx = block.vtx.at(i);
-        outputs += tx->vout.size();
-
-        CAmount tx_total_out = 0;
-        if (loop_outputs) {
-            for (const CTxOut& out : tx->vout) {
-                tx_total_out += out.nValue;
-
-                size_t out_size = GetSerializeSize(out) + PER_UTXO_OVERHEAD;
-                utxo_size_inc += out_size;
-
-                // The Genesis block and the repeated BIP30 block coinbases don't change the UTXO
-                // set counts, so they have to be excluded from the statistics
-                if (pindex.nHeight == 0 || (IsBIP30Repeat(pindex) && tx->IsCoinBase())) continue;
-                // Skip unspendable outputs since they are not included in the UTXO set
-                if (out.scriptPubKey.IsUnspendable()) continue;
-
-                ++utxos;
-                utxo_size_inc_actual += out_size;
-            }
-        }
-
-        if (tx->IsCoinBase()) {
-            continue;
-        }
-
-        inputs += tx->vin.size(); // Don't count coinbase's fake input
-        total_out += tx_total_out; // Don't count coinbase reward
-
-        int64_t tx_size = 0;
-        if (do_calculate_size) {
-
-            tx_size = tx->GetTotalSize();
-            if (do_mediantxsize) {
-                txsize_array.push_back(tx_size);
-            }
-            maxtxsize = std::max(maxtxsize, tx_size);
-            mintxsize = std::min(mintxsize, tx_size);
-            total_size += tx_size;
-        }
-
-        int64_t weight = 0;
-        if (do_calculate_weight) {
-            weight = GetTransactionWeight(*tx);
-            total_weight += weight;
-        }
-
-        if (do_calculate_sw && tx->HasWitness()) {
-            ++swtxs;
-            swtotal_size += tx_size;
-            swtotal_weight += weight;
-        }
-
-        if (loop_inputs) {
-            CAmount tx_total_in = 0;
-            const auto& txundo = blockUndo.vtxundo.at(i - 1);
-            for (const Coin& coin: txundo.vprevout) {
-                const CTxOut& prevoutput = coin.out;
-
-                tx_total_in += prevoutput.nValue;
-                size_t prevout_size = GetSerializeSize(prevoutput) + PER_UTXO_OVERHEAD;
-                utxo_size_inc -= prevout_size;
-                utxo_size_inc_actual -= prevout_size;
-            }
-
-            CAmount txfee = tx_total_in - tx_total_out;
-            CHECK_NONFATAL(MoneyRange(txfee));
-            if (do_medianfee) {
-                fee_array.push_back(txfee);
-            }
-            maxfee = std::max(maxfee, txfee);
-            minfee = std::min(minfee, txfee);
-            totalfee += txfee;
-
-            // New feerate uses satoshis per virtual byte instead of per serialized byte
-            CAmount feerate = weight ? (txfee * WITNESS_SCALE_FACTOR) / weight : 0;
-            if (do_feerate_percentiles) {
-                feerate_array.emplace_back(feerate, weight);
-            }
-            maxfeerate = std::max(maxfeerate, feerate);
-            minfeerate = std::min(minfeerate, feerate);
-        }
+    // The block stats index turns the query into a point lookup; without it
+    // (or for blocks it hasn't covered yet) fall back to reading the block
+    // and undo data from disk and computing the stats here.
+    BlockStats block_stats;
+    std::optional<BlockStats> indexed_stats;
+    if (g_blockstats_index) {
+        indexed_stats = g_blockstats_index->LookUpStats(pindex);
+    }
+    if (indexed_stats) {
+        block_stats = *indexed_stats;
+    } else {
+        const CBlock& block = GetBlockChecked(chainman.m_blockman, pindex);
+        const CBlockUndo& blockUndo = GetUndoChecked(chainman.m_blockman, pindex);
+        block_stats = ComputeBlockStats(block, blockUndo, pindex);
     }
-
-    CAmount feerate_percentiles[NUM_GETBLOCKSTATS_PERCENTILES] = { 0 };
-    CalculatePercentilesByWeight(feerate_percentiles, feerate_array, total_weight);
 
     UniValue feerates_res(UniValue::VARR);
     for (int64_t i = 0; i < NUM_GETBLOCKSTATS_PERCENTILES; i++) {
-        feerates_res.push_back(feerate_percentiles[i]);
+        feerates_res.push_back(block_stats.feerate_percentiles[i]);
     }
 
     UniValue ret_all(UniValue::VOBJ);
-    ret_all.pushKV("avgfee", (block.vtx.size() > 1) ? totalfee / (block.vtx.size() - 1) : 0);
-    ret_all.pushKV("avgfeerate", total_weight ? (totalfee * WITNESS_SCALE_FACTOR) / total_weight : 0); // Unit: sat/vbyte
-    ret_all.pushKV("avgtxsize", (block.vtx.size() > 1) ? total_size / (block.vtx.size() - 1) : 0);
+    ret_all.pushKV("avgfee", (block_stats.txs > 1) ? block_stats.totalfee / (block_stats.txs - 1) : 0);
+    ret_all.pushKV("avgfeerate", block_stats.total_weight ? (block_stats.totalfee * WITNESS_SCALE_FACTOR) / block_stats.total_weight : 0); // Unit: sat/vbyte
+    ret_all.pushKV("avgtxsize", (block_stats.txs > 1) ? block_stats.total_size / (block_stats.txs - 1) : 0);
     ret_all.pushKV("blockhash", pindex.GetBlockHash().GetHex());
     ret_all.pushKV("feerate_percentiles", std::move(feerates_res));
     ret_all.pushKV("height", (int64_t)pindex.nHeight);
-    ret_all.pushKV("ins", inputs);
-    ret_all.pushKV("maxfee", maxfee);
-    ret_all.pushKV("maxfeerate", maxfeerate);
-    ret_all.pushKV("maxtxsize", maxtxsize);
-    ret_all.pushKV("medianfee", CalculateTruncatedMedian(fee_array));
+    ret_all.pushKV("ins", block_stats.inputs);
+    ret_all.pushKV("maxfee", block_stats.maxfee);
+    ret_all.pushKV("maxfeerate", block_stats.maxfeerate);
+    ret_all.pushKV("maxtxsize", block_stats.maxtxsize);
+    ret_all.pushKV("medianfee", block_stats.medianfee);
     ret_all.pushKV("mediantime", pindex.GetMedianTimePast());
-    ret_all.pushKV("mediantxsize", CalculateTruncatedMedian(txsize_array));
-    ret_all.pushKV("minfee", (minfee == MAX_MONEY) ? 0 : minfee);
-    ret_all.pushKV("minfeerate", (minfeerate == MAX_MONEY) ? 0 : minfeerate);
-    ret_all.pushKV("mintxsize", mintxsize == MAX_BLOCK_SERIALIZED_SIZE ? 0 : mintxsize);
-    ret_all.pushKV("outs", outputs);
+    ret_all.pushKV("mediantxsize", block_stats.mediantxsize);
+    ret_all.pushKV("minfee", block_stats.minfee);
+    ret_all.pushKV("minfeerate", block_stats.minfeerate);
+    ret_all.pushKV("mintxsize", block_stats.mintxsize);
+    ret_all.pushKV("outs", block_stats.outputs);
     ret_all.pushKV("subsidy", GetBlockSubsidy(pindex.nHeight, chainman.GetParams().GetConsensus()));
-    ret_all.pushKV("swtotal_size", swtotal_size);
-    ret_all.pushKV("swtotal_weight", swtotal_weight);
-    ret_all.pushKV("swtxs", swtxs);
+    ret_all.pushKV("swtotal_size", block_stats.swtotal_size);
+    ret_all.pushKV("swtotal_weight", block_stats.swtotal_weight);
+    ret_all.pushKV("swtxs", block_stats.swtxs);
     ret_all.pushKV("time", pindex.GetBlockTime());
-    ret_all.pushKV("total_out", total_out);
-    ret_all.pushKV("total_size", total_size);
-    ret_all.pushKV("total_weight", total_weight);
-    ret_all.pushKV("totalfee", totalfee);
-    ret_all.pushKV("txs", (int64_t)block.vtx.size());
-    ret_all.pushKV("utxo_increase", outputs - inputs);
-    ret_all.pushKV("utxo_size_inc", utxo_size_inc);
-    ret_all.pushKV("utxo_increase_actual", utxos - inputs);
-    ret_all.pushKV("utxo_size_inc_actual", utxo_size_inc_actual);
-
-    if (do_all) {
+    ret_all.pushKV("total_out", block_stats.total_out);
+    ret_all.pushKV("total_size", block_stats.total_size);
+    ret_all.pushKV("total_weight", block_stats.total_weight);
+    ret_all.pushKV("totalfee", block_stats.totalfee);
+    ret_all.pushKV("txs", block_stats.txs);
+    ret_all.pushKV("utxo_increase", block_stats.outputs - block_stats.inputs);
+    ret_all.pushKV("utxo_size_inc", block_stats.utxo_size_inc);
+    ret_all.pushKV("utxo_increase_actual", block_stats.utxo_increase_actual);
+    ret_all.pushKV("utxo_size_inc_actual", block_stats.utxo_size_inc_actual);
+
+    if (stats.empty()) { // Return everything if nothing selected (default)
         return ret_all;
     }
 
@@ -2105,11 +2228,11 @@ static RPCHelpMan getblockstats()
 }
 
 namespace {
-//! Search for a given set of pubkey scripts
-bool FindScriptPubKey(std::atomic<int>& scan_progress, const std::atomic<bool>& should_abort, int64_t& count, CCoinsViewCursor* cursor, const std::set<CScript>& needles, std::map<COutPoint, Coin>& out_results, std::function<void()>& interruption_point)
+//! Search for a given set of pubkey scripts. The caller initializes count (and
+//! scan_progress) so that a scan resumed from a checkpoint keeps counting from
+//! where it left off. On abort, resume_key is set to the first unprocessed key.
+bool FindScriptPubKey(std::atomic<int>& scan_progress, const std::atomic<bool>& should_abort, int64_t& count, CCoinsViewCursor* cursor, const std::unordered_set<CScript, SaltedSipHasher>& needles, std::map<COutPoint, Coin>& out_results, std::function<void()>& interruption_point, COutPoint& resume_key)
 {
-    scan_progress = 0;
-    count = 0;
     while (cursor->Valid()) {
         COutPoint key;
         Coin coin;
@@ -2117,7 +2240,11 @@ bool FindScriptPubKey(std::atomic<int>& scan_progress, const std::atomic<bool>&
         if (++count % 8192 == 0) {
             interruption_point();
             if (should_abort) {
-                // allow to abort the scan via the abort reference
+                // allow to abort the scan via the abort reference; the current
+                // key has not been matched yet, so it is where a resumed scan
+                // picks up (and where it will be counted)
+                resume_key = key;
+                --count;
                 return false;
             }
         }
@@ -2136,6 +2263,22 @@ bool FindScriptPubKey(std::atomic<int>& scan_progress, const std::atomic<bool>&
 }
 } // namespace
 
+/** State left behind by an aborted scantxoutset run. A subsequent "start" with
+ *  the same scan objects resumes from here instead of rescanning from the
+ *  beginning; a "start" with different scan objects discards it. Only accessed
+ *  while the scan is reserved, so no lock is needed. */
+struct CoinsScanCheckpoint {
+    //! The scripts the aborted scan was matching against
+    std::set<CScript> needles;
+    //! Matches accumulated before the abort
+    std::map<COutPoint, Coin> results;
+    //! First coin not yet processed; the resumed cursor seeks here
+    COutPoint resume_key;
+    //! Number of coins processed before the abort
+    int64_t count;
+};
+static std::optional<CoinsScanCheckpoint> g_scan_checkpoint;
+
 /** RAII object to prevent concurrency issue when scanning the txout set */
 static std::atomic<int> g_scan_progress;
 static std::atomic<bool> g_scan_in_progress;
@@ -2220,7 +2363,10 @@ static RPCHelpMan scantxoutset()
         "or more path elements separated by \"/\", and optionally ending in \"/*\" (unhardened), or \"/*'\" or \"/*h\" (hardened) to specify all\n"
         "unhardened or hardened child keys.\n"
         "In the latter case, a range needs to be specified by below if different from 1000.\n"
-        "For more information on output descriptors, see the documentation in the doc/descriptors.md file.\n",
+        "For more information on output descriptors, see the documentation in the doc/descriptors.md file.\n"
+        "\nAn aborted scan keeps its position and partial results: issuing \"start\" again with the same scan objects\n"
+        "resumes it instead of restarting, although coins already scanned may have been spent in the meantime.\n"
+        "Starting a scan with different scan objects discards the saved position.\n",
         {
             scan_action_arg_desc,
             scan_objects_arg_desc,
@@ -2291,7 +2437,7 @@ static RPCHelpMan scantxoutset()
             throw JSONRPCError(RPC_MISC_ERROR, "scanobjects argument is required for the start action");
         }
 
-        std::set<CScript> needles;
+        std::unordered_set<CScript, SaltedSipHasher> needles;
         std::map<CScript, std::string> descriptors;
         CAmount total_in = 0;
 
@@ -2312,6 +2458,15 @@ static RPCHelpMan scantxoutset()
         std::map<COutPoint, Coin> coins;
         g_should_abort_scan = false;
         int64_t count = 0;
+        std::optional<COutPoint> resume_from;
+        if (g_scan_checkpoint) {
+            if (std::set<CScript>(needles.begin(), needles.end()) == g_scan_checkpoint->needles) {
+                coins = std::move(g_scan_checkpoint->results);
+                resume_from = g_scan_checkpoint->resume_key;
+                count = g_scan_checkpoint->count;
+            }
+            g_scan_checkpoint.reset();
+        }
         std::unique_ptr<CCoinsViewCursor> pcursor;
         const CBlockIndex* tip;
         NodeContext& node = EnsureAnyNodeContext(request.context);
@@ -2320,10 +2475,21 @@ static RPCHelpMan scantxoutset()
             LOCK(cs_main);
             Chainstate& active_chainstate = chainman.ActiveChainstate();
             active_chainstate.ForceFlushStateToDisk();
-            pcursor = CHECK_NONFATAL(active_chainstate.CoinsDB().Cursor());
+            // The cursor reads a LevelDB snapshot taken here, so later flushes
+            // proceed concurrently without affecting this scan.
+            pcursor = CHECK_NONFATAL(resume_from ? active_chainstate.CoinsDB().Cursor(*resume_from) : active_chainstate.CoinsDB().Cursor());
             tip = CHECK_NONFATAL(active_chainstate.m_chain.Tip());
         }
-        bool res = FindScriptPubKey(g_scan_progress, g_should_abort_scan, count, pcursor.get(), needles, coins, node.rpc_interruption_point);
+        COutPoint resume_key;
+        bool res = FindScriptPubKey(g_scan_progress, g_should_abort_scan, count, pcursor.get(), needles, coins, node.rpc_interruption_point, resume_key);
+        if (!res && g_should_abort_scan) {
+            g_scan_checkpoint = CoinsScanCheckpoint{
+                .needles = {needles.begin(), needles.end()},
+                .results = coins,
+                .resume_key = resume_key,
+                .count = count,
+            };
+        }
         result.pushKV("success", res);
         result.pushKV("txouts", count);
         result.pushKV("height", tip->nHeight);
@@ -3162,43 +3328,110 @@ UniValue WriteUTXOSnapshot(
     size_t written_coins_count{0};
     std::vector<std::pair<uint32_t, Coin>> coins;
 
+    // The cursor walk and the serialization are overlapped with the file I/O:
+    // coins are serialized into in-memory batches on this thread while a
+    // background writer drains completed batches to disk, so the dump is not
+    // bottlenecked on whichever of LevelDB iteration or disk writes is slower.
+    //! Target size of one in-memory batch before it is handed to the writer.
+    constexpr size_t SNAPSHOT_BATCH_SIZE{4 << 20};
+    //! Maximum number of completed batches queued for writing before the
+    //! cursor thread blocks, bounding memory use.
+    constexpr size_t SNAPSHOT_MAX_QUEUED_BATCHES{4};
+
+    std::mutex write_mutex;
+    std::condition_variable write_cv;
+    std::deque<DataStream> write_queue;
+    bool done{false};
+    std::exception_ptr write_error;
+
+    std::thread writer([&] {
+        std::unique_lock<std::mutex> lock(write_mutex);
+        while (true) {
+            write_cv.wait(lock, [&] { return !write_queue.empty() || done; });
+            if (write_queue.empty()) break;
+            DataStream batch{std::move(write_queue.front())};
+            write_queue.pop_front();
+            lock.unlock();
+            write_cv.notify_one();
+            try {
+                afile.write(batch);
+            } catch (...) {
+                lock.lock();
+                write_error = std::current_exception();
+                done = true;
+                write_queue.clear();
+                break;
+            }
+            lock.lock();
+        }
+    });
+
+    DataStream batch;
+    auto flush_batch = [&] {
+        std::unique_lock<std::mutex> lock(write_mutex);
+        write_cv.wait(lock, [&] { return write_queue.size() < SNAPSHOT_MAX_QUEUED_BATCHES || done; });
+        if (write_error) std::rethrow_exception(write_error);
+        write_queue.push_back(std::move(batch));
+        lock.unlock();
+        write_cv.notify_one();
+        batch.clear();
+    };
+    auto stop_writer = [&] {
+        {
+            std::lock_guard<std::mutex> lock(write_mutex);
+            done = true;
+        }
+        write_cv.notify_one();
+        writer.join();
+    };
+
     // To reduce space the serialization format of the snapshot avoids
     // duplication of tx hashes. The code takes advantage of the guarantee by
     // leveldb that keys are lexicographically sorted.
     // In the coins vector we collect all coins that belong to a certain tx hash
     // (key.hash) and when we have them all (key.hash != last_hash) we write
-    // them to file using the below lambda function.
+    // them to the current batch using the below lambda function.
     // See also https://github.com/bitcoin/bitcoin/issues/25675
-    auto write_coins_to_file = [&](AutoFile& afile, const Txid& last_hash, const std::vector<std::pair<uint32_t, Coin>>& coins, size_t& written_coins_count) {
-        afile << last_hash;
-        WriteCompactSize(afile, coins.size());
+    auto write_coins_to_batch = [&](DataStream& batch, const Txid& last_hash, const std::vector<std::pair<uint32_t, Coin>>& coins, size_t& written_coins_count) {
+        batch << last_hash;
+        WriteCompactSize(batch, coins.size());
         for (const auto& [n, coin] : coins) {
-            WriteCompactSize(afile, n);
-            afile << coin;
+            WriteCompactSize(batch, n);
+            batch << coin;
             ++written_coins_count;
         }
+        if (batch.size() >= SNAPSHOT_BATCH_SIZE) flush_batch();
     };
 
-    pcursor->GetKey(key);
-    last_hash = key.hash;
-    while (pcursor->Valid()) {
-        if (iter % 5000 == 0) interruption_point();
-        ++iter;
-        if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
-            if (key.hash != last_hash) {
-                write_coins_to_file(afile, last_hash, coins, written_coins_count);
-                last_hash = key.hash;
-                coins.clear();
+    try {
+        pcursor->GetKey(key);
+        last_hash = key.hash;
+        while (pcursor->Valid()) {
+            if (iter % 5000 == 0) interruption_point();
+            ++iter;
+            if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
+                if (key.hash != last_hash) {
+                    write_coins_to_batch(batch, last_hash, coins, written_coins_count);
+                    last_hash = key.hash;
+                    coins.clear();
+                }
+                coins.emplace_back(key.n, coin);
             }
-            coins.emplace_back(key.n, coin);
+            pcursor->Next();
         }
-        pcursor->Next();
-    }
 
-    if (!coins.empty()) {
-        write_coins_to_file(afile, last_hash, coins, written_coins_count);
+        if (!coins.empty()) {
+            write_coins_to_batch(batch, last_hash, coins, written_coins_count);
+        }
+        if (!batch.empty()) flush_batch();
+    } catch (...) {
+        stop_writer();
+        throw;
     }
 
+    stop_writer();
+    if (write_error) std::rethrow_exception(write_error);
+
     CHECK_NONFATAL(written_coins_count == maybe_stats->coins_count);
 
     afile.fclose();
@@ -3385,6 +3618,7 @@ void RegisterBlockchainRPCCommands(CRPCTable& t)
         {"blockchain", &getblockchaininfo},
         {"blockchain", &getchaintxstats},
         {"blockchain", &getblockstats},
+        {"blockchain", &getblockconnectionstats},
         {"blockchain", &getbestblockhash},
         {"blockchain", &getblockcount},
         {"blockchain", &getblock},
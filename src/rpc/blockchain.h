@@ -18,6 +18,7 @@
 
 class CBlock;
 class CBlockIndex;
+class CBlockUndo;
 class Chainstate;
 class UniValue;
 namespace node {
@@ -27,6 +28,55 @@ struct NodeContext;
 
 static constexpr int NUM_GETBLOCKSTATS_PERCENTILES = 5;
 
+/**
+ * Per-block statistics served by getblockstats and persisted by the optional
+ * block stats index. Medians, percentiles and min/max values must be
+ * precomputed (they are not derivable from aggregates); averages and the
+ * utxo_increase counts are derived at query time. Min values are reported as
+ * 0 rather than a sentinel when the block has no non-coinbase transactions,
+ * matching the RPC output.
+ */
+struct BlockStats {
+    int64_t txs{0};     //!< number of transactions (including coinbase)
+    int64_t inputs{0};  //!< number of inputs (excluding coinbase)
+    int64_t outputs{0}; //!< number of outputs
+    CAmount total_out{0};
+    CAmount totalfee{0};
+    CAmount minfee{0};
+    CAmount maxfee{0};
+    CAmount medianfee{0};
+    CAmount minfeerate{0};
+    CAmount maxfeerate{0};
+    CAmount feerate_percentiles[NUM_GETBLOCKSTATS_PERCENTILES]{};
+    int64_t mintxsize{0};
+    int64_t maxtxsize{0};
+    int64_t mediantxsize{0};
+    int64_t total_size{0};
+    int64_t total_weight{0};
+    int64_t swtxs{0};
+    int64_t swtotal_size{0};
+    int64_t swtotal_weight{0};
+    int64_t utxo_size_inc{0};
+    int64_t utxo_increase_actual{0};
+    int64_t utxo_size_inc_actual{0};
+
+    SERIALIZE_METHODS(BlockStats, obj)
+    {
+        READWRITE(obj.txs, obj.inputs, obj.outputs, obj.total_out, obj.totalfee,
+                  obj.minfee, obj.maxfee, obj.medianfee, obj.minfeerate, obj.maxfeerate,
+                  obj.mintxsize, obj.maxtxsize, obj.mediantxsize, obj.total_size, obj.total_weight,
+                  obj.swtxs, obj.swtotal_size, obj.swtotal_weight,
+                  obj.utxo_size_inc, obj.utxo_increase_actual, obj.utxo_size_inc_actual);
+        for (auto& percentile : obj.feerate_percentiles) READWRITE(percentile);
+    }
+};
+
+/** Compute the full per-block statistics from a block and its undo data. */
+BlockStats ComputeBlockStats(const CBlock& block, const CBlockUndo& block_undo, const CBlockIndex& pindex);
+
+/** Default for -rpccachesize, in MiB of raw block data backing cached getblock responses */
+static constexpr int64_t DEFAULT_RPC_CACHE_SIZE_MB{16};
+
 /**
  * Get the difficulty of the net wrt to the given block index.
  *
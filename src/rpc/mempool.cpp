@@ -75,19 +75,17 @@ static RPCHelpMan sendrawtransaction()
         {
             const CAmount max_burn_amount = request.params[2].isNull() ? 0 : AmountFromValue(request.params[2]);
 
-            CMutableTransaction mtx;
-            if (!DecodeHexTx(mtx, request.params[0].get_str())) {
+            const CTransactionRef tx{DecodeHexTxCached(request.params[0].get_str())};
+            if (!tx) {
                 throw JSONRPCError(RPC_DESERIALIZATION_ERROR, "TX decode failed. Make sure the tx has at least one input.");
             }
 
-            for (const auto& out : mtx.vout) {
+            for (const auto& out : tx->vout) {
                 if((out.scriptPubKey.IsUnspendable() || !out.scriptPubKey.HasValidOps()) && out.nValue > max_burn_amount) {
                     throw JSONRPCTransactionError(TransactionError::MAX_BURN_EXCEEDED);
                 }
             }
 
-            CTransactionRef tx(MakeTransactionRef(std::move(mtx)));
-
             const CFeeRate max_raw_tx_fee_rate{ParseFeeRate(self.Arg<UniValue>("maxfeerate"))};
 
             int64_t virtual_size = GetVirtualTransactionSize(*tx);
@@ -174,12 +172,12 @@ static RPCHelpMan testmempoolaccept()
             std::vector<CTransactionRef> txns;
             txns.reserve(raw_transactions.size());
             for (const auto& rawtx : raw_transactions.getValues()) {
-                CMutableTransaction mtx;
-                if (!DecodeHexTx(mtx, rawtx.get_str())) {
+                CTransactionRef tx{DecodeHexTxCached(rawtx.get_str())};
+                if (!tx) {
                     throw JSONRPCError(RPC_DESERIALIZATION_ERROR,
                                        "TX decode failed: " + rawtx.get_str() + " Make sure the tx has at least one input.");
                 }
-                txns.emplace_back(MakeTransactionRef(std::move(mtx)));
+                txns.emplace_back(std::move(tx));
             }
 
             NodeContext& node = EnsureAnyNodeContext(request.context);
@@ -359,6 +357,17 @@ UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempoo
         }
         return o;
     } else {
+        if (!include_mempool_sequence) {
+            // The plain txid list is served from the mempool's cached
+            // snapshot: repeated polling only takes pool.cs when the
+            // transaction set actually changed, so monitoring traffic
+            // doesn't block relay.
+            UniValue a(UniValue::VARR);
+            for (const Txid& txid : *pool.GetTxidSnapshot()) {
+                a.push_back(txid.ToString());
+            }
+            return a;
+        }
         UniValue a(UniValue::VARR);
         uint64_t mempool_sequence;
         {
@@ -368,14 +377,10 @@ UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempoo
             }
             mempool_sequence = pool.GetSequence();
         }
-        if (!include_mempool_sequence) {
-            return a;
-        } else {
-            UniValue o(UniValue::VOBJ);
-            o.pushKV("txids", std::move(a));
-            o.pushKV("mempool_sequence", mempool_sequence);
-            return o;
-        }
+        UniValue o(UniValue::VOBJ);
+        o.pushKV("txids", std::move(a));
+        o.pushKV("mempool_sequence", mempool_sequence);
+        return o;
     }
 }
 
@@ -8,6 +8,7 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <chainparamsbase.h>
+#include <common/args.h>
 #include <common/system.h>
 #include <consensus/amount.h>
 #include <consensus/consensus.h>
@@ -17,11 +18,13 @@
 #include <core_io.h>
 #include <deploymentinfo.h>
 #include <deploymentstatus.h>
+#include <httpserver.h>
 #include <interfaces/mining.h>
 #include <key_io.h>
 #include <net.h>
 #include <node/context.h>
 #include <node/miner.h>
+#include <node/pow_search.h>
 #include <node/warnings.h>
 #include <policy/ephemeral_policy.h>
 #include <pow.h>
@@ -43,6 +46,7 @@
 #include <validation.h>
 #include <validationinterface.h>
 
+#include <atomic>
 #include <memory>
 #include <stdint.h>
 
@@ -136,27 +140,22 @@ static bool GenerateBlock(ChainstateManager& chainman, CBlock&& block, uint64_t&
     block_out.reset();
     block.hashMerkleRoot = BlockMerkleRoot(block);
 
-    // Initialize TENS hashing context with seed from block header
-    uint256 seed = block.GetHash();
-    TensHashContext* ctx = tens_hash_init(seed.begin());
-    if (!ctx) {
-        return false;
-    }
-
-    while (max_tries > 0 && block.nNonce < std::numeric_limits<uint32_t>::max() && 
-           !CheckProofOfWork(block.GetPoWHashPrecomputed(ctx), block.nBits, chainman.GetConsensus()) && 
-           !chainman.m_interrupt) {
-        ++block.nNonce;
-        --max_tries;
-    }
-
-    tens_hash_free(ctx);
-    if (max_tries == 0 || chainman.m_interrupt) {
-        return false;
-    }
-    if (block.nNonce == std::numeric_limits<uint32_t>::max()) {
+    // Search the nonce space with the in-daemon multi-threaded engine; all
+    // workers share this header's cached TensHash context.
+    uint64_t tries_used{0};
+    std::optional<uint32_t> nonce = node::FindProofOfWorkNonce(
+        block, block.nNonce, max_tries, /*num_threads=*/0, chainman.GetConsensus(),
+        &chainman.m_interrupt, &tries_used);
+    max_tries -= std::min(max_tries, tries_used);
+    if (!nonce) {
+        if (max_tries == 0 || chainman.m_interrupt) {
+            return false;
+        }
+        // Nonce space exhausted without a solution; caller retries with a new template.
+        block.nNonce = std::numeric_limits<uint32_t>::max();
         return true;
     }
+    block.nNonce = *nonce;
 
     block_out = std::make_shared<const CBlock>(std::move(block));
 
@@ -710,6 +709,42 @@ static RPCHelpMan getblocktemplate()
     NodeContext& node = EnsureAnyNodeContext(request.context);
     ChainstateManager& chainman = EnsureChainman(node);
     Mining& miner = EnsureMining(node);
+
+    // Proposals are handled before taking cs_main: TestProposedBlock() holds
+    // the lock only briefly to pin the tip, so continuous proposal traffic
+    // cannot stall block connection.
+    if (!request.params[0].isNull()) {
+        const UniValue& modeval = request.params[0].get_obj().find_value("mode");
+        if (modeval.isStr() && modeval.get_str() == "proposal") {
+            const UniValue& dataval = request.params[0].get_obj().find_value("data");
+            if (!dataval.isStr())
+                throw JSONRPCError(RPC_TYPE_ERROR, "Missing data String key for proposal");
+
+            CBlock block;
+            if (!DecodeHexBlk(block, dataval.get_str()))
+                throw JSONRPCError(RPC_DESERIALIZATION_ERROR, "Block decode failed");
+
+            {
+                LOCK(cs_main);
+                const CBlockIndex* pindex = chainman.m_blockman.LookupBlockIndex(block.GetHash());
+                if (pindex) {
+                    if (pindex->IsValid(BLOCK_VALID_SCRIPTS))
+                        return "duplicate";
+                    if (pindex->nStatus & BLOCK_FAILED_MASK)
+                        return "duplicate-invalid";
+                    return "duplicate-inconclusive";
+                }
+            }
+
+            BlockValidationState state;
+            // TestProposedBlock only supports blocks built on the current Tip
+            if (TestProposedBlock(state, chainman, block) == ProposalCheckResult::STALE_PREVBLK) {
+                return "inconclusive-not-best-prevblk";
+            }
+            return BIP22ValidationResult(state);
+        }
+    }
+
     LOCK(cs_main);
     uint256 tip{CHECK_NONFATAL(miner.getTip()).value().hash};
 
@@ -730,35 +765,6 @@ static RPCHelpMan getblocktemplate()
             throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid mode");
         lpval = oparam.find_value("longpollid");
 
-        if (strMode == "proposal")
-        {
-            const UniValue& dataval = oparam.find_value("data");
-            if (!dataval.isStr())
-                throw JSONRPCError(RPC_TYPE_ERROR, "Missing data String key for proposal");
-
-            CBlock block;
-            if (!DecodeHexBlk(block, dataval.get_str()))
-                throw JSONRPCError(RPC_DESERIALIZATION_ERROR, "Block decode failed");
-
-            uint256 hash = block.GetHash();
-            const CBlockIndex* pindex = chainman.m_blockman.LookupBlockIndex(hash);
-            if (pindex) {
-                if (pindex->IsValid(BLOCK_VALID_SCRIPTS))
-                    return "duplicate";
-                if (pindex->nStatus & BLOCK_FAILED_MASK)
-                    return "duplicate-invalid";
-                return "duplicate-inconclusive";
-            }
-
-            // TestBlockValidity only supports blocks built on the current Tip
-            if (block.hashPrevBlock != tip) {
-                return "inconclusive-not-best-prevblk";
-            }
-            BlockValidationState state;
-            TestBlockValidity(state, chainman.GetParams(), chainman.ActiveChainstate(), block, chainman.m_blockman.LookupBlockIndex(block.hashPrevBlock), /*fCheckPOW=*/false, /*fCheckMerkleRoot=*/true);
-            return BIP22ValidationResult(state);
-        }
-
         const UniValue& aClientRules = oparam.find_value("rules");
         if (aClientRules.isArray()) {
             for (unsigned int i = 0; i < aClientRules.size(); ++i) {
@@ -806,18 +812,30 @@ static RPCHelpMan getblocktemplate()
             nTransactionsUpdatedLastLP = nTransactionsUpdatedLast;
         }
 
+        // Each long poll parks an HTTP worker thread for up to a minute. Cap
+        // how many may do so at once; waiters over the cap get one short
+        // bounded wait and then the current template, so a crowd of
+        // long-polling pool connections cannot occupy every worker thread
+        // and starve other RPCs. Responding early is fine per BIP 22: the
+        // server may reply to a long poll at any time.
+        static std::atomic<int> num_longpoll_waiters{0};
+        const int max_longpoll_waiters{std::max<int>(1, gArgs.GetIntArg("-rpcthreads", DEFAULT_HTTP_THREADS) / 2)};
+
         // Release lock while waiting
         LEAVE_CRITICAL_SECTION(cs_main);
         {
-            MillisecondsDouble checktxtime{std::chrono::minutes(1)};
+            const bool over_cap{num_longpoll_waiters.fetch_add(1) >= max_longpoll_waiters};
+            MillisecondsDouble checktxtime{over_cap ? std::chrono::seconds(1) : std::chrono::minutes(1)};
             while (tip == hashWatchedChain && IsRPCRunning()) {
                 tip = miner.waitTipChanged(hashWatchedChain, checktxtime).hash;
                 // Timeout: Check transactions for update
                 // without holding the mempool lock to avoid deadlocks
                 if (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLastLP)
                     break;
+                if (over_cap) break;
                 checktxtime = std::chrono::seconds(10);
             }
+            num_longpoll_waiters.fetch_sub(1);
         }
         ENTER_CRITICAL_SECTION(cs_main);
 
@@ -19,6 +19,7 @@
 #include <node/warnings.h>
 #include <policy/settings.h>
 #include <protocol.h>
+#include <random.h>
 #include <rpc/blockchain.h>
 #include <rpc/protocol.h>
 #include <rpc/server_util.h>
@@ -31,6 +32,7 @@
 #include <util/translation.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <optional>
 
 #include <univalue.h>
@@ -147,6 +149,8 @@ static RPCHelpMan getpeerinfo()
                     {RPCResult::Type::NUM, "timeoffset", "The time offset in seconds"},
                     {RPCResult::Type::NUM, "pingtime", /*optional=*/true, "The last ping time in milliseconds (ms), if any"},
                     {RPCResult::Type::NUM, "minping", /*optional=*/true, "The minimum observed ping time in milliseconds (ms), if any"},
+                    {RPCResult::Type::NUM, "avgping", /*optional=*/true, "The smoothed (exponentially weighted) ping time estimate used for adaptive block-download timeouts, if any"},
+                    {RPCResult::Type::NUM, "pingjitter", /*optional=*/true, "The mean deviation of the ping time around avgping, if any"},
                     {RPCResult::Type::NUM, "pingwait", /*optional=*/true, "The duration in milliseconds (ms) of an outstanding ping (if non-zero)"},
                     {RPCResult::Type::NUM, "version", "The peer version, such as 70001"},
                     {RPCResult::Type::STR, "subver", "The string version"},
@@ -169,6 +173,7 @@ static RPCHelpMan getpeerinfo()
                         {RPCResult::Type::STR, "permission_type", Join(NET_PERMISSIONS_DOC, ",\n") + ".\n"},
                     }},
                     {RPCResult::Type::NUM, "minfeefilter", "The minimum fee rate for transactions this peer accepts"},
+                    {RPCResult::Type::NUM, "tx_announcements_queued", "The number of transaction announcements queued for this peer, waiting for the next trickle"},
                     {RPCResult::Type::OBJ_DYN, "bytessent_per_msg", "",
                     {
                         {RPCResult::Type::NUM, "msg", "The total bytes sent aggregated by message type\n"
@@ -247,6 +252,10 @@ static RPCHelpMan getpeerinfo()
         if (stats.m_min_ping_time < std::chrono::microseconds::max()) {
             obj.pushKV("minping", Ticks<SecondsDouble>(stats.m_min_ping_time));
         }
+        if (stats.m_smoothed_ping_time > 0us) {
+            obj.pushKV("avgping", Ticks<SecondsDouble>(stats.m_smoothed_ping_time));
+            obj.pushKV("pingjitter", Ticks<SecondsDouble>(stats.m_ping_time_jitter));
+        }
         if (statestats.m_ping_wait > 0s) {
             obj.pushKV("pingwait", Ticks<SecondsDouble>(statestats.m_ping_wait));
         }
@@ -276,6 +285,7 @@ static RPCHelpMan getpeerinfo()
         }
         obj.pushKV("permissions", std::move(permissions));
         obj.pushKV("minfeefilter", ValueFromAmount(statestats.m_fee_filter_received));
+        obj.pushKV("tx_announcements_queued", statestats.m_tx_announcements_queued);
 
         UniValue sendPerMsgType(UniValue::VOBJ);
         for (const auto& i : stats.mapSendBytesPerMsgType) {
@@ -939,8 +949,11 @@ static RPCHelpMan getnodeaddresses()
         throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Network not recognized: %s", request.params[1].get_str()));
     }
 
-    // returns a shuffled list of CAddress
-    const std::vector<CAddress> vAddr{connman.GetAddresses(count, /*max_pct=*/0, network)};
+    // Addresses come from a periodically refreshed snapshot, so frequent
+    // monitoring calls do not contend with address relay for addrman's lock.
+    std::vector<CAddress> vAddr{connman.GetAddressesSnapshot(network)};
+    std::shuffle(vAddr.begin(), vAddr.end(), FastRandomContext{});
+    if (count > 0 && vAddr.size() > static_cast<size_t>(count)) vAddr.resize(count);
     UniValue ret(UniValue::VARR);
 
     for (const CAddress& addr : vAddr) {
@@ -14,6 +14,7 @@
 #include <interfaces/echo.h>
 #include <interfaces/init.h>
 #include <interfaces/ipc.h>
+#include <crypto/kernelstats.h>
 #include <kernel/cs_main.h>
 #include <logging.h>
 #include <node/context.h>
@@ -21,7 +22,9 @@
 #include <rpc/server_util.h>
 #include <rpc/util.h>
 #include <scheduler.h>
+#include <sync.h>
 #include <univalue.h>
+#include <util/allocprofile.h>
 #include <util/any.h>
 #include <util/check.h>
 #include <util/time.h>
@@ -137,6 +140,51 @@ static std::string RPCMallocInfo()
 }
 #endif
 
+static RPCHelpMan getlockstats()
+{
+    return RPCHelpMan{"getlockstats",
+                "Returns per-call-site lock statistics: acquisitions, contended acquisitions\n"
+                "and total time spent waiting for the lock, sorted by wait time. Counters are\n"
+                "cumulative since startup.\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::ARR, "", "",
+                    {
+                        {RPCResult::Type::OBJ, "", "",
+                        {
+                            {RPCResult::Type::STR, "name", "The lock expression at the call site"},
+                            {RPCResult::Type::STR, "site", "Source location of the call site (file:line)"},
+                            {RPCResult::Type::NUM, "acquisitions", "Number of times the lock was taken here"},
+                            {RPCResult::Type::NUM, "contended", "Number of acquisitions that had to wait"},
+                            {RPCResult::Type::NUM, "wait_usec", "Total microseconds spent waiting here"},
+                        }},
+                    }
+                },
+                RPCExamples{
+                    HelpExampleCli("getlockstats", "")
+            + HelpExampleRpc("getlockstats", "")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    std::vector<LockSiteStats> stats{GetLockStats()};
+    std::sort(stats.begin(), stats.end(), [](const LockSiteStats& a, const LockSiteStats& b) {
+        return a.wait_usec > b.wait_usec;
+    });
+    UniValue ret(UniValue::VARR);
+    for (const LockSiteStats& site : stats) {
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("name", site.name);
+        obj.pushKV("site", strprintf("%s:%d", site.file, site.line));
+        obj.pushKV("acquisitions", site.acquisitions);
+        obj.pushKV("contended", site.contended);
+        obj.pushKV("wait_usec", site.wait_usec);
+        ret.push_back(std::move(obj));
+    }
+    return ret;
+},
+    };
+}
+
 static RPCHelpMan getmemoryinfo()
 {
     /* Please, avoid using the word "pool" here in the RPC interface or help,
@@ -162,6 +210,14 @@ static RPCHelpMan getmemoryinfo()
                                 {RPCResult::Type::NUM, "chunks_used", "Number allocated chunks"},
                                 {RPCResult::Type::NUM, "chunks_free", "Number unused chunks"},
                             }},
+                            {RPCResult::Type::OBJ_DYN, "allocations", "Cumulative counters for instrumented hot-path buffer allocations, by subsystem",
+                            {
+                                {RPCResult::Type::OBJ, "name", "",
+                                {
+                                    {RPCResult::Type::NUM, "count", "Number of allocations since startup"},
+                                    {RPCResult::Type::NUM, "bytes", "Total bytes allocated since startup"},
+                                }},
+                            }},
                         }
                     },
                     RPCResult{"mode \"mallocinfo\"",
@@ -178,6 +234,14 @@ static RPCHelpMan getmemoryinfo()
     if (mode == "stats") {
         UniValue obj(UniValue::VOBJ);
         obj.pushKV("locked", RPCLockedMemoryInfo());
+        UniValue allocations(UniValue::VOBJ);
+        for (size_t i = 0; i < alloc_profile::TAG_NAMES.size(); ++i) {
+            UniValue tag(UniValue::VOBJ);
+            tag.pushKV("count", alloc_profile::g_counters[i].count.load(std::memory_order_relaxed));
+            tag.pushKV("bytes", alloc_profile::g_counters[i].bytes.load(std::memory_order_relaxed));
+            allocations.pushKV(std::string{alloc_profile::TAG_NAMES[i]}, std::move(tag));
+        }
+        obj.pushKV("allocations", std::move(allocations));
         return obj;
     } else if (mode == "mallocinfo") {
 #ifdef HAVE_MALLOC_INFO
@@ -192,6 +256,40 @@ static RPCHelpMan getmemoryinfo()
     };
 }
 
+static RPCHelpMan getcryptostats()
+{
+    return RPCHelpMan{"getcryptostats",
+                "Returns cumulative call and input-byte counters for the crypto kernels (SHA256, ChaCha20, SipHash, TensHash).\n"
+                "Counters accumulate in thread-local batches, so totals may lag the most recent few thousand operations per thread.\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ_DYN, "", "",
+                    {
+                        {RPCResult::Type::OBJ, "name", "Counters for one kernel",
+                        {
+                            {RPCResult::Type::NUM, "calls", "Number of calls into the kernel since startup"},
+                            {RPCResult::Type::NUM, "bytes", "Total input bytes processed since startup"},
+                        }},
+                    }
+                },
+                RPCExamples{
+                    HelpExampleCli("getcryptostats", "")
+            + HelpExampleRpc("getcryptostats", "")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    UniValue obj(UniValue::VOBJ);
+    for (size_t i = 0; i < kernel_stats::KERNEL_NAMES.size(); ++i) {
+        UniValue kernel(UniValue::VOBJ);
+        kernel.pushKV("calls", kernel_stats::g_counters[i].calls.load(std::memory_order_relaxed));
+        kernel.pushKV("bytes", kernel_stats::g_counters[i].bytes.load(std::memory_order_relaxed));
+        obj.pushKV(std::string{kernel_stats::KERNEL_NAMES[i]}, std::move(kernel));
+    }
+    return obj;
+},
+    };
+}
+
 static void EnableOrDisableLogCategories(UniValue cats, bool enable) {
     cats = cats.get_array();
     for (unsigned int i = 0; i < cats.size(); ++i) {
@@ -403,6 +501,8 @@ static RPCHelpMan getindexinfo()
 void RegisterNodeRPCCommands(CRPCTable& t)
 {
     static const CRPCCommand commands[]{
+        {"control", &getcryptostats},
+        {"control", &getlockstats},
         {"control", &getmemoryinfo},
         {"control", &logging},
         {"util", &getindexinfo},
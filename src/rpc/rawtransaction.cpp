@@ -464,17 +464,16 @@ static RPCHelpMan decoderawtransaction()
                 },
         [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
 {
-    CMutableTransaction mtx;
-
     bool try_witness = request.params[1].isNull() ? true : request.params[1].get_bool();
     bool try_no_witness = request.params[1].isNull() ? true : !request.params[1].get_bool();
 
-    if (!DecodeHexTx(mtx, request.params[0].get_str(), try_no_witness, try_witness)) {
+    const CTransactionRef tx{DecodeHexTxCached(request.params[0].get_str(), try_no_witness, try_witness)};
+    if (!tx) {
         throw JSONRPCError(RPC_DESERIALIZATION_ERROR, "TX decode failed");
     }
 
     UniValue result(UniValue::VOBJ);
-    TxToUniv(CTransaction(std::move(mtx)), /*block_hash=*/uint256(), /*entry=*/result, /*include_hex=*/false);
+    TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/result, /*include_hex=*/false);
 
     return result;
 },
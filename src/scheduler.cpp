@@ -4,6 +4,7 @@
 
 #include <scheduler.h>
 
+#include <logging.h>
 #include <sync.h>
 #include <util/time.h>
 
@@ -50,8 +51,27 @@ void CScheduler::serviceQueue()
             if (shouldStop() || taskQueue.empty())
                 continue;
 
-            Function f = taskQueue.begin()->second;
-            taskQueue.erase(taskQueue.begin());
+            // Among the tasks that are due, run the highest-priority one
+            // first, so latency-sensitive work is not stuck behind heavyweight
+            // maintenance that came due earlier in the same wakeup.
+            const auto now{std::chrono::steady_clock::now()};
+            auto chosen = taskQueue.begin();
+            for (auto it = taskQueue.begin(); it != taskQueue.end() && it->first <= now; ++it) {
+                if (it->second.priority < chosen->second.priority) chosen = it;
+            }
+
+            const auto lag{std::chrono::duration_cast<std::chrono::microseconds>(now - chosen->first)};
+            if (lag > m_lag_info.max_lag) m_lag_info.max_lag = lag;
+            if (lag > 0us) m_lag_info.last_lag = lag; else m_lag_info.last_lag = 0us;
+            ++m_lag_info.tasks_run;
+            if (lag >= LAG_WARN_THRESHOLD && now - m_last_lag_warning >= LAG_WARN_INTERVAL) {
+                m_last_lag_warning = now;
+                LogWarning("Scheduler is running %d ms behind schedule; %d tasks queued\n",
+                           count_milliseconds(std::chrono::duration_cast<std::chrono::milliseconds>(lag)), taskQueue.size());
+            }
+
+            Function f = std::move(chosen->second.func);
+            taskQueue.erase(chosen);
 
             {
                 // Unlock before calling f, so it can reschedule itself or another task
@@ -68,11 +88,11 @@ void CScheduler::serviceQueue()
     newTaskScheduled.notify_one();
 }
 
-void CScheduler::schedule(CScheduler::Function f, std::chrono::steady_clock::time_point t)
+void CScheduler::schedule(CScheduler::Function f, std::chrono::steady_clock::time_point t, Priority priority)
 {
     {
         LOCK(newTaskMutex);
-        taskQueue.insert(std::make_pair(t, f));
+        taskQueue.emplace(t, Task{std::move(f), priority});
     }
     newTaskScheduled.notify_one();
 }
@@ -85,7 +105,7 @@ void CScheduler::MockForward(std::chrono::seconds delta_seconds)
         LOCK(newTaskMutex);
 
         // use temp_queue to maintain updated schedule
-        std::multimap<std::chrono::steady_clock::time_point, Function> temp_queue;
+        std::multimap<std::chrono::steady_clock::time_point, Task> temp_queue;
 
         for (const auto& element : taskQueue) {
             temp_queue.emplace_hint(temp_queue.cend(), element.first - delta_seconds, element.second);
@@ -99,15 +119,15 @@ void CScheduler::MockForward(std::chrono::seconds delta_seconds)
     newTaskScheduled.notify_one();
 }
 
-static void Repeat(CScheduler& s, CScheduler::Function f, std::chrono::milliseconds delta)
+static void Repeat(CScheduler& s, CScheduler::Function f, std::chrono::milliseconds delta, CScheduler::Priority priority)
 {
     f();
-    s.scheduleFromNow([=, &s] { Repeat(s, f, delta); }, delta);
+    s.scheduleFromNow([=, &s] { Repeat(s, f, delta, priority); }, delta, priority);
 }
 
-void CScheduler::scheduleEvery(CScheduler::Function f, std::chrono::milliseconds delta)
+void CScheduler::scheduleEvery(CScheduler::Function f, std::chrono::milliseconds delta, Priority priority)
 {
-    scheduleFromNow([this, f, delta] { Repeat(*this, f, delta); }, delta);
+    scheduleFromNow([this, f, delta, priority] { Repeat(*this, f, delta, priority); }, delta, priority);
 }
 
 size_t CScheduler::getQueueInfo(std::chrono::steady_clock::time_point& first,
@@ -128,6 +148,12 @@ bool CScheduler::AreThreadsServicingQueue() const
     return nThreadsServicingQueue;
 }
 
+CScheduler::LagInfo CScheduler::GetLagInfo() const
+{
+    LOCK(newTaskMutex);
+    return m_lag_info;
+}
+
 
 void SerialTaskRunner::MaybeScheduleProcessQueue()
 {
@@ -13,6 +13,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
@@ -46,13 +47,24 @@ public:
 
     typedef std::function<void()> Function;
 
+    /** Relative importance of a task. The queue stays ordered by time; the
+     * priority only decides which task runs first when several are due at
+     * once, so latency-sensitive work is not stuck behind heavyweight
+     * maintenance that happened to come due earlier in the same service-thread
+     * wakeup. */
+    enum class Priority : uint8_t {
+        CRITICAL,   //!< Latency-sensitive work; runs before other due tasks
+        NORMAL,
+        BACKGROUND, //!< Heavyweight periodic maintenance; runs only when no other task is due
+    };
+
     /** Call func at/after time t */
-    void schedule(Function f, std::chrono::steady_clock::time_point t) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+    void schedule(Function f, std::chrono::steady_clock::time_point t, Priority priority = Priority::NORMAL) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
     /** Call f once after the delta has passed */
-    void scheduleFromNow(Function f, std::chrono::milliseconds delta) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
+    void scheduleFromNow(Function f, std::chrono::milliseconds delta, Priority priority = Priority::NORMAL) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
     {
-        schedule(std::move(f), std::chrono::steady_clock::now() + delta);
+        schedule(std::move(f), std::chrono::steady_clock::now() + delta, priority);
     }
 
     /**
@@ -61,7 +73,7 @@ public:
      * The timing is not exact: Every time f is finished, it is rescheduled to run again after delta. If you need more
      * accurate scheduling, don't use this method.
      */
-    void scheduleEvery(Function f, std::chrono::milliseconds delta) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+    void scheduleEvery(Function f, std::chrono::milliseconds delta, Priority priority = Priority::NORMAL) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
     /**
      * Mock the scheduler to fast forward in time.
@@ -101,10 +113,33 @@ public:
     /** Returns true if there are threads actively running in serviceQueue() */
     bool AreThreadsServicingQueue() const EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
+    /** How far behind schedule the service thread is running. */
+    struct LagInfo {
+        //! Number of tasks executed so far
+        uint64_t tasks_run{0};
+        //! Scheduled-to-started delay of the most recently started task
+        std::chrono::microseconds last_lag{0};
+        //! Largest scheduled-to-started delay observed so far
+        std::chrono::microseconds max_lag{0};
+    };
+    /** Return queued-vs-ran lag metrics, for monitoring a scheduler that has
+     * fallen behind. */
+    LagInfo GetLagInfo() const EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+
 private:
     mutable Mutex newTaskMutex;
     std::condition_variable newTaskScheduled;
-    std::multimap<std::chrono::steady_clock::time_point, Function> taskQueue GUARDED_BY(newTaskMutex);
+    struct Task {
+        Function func;
+        Priority priority;
+    };
+    std::multimap<std::chrono::steady_clock::time_point, Task> taskQueue GUARDED_BY(newTaskMutex);
+    LagInfo m_lag_info GUARDED_BY(newTaskMutex);
+    //! Lag beyond which a warning is logged
+    static constexpr std::chrono::seconds LAG_WARN_THRESHOLD{5};
+    //! Minimum spacing between lag warnings
+    static constexpr std::chrono::minutes LAG_WARN_INTERVAL{1};
+    std::chrono::steady_clock::time_point m_last_lag_warning GUARDED_BY(newTaskMutex){};
     int nThreadsServicingQueue GUARDED_BY(newTaskMutex){0};
     bool stopRequested GUARDED_BY(newTaskMutex){false};
     bool stopWhenEmpty GUARDED_BY(newTaskMutex){false};
@@ -12,6 +12,8 @@
 #include <script/script.h>
 #include <uint256.h>
 
+#include <type_traits>
+
 typedef std::vector<unsigned char> valtype;
 
 namespace {
@@ -403,7 +405,18 @@ static bool EvalChecksig(const valtype& sig, const valtype& pubkey, CScript::con
     assert(false);
 }
 
-bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript& script, unsigned int flags, const BaseSignatureChecker& checker, SigVersion sigversion, ScriptExecutionData& execdata, ScriptError* serror)
+/** Interpreter core, parameterized on the flags type.
+ *
+ * Called with Flags = unsigned int this is the ordinary runtime-checked
+ * interpreter. Called with Flags = std::integral_constant<unsigned int, N>
+ * every `flags & SCRIPT_VERIFY_*` test in the opcode loop folds to a
+ * compile-time constant, so the compiler strips the branches of rules that
+ * are disabled (or unconditionally enabled) in that flag bundle. EvalScript
+ * below dispatches the consensus flag combinations that occur on this chain
+ * to dedicated instantiations and everything else to the runtime version.
+ */
+template <typename Flags>
+static bool EvalScriptImpl(std::vector<std::vector<unsigned char> >& stack, const CScript& script, Flags flags, const BaseSignatureChecker& checker, SigVersion sigversion, ScriptExecutionData& execdata, ScriptError* serror)
 {
     static const CScriptNum bnZero(0);
     static const CScriptNum bnOne(1);
@@ -1233,6 +1246,26 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
     return set_success(serror);
 }
 
+//! The block script flags of the era before the later deployments activate
+//! (see GetBlockScriptFlags in validation.cpp).
+static constexpr unsigned int BLOCK_FLAGS_BASE{SCRIPT_VERIFY_P2SH | SCRIPT_VERIFY_WITNESS | SCRIPT_VERIFY_TAPROOT};
+//! The steady-state block script flags once all deployments are active.
+static constexpr unsigned int BLOCK_FLAGS_ALL{BLOCK_FLAGS_BASE | SCRIPT_VERIFY_DERSIG |
+                                              SCRIPT_VERIFY_CHECKLOCKTIMEVERIFY | SCRIPT_VERIFY_CHECKSEQUENCEVERIFY |
+                                              SCRIPT_VERIFY_NULLDUMMY};
+
+bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript& script, unsigned int flags, const BaseSignatureChecker& checker, SigVersion sigversion, ScriptExecutionData& execdata, ScriptError* serror)
+{
+    switch (flags) {
+    case BLOCK_FLAGS_ALL:
+        return EvalScriptImpl(stack, script, std::integral_constant<unsigned int, BLOCK_FLAGS_ALL>{}, checker, sigversion, execdata, serror);
+    case BLOCK_FLAGS_BASE:
+        return EvalScriptImpl(stack, script, std::integral_constant<unsigned int, BLOCK_FLAGS_BASE>{}, checker, sigversion, execdata, serror);
+    default:
+        return EvalScriptImpl(stack, script, flags, checker, sigversion, execdata, serror);
+    }
+}
+
 bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript& script, unsigned int flags, const BaseSignatureChecker& checker, SigVersion sigversion, ScriptError* serror)
 {
     ScriptExecutionData execdata;
@@ -1442,6 +1475,20 @@ void PrecomputedTransactionData::Init(const T& txTo, std::vector<CTxOut>&& spent
     if (uses_bip341_taproot && m_spent_outputs_ready) {
         m_spent_amounts_single_hash = GetSpentAmountsSHA256(m_spent_outputs);
         m_spent_scripts_single_hash = GetSpentScriptsSHA256(m_spent_outputs);
+        // Absorb the sighash prefix for SIGHASH_DEFAULT once; it is shared by
+        // all inputs of the transaction (input_type is not ANYONECANPAY and
+        // output_type is SIGHASH_ALL for this hash type).
+        HashWriter ss{HASHER_TAPSIGHASH};
+        ss << uint8_t{0}; // Epoch
+        ss << uint8_t{SIGHASH_DEFAULT};
+        ss << txTo.version;
+        ss << txTo.nLockTime;
+        ss << m_prevouts_single_hash;
+        ss << m_spent_amounts_single_hash;
+        ss << m_spent_scripts_single_hash;
+        ss << m_sequences_single_hash;
+        ss << m_outputs_single_hash;
+        m_tapdefault_midstate = ss;
         m_bip341_taproot_ready = true;
     }
 }
@@ -1499,29 +1546,36 @@ bool SignatureHashSchnorr(uint256& hash_out, ScriptExecutionData& execdata, cons
         return HandleMissingData(mdb);
     }
 
-    HashWriter ss{HASHER_TAPSIGHASH};
-
-    // Epoch
-    static constexpr uint8_t EPOCH = 0;
-    ss << EPOCH;
-
-    // Hash type
     const uint8_t output_type = (hash_type == SIGHASH_DEFAULT) ? SIGHASH_ALL : (hash_type & SIGHASH_OUTPUT_MASK); // Default (no sighash byte) is equivalent to SIGHASH_ALL
     const uint8_t input_type = hash_type & SIGHASH_INPUT_MASK;
     if (!(hash_type <= 0x03 || (hash_type >= 0x81 && hash_type <= 0x83))) return false;
-    ss << hash_type;
 
-    // Transaction level data
-    ss << tx_to.version;
-    ss << tx_to.nLockTime;
-    if (input_type != SIGHASH_ANYONECANPAY) {
-        ss << cache.m_prevouts_single_hash;
-        ss << cache.m_spent_amounts_single_hash;
-        ss << cache.m_spent_scripts_single_hash;
-        ss << cache.m_sequences_single_hash;
-    }
-    if (output_type == SIGHASH_ALL) {
-        ss << cache.m_outputs_single_hash;
+    HashWriter ss{HASHER_TAPSIGHASH};
+    if (hash_type == SIGHASH_DEFAULT) {
+        // The prefix up to and including the transaction level data is the
+        // same for every input and was absorbed once in
+        // PrecomputedTransactionData::Init.
+        ss = cache.m_tapdefault_midstate;
+    } else {
+        // Epoch
+        static constexpr uint8_t EPOCH = 0;
+        ss << EPOCH;
+
+        // Hash type
+        ss << hash_type;
+
+        // Transaction level data
+        ss << tx_to.version;
+        ss << tx_to.nLockTime;
+        if (input_type != SIGHASH_ANYONECANPAY) {
+            ss << cache.m_prevouts_single_hash;
+            ss << cache.m_spent_amounts_single_hash;
+            ss << cache.m_spent_scripts_single_hash;
+            ss << cache.m_sequences_single_hash;
+        }
+        if (output_type == SIGHASH_ALL) {
+            ss << cache.m_outputs_single_hash;
+        }
     }
 
     // Data about the input/prevout being spent
@@ -1895,8 +1949,34 @@ static bool VerifyWitnessProgram(const CScriptWitness& witness, int witversion,
             if (stack.size() != 2) {
                 return set_error(serror, SCRIPT_ERR_WITNESS_PROGRAM_MISMATCH); // 2 items in witness
             }
+            // The implied script below is verified directly instead of through
+            // the interpreter, replicating the exact order in which its opcodes
+            // would run: stack element size limits, the EQUALVERIFY key hash
+            // comparison, then OP_CHECKSIG's encoding rules and the signature
+            // check itself. This skips the interpreter's per-element heap
+            // allocations on the most common input type; exec_script is still
+            // materialized because it is the signature hash's scriptCode.
             exec_script << OP_DUP << OP_HASH160 << program << OP_EQUALVERIFY << OP_CHECKSIG;
-            return ExecuteWitnessScript(stack, exec_script, flags, SigVersion::WITNESS_V0, checker, execdata, serror);
+            const valtype& sig = stack[0];
+            const valtype& pubkey = stack[1];
+            if (sig.size() > MAX_SCRIPT_ELEMENT_SIZE || pubkey.size() > MAX_SCRIPT_ELEMENT_SIZE) {
+                return set_error(serror, SCRIPT_ERR_PUSH_SIZE);
+            }
+            unsigned char pubkey_hash[WITNESS_V0_KEYHASH_SIZE];
+            CHash160().Write(pubkey).Finalize(pubkey_hash);
+            if (memcmp(pubkey_hash, program.data(), WITNESS_V0_KEYHASH_SIZE) != 0) {
+                return set_error(serror, SCRIPT_ERR_EQUALVERIFY);
+            }
+            if (!CheckSignatureEncoding(sig, flags, serror) || !CheckPubKeyEncoding(pubkey, flags, SigVersion::WITNESS_V0, serror)) {
+                return false; // serror is set
+            }
+            if (!checker.CheckECDSASignature(sig, pubkey, exec_script, SigVersion::WITNESS_V0)) {
+                if ((flags & SCRIPT_VERIFY_NULLFAIL) && sig.size()) {
+                    return set_error(serror, SCRIPT_ERR_SIG_NULLFAIL);
+                }
+                return set_error(serror, SCRIPT_ERR_EVAL_FALSE);
+            }
+            return set_success(serror);
         } else {
             return set_error(serror, SCRIPT_ERR_WITNESS_PROGRAM_WRONG_LENGTH);
         }
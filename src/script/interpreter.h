@@ -161,6 +161,12 @@ struct PrecomputedTransactionData
     uint256 m_spent_scripts_single_hash;
     //! Whether the 5 fields above are initialized.
     bool m_bip341_taproot_ready = false;
+    //! SHA256 midstate of the BIP341 sighash prefix that is identical for
+    //! every input when hash_type is SIGHASH_DEFAULT (epoch, hash type and
+    //! all transaction-level data), so that per-signature hashing only has to
+    //! cover the short per-input suffix. Only valid if
+    //! m_bip341_taproot_ready is set.
+    HashWriter m_tapdefault_midstate{};
 
     // BIP143 precomputed data (double-SHA256).
     uint256 hashPrevouts, hashSequence, hashOutputs;
@@ -405,8 +405,11 @@ private:
  *  of vectors in cases where they normally contain a small number of small elements.
  * Tests in October 2015 showed use of this reduced dbcache memory usage by 23%
  *  and made an initial sync 13% faster.
+ * The direct capacity was later raised from 28 (sized for legacy P2PKH) to 36:
+ *  taproot and P2WSH scriptPubKeys are 34 bytes and would otherwise spill to
+ *  the heap for every modern output.
  */
-typedef prevector<28, unsigned char> CScriptBase;
+typedef prevector<36, unsigned char> CScriptBase;
 
 bool GetScriptOp(CScriptBase::const_iterator& pc, CScriptBase::const_iterator end, opcodetype& opcodeRet, std::vector<unsigned char>* pvchRet);
 
@@ -31,7 +31,13 @@ SignatureCache::SignatureCache(const size_t max_size_bytes)
     m_salted_hasher_schnorr.Write(nonce.begin(), 32);
     m_salted_hasher_schnorr.Write(PADDING_SCHNORR, 32);
 
-    const auto [num_elems, approx_size_bytes] = setValid.setup_bytes(max_size_bytes);
+    size_t num_elems{0};
+    size_t approx_size_bytes{0};
+    for (Shard& shard : m_shards) {
+        const auto [shard_elems, shard_bytes] = shard.set_valid.setup_bytes(max_size_bytes / NUM_SHARDS);
+        num_elems += shard_elems;
+        approx_size_bytes += shard_bytes;
+    }
     LogPrintf("Using %zu MiB out of %zu MiB requested for signature cache, able to store %zu elements\n",
               approx_size_bytes >> 20, max_size_bytes >> 20, num_elems);
 }
@@ -50,14 +56,18 @@ void SignatureCache::ComputeEntrySchnorr(uint256& entry, const uint256& hash, Sp
 
 bool SignatureCache::Get(const uint256& entry, const bool erase)
 {
-    std::shared_lock<std::shared_mutex> lock(cs_sigcache);
-    return setValid.contains(entry, erase);
+    Shard& shard = GetShard(entry);
+    // Start pulling the candidate buckets in while we wait for the lock.
+    shard.set_valid.prefetch(entry);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.set_valid.contains(entry, erase);
 }
 
 void SignatureCache::Set(const uint256& entry)
 {
-    std::unique_lock<std::shared_mutex> lock(cs_sigcache);
-    setValid.insert(entry);
+    Shard& shard = GetShard(entry);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.set_valid.insert(entry);
 }
 
 bool CachingTransactionSignatureChecker::VerifyECDSASignature(const std::vector<unsigned char>& vchSig, const CPubKey& pubkey, const uint256& sighash) const
@@ -14,6 +14,7 @@
 #include <uint256.h>
 #include <util/hasher.h>
 
+#include <array>
 #include <cstddef>
 #include <shared_mutex>
 #include <vector>
@@ -42,8 +43,20 @@ private:
     CSHA256 m_salted_hasher_ecdsa;
     CSHA256 m_salted_hasher_schnorr;
     typedef CuckooCache::cache<uint256, SignatureCacheHasher> map_type;
-    map_type setValid;
-    std::shared_mutex cs_sigcache;
+
+    //! Number of independently locked cache shards. Must be a power of two.
+    //! Entries are salted SHA256 hashes, so any entry byte selects a shard
+    //! uniformly; sharding keeps writers on different shards from contending
+    //! during parallel script verification.
+    static constexpr size_t NUM_SHARDS{16};
+
+    struct Shard {
+        map_type set_valid;
+        std::shared_mutex mutex;
+    };
+    std::array<Shard, NUM_SHARDS> m_shards;
+
+    Shard& GetShard(const uint256& entry) { return m_shards[entry.data()[0] & (NUM_SHARDS - 1)]; }
 
 public:
     SignatureCache(size_t max_size_bytes);
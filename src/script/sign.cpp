@@ -317,6 +317,31 @@ struct TapSatisfier: Satisfier<XOnlyPubKey> {
     }
 };
 
+/** Parse a script as Miniscript, memoizing the result per thread.
+ *
+ * A wallet spending many inputs controlled by the same script template (e.g. a
+ * multisig vault withdrawal) re-parses and type-checks the identical witness
+ * script for every input, even though that analysis only depends on the script
+ * itself. Cache the parsed tree keyed by script so the structural work happens
+ * once; satisfaction (which substitutes the per-input signatures) still runs
+ * per input against the cached tree.
+ *
+ * Key hashes inside the script are resolved to keys at parse time through the
+ * satisfier's provider, but the script commits to the hash, so a resolved node
+ * remains valid whichever provider later satisfies it. Parse failures are not
+ * cached, as they may be due to a missing pubkey lookup. */
+template<typename Ctx>
+static const miniscript::Node<typename Ctx::Key>* ParseMiniscript(const CScript& script, const Ctx& ctx)
+{
+    thread_local std::map<CScript, miniscript::NodeRef<typename Ctx::Key>> cache;
+    static constexpr size_t MAX_CACHED_MINISCRIPTS{100};
+    if (const auto it{cache.find(script)}; it != cache.end()) return it->second.get();
+    auto node{miniscript::FromScript(script, ctx)};
+    if (!node) return nullptr;
+    if (cache.size() >= MAX_CACHED_MINISCRIPTS) cache.clear();
+    return cache.emplace(script, std::move(node)).first->second.get();
+}
+
 static bool SignTaprootScript(const SigningProvider& provider, const BaseSignatureCreator& creator, SignatureData& sigdata, int leaf_version, Span<const unsigned char> script_bytes, std::vector<valtype>& result)
 {
     // Only BIP342 tapscript signing is supported for now.
@@ -326,7 +351,7 @@ static bool SignTaprootScript(const SigningProvider& provider, const BaseSignatu
     CScript script = CScript(script_bytes.begin(), script_bytes.end());
 
     TapSatisfier ms_satisfier{provider, sigdata, creator, script, leaf_hash};
-    const auto ms = miniscript::FromScript(script, ms_satisfier);
+    const auto* ms = ParseMiniscript(script, ms_satisfier);
     return ms && ms->Satisfy(ms_satisfier, result) == miniscript::Availability::YES;
 }
 
@@ -544,7 +569,7 @@ bool ProduceSignature(const SigningProvider& provider, const BaseSignatureCreato
         // and the extractor relies on this behaviour to combine witnesses.
         if (!solved && result.empty()) {
             WshSatisfier ms_satisfier{provider, sigdata, creator, witnessscript};
-            const auto ms = miniscript::FromScript(witnessscript, ms_satisfier);
+            const auto* ms = ParseMiniscript(witnessscript, ms_satisfier);
             solved = ms && ms->Satisfy(ms_satisfier, result) == miniscript::Availability::YES;
         }
         result.emplace_back(witnessscript.begin(), witnessscript.end());
@@ -9,6 +9,7 @@
 #include <util/strencodings.h>
 #include <util/threadnames.h>
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <set>
@@ -320,3 +321,78 @@ bool LockStackEmpty()
 bool g_debug_lockorder_abort = true;
 
 #endif /* DEBUG_LOCKORDER */
+
+namespace {
+//! One statically allocated slot per lock call site. Sites are identified by
+//! (file pointer, line): __FILE__ literals are unique per site, so pointer
+//! identity is enough and no strings are hashed on the hot path.
+struct LockSiteSlot {
+    std::atomic<const char*> file{nullptr}; //!< claim marker; nullptr = free
+    std::atomic<int> line{0};               //!< published after the claim
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> wait_usec{0};
+};
+
+//! Fixed open-addressing table; the tree has a few hundred distinct LOCK
+//! sites, most of which are never hit. Sites that do not fit (or collide
+//! past the probe limit) are silently not tracked rather than slowing the
+//! caller down.
+constexpr size_t LOCK_STATS_SLOTS{1024}; // power of two
+constexpr size_t LOCK_STATS_MAX_PROBES{8};
+LockSiteSlot g_lock_stats[LOCK_STATS_SLOTS];
+
+LockSiteSlot* FindLockSiteSlot(const char* name, const char* file, int line)
+{
+    size_t idx = (((reinterpret_cast<uintptr_t>(file) >> 3) * 31) + static_cast<size_t>(line)) & (LOCK_STATS_SLOTS - 1);
+    for (size_t probe = 0; probe < LOCK_STATS_MAX_PROBES; ++probe, idx = (idx + 1) & (LOCK_STATS_SLOTS - 1)) {
+        LockSiteSlot& slot = g_lock_stats[idx];
+        const char* slot_file = slot.file.load(std::memory_order_acquire);
+        if (slot_file == file && slot.line.load(std::memory_order_relaxed) == line) return &slot;
+        if (slot_file == nullptr) {
+            const char* expected = nullptr;
+            if (slot.file.compare_exchange_strong(expected, file, std::memory_order_acq_rel)) {
+                // Claimed; publish the rest of the key. A concurrent probe
+                // for the same site racing this store may miss the match and
+                // claim a second slot, which merely splits the counters.
+                slot.line.store(line, std::memory_order_relaxed);
+                slot.name.store(name, std::memory_order_relaxed);
+                return &slot;
+            }
+            if (expected == file && slot.line.load(std::memory_order_relaxed) == line) return &slot;
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
+void RecordLockAcquire(const char* name, const char* file, int line, bool contended, int64_t wait_usec)
+{
+    LockSiteSlot* slot = FindLockSiteSlot(name, file, line);
+    if (!slot) return;
+    slot->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (contended) {
+        slot->contended.fetch_add(1, std::memory_order_relaxed);
+        slot->wait_usec.fetch_add(static_cast<uint64_t>(wait_usec), std::memory_order_relaxed);
+    }
+}
+
+std::vector<LockSiteStats> GetLockStats()
+{
+    std::vector<LockSiteStats> out;
+    for (const LockSiteSlot& slot : g_lock_stats) {
+        if (slot.file.load(std::memory_order_acquire) == nullptr) continue;
+        const char* name{slot.name.load(std::memory_order_relaxed)};
+        if (name == nullptr) continue; // claim in progress
+        out.push_back(LockSiteStats{
+            .name = name,
+            .file = slot.file.load(std::memory_order_relaxed),
+            .line = slot.line.load(std::memory_order_relaxed),
+            .acquisitions = slot.acquisitions.load(std::memory_order_relaxed),
+            .contended = slot.contended.load(std::memory_order_relaxed),
+            .wait_usec = slot.wait_usec.load(std::memory_order_relaxed),
+        });
+    }
+    return out;
+}
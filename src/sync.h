@@ -14,10 +14,13 @@
 #include <threadsafety.h> // IWYU pragma: export
 #include <util/macros.h>
 
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 ////////////////////////////////////////////////
 //                                            //
@@ -52,6 +55,27 @@ LEAVE_CRITICAL_SECTION(mutex); // no RAII
 //                           //
 ///////////////////////////////
 
+/**
+ * Lightweight always-on lock statistics, surfaced by the getlockstats RPC.
+ * Each UniqueLock call site gets atomic counters of acquisitions, contended
+ * acquisitions and total time spent waiting; the uncontended fast path only
+ * pays one hashed relaxed increment, and the clock is read only when the
+ * initial try_lock fails. Unlike DEBUG_LOCKORDER this is cheap enough for
+ * production, which is where contention questions actually come up.
+ */
+void RecordLockAcquire(const char* name, const char* file, int line, bool contended, int64_t wait_usec);
+
+struct LockSiteStats {
+    const char* name;
+    const char* file;
+    int line;
+    uint64_t acquisitions;
+    uint64_t contended;
+    uint64_t wait_usec;
+};
+/** Snapshot of the statistics of every lock site seen so far. */
+std::vector<LockSiteStats> GetLockStats();
+
 #ifdef DEBUG_LOCKORDER
 template <typename MutexType>
 void EnterCritical(const char* pszName, const char* pszFile, int nLine, MutexType* cs, bool fTry = false);
@@ -156,17 +180,24 @@ private:
     void Enter(const char* pszName, const char* pszFile, int nLine)
     {
         EnterCritical(pszName, pszFile, nLine, Base::mutex());
+        if (Base::try_lock()) {
+            RecordLockAcquire(pszName, pszFile, nLine, /*contended=*/false, /*wait_usec=*/0);
+            return;
+        }
 #ifdef DEBUG_LOCKCONTENTION
-        if (Base::try_lock()) return;
         LOG_TIME_MICROS_WITH_CATEGORY(strprintf("lock contention %s, %s:%d", pszName, pszFile, nLine), BCLog::LOCK);
 #endif
+        const auto start{std::chrono::steady_clock::now()};
         Base::lock();
+        const auto wait{std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)};
+        RecordLockAcquire(pszName, pszFile, nLine, /*contended=*/true, wait.count());
     }
 
     bool TryEnter(const char* pszName, const char* pszFile, int nLine)
     {
         EnterCritical(pszName, pszFile, nLine, Base::mutex(), true);
         if (Base::try_lock()) {
+            RecordLockAcquire(pszName, pszFile, nLine, /*contended=*/false, /*wait_usec=*/0);
             return true;
         }
         LeaveCritical();
@@ -0,0 +1,106 @@
+// Copyright (c) 2024-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockview.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <serialize.h>
+#include <streams.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+using node::BlockView;
+
+BOOST_AUTO_TEST_SUITE(blockview_tests)
+
+namespace {
+CBlock MakeTestBlock()
+{
+    CBlock block;
+    block.nVersion = 1;
+    block.nTime = 1234567890;
+
+    // Coinbase-like transaction without witness data
+    CMutableTransaction tx1;
+    tx1.vin.resize(1);
+    tx1.vin[0].scriptSig = CScript() << OP_1 << OP_2;
+    tx1.vout.resize(1);
+    tx1.vout[0].nValue = 50 * COIN;
+    tx1.vout[0].scriptPubKey = CScript() << OP_TRUE;
+
+    // Transaction with two inputs, one of which carries a witness stack
+    CMutableTransaction tx2;
+    tx2.vin.resize(2);
+    tx2.vin[0].prevout = COutPoint(Txid::FromUint256(uint256::ONE), 0);
+    tx2.vin[1].prevout = COutPoint(Txid::FromUint256(uint256::ONE), 1);
+    tx2.vin[1].scriptWitness.stack = {{0x01, 0x02, 0x03}, {0x04}};
+    tx2.vout.resize(2);
+    tx2.vout[0].nValue = 1 * COIN;
+    tx2.vout[0].scriptPubKey = CScript() << OP_TRUE;
+    tx2.vout[1].nValue = 2 * COIN;
+    tx2.vout[1].scriptPubKey = CScript() << OP_FALSE;
+
+    block.vtx.push_back(MakeTransactionRef(tx1));
+    block.vtx.push_back(MakeTransactionRef(tx2));
+    return block;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(blockview_parse)
+{
+    const CBlock block{MakeTestBlock()};
+    DataStream ss;
+    ss << TX_WITH_WITNESS(block);
+    const std::vector<uint8_t> data{UCharCast(ss.data()), UCharCast(ss.data()) + ss.size()};
+
+    const BlockView view{data};
+    BOOST_REQUIRE(view.IsValid());
+    BOOST_CHECK_EQUAL(view.GetHeader().GetHash(), block.GetHash());
+    BOOST_REQUIRE_EQUAL(view.TxCount(), block.vtx.size());
+
+    // Each transaction's byte range must match its standalone serialization.
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        DataStream tx_ss;
+        tx_ss << TX_WITH_WITNESS(*block.vtx[i]);
+        const auto tx_bytes{view.TxBytes(i)};
+        BOOST_REQUIRE_EQUAL(tx_bytes.size(), tx_ss.size());
+        BOOST_CHECK(std::equal(tx_bytes.begin(), tx_bytes.end(), UCharCast(tx_ss.data())));
+    }
+
+    // Splicing the witness data out must reproduce the non-witness block
+    // serialization exactly.
+    std::vector<uint8_t> stripped;
+    const auto prefix{view.PrefixBytes()};
+    stripped.insert(stripped.end(), prefix.begin(), prefix.end());
+    for (size_t i = 0; i < view.TxCount(); ++i) {
+        view.AppendTxWithoutWitness(i, stripped);
+    }
+    DataStream no_witness;
+    no_witness << TX_NO_WITNESS(block);
+    BOOST_REQUIRE_EQUAL(stripped.size(), no_witness.size());
+    BOOST_CHECK(std::equal(stripped.begin(), stripped.end(), UCharCast(no_witness.data())));
+}
+
+BOOST_AUTO_TEST_CASE(blockview_invalid)
+{
+    const CBlock block{MakeTestBlock()};
+    DataStream ss;
+    ss << TX_WITH_WITNESS(block);
+    std::vector<uint8_t> data{UCharCast(ss.data()), UCharCast(ss.data()) + ss.size()};
+
+    // Truncated buffer
+    const BlockView truncated{std::span{data}.first(data.size() - 5)};
+    BOOST_CHECK(!truncated.IsValid());
+
+    // Trailing garbage
+    data.push_back(0x00);
+    const BlockView trailing{data};
+    BOOST_CHECK(!trailing.IsValid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -490,7 +490,7 @@ BOOST_AUTO_TEST_CASE(rolling_bloom)
             ++nHits;
     }
     // Expect about 100 hits
-    BOOST_CHECK_EQUAL(nHits, 71U);
+    BOOST_CHECK_EQUAL(nHits, 108U);
 
     BOOST_CHECK(rb1.contains(data[DATASIZE-1]));
     rb1.reset();
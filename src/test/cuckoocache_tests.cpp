@@ -49,6 +49,28 @@ BOOST_AUTO_TEST_CASE(test_cuckoocache_no_fakes)
     }
 };
 
+/* Test that contains_batch agrees with contains, element for element, on a
+ * mix of inserted and never-inserted values.
+ */
+BOOST_AUTO_TEST_CASE(test_cuckoocache_contains_batch)
+{
+    SeedRandomForTest(SeedRand::ZEROS);
+    CuckooCache::cache<uint256, SignatureCacheHasher> cc{};
+    cc.setup_bytes(4 << 20);
+    std::vector<uint256> keys;
+    for (int x = 0; x < 1000; ++x) {
+        keys.push_back(m_rng.rand256());
+        if (x % 2 == 0) cc.insert(keys.back());
+    }
+    // std::vector<bool> has no contiguous storage; collect via a plain array.
+    std::unique_ptr<bool[]> out{new bool[keys.size()]};
+    cc.contains_batch(keys, {out.get(), keys.size()}, false);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        BOOST_CHECK_EQUAL(out[i], cc.contains(keys[i], false));
+        BOOST_CHECK_EQUAL(out[i], i % 2 == 0);
+    }
+};
+
 struct HitRateTest : BasicTestingSetup {
 /** This helper returns the hit rate when megabytes*load worth of entries are
  * inserted into a megabytes sized cache
@@ -146,6 +146,25 @@ BOOST_AUTO_TEST_CASE(siphash)
         BOOST_CHECK_EQUAL(SipHashUint256(k1, k2, x), sip256.Finalize());
         BOOST_CHECK_EQUAL(SipHashUint256Extra(k1, k2, x, n), sip288.Finalize());
     }
+
+    // Check consistency between SipHashUint256 and the (possibly vectorized)
+    // batch implementation, including non-multiple-of-lane-count tails.
+    SipHashAutoDetect();
+    for (size_t len : {size_t{0}, size_t{1}, size_t{3}, size_t{4}, size_t{7}, size_t{64}}) {
+        uint64_t k1 = ctx.rand64();
+        uint64_t k2 = ctx.rand64();
+        std::vector<uint256> vals(len);
+        std::vector<const uint256*> ptrs(len);
+        for (size_t i = 0; i < len; ++i) {
+            vals[i] = m_rng.rand256();
+            ptrs[i] = &vals[i];
+        }
+        std::vector<uint64_t> out(len);
+        SipHashUint256Batch(k1, k2, ptrs, out);
+        for (size_t i = 0; i < len; ++i) {
+            BOOST_CHECK_EQUAL(out[i], SipHashUint256(k1, k2, vals[i]));
+        }
+    }
 }
 
 BOOST_AUTO_TEST_SUITE_END()
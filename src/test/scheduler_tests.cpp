@@ -212,4 +212,30 @@ BOOST_AUTO_TEST_CASE(mockforward)
     BOOST_CHECK(delta > 2*60 && delta < 3*60);
 }
 
+BOOST_AUTO_TEST_CASE(priority_order)
+{
+    CScheduler scheduler;
+
+    // Queue several already-due tasks before the service thread starts: a
+    // background task with the earliest time, then normal and critical ones.
+    // The service thread must pick the due tasks in priority order, not in
+    // time order.
+    std::vector<int> order;
+    const auto now{std::chrono::steady_clock::now()};
+    scheduler.schedule([&] { order.push_back(3); }, now - std::chrono::milliseconds{3}, CScheduler::Priority::BACKGROUND);
+    scheduler.schedule([&] { order.push_back(2); }, now - std::chrono::milliseconds{2}, CScheduler::Priority::NORMAL);
+    scheduler.schedule([&] { order.push_back(1); }, now - std::chrono::milliseconds{1}, CScheduler::Priority::CRITICAL);
+
+    std::thread scheduler_thread([&] { scheduler.serviceQueue(); });
+    scheduler.StopWhenDrained();
+    scheduler_thread.join();
+
+    const std::vector<int> expected{1, 2, 3};
+    BOOST_CHECK(order == expected);
+
+    const auto lag_info{scheduler.GetLagInfo()};
+    BOOST_CHECK_EQUAL(lag_info.tasks_run, 3u);
+    BOOST_CHECK(lag_info.max_lag >= std::chrono::milliseconds{1});
+}
+
 BOOST_AUTO_TEST_SUITE_END()
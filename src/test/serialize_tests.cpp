@@ -3,6 +3,8 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <hash.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
 #include <serialize.h>
 #include <streams.h>
 #include <test/util/setup_common.h>
@@ -99,6 +101,10 @@ BOOST_AUTO_TEST_CASE(sizes)
     BOOST_CHECK_EQUAL(GetSerializeSize(bool(0)), 1U);
     BOOST_CHECK_EQUAL(GetSerializeSize(std::array<uint8_t, 1>{0}), 1U);
     BOOST_CHECK_EQUAL(GetSerializeSize(std::array<uint8_t, 2>{0, 0}), 2U);
+
+    // The compile-time sizes of fixed-size types must match the serializers.
+    BOOST_CHECK_EQUAL(GetSerializeSize(CBlockHeader{}), CBlockHeader::SERIALIZED_SIZE);
+    BOOST_CHECK_EQUAL(GetSerializeSize(COutPoint{}), COutPoint::SERIALIZED_SIZE);
 }
 
 BOOST_AUTO_TEST_CASE(varints)
@@ -14,9 +14,12 @@
 #include <uint256.h>
 #include <util/vector.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <deque>
 #include <iterator>
+#include <thread>
 #include <utility>
 
 static constexpr uint8_t DB_COIN{'C'};
@@ -115,22 +118,50 @@ bool CCoinsViewDB::BatchWrite(CoinsViewCacheCursor& cursor, const uint256 &hashB
     // interrupting after partial writes from multiple independent reorgs.
     batch.Erase(DB_BEST_BLOCK);
     batch.Write(DB_HEAD_BLOCKS, Vector(hashBlock, old_tip));
-
-    for (auto it{cursor.Begin()}; it != cursor.End();) {
-        if (it->second.IsDirty()) {
-            CoinEntry entry(&it->first);
-            if (it->second.coin.IsSpent())
-                batch.Erase(entry);
-            else
-                batch.Write(entry, it->second.coin);
-            changed++;
+    m_db->WriteBatch(batch);
+    batch.Clear();
+
+    // Serialization of the dirty coins into batches dominates large flushes,
+    // so it is spread over several threads: the cursor is walked on this
+    // thread to collect a chunk of dirty entries, the chunk is partitioned
+    // across workers each filling an independent CDBBatch (coins are keyed by
+    // outpoint, so the batches touch disjoint keys), and the batches are then
+    // committed in sequence. This is crash-safe for the same reason partial
+    // batches are: DB_HEAD_BLOCKS has already been written above, and
+    // DB_BEST_BLOCK is only restored once everything else has landed.
+    const size_t num_workers{std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4)};
+    const size_t chunk_bytes_target{m_options.batch_write_bytes * num_workers};
+    std::vector<CoinsCachePair*> chunk;
+    const auto flush_chunk{[&]() {
+        if (chunk.empty()) return;
+        std::deque<CDBBatch> batches; // deque: CDBBatch is not movable
+        for (size_t i = 0; i < num_workers; ++i) batches.emplace_back(*m_db);
+        std::vector<std::thread> workers;
+        workers.reserve(num_workers);
+        const size_t stride{(chunk.size() + num_workers - 1) / num_workers};
+        for (size_t t = 0; t < num_workers; ++t) {
+            const size_t chunk_begin{t * stride};
+            const size_t chunk_end{std::min(chunk_begin + stride, chunk.size())};
+            if (chunk_begin >= chunk_end) break;
+            workers.emplace_back([&, chunk_begin, chunk_end, t] {
+                for (size_t i = chunk_begin; i < chunk_end; ++i) {
+                    CoinEntry entry(&chunk[i]->first);
+                    if (chunk[i]->second.coin.IsSpent())
+                        batches[t].Erase(entry);
+                    else
+                        batches[t].Write(entry, chunk[i]->second.coin);
+                }
+            });
         }
-        count++;
-        it = cursor.NextAndMaybeErase(*it);
-        if (batch.SizeEstimate() > m_options.batch_write_bytes) {
-            LogDebug(BCLog::COINDB, "Writing partial batch of %.2f MiB\n", batch.SizeEstimate() * (1.0 / 1048576.0));
-            m_db->WriteBatch(batch);
-            batch.Clear();
+        for (auto& worker : workers) worker.join();
+        // The entries may only be erased or unflagged once the workers are
+        // done serializing them.
+        for (CoinsCachePair* entry : chunk) cursor.NextAndMaybeErase(*entry);
+        chunk.clear();
+        for (CDBBatch& worker_batch : batches) {
+            if (worker_batch.SizeEstimate() == 0) continue;
+            LogDebug(BCLog::COINDB, "Writing partial batch of %.2f MiB\n", worker_batch.SizeEstimate() * (1.0 / 1048576.0));
+            m_db->WriteBatch(worker_batch);
             if (m_options.simulate_crash_ratio) {
                 static FastRandomContext rng;
                 if (rng.randrange(m_options.simulate_crash_ratio) == 0) {
@@ -139,7 +170,27 @@ bool CCoinsViewDB::BatchWrite(CoinsViewCacheCursor& cursor, const uint256 &hashB
                 }
             }
         }
+    }};
+
+    size_t chunk_bytes{0};
+    for (auto it{cursor.Begin()}; it != cursor.End();) {
+        const auto next{it->second.Next()};
+        if (it->second.IsDirty()) {
+            // Defer erasure/unflagging to flush_chunk().
+            chunk.push_back(it);
+            chunk_bytes += it->second.coin.DynamicMemoryUsage();
+            changed++;
+        } else {
+            cursor.NextAndMaybeErase(*it);
+        }
+        count++;
+        it = next;
+        if (chunk_bytes > chunk_bytes_target) {
+            flush_chunk();
+            chunk_bytes = 0;
+        }
     }
+    flush_chunk();
 
     // In the last batch, mark the database as consistent with hashBlock again.
     batch.Erase(DB_HEAD_BLOCKS);
@@ -198,6 +249,22 @@ std::unique_ptr<CCoinsViewCursor> CCoinsViewDB::Cursor() const
     return i;
 }
 
+std::unique_ptr<CCoinsViewCursor> CCoinsViewDB::Cursor(const COutPoint& start) const
+{
+    auto i = std::make_unique<CCoinsViewDBCursor>(
+        const_cast<CDBWrapper&>(*m_db).NewIterator(), GetBestBlock());
+    i->pcursor->Seek(CoinEntry(&start));
+    // Cache key of first record at or past the start position
+    if (i->pcursor->Valid()) {
+        CoinEntry entry(&i->keyTmp.second);
+        i->pcursor->GetKey(entry);
+        i->keyTmp.first = entry.key;
+    } else {
+        i->keyTmp.first = 0; // Make sure Valid() and GetKey() return false
+    }
+    return i;
+}
+
 bool CCoinsViewDBCursor::GetKey(COutPoint &key) const
 {
     // Return cached key
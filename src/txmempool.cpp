@@ -169,12 +169,26 @@ util::Result<CTxMemPool::setEntries> CTxMemPool::CalculateAncestorsAndCheckLimit
     int64_t totalSizeWithAncestors = entry_size;
     setEntries ancestors;
 
-    while (!staged_ancestors.empty()) {
-        const CTxMemPoolEntry& stage = staged_ancestors.begin()->get();
-        txiter stageit = mapTx.iterator_to(stage);
+    // Walk the ancestor graph with an epoch-marked vector as the work queue:
+    // the visited marker guarantees each entry is discovered exactly once, so
+    // no per-step set lookups or staged-set node allocations are needed.
+    WITH_FRESH_EPOCH(m_epoch);
+    std::vector<txiter>& stage{m_traversal_scratch};
+    stage.clear();
+    for (const CTxMemPoolEntry& parent : staged_ancestors) {
+        txiter parent_it = mapTx.iterator_to(parent);
+        visited(parent_it);
+        stage.push_back(parent_it);
+    }
+    // Number of distinct in-mempool ancestors discovered so far, whether still
+    // queued in stage or already moved to ancestors.
+    uint64_t discovered{stage.size()};
+
+    while (!stage.empty()) {
+        txiter stageit = stage.back();
+        stage.pop_back();
 
         ancestors.insert(stageit);
-        staged_ancestors.erase(stage);
         totalSizeWithAncestors += stageit->GetTxSize();
 
         if (stageit->GetSizeWithDescendants() + entry_size > limits.descendant_size_vbytes) {
@@ -190,10 +204,11 @@ util::Result<CTxMemPool::setEntries> CTxMemPool::CalculateAncestorsAndCheckLimit
             txiter parent_it = mapTx.iterator_to(parent);
 
             // If this is a new ancestor, add it.
-            if (ancestors.count(parent_it) == 0) {
-                staged_ancestors.insert(parent);
+            if (!visited(parent_it)) {
+                stage.push_back(parent_it);
+                ++discovered;
             }
-            if (staged_ancestors.size() + ancestors.size() + entry_count > static_cast<uint64_t>(limits.ancestor_count)) {
+            if (discovered + entry_count > static_cast<uint64_t>(limits.ancestor_count)) {
                 return util::Error{Untranslated(strprintf("too many unconfirmed ancestors [limit: %u]", limits.ancestor_count))};
             }
         }
@@ -414,6 +429,31 @@ static CTxMemPool::Options&& Flatten(CTxMemPool::Options&& opts, bilingual_str&
 CTxMemPool::CTxMemPool(Options opts, bilingual_str& error)
     : m_opts{Flatten(std::move(opts), error)}
 {
+    if (!m_opts.trace_file.empty()) {
+        LOCK(m_trace_mutex);
+        m_trace_file.emplace(fsbridge::fopen(m_opts.trace_file, "ab"));
+        if (m_trace_file->IsNull()) {
+            error = Untranslated(strprintf("Unable to open mempool trace file %s", fs::PathToString(m_opts.trace_file)));
+        } else {
+            m_is_tracing = true;
+            LogPrintf("Appending mempool trace to %s\n", fs::PathToString(m_opts.trace_file));
+        }
+    }
+}
+
+void CTxMemPool::TraceAcceptedTransaction(const CTransactionRef& tx, const std::vector<Coin>& spent_coins)
+{
+    LOCK(m_trace_mutex);
+    if (!m_trace_file) return;
+    try {
+        *m_trace_file << uint64_t(TicksSinceEpoch<std::chrono::microseconds>(SystemClock::now()))
+                      << TX_WITH_WITNESS(*tx)
+                      << spent_coins;
+    } catch (const std::ios_base::failure& e) {
+        LogPrintf("Error writing mempool trace (%s); disabling capture\n", e.what());
+        m_trace_file.reset();
+        m_is_tracing = false;
+    }
 }
 
 bool CTxMemPool::isSpent(const COutPoint& outpoint) const
@@ -504,6 +544,7 @@ void CTxMemPool::addNewTransaction(CTxMemPool::txiter newit, CTxMemPool::setEntr
     UpdateEntryForAncestors(newit, setAncestors);
 
     nTransactionsUpdated++;
+    m_membership_version.fetch_add(1, std::memory_order_release);
     totalTxSize += entry.GetTxSize();
     m_total_fee += entry.GetFee();
 
@@ -517,6 +558,27 @@ void CTxMemPool::addNewTransaction(CTxMemPool::txiter newit, CTxMemPool::setEntr
     );
 }
 
+void CTxMemPool::CalculateDescendantsCached(txiter entryit, setEntries& setDescendants) const
+{
+    AssertLockHeld(cs);
+    //! Bound on distinct conflicted entries memoized between membership changes.
+    static constexpr size_t MAX_CONFLICT_SET_CACHE{1000};
+
+    // The version can't move while cs is held, so a matching stamp means no
+    // entry has been added or removed since the cached set was computed.
+    const uint64_t version{m_membership_version.load(std::memory_order_relaxed)};
+    if (m_conflict_set_cache_version != version || m_conflict_set_cache.size() >= MAX_CONFLICT_SET_CACHE) {
+        m_conflict_set_cache.clear();
+        m_conflict_set_cache_version = version;
+    }
+
+    const auto [cached, inserted] = m_conflict_set_cache.try_emplace(entryit->GetTx().GetHash());
+    if (inserted) {
+        CalculateDescendants(entryit, cached->second);
+    }
+    setDescendants.insert(cached->second.begin(), cached->second.end());
+}
+
 void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
 {
     // We increment mempool sequence value no matter removal reason
@@ -560,6 +622,7 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     cachedInnerUsage -= memusage::DynamicUsage(it->GetMemPoolParentsConst()) + memusage::DynamicUsage(it->GetMemPoolChildrenConst());
     mapTx.erase(it);
     nTransactionsUpdated++;
+    m_membership_version.fetch_add(1, std::memory_order_release);
 }
 
 // Calculates descendants of entry that are not already in setDescendants, and adds to
@@ -570,23 +633,29 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
 // can save time by not iterating over those entries.
 void CTxMemPool::CalculateDescendants(txiter entryit, setEntries& setDescendants) const
 {
-    setEntries stage;
+    // Epoch-marked traversal with a vector work queue: the visited marker
+    // dedupes within this call, while the setDescendants lookup prunes
+    // subtrees that were fully walked by a previous call.
+    WITH_FRESH_EPOCH(m_epoch);
+    std::vector<txiter>& stage{m_traversal_scratch};
+    stage.clear();
     if (setDescendants.count(entryit) == 0) {
-        stage.insert(entryit);
+        visited(entryit);
+        stage.push_back(entryit);
     }
     // Traverse down the children of entry, only adding children that are not
     // accounted for in setDescendants already (because those children have either
     // already been walked, or will be walked in this iteration).
     while (!stage.empty()) {
-        txiter it = *stage.begin();
+        txiter it = stage.back();
+        stage.pop_back();
         setDescendants.insert(it);
-        stage.erase(it);
 
         const CTxMemPoolEntry::Children& children = it->GetMemPoolChildrenConst();
         for (const CTxMemPoolEntry& child : children) {
             txiter childiter = mapTx.iterator_to(child);
-            if (!setDescendants.count(childiter)) {
-                stage.insert(childiter);
+            if (!visited(childiter) && !setDescendants.count(childiter)) {
+                stage.push_back(childiter);
             }
         }
     }
@@ -794,26 +863,6 @@ void CTxMemPool::check(const CCoinsViewCache& active_coins_tip, int64_t spendhei
     assert(innerUsage == cachedInnerUsage);
 }
 
-bool CTxMemPool::CompareDepthAndScore(const uint256& hasha, const uint256& hashb, bool wtxid)
-{
-    /* Return `true` if hasha should be considered sooner than hashb. Namely when:
-     *   a is not in the mempool, but b is
-     *   both are in the mempool and a has fewer ancestors than b
-     *   both are in the mempool and a has a higher score than b
-     */
-    LOCK(cs);
-    indexed_transaction_set::const_iterator j = wtxid ? get_iter_from_wtxid(hashb) : mapTx.find(hashb);
-    if (j == mapTx.end()) return false;
-    indexed_transaction_set::const_iterator i = wtxid ? get_iter_from_wtxid(hasha) : mapTx.find(hasha);
-    if (i == mapTx.end()) return true;
-    uint64_t counta = i->GetCountWithAncestors();
-    uint64_t countb = j->GetCountWithAncestors();
-    if (counta == countb) {
-        return CompareTxMemPoolEntryByScore()(*i, *j);
-    }
-    return counta < countb;
-}
-
 namespace {
 class DepthAndScoreComparator
 {
@@ -860,6 +909,35 @@ std::vector<CTxMemPoolEntryRef> CTxMemPool::entryAll() const
     return ret;
 }
 
+std::shared_ptr<const std::vector<Txid>> CTxMemPool::GetTxidSnapshot() const
+{
+    const uint64_t version{m_membership_version.load(std::memory_order_acquire)};
+    {
+        LOCK(m_snapshot_mutex);
+        if (m_txid_snapshot && m_txid_snapshot_version == version) {
+            return m_txid_snapshot;
+        }
+    }
+
+    auto snapshot{std::make_shared<std::vector<Txid>>()};
+    uint64_t built_version;
+    {
+        LOCK(cs);
+        snapshot->reserve(mapTx.size());
+        for (const auto& it : GetSortedDepthAndScore()) {
+            snapshot->push_back(it->GetTx().GetHash());
+        }
+        // The version can't move while cs is held, so the snapshot is
+        // consistent with the value recorded here.
+        built_version = m_membership_version.load(std::memory_order_relaxed);
+    }
+
+    LOCK(m_snapshot_mutex);
+    m_txid_snapshot = std::move(snapshot);
+    m_txid_snapshot_version = built_version;
+    return m_txid_snapshot;
+}
+
 std::vector<TxMempoolInfo> CTxMemPool::infoAll() const
 {
     LOCK(cs);
@@ -1162,19 +1240,42 @@ void CTxMemPool::TrimToSize(size_t sizelimit, std::vector<COutPoint>* pvNoSpends
     unsigned nTxnRemoved = 0;
     CFeeRate maxFeeRateRemoved(0);
     while (!mapTx.empty() && DynamicMemoryUsage() > sizelimit) {
-        indexed_transaction_set::index<descendant_score>::type::iterator it = mapTx.get<descendant_score>().begin();
-
-        // We set the new mempool min fee to the feerate of the removed set, plus the
-        // "minimum reasonable fee rate" (ie some value under which we consider txn
-        // to have 0 fee). This way, we don't allow txn to enter mempool with feerate
-        // equal to txn which were removed with no block in between.
-        CFeeRate removed(it->GetModFeesWithDescendants(), it->GetSizeWithDescendants());
-        removed += m_opts.incremental_relay_feerate;
-        trackPackageRemoved(removed);
-        maxFeeRateRemoved = std::max(maxFeeRateRemoved, removed);
-
+        // Select a whole batch of victim packages in one pass over the
+        // descendant-score index, estimating the memory each eviction
+        // releases, and remove them with a single RemoveStaged call so the
+        // remaining entries' ancestor state is only updated once. The
+        // estimate ignores parent/child link usage, so it undershoots; the
+        // outer loop re-checks actual usage and selects another batch if
+        // needed.
+        const uint64_t to_release{DynamicMemoryUsage() - sizelimit};
+        uint64_t released_estimate{0};
         setEntries stage;
-        CalculateDescendants(mapTx.project<0>(it), stage);
+        auto it = mapTx.get<descendant_score>().begin();
+        while (it != mapTx.get<descendant_score>().end() && released_estimate < to_release) {
+            txiter entry = mapTx.project<0>(it);
+            ++it;
+            // Already scheduled as a descendant of an earlier victim; its
+            // descendant score is stale, but it is being removed regardless.
+            if (stage.count(entry)) continue;
+
+            // We set the new mempool min fee to the feerate of the removed set, plus the
+            // "minimum reasonable fee rate" (ie some value under which we consider txn
+            // to have 0 fee). This way, we don't allow txn to enter mempool with feerate
+            // equal to txn which were removed with no block in between.
+            CFeeRate removed(entry->GetModFeesWithDescendants(), entry->GetSizeWithDescendants());
+            removed += m_opts.incremental_relay_feerate;
+            trackPackageRemoved(removed);
+            maxFeeRateRemoved = std::max(maxFeeRateRemoved, removed);
+
+            setEntries descendants;
+            CalculateDescendants(entry, descendants);
+            for (txiter descendant : descendants) {
+                if (stage.insert(descendant).second) {
+                    // Same per-entry overhead estimate as DynamicMemoryUsage().
+                    released_estimate += memusage::MallocUsage(sizeof(CTxMemPoolEntry) + 15 * sizeof(void*)) + descendant->DynamicMemoryUsage();
+                }
+            }
+        }
         nTxnRemoved += stage.size();
 
         std::vector<CTransaction> txn;
@@ -17,6 +17,7 @@
 #include <policy/feerate.h>
 #include <policy/packages.h>
 #include <primitives/transaction.h>
+#include <streams.h>
 #include <sync.h>
 #include <util/epochguard.h>
 #include <util/hasher.h>
@@ -319,10 +320,28 @@ protected:
     // is added or removed from the mempool for any reason.
     mutable uint64_t m_sequence_number GUARDED_BY(cs){1};
 
+    //! Bumped (under cs) whenever the set of transactions changes, so
+    //! GetTxidSnapshot() can tell whether its cached copy is still current
+    //! without taking cs.
+    std::atomic<uint64_t> m_membership_version{0};
+
+    //! Cached immutable txid list handed out by GetTxidSnapshot(), and the
+    //! membership version it was built at. Guarded by its own mutex so
+    //! snapshot readers never contend with cs.
+    mutable Mutex m_snapshot_mutex;
+    mutable std::shared_ptr<const std::vector<Txid>> m_txid_snapshot GUARDED_BY(m_snapshot_mutex);
+    mutable uint64_t m_txid_snapshot_version GUARDED_BY(m_snapshot_mutex){0};
+
     void trackPackageRemoved(const CFeeRate& rate) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
     bool m_load_tried GUARDED_BY(cs){false};
 
+    //! File and mutex for -mempooltrace capture (see MemPoolOptions::trace_file).
+    mutable Mutex m_trace_mutex;
+    std::optional<AutoFile> m_trace_file GUARDED_BY(m_trace_mutex);
+    //! Set once in the constructor if the trace file was opened successfully.
+    bool m_is_tracing{false};
+
     CFeeRate GetMinFee(size_t sizelimit) const;
 
 public:
@@ -401,6 +420,18 @@ public:
 private:
     typedef std::map<txiter, setEntries, CompareIteratorByHash> cacheMap;
 
+    /** Scratch work queue reused by the epoch-based ancestor/descendant
+     * traversals, so repeated policy checks do not reallocate it. Only valid
+     * within a single traversal; each user clears it on entry. */
+    mutable std::vector<txiter> m_traversal_scratch GUARDED_BY(cs);
+
+    //! Memoized descendant sets for RBF conflict evaluation, keyed by the
+    //! txid of the directly conflicted entry. Entries are only valid at the
+    //! membership version they were computed at: any add or removal bumps
+    //! the version, which both invalidates the cached sets and guarantees
+    //! that no cached iterator can dangle.
+    mutable std::map<uint256, setEntries> m_conflict_set_cache GUARDED_BY(cs);
+    mutable uint64_t m_conflict_set_cache_version GUARDED_BY(cs){0};
 
     void UpdateParent(txiter entry, txiter parent, bool add) EXCLUSIVE_LOCKS_REQUIRED(cs);
     void UpdateChild(txiter entry, txiter child, bool add) EXCLUSIVE_LOCKS_REQUIRED(cs);
@@ -438,6 +469,16 @@ public:
 
     const Options m_opts;
 
+    //! Whether -mempooltrace capture is active.
+    bool IsTracing() const { return m_is_tracing; }
+
+    /**
+     * Append an accepted transaction to the trace file, together with the
+     * current time and the coins its inputs spend (in input order). Called by
+     * MemPoolAccept after the transaction has been added to the pool.
+     */
+    void TraceAcceptedTransaction(const CTransactionRef& tx, const std::vector<Coin>& spent_coins) EXCLUSIVE_LOCKS_REQUIRED(!m_trace_mutex);
+
     /** Create a new CTxMemPool.
      * Sanity checks will be off by default for performance, because otherwise
      * accepting transactions becomes O(N^2) where N is the number of transactions
@@ -466,7 +507,6 @@ public:
     void removeConflicts(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(cs);
     void removeForBlock(const std::vector<CTransactionRef>& vtx, unsigned int nBlockHeight) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
-    bool CompareDepthAndScore(const uint256& hasha, const uint256& hashb, bool wtxid=false);
     bool isSpent(const COutPoint& outpoint) const;
     unsigned int GetTransactionsUpdated() const;
     void AddTransactionsUpdated(unsigned int n);
@@ -587,6 +627,12 @@ public:
      *  already in it.  */
     void CalculateDescendants(txiter it, setEntries& setDescendants) const EXCLUSIVE_LOCKS_REQUIRED(cs);
 
+    /** Like CalculateDescendants(), but memoizes the per-entry descendant set
+     *  so repeated RBF evaluations of the same conflicts (package contexts,
+     *  resubmissions) don't re-walk the descendant graph. The cache is
+     *  dropped whenever the set of mempool transactions changes. */
+    void CalculateDescendantsCached(txiter it, setEntries& setDescendants) const EXCLUSIVE_LOCKS_REQUIRED(cs);
+
     /** The minimum fee to get into the mempool, which may itself not be enough
      *  for larger-sized transactions.
      *  The m_incremental_relay_feerate policy variable is used to bound the time it
@@ -669,6 +715,17 @@ public:
     std::vector<CTxMemPoolEntryRef> entryAll() const EXCLUSIVE_LOCKS_REQUIRED(cs);
     std::vector<TxMempoolInfo> infoAll() const;
 
+    /** Return an immutable list of all txids in the mempool.
+     *
+     * The list is served from a cached snapshot that is rebuilt only when the
+     * transaction set has changed since it was taken, so repeated callers
+     * (monitoring RPC storms on getrawmempool, for instance) usually don't
+     * touch cs at all and never block transaction relay while consuming the
+     * result. The snapshot may be stale by the time it is inspected, exactly
+     * as a copied-under-lock list would be.
+     */
+    std::shared_ptr<const std::vector<Txid>> GetTxidSnapshot() const;
+
     size_t DynamicMemoryUsage() const;
 
     /** Adds a transaction to the unbroadcast set */
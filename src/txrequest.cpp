@@ -57,6 +57,9 @@ enum class State : uint8_t {
 //! Type alias for sequence numbers.
 using SequenceNumber = uint64_t;
 
+//! Type alias for priorities.
+using Priority = uint64_t;
+
 /** An announcement. This is the data we track for each txid or wtxid that is announced to us by each peer. */
 struct Announcement {
     /** Txid or wtxid that was announced. */
@@ -65,6 +68,10 @@ struct Announcement {
     std::chrono::microseconds m_time;
     /** What peer the request was from. */
     const NodeId m_peer;
+    /** Precomputed priority of this announcement. It only depends on immutable fields
+     *  (txhash, peer, preferred), so it is cached here rather than recomputed by SipHash
+     *  inside every ByTxHash index comparison. */
+    const Priority m_priority;
     /** What sequence number this announcement has. */
     const SequenceNumber m_sequence : 59;
     /** Whether the request is preferred. */
@@ -97,14 +104,11 @@ struct Announcement {
 
     /** Construct a new announcement from scratch, initially in CANDIDATE_DELAYED state. */
     Announcement(const GenTxid& gtxid, NodeId peer, bool preferred, std::chrono::microseconds reqtime,
-                 SequenceNumber sequence)
-        : m_txhash(gtxid.GetHash()), m_time(reqtime), m_peer(peer), m_sequence(sequence), m_preferred(preferred),
-          m_is_wtxid{gtxid.IsWtxid()} {}
+                 SequenceNumber sequence, Priority priority)
+        : m_txhash(gtxid.GetHash()), m_time(reqtime), m_peer(peer), m_priority(priority),
+          m_sequence(sequence), m_preferred(preferred), m_is_wtxid{gtxid.IsWtxid()} {}
 };
 
-//! Type alias for priorities.
-using Priority = uint64_t;
-
 /** A functor with embedded salt that computes priority of an announcement.
  *
  * Higher priorities are selected first.
@@ -164,14 +168,12 @@ struct ByPeerViewExtractor
 //   deleted.
 struct ByTxHash {};
 using ByTxHashView = std::tuple<const uint256&, State, Priority>;
-class ByTxHashViewExtractor {
-    const PriorityComputer& m_computer;
-public:
-    explicit ByTxHashViewExtractor(const PriorityComputer& computer) : m_computer(computer) {}
+struct ByTxHashViewExtractor
+{
     using result_type = ByTxHashView;
     result_type operator()(const Announcement& ann) const
     {
-        const Priority prio = (ann.GetState() == State::CANDIDATE_READY) ? m_computer(ann) : 0;
+        const Priority prio = (ann.GetState() == State::CANDIDATE_READY) ? ann.m_priority : 0;
         return ByTxHashView{ann.m_txhash, ann.GetState(), prio};
     }
 };
@@ -415,9 +417,7 @@ private:
             // already.
             Modify<ByTxHash>(it, [](Announcement& ann){ ann.SetState(State::CANDIDATE_BEST); });
         } else if (it_next->GetState() == State::CANDIDATE_BEST) {
-            Priority priority_old = m_computer(*it_next);
-            Priority priority_new = m_computer(*it);
-            if (priority_new > priority_old) {
+            if (it->m_priority > it_next->m_priority) {
                 // There is a CANDIDATE_BEST announcement already, but this one is better.
                 Modify<ByTxHash>(it_next, [](Announcement& ann){ ann.SetState(State::CANDIDATE_READY); });
                 Modify<ByTxHash>(it, [](Announcement& ann){ ann.SetState(State::CANDIDATE_BEST); });
@@ -522,16 +522,9 @@ private:
     }
 
 public:
-    explicit Impl(bool deterministic) :
-        m_computer(deterministic),
-        // Explicitly initialize m_index as we need to pass a reference to m_computer to ByTxHashViewExtractor.
-        m_index(boost::make_tuple(
-            boost::make_tuple(ByPeerViewExtractor(), std::less<ByPeerView>()),
-            boost::make_tuple(ByTxHashViewExtractor(m_computer), std::less<ByTxHashView>()),
-            boost::make_tuple(ByTimeViewExtractor(), std::less<ByTimeView>())
-        )) {}
-
-    // Disable copying and assigning (a default copy won't work due the stateful ByTxHashViewExtractor).
+    explicit Impl(bool deterministic) : m_computer(deterministic) {}
+
+    // Disable copying and assigning (the data structure is only ever owned by a single tracker).
     Impl(const Impl&) = delete;
     Impl& operator=(const Impl&) = delete;
 
@@ -602,7 +595,8 @@ public:
         // Try creating the announcement with CANDIDATE_DELAYED state (which will fail due to the uniqueness
         // of the ByPeer index if a non-CANDIDATE_BEST announcement already exists with the same txhash and peer).
         // Bail out in that case.
-        auto ret = m_index.get<ByPeer>().emplace(gtxid, peer, preferred, reqtime, m_current_sequence);
+        auto ret = m_index.get<ByPeer>().emplace(gtxid, peer, preferred, reqtime, m_current_sequence,
+                                                 m_computer(gtxid.GetHash(), peer, preferred));
         if (!ret.second) return;
 
         // Update accounting metadata.
@@ -101,6 +101,16 @@ void UniValue::setObject()
     typ = VOBJ;
 }
 
+void UniValue::reserve(size_t n)
+{
+    if (typ == VOBJ) {
+        keys.reserve(n);
+    }
+    if (typ == VOBJ || typ == VARR) {
+        values.reserve(n);
+    }
+}
+
 void UniValue::push_back(UniValue val)
 {
     checkType(VARR);
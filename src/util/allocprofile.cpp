@@ -0,0 +1,23 @@
+// Copyright (c) 2024-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/allocprofile.h>
+
+#include <logging.h>
+
+#include <string>
+
+namespace alloc_profile {
+void LogStats()
+{
+    std::string line;
+    for (std::size_t i = 0; i < TAG_NAMES.size(); ++i) {
+        if (!line.empty()) line += ' ';
+        line += strprintf("%s: count=%d bytes=%d", TAG_NAMES[i],
+                          g_counters[i].count.load(std::memory_order_relaxed),
+                          g_counters[i].bytes.load(std::memory_order_relaxed));
+    }
+    LogDebug(BCLog::ALLOC, "allocations: %s\n", line);
+}
+} // namespace alloc_profile
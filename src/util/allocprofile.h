@@ -0,0 +1,80 @@
+// Copyright (c) 2024-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_ALLOCPROFILE_H
+#define BITCOIN_UTIL_ALLOCPROFILE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/** Lightweight counters for hot-path buffer allocations.
+ *
+ * Instrumented call sites record the allocation of a working buffer under a
+ * subsystem tag; the cumulative counters are reported periodically under
+ * -debug=alloc and through getmemoryinfo, so allocation-rate regressions can
+ * be spotted without attaching an external heap profiler. Only deliberately
+ * instrumented buffers are counted, not every malloc.
+ *
+ * Counts accumulate in thread-local storage and are flushed to the global
+ * counters in batches, so recording on a hot path (e.g. per TensHash layer
+ * buffer, with many hashing threads) never contends on a shared cache line.
+ * The published totals may consequently lag by up to one unflushed batch per
+ * thread.
+ */
+namespace alloc_profile {
+
+enum class Tag : std::size_t {
+    POW,  //!< TensHash working buffers and arenas
+    NET,  //!< serialized P2P message payloads
+    HTTP, //!< HTTP/RPC reply bodies
+};
+inline constexpr std::array<std::string_view, 3> TAG_NAMES{"pow", "net", "http"};
+
+struct TagCounters {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> bytes{0};
+};
+inline std::array<TagCounters, TAG_NAMES.size()> g_counters;
+
+namespace detail {
+struct LocalCounters {
+    uint64_t count{0};
+    uint64_t bytes{0};
+};
+inline thread_local std::array<LocalCounters, TAG_NAMES.size()> t_counters;
+inline thread_local uint32_t t_unflushed{0};
+
+//! Number of records a thread accumulates before publishing them.
+inline constexpr uint32_t FLUSH_INTERVAL{1024};
+} // namespace detail
+
+inline void Flush() noexcept
+{
+    for (std::size_t i = 0; i < TAG_NAMES.size(); ++i) {
+        detail::LocalCounters& local{detail::t_counters[i]};
+        if (local.count == 0) continue;
+        g_counters[i].count.fetch_add(local.count, std::memory_order_relaxed);
+        g_counters[i].bytes.fetch_add(local.bytes, std::memory_order_relaxed);
+        local = {};
+    }
+    detail::t_unflushed = 0;
+}
+
+inline void Record(Tag tag, std::size_t bytes) noexcept
+{
+    detail::LocalCounters& local{detail::t_counters[static_cast<std::size_t>(tag)]};
+    ++local.count;
+    local.bytes += bytes;
+    if (++detail::t_unflushed >= detail::FLUSH_INTERVAL) Flush();
+}
+
+/** Log one BCLog::ALLOC line with the cumulative per-tag counters. */
+void LogStats();
+
+} // namespace alloc_profile
+
+#endif // BITCOIN_UTIL_ALLOCPROFILE_H
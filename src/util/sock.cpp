@@ -13,6 +13,10 @@
 
 #include <memory>
 #include <stdexcept>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 #include <string>
 
 #ifdef USE_POLL
@@ -419,6 +423,102 @@ bool Sock::operator==(SOCKET s) const
     return m_socket == s;
 };
 
+#ifdef __linux__
+
+EpollSocketEvents::EpollSocketEvents() : m_epoll_fd{epoll_create1(EPOLL_CLOEXEC)}
+{
+    if (m_epoll_fd == -1) {
+        LogPrintf("epoll_create1 failed, falling back to poll: %s\n", SysErrorString(errno));
+    }
+}
+
+EpollSocketEvents::~EpollSocketEvents()
+{
+    if (m_epoll_fd != -1) close(m_epoll_fd);
+}
+
+bool EpollSocketEvents::WaitMany(std::chrono::milliseconds timeout, Sock::EventsPerSock& events_per_sock)
+{
+    if (m_epoll_fd == -1) return false;
+
+    struct Entry {
+        const Sock* sock;
+        Sock::Events* events;
+    };
+    std::unordered_map<SOCKET, Entry> by_fd;
+    by_fd.reserve(events_per_sock.size());
+    for (auto& [sock, events] : events_per_sock) {
+        by_fd.emplace(sock->m_socket, Entry{sock.get(), &events});
+    }
+
+    // Deregister sockets that are gone (or whose fd was closed and reused by
+    // a different Sock object since the last call).
+    for (auto it{m_registered.begin()}; it != m_registered.end();) {
+        const auto sock{it->second.first.lock()};
+        const auto found{by_fd.find(it->first)};
+        if (!sock || found == by_fd.end() || found->second.sock != sock.get()) {
+            // A registration is auto-removed when its socket closes; a live
+            // socket that merely left the interest set must be removed
+            // explicitly. Failure (EBADF/ENOENT) is fine either way.
+            struct epoll_event ev{};
+            epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->first, &ev);
+            it = m_registered.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Register new sockets and update changed interests.
+    for (auto& [sock, events] : events_per_sock) {
+        const SOCKET fd{sock->m_socket};
+        const auto it{m_registered.find(fd)};
+        if (it != m_registered.end() && it->second.second == events.requested) continue;
+
+        struct epoll_event ev{};
+        if (events.requested & Sock::RECV) ev.events |= EPOLLIN;
+        if (events.requested & Sock::SEND) ev.events |= EPOLLOUT;
+        ev.data.fd = fd;
+        if (epoll_ctl(m_epoll_fd, it == m_registered.end() ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &ev) == -1) {
+            // Not a real/pollable descriptor (e.g. a mocked socket in tests):
+            // have the caller wait through the generic Sock::WaitMany().
+            if (it != m_registered.end()) m_registered.erase(it);
+            return false;
+        }
+        m_registered[fd] = {std::weak_ptr<const Sock>{sock}, events.requested};
+    }
+
+    for (auto& [sock, events] : events_per_sock) {
+        events.occurred = 0;
+    }
+
+    std::vector<struct epoll_event> ready(std::max<size_t>(events_per_sock.size(), 1));
+    const int n{epoll_wait(m_epoll_fd, ready.data(), ready.size(), count_milliseconds(timeout))};
+    if (n == -1) {
+        return errno == EINTR; // treated like a timeout: all occurred are 0
+    }
+    for (int i{0}; i < n; ++i) {
+        const auto it{by_fd.find(ready[i].data.fd)};
+        if (it == by_fd.end()) continue;
+        if (ready[i].events & EPOLLIN) it->second.events->occurred |= Sock::RECV;
+        if (ready[i].events & EPOLLOUT) it->second.events->occurred |= Sock::SEND;
+        if (ready[i].events & (EPOLLERR | EPOLLHUP)) it->second.events->occurred |= Sock::ERR;
+    }
+
+    return true;
+}
+
+#else
+
+EpollSocketEvents::EpollSocketEvents() = default;
+EpollSocketEvents::~EpollSocketEvents() = default;
+
+bool EpollSocketEvents::WaitMany(std::chrono::milliseconds, Sock::EventsPerSock&)
+{
+    return false;
+}
+
+#endif // __linux__
+
 std::string NetworkErrorString(int err)
 {
 #if defined(WIN32)
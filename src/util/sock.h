@@ -279,6 +279,56 @@ private:
      * Close `m_socket` if it is not `INVALID_SOCKET`.
      */
     void Close();
+
+    //! Needs `m_socket` to register descriptors with the kernel.
+    friend class EpollSocketEvents;
+};
+
+/**
+ * Persistent socket event engine backed by epoll(7) on Linux.
+ *
+ * `Sock::WaitMany()` hands the kernel the full interest set on every call,
+ * which costs O(sockets) syscall payload per event-loop iteration. This
+ * engine keeps a long-lived epoll instance and only issues `epoll_ctl(2)`
+ * when a socket appears, disappears, or changes its requested events, so
+ * steady-state iterations are a single `epoll_wait(2)` returning only the
+ * active sockets.
+ *
+ * Level-triggered mode is used deliberately: the net event loop services at
+ * most one receive/send per socket per iteration and relies on readiness
+ * being re-reported, which edge-triggered registration would break.
+ *
+ * On platforms without epoll, or whenever registration fails (e.g. under
+ * mocked sockets in tests), `WaitMany()` returns false and the caller is
+ * expected to fall back to `Sock::WaitMany()`.
+ */
+class EpollSocketEvents
+{
+public:
+    EpollSocketEvents();
+    ~EpollSocketEvents();
+    EpollSocketEvents(const EpollSocketEvents&) = delete;
+    EpollSocketEvents& operator=(const EpollSocketEvents&) = delete;
+
+    /** Whether an epoll instance could be created. */
+    bool IsUsable() const { return m_epoll_fd != -1; }
+
+    /**
+     * Same semantics as `Sock::WaitMany()`. Registrations from previous calls
+     * are reconciled against `events_per_sock`: sockets no longer present are
+     * deregistered, new or changed ones are (re)registered.
+     * @return false if the engine is unusable or a syscall failed; the caller
+     * should then wait via `Sock::WaitMany()` instead.
+     */
+    [[nodiscard]] bool WaitMany(std::chrono::milliseconds timeout, Sock::EventsPerSock& events_per_sock);
+
+private:
+    /** epoll instance, or -1 on platforms without epoll. */
+    int m_epoll_fd{-1};
+    /** Interest currently registered with the kernel, per file descriptor.
+     *  The weak_ptr detects a closed-and-reused descriptor: a different Sock
+     *  under a known fd means the old registration died with its socket. */
+    std::unordered_map<SOCKET, std::pair<std::weak_ptr<const Sock>, Sock::Event>> m_registered;
 };
 
 /** Return readable error string for a network error code */
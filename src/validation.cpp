@@ -65,14 +65,19 @@
 #include <validationinterface.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <deque>
+#include <future>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <span>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -112,6 +117,8 @@ const std::vector<std::string> CHECKLEVEL_DOC {
 static constexpr int PRUNE_LOCK_BUFFER{10};
 
 TRACEPOINT_SEMAPHORE(validation, block_connected);
+TRACEPOINT_SEMAPHORE(validation, block_connect_stages);
+TRACEPOINT_SEMAPHORE(validation, connect_tip_stages);
 TRACEPOINT_SEMAPHORE(utxocache, flush);
 TRACEPOINT_SEMAPHORE(mempool, replaced);
 TRACEPOINT_SEMAPHORE(mempool, rejected);
@@ -663,10 +670,18 @@ private:
         PrecomputedTransactionData m_precomputed_txdata;
     };
 
+    // Run the checks that depend only on the transaction itself and on
+    // immutable mempool options: consensus encoding rules, the coinbase
+    // prohibition and standardness. Requires no locks, so malformed or
+    // nonstandard submissions are rejected before contending with mempool
+    // readers on m_pool.cs.
+    bool ContextFreeChecks(Workspace& ws);
+
     // Run the policy checks on a given transaction, excluding any script checks.
     // Looks up inputs, calculates feerate, considers replacement, evaluates
     // package limits, etc. As this function can be invoked for "free" by a peer,
     // only tests that are fast should be done here (to avoid CPU DoS).
+    // ContextFreeChecks() must have passed for the transaction already.
     bool PreChecks(ATMPArgs& args, Workspace& ws) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_pool.cs);
 
     // Run checks for mempool replace-by-fee, only used in AcceptSingleTransaction.
@@ -681,7 +696,10 @@ private:
 
     // Run the script checks using our policy flags. As this can be slow, we should
     // only invoke this on transactions that have otherwise passed policy checks.
-    bool PolicyScriptChecks(const ATMPArgs& args, Workspace& ws) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_pool.cs);
+    // With allow_parallel, the script executions are dispatched to the check
+    // queue worker pool; pass false when the caller already holds a
+    // CCheckQueueControl (the control mutex is not recursive).
+    bool PolicyScriptChecks(const ATMPArgs& args, Workspace& ws, bool allow_parallel = true) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_pool.cs);
 
     // Re-run the script checks, using consensus flags, and try to cache the
     // result in the scriptcache. This should be done after
@@ -764,20 +782,9 @@ private:
     }
 };
 
-bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
+bool MemPoolAccept::ContextFreeChecks(Workspace& ws)
 {
-    AssertLockHeld(cs_main);
-    AssertLockHeld(m_pool.cs);
-    const CTransactionRef& ptx = ws.m_ptx;
     const CTransaction& tx = *ws.m_ptx;
-    const Txid& hash = ws.m_hash;
-
-    // Copy/alias what we need out of args
-    const int64_t nAcceptTime = args.m_accept_time;
-    const bool bypass_limits = args.m_bypass_limits;
-    std::vector<COutPoint>& coins_to_uncache = args.m_coins_to_uncache;
-
-    // Alias what we need out of ws
     TxValidationState& state = ws.m_state;
 
     if (!CheckTransaction(tx, state)) {
@@ -795,9 +802,32 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
     }
 
     // Transactions smaller than 65 non-witness bytes are not relayed to mitigate CVE-2017-12842.
-    if (::GetSerializeSize(TX_NO_WITNESS(tx)) < MIN_STANDARD_TX_NONWITNESS_SIZE)
+    if (tx.GetStrippedSize() < MIN_STANDARD_TX_NONWITNESS_SIZE)
         return state.Invalid(TxValidationResult::TX_NOT_STANDARD, "tx-size-small");
 
+    return true;
+}
+
+bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
+{
+    AssertLockHeld(cs_main);
+    AssertLockHeld(m_pool.cs);
+    const CTransactionRef& ptx = ws.m_ptx;
+    const CTransaction& tx = *ws.m_ptx;
+    const Txid& hash = ws.m_hash;
+
+    // Copy/alias what we need out of args
+    const int64_t nAcceptTime = args.m_accept_time;
+    const bool bypass_limits = args.m_bypass_limits;
+    std::vector<COutPoint>& coins_to_uncache = args.m_coins_to_uncache;
+
+    // Alias what we need out of ws
+    TxValidationState& state = ws.m_state;
+
+    // The transaction-only checks (consensus encoding, coinbase,
+    // standardness) already ran in ContextFreeChecks() before the mempool
+    // lock was taken.
+
     // Only accept nLockTime-using transactions that can be mined in the next
     // block; we don't want our mempool filled up with transactions that can't
     // be mined yet.
@@ -1224,7 +1254,7 @@ bool MemPoolAccept::PackageMempoolChecks(const std::vector<CTransactionRef>& txn
     return true;
 }
 
-bool MemPoolAccept::PolicyScriptChecks(const ATMPArgs& args, Workspace& ws)
+bool MemPoolAccept::PolicyScriptChecks(const ATMPArgs& args, Workspace& ws, bool allow_parallel)
 {
     AssertLockHeld(cs_main);
     AssertLockHeld(m_pool.cs);
@@ -1233,6 +1263,24 @@ bool MemPoolAccept::PolicyScriptChecks(const ATMPArgs& args, Workspace& ws)
 
     constexpr unsigned int scriptVerifyFlags = STANDARD_SCRIPT_VERIFY_FLAGS;
 
+    // With worker threads available, dispatch the script executions to the
+    // check queue pool blocks use, so a transaction with many inputs does not
+    // verify them all on the calling (message-handler) thread. Holding
+    // cs_main guarantees the queue is not in use by block connection. On
+    // failure, fall through to the serial path below, which reproduces the
+    // canonical error including the witness-stripped distinction.
+    if (allow_parallel && m_active_chainstate.m_chainman.GetCheckQueue().HasThreads()) {
+        std::vector<CScriptCheck> vChecks;
+        // Cannot fail when the checks are deferred rather than executed.
+        CheckInputScripts(tx, state, m_view, scriptVerifyFlags, /*cacheSigStore=*/true,
+                          /*cacheFullScriptStore=*/false, ws.m_precomputed_txdata, GetValidationCache(), &vChecks);
+        CCheckQueueControl<CScriptCheck> control(&m_active_chainstate.m_chainman.GetCheckQueue());
+        control.Add(std::move(vChecks));
+        if (!control.Complete().has_value()) {
+            return true;
+        }
+    }
+
     // Check input scripts and signatures.
     // This is done last to help prevent CPU exhaustion denial-of-service attacks.
     if (!CheckInputScripts(tx, state, m_view, scriptVerifyFlags, true, false, ws.m_precomputed_txdata, GetValidationCache())) {
@@ -1282,6 +1330,12 @@ bool MemPoolAccept::ConsensusScriptChecks(const ATMPArgs& args, Workspace& ws)
         return Assume(false);
     }
 
+    // Record the flags on the prospective mempool entry, so that ConnectBlock
+    // can skip re-verifying these scripts if the transaction is mined with
+    // identical flags (even after the script execution cache entry has been
+    // evicted).
+    ws.m_tx_handle->UpdateValidatedScriptFlags(currentBlockScriptVerifyFlags);
+
     return true;
 }
 
@@ -1415,11 +1469,16 @@ bool MemPoolAccept::SubmitPackage(const ATMPArgs& args, std::vector<Workspace>&
 MempoolAcceptResult MemPoolAccept::AcceptSingleTransaction(const CTransactionRef& ptx, ATMPArgs& args)
 {
     AssertLockHeld(cs_main);
-    LOCK(m_pool.cs); // mempool "read lock" (held through m_pool.m_opts.signals->TransactionAddedToMempool())
 
     Workspace ws(ptx);
     const std::vector<Wtxid> single_wtxid{ws.m_ptx->GetWitnessHash()};
 
+    // Screen out malformed and nonstandard transactions before contending
+    // with mempool readers for the lock below.
+    if (!ContextFreeChecks(ws)) return MempoolAcceptResult::Failure(ws.m_state);
+
+    LOCK(m_pool.cs); // mempool "read lock" (held through m_pool.m_opts.signals->TransactionAddedToMempool())
+
     if (!PreChecks(args, ws)) {
         if (ws.m_state.GetResult() == TxValidationResult::TX_RECONSIDERABLE) {
             // Failed for fee reasons. Provide the effective feerate and which tx was included.
@@ -1439,7 +1498,13 @@ MempoolAcceptResult MemPoolAccept::AcceptSingleTransaction(const CTransactionRef
 
     if (m_pool.m_opts.require_standard) {
         Txid dummy_txid;
-        if (!CheckEphemeralSpends(/*package=*/{ptx}, m_pool.m_opts.dust_relay_feerate, m_pool, ws.m_state, dummy_txid)) {
+        // Reuse the ancestor set computed in PreChecks, so the dust checks
+        // don't re-query the mempool for each input.
+        AncestorTxRefs ancestor_txs;
+        for (const auto& ancestor_it : ws.m_ancestors) {
+            ancestor_txs.emplace(ancestor_it->GetTx().GetHash(), ancestor_it->GetSharedTx());
+        }
+        if (!CheckEphemeralSpends(/*package=*/{ptx}, m_pool.m_opts.dust_relay_feerate, m_pool, ws.m_state, dummy_txid, &ancestor_txs)) {
             return MempoolAcceptResult::Failure(ws.m_state);
         }
     }
@@ -1496,6 +1561,18 @@ MempoolAcceptResult MemPoolAccept::AcceptSingleTransaction(const CTransactionRef
                  ws.m_vsize - static_cast<int>(m_subpackage.m_conflicting_size));
     }
 
+    if (m_pool.IsTracing()) {
+        // The spent coins are still cached in m_view from PreChecks; record
+        // them so the trace is self-contained and replayable without the
+        // capturing node's chainstate.
+        std::vector<Coin> spent_coins;
+        spent_coins.reserve(ws.m_ptx->vin.size());
+        for (const CTxIn& txin : ws.m_ptx->vin) {
+            spent_coins.push_back(m_view.AccessCoin(txin.prevout));
+        }
+        m_pool.TraceAcceptedTransaction(ws.m_ptx, spent_coins);
+    }
+
     return MempoolAcceptResult::Success(std::move(m_subpackage.m_replaced_transactions), ws.m_vsize, ws.m_base_fees,
                                         effective_feerate, single_wtxid);
 }
@@ -1514,6 +1591,16 @@ PackageMempoolAcceptResult MemPoolAccept::AcceptMultipleTransactions(const std::
                    [](const auto& tx) { return Workspace(tx); });
     std::map<uint256, MempoolAcceptResult> results;
 
+    // The per-transaction context-free checks can likewise run before the
+    // mempool lock.
+    for (Workspace& ws : workspaces) {
+        if (!ContextFreeChecks(ws)) {
+            package_state.Invalid(PackageValidationResult::PCKG_TX, "transaction failed");
+            results.emplace(ws.m_ptx->GetWitnessHash(), MempoolAcceptResult::Failure(ws.m_state));
+            return PackageMempoolAcceptResult(package_state, std::move(results));
+        }
+    }
+
     LOCK(m_pool.cs);
 
     // Do all PreChecks first and fail fast to avoid running expensive script checks when unnecessary.
@@ -1593,16 +1680,60 @@ PackageMempoolAcceptResult MemPoolAccept::AcceptMultipleTransactions(const std::
     if (m_pool.m_opts.require_standard) {
         TxValidationState child_state;
         Txid child_txid;
-        if (!CheckEphemeralSpends(txns, m_pool.m_opts.dust_relay_feerate, m_pool, child_state, child_txid)) {
+        // Reuse the per-workspace ancestor sets computed in PreChecks, so the
+        // dust checks don't re-query the mempool for each input.
+        AncestorTxRefs ancestor_txs;
+        for (const Workspace& ws : workspaces) {
+            for (const auto& ancestor_it : ws.m_ancestors) {
+                ancestor_txs.emplace(ancestor_it->GetTx().GetHash(), ancestor_it->GetSharedTx());
+            }
+        }
+        if (!CheckEphemeralSpends(txns, m_pool.m_opts.dust_relay_feerate, m_pool, child_state, child_txid, &ancestor_txs)) {
             package_state.Invalid(PackageValidationResult::PCKG_TX, "unspent-dust");
             results.emplace(child_txid, MempoolAcceptResult::Failure(child_state));
             return PackageMempoolAcceptResult(package_state, std::move(results));
         }
     }
 
+    // Check input scripts for all package members at once. With worker
+    // threads available, the script executions of sibling transactions are
+    // deferred onto the script check queue and run in parallel, so package
+    // accept latency no longer grows linearly with the member count. Holding
+    // cs_main guarantees the queue is not in use by block connection. The
+    // script execution cache lookups stay on this thread, and the deferred
+    // checks only write the internally synchronized signature cache.
+    bool scripts_verified{false};
+    if (m_active_chainstate.m_chainman.GetCheckQueue().HasThreads()) {
+        CCheckQueueControl<CScriptCheck> control(&m_active_chainstate.m_chainman.GetCheckQueue());
+        for (Workspace& ws : workspaces) {
+            std::vector<CScriptCheck> vChecks;
+            // Cannot fail when the checks are deferred rather than executed.
+            CheckInputScripts(*ws.m_ptx, ws.m_state, m_view, STANDARD_SCRIPT_VERIFY_FLAGS, /*cacheSigStore=*/true,
+                              /*cacheFullScriptStore=*/false, ws.m_precomputed_txdata, GetValidationCache(), &vChecks);
+            control.Add(std::move(vChecks));
+        }
+        if (control.Complete().has_value()) {
+            // At least one input script is invalid. Re-run the serial
+            // per-transaction checks to attribute the failure to the right
+            // transaction with the canonical error (including the
+            // witness-stripped distinction); script checks are
+            // deterministic, so the re-run fails the same way. The batch
+            // control is still held, so the re-run must stay serial.
+            for (Workspace& ws : workspaces) {
+                if (!PolicyScriptChecks(args, ws, /*allow_parallel=*/false)) {
+                    package_state.Invalid(PackageValidationResult::PCKG_TX, "transaction failed");
+                    results.emplace(ws.m_ptx->GetWitnessHash(), MempoolAcceptResult::Failure(ws.m_state));
+                    return PackageMempoolAcceptResult(package_state, std::move(results));
+                }
+            }
+            Assume(false);
+        }
+        scripts_verified = true;
+    }
+
     for (Workspace& ws : workspaces) {
         ws.m_package_feerate = package_feerate;
-        if (!PolicyScriptChecks(args, ws)) {
+        if (!scripts_verified && !PolicyScriptChecks(args, ws)) {
             // Exit early to avoid doing pointless work. Update the failed tx result; the rest are unfinished.
             package_state.Invalid(PackageValidationResult::PCKG_TX, "transaction failed");
             results.emplace(ws.m_ptx->GetWitnessHash(), MempoolAcceptResult::Failure(ws.m_state));
@@ -2000,12 +2131,20 @@ void Chainstate::InitCoinsDB(
     m_coinsdb_cache_size_bytes = cache_size_bytes;
 }
 
+//! Below this coinstip cache size, incremental rehashes of the coins map are
+//! too small to stall block connection; skip pre-sizing so small (notably
+//! test) caches keep their minimal footprint.
+static constexpr size_t MIN_COINS_CACHE_RESERVE_BYTES{64 << 20};
+
 void Chainstate::InitCoinsCache(size_t cache_size_bytes)
 {
     AssertLockHeld(::cs_main);
     assert(m_coins_views != nullptr);
     m_coinstip_cache_size_bytes = cache_size_bytes;
     m_coins_views->InitCache();
+    if (cache_size_bytes >= MIN_COINS_CACHE_RESERVE_BYTES) {
+        CoinsTip().Reserve(cache_size_bytes);
+    }
 }
 
 // Note that though this is marked const, we may end up modifying `m_cached_finished_ibd`, which
@@ -2092,7 +2231,7 @@ void Chainstate::InvalidBlockFound(CBlockIndex* pindex, const BlockValidationSta
     if (state.GetResult() != BlockValidationResult::BLOCK_MUTATED) {
         pindex->nStatus |= BLOCK_FAILED_VALID;
         m_chainman.m_failed_blocks.insert(pindex);
-        m_blockman.m_dirty_blockindex.insert(pindex);
+        m_blockman.MarkBlockIndexDirty(pindex);
         setBlockIndexCandidates.erase(pindex);
         InvalidChainFound(pindex);
     }
@@ -2295,16 +2434,20 @@ int ApplyTxInUndo(Coin&& undo, CCoinsViewCache& view, const COutPoint& out)
 
 /** Undo the effects of this block (with given index) on the UTXO set represented by coins.
  *  When FAILED is returned, view is left in an indeterminate state. */
-DisconnectResult Chainstate::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view)
+DisconnectResult Chainstate::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, CBlockUndo* undo)
 {
     AssertLockHeld(::cs_main);
     bool fClean = true;
 
-    CBlockUndo blockUndo;
-    if (!m_blockman.ReadBlockUndo(blockUndo, *pindex)) {
-        LogError("DisconnectBlock(): failure reading undo data\n");
-        return DISCONNECT_FAILED;
+    CBlockUndo read_undo;
+    if (!undo) {
+        if (!m_blockman.ReadBlockUndo(read_undo, *pindex)) {
+            LogError("DisconnectBlock(): failure reading undo data\n");
+            return DISCONNECT_FAILED;
+        }
+        undo = &read_undo;
     }
+    CBlockUndo& blockUndo{*undo};
 
     if (blockUndo.vtxundo.size() + 1 != block.vtx.size()) {
         LogError("DisconnectBlock(): block and undo data inconsistent\n");
@@ -2433,6 +2576,51 @@ static unsigned int GetBlockScriptFlags(const CBlockIndex& block_index, const Ch
     return flags;
 }
 
+//! Blocks spending fewer inputs than this are connected without warming the
+//! coins backend first; the thread spawn would cost more than the misses.
+static constexpr size_t MIN_PREFETCH_INPUTS{128};
+
+/** Warm the coins database caches for all inputs spent by a block.
+ *
+ * The serial loop in ConnectBlock resolves every prevout through
+ * CCoinsViewCache, and on a cold cache most of its time is spent waiting on
+ * leveldb reads one input at a time. CCoinsViewCache itself is not thread
+ * safe (every lookup mutates the cache map), so the per-input work cannot be
+ * moved into worker threads directly; instead we issue the same reads
+ * against the thread-safe database backend ahead of time, so the serial
+ * cache misses that follow are served from leveldb's block cache and the OS
+ * page cache rather than disk. Prevouts created earlier in the same block
+ * simply miss in the database, which is harmless.
+ */
+static void PrefetchInputCoins(const CBlock& block, const CCoinsView& db)
+{
+    std::vector<const COutPoint*> prevouts;
+    for (const auto& tx : block.vtx) {
+        if (tx->IsCoinBase()) continue;
+        for (const CTxIn& txin : tx->vin) {
+            prevouts.push_back(&txin.prevout);
+        }
+    }
+    if (prevouts.size() < MIN_PREFETCH_INPUTS) return;
+
+    const size_t num_threads{std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4)};
+    std::atomic<size_t> cursor{0};
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&] {
+            static constexpr size_t CHUNK{16};
+            size_t base;
+            while ((base = cursor.fetch_add(CHUNK, std::memory_order_relaxed)) < prevouts.size()) {
+                const size_t end{std::min(base + CHUNK, prevouts.size())};
+                for (size_t i = base; i < end; ++i) {
+                    (void)db.GetCoin(*prevouts[i]);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+}
 
 /** Apply the effects of this block (with given index) on the UTXO set represented by coins.
  *  Validity checks that depend on the UTXO set are also done; ConnectBlock()
@@ -2621,6 +2809,26 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     // Get the script flags for this block
     unsigned int flags{GetBlockScriptFlags(*pindex, m_chainman)};
 
+    // Transactions whose input scripts were already fully validated on
+    // mempool acceptance against the same flags don't need their scripts
+    // checked again. The wtxid must match so a tx mined with a different
+    // witness than the one we validated is still checked, and the flags must
+    // be identical (they may differ around a soft-fork activation). This
+    // mirrors the script execution cache's (wtxid, flags) key, but survives
+    // cache eviction under large mempools.
+    std::vector<bool> prevalidated(block.vtx.size(), false);
+    if (fScriptChecks && m_mempool) {
+        LOCK(m_mempool->cs);
+        for (unsigned int i = 1; i < block.vtx.size(); i++) {
+            const CTransaction& tx{*block.vtx[i]};
+            const CTxMemPoolEntry* entry{m_mempool->GetEntry(tx.GetHash())};
+            if (entry && entry->GetTx().GetWitnessHash() == tx.GetWitnessHash() &&
+                entry->GetValidatedScriptFlags() == std::optional<unsigned int>{flags}) {
+                prevalidated[i] = true;
+            }
+        }
+    }
+
     const auto time_2{SteadyClock::now()};
     m_chainman.time_forks += time_2 - time_1;
     LogDebug(BCLog::BENCH, "    - Fork checks: %.2fms [%.2fs (%.2fms/blk)]\n",
@@ -2628,6 +2836,10 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
              Ticks<SecondsDouble>(m_chainman.time_forks),
              Ticks<MillisecondsDouble>(m_chainman.time_forks) / m_chainman.num_blocks_total);
 
+    // Warm the database caches for this block's inputs before the serial
+    // per-transaction loop below starts resolving them one at a time.
+    PrefetchInputCoins(block, CoinsDB());
+
     CBlockUndo blockundo;
 
     // Precomputed transaction data pointers must not be invalidated
@@ -2698,7 +2910,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
             std::vector<CScriptCheck> vChecks;
             bool fCacheResults = fJustCheck; /* Don't cache results if we're actually connecting blocks (still consult the cache, though) */
             TxValidationState tx_state;
-            if (fScriptChecks && !CheckInputScripts(tx, tx_state, view, flags, fCacheResults, fCacheResults, txsdata[i], m_chainman.m_validation_cache, parallel_script_checks ? &vChecks : nullptr)) {
+            if (fScriptChecks && !prevalidated[i] && !CheckInputScripts(tx, tx_state, view, flags, fCacheResults, fCacheResults, txsdata[i], m_chainman.m_validation_cache, parallel_script_checks ? &vChecks : nullptr)) {
                 // Any transaction validation failure in ConnectBlock is a block consensus failure
                 state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
                               tx_state.GetRejectReason(), tx_state.GetDebugMessage());
@@ -2721,6 +2933,22 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
              Ticks<SecondsDouble>(m_chainman.time_connect),
              Ticks<MillisecondsDouble>(m_chainman.time_connect) / m_chainman.num_blocks_total);
 
+    // The undo data is complete at this point; overlap its serialization and
+    // checksumming with the wait for the parallel script checks below.
+    DataStream undo_data{};
+    uint256 undo_checksum;
+    std::thread undo_serializer;
+    if (!fJustCheck && pindex->GetUndoPos().IsNull()) {
+        undo_serializer = std::thread([&] {
+            undo_data.reserve(GetSerializeSize(blockundo));
+            undo_data << blockundo;
+            HashWriter hasher{};
+            hasher << pindex->pprev->GetBlockHash();
+            hasher.write(undo_data);
+            undo_checksum = hasher.GetHash();
+        });
+    }
+
     CAmount blockReward = nFees + GetBlockSubsidy(pindex->nHeight, params.GetConsensus());
     if (block.vtx[0]->GetValueOut() > blockReward && state.IsValid()) {
         state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-cb-amount",
@@ -2732,6 +2960,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, strprintf("mandatory-script-verify-flag-failed (%s)", ScriptErrorString(parallel_result->first)), parallel_result->second);
     }
     if (!state.IsValid()) {
+        if (undo_serializer.joinable()) undo_serializer.join();
         LogInfo("Block validation error: %s", state.ToString());
         return false;
     }
@@ -2747,7 +2976,8 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         return true;
     }
 
-    if (!m_blockman.WriteBlockUndo(blockundo, state, *pindex)) {
+    if (undo_serializer.joinable()) undo_serializer.join();
+    if (!m_blockman.WriteBlockUndo(undo_data, undo_checksum, state, *pindex)) {
         return false;
     }
 
@@ -2760,7 +2990,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     if (!pindex->IsValid(BLOCK_VALID_SCRIPTS)) {
         pindex->RaiseValidity(BLOCK_VALID_SCRIPTS);
-        m_blockman.m_dirty_blockindex.insert(pindex);
+        m_blockman.MarkBlockIndexDirty(pindex);
     }
 
     // add this block to the view's block chain
@@ -2782,6 +3012,22 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         Ticks<std::chrono::nanoseconds>(time_5 - time_start)
     );
 
+    // Per-stage breakdown of the ConnectBlock() call, so external tooling can
+    // attribute block-connect latency without parsing BCLog::BENCH output.
+    // The script-verify stage only covers the wait for the parallel check
+    // queue; the serial portion of script checking is part of the connect
+    // stage.
+    TRACEPOINT(validation, block_connect_stages,
+        block_hash.data(),
+        pindex->nHeight,
+        Ticks<std::chrono::nanoseconds>(time_1 - time_start),
+        Ticks<std::chrono::nanoseconds>(time_2 - time_1),
+        Ticks<std::chrono::nanoseconds>(time_3 - time_2),
+        Ticks<std::chrono::nanoseconds>(time_4 - time_3),
+        Ticks<std::chrono::nanoseconds>(time_5 - time_4),
+        Ticks<std::chrono::nanoseconds>(time_6 - time_5)
+    );
+
     return true;
 }
 
@@ -2894,6 +3140,14 @@ bool Chainstate::FlushStateToDisk(
         bool fPeriodicWrite = mode == FlushStateMode::PERIODIC && nNow > m_last_write + DATABASE_WRITE_INTERVAL;
         // It's been very long since we flushed the cache. Do this infrequently, to optimize cache usage.
         bool fPeriodicFlush = mode == FlushStateMode::PERIODIC && nNow > m_last_flush + DATABASE_FLUSH_INTERVAL;
+        // Trickle the dirty coin set to disk on the same cadence as the block
+        // index write (which the crash-safety ordering requires anyway). Each
+        // sync then covers roughly one write interval's worth of dirty
+        // entries instead of letting them pile up for a single multi-minute
+        // flush that freezes the node. Skipped during IBD, where the cache
+        // exists to absorb short-lived coins and early writes would mostly be
+        // deleted again.
+        bool fPeriodicSync = fPeriodicWrite && !m_chainman.IsInitialBlockDownload();
         // Combine all conditions that result in a full cache flush.
         fDoFullFlush = (mode == FlushStateMode::ALWAYS) || fCacheLarge || fCacheCritical || fPeriodicFlush || fFlushForPrune;
         // Write blocks and block index to disk.
@@ -2921,16 +3175,28 @@ bool Chainstate::FlushStateToDisk(
                     return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to block index database."));
                 }
             }
-            // Finally remove any pruned files
+            // Finally queue any pruned files for removal. The unlink itself
+            // runs on a background task so multi-file deletes don't add
+            // latency to block connection.
             if (fFlushForPrune) {
-                LOG_TIME_MILLIS_WITH_CATEGORY("unlink pruned files", BCLog::BENCH);
+                LOG_TIME_MILLIS_WITH_CATEGORY("queue pruned files for unlink", BCLog::BENCH);
 
-                m_blockman.UnlinkPrunedFiles(setFilesToPrune);
+                // The files must not disappear before the block index that
+                // records them as pruned has landed on disk.
+                if (!m_blockman.WaitForBlockIndexWrite()) {
+                    return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to block index database."));
+                }
+                m_blockman.UnlinkPrunedFilesInBackground(setFilesToPrune);
             }
             m_last_write = nNow;
         }
         // Flush best chain related state. This can only be done if the blocks / block index write was also done.
-        if (fDoFullFlush && !CoinsTip().GetBestBlock().IsNull()) {
+        if ((fDoFullFlush || fPeriodicSync) && !CoinsTip().GetBestBlock().IsNull()) {
+            // The chainstate refers to block index entries, so the background
+            // block index write must have completed before the coins flush.
+            if (!m_blockman.WaitForBlockIndexWrite()) {
+                return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to block index database."));
+            }
             if (coins_mem_usage >= WARN_FLUSH_COINS_SIZE) LogWarning("Flushing large (%d GiB) UTXO set to disk, it may take several minutes", coins_mem_usage >> 30);
             LOG_TIME_MILLIS_WITH_CATEGORY(strprintf("write coins cache to disk (%d coins, %.2fKiB)",
                 coins_count, coins_mem_usage >> 10), BCLog::BENCH);
@@ -3057,7 +3323,7 @@ void Chainstate::UpdateTip(const CBlockIndex* pindexNew)
   * disconnectpool (note that the caller is responsible for mempool consistency
   * in any case).
   */
-bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool)
+bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool, std::shared_ptr<const CBlock> pblock, CBlockUndo* undo)
 {
     AssertLockHeld(cs_main);
     if (m_mempool) AssertLockHeld(m_mempool->cs);
@@ -3065,19 +3331,22 @@ bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTra
     CBlockIndex *pindexDelete = m_chain.Tip();
     assert(pindexDelete);
     assert(pindexDelete->pprev);
-    // Read block from disk.
-    std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
-    CBlock& block = *pblock;
-    if (!m_blockman.ReadBlock(block, *pindexDelete)) {
-        LogError("DisconnectTip(): Failed to read block\n");
-        return false;
+    // Read block from disk unless a read-ahead copy was handed in.
+    if (!pblock) {
+        auto read_block{std::make_shared<CBlock>()};
+        if (!m_blockman.ReadBlock(*read_block, *pindexDelete)) {
+            LogError("DisconnectTip(): Failed to read block\n");
+            return false;
+        }
+        pblock = std::move(read_block);
     }
+    const CBlock& block = *pblock;
     // Apply the block atomically to the chain state.
     const auto time_start{SteadyClock::now()};
     {
         CCoinsViewCache view(&CoinsTip());
         assert(view.GetBestBlock() == pindexDelete->GetBlockHash());
-        if (DisconnectBlock(block, pindexDelete, view) != DISCONNECT_OK) {
+        if (DisconnectBlock(block, pindexDelete, view, undo) != DISCONNECT_OK) {
             LogError("DisconnectTip(): DisconnectBlock %s failed\n", pindexDelete->GetBlockHash().ToString());
             return false;
         }
@@ -3254,6 +3523,19 @@ bool Chainstate::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew,
              Ticks<SecondsDouble>(m_chainman.time_total),
              Ticks<MillisecondsDouble>(m_chainman.time_total) / m_chainman.num_blocks_total);
 
+    // Per-stage breakdown of the ConnectTip() call. The read stage covers
+    // loading the block from disk (including the proof-of-work recheck done
+    // by ReadBlock) and is zero when a cached or read-ahead block was used.
+    TRACEPOINT(validation, connect_tip_stages,
+        pindexNew->GetBlockHash().data(),
+        pindexNew->nHeight,
+        Ticks<std::chrono::nanoseconds>(time_2 - time_1),
+        Ticks<std::chrono::nanoseconds>(time_3 - time_2),
+        Ticks<std::chrono::nanoseconds>(time_4 - time_3),
+        Ticks<std::chrono::nanoseconds>(time_5 - time_4),
+        Ticks<std::chrono::nanoseconds>(time_6 - time_5)
+    );
+
     // If we are the background validation chainstate, check to see if we are done
     // validating the snapshot (i.e. our tip has reached the snapshot's base block).
     if (this != &m_chainman.ActiveChainstate()) {
@@ -3307,7 +3589,7 @@ CBlockIndex* Chainstate::FindMostWorkChain()
                 while (pindexTest != pindexFailed) {
                     if (fFailedChain) {
                         pindexFailed->nStatus |= BLOCK_FAILED_CHILD;
-                        m_blockman.m_dirty_blockindex.insert(pindexFailed);
+                        m_blockman.MarkBlockIndexDirty(pindexFailed);
                     } else if (fMissingData) {
                         // If we're missing data, then add back to m_blocks_unlinked,
                         // so that if the block arrives in the future we can try adding
@@ -3358,8 +3640,50 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
     // Disconnect active blocks which are no longer in the best chain.
     bool fBlocksDisconnected = false;
     DisconnectedBlockTransactions disconnectpool{MAX_DISCONNECTED_TX_POOL_BYTES};
+    if (m_chain.Tip() && m_chain.Tip() != pindexFork) {
+        // The whole disconnect path is known as soon as the fork point is;
+        // ask the OS to start paging in its block and undo data right away.
+        constexpr int DISCONNECT_PREFETCH_MAX{128};
+        int depth{0};
+        for (const CBlockIndex* pindex = m_chain.Tip(); pindex != pindexFork && depth < DISCONNECT_PREFETCH_MAX; pindex = pindex->pprev, ++depth) {
+            m_blockman.PrefetchBlock(pindex->GetBlockPos());
+            m_blockman.PrefetchBlockUndo(pindex->GetUndoPos());
+        }
+    }
+    // While block N is being disconnected, a background task reads and
+    // deserializes block N-1 and its undo data. The loop below holds cs_main
+    // throughout, so the reader works purely from positions and hashes
+    // captured up front (the lock-free ReadBlock/ReadBlockUndo overloads).
+    struct DisconnectReadAhead {
+        std::shared_ptr<const CBlock> block;
+        std::unique_ptr<CBlockUndo> undo;
+    };
+    std::future<DisconnectReadAhead> disconnect_read_ahead;
+    auto start_disconnect_read_ahead = [&](const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
+        const FlatFilePos block_pos{pindex->GetBlockPos()};
+        const FlatFilePos undo_pos{pindex->GetUndoPos()};
+        const uint256 expected_hash{pindex->GetBlockHash()};
+        const uint256 prev_hash{pindex->pprev->GetBlockHash()};
+        disconnect_read_ahead = std::async(std::launch::async, [this, block_pos, undo_pos, expected_hash, prev_hash]() -> DisconnectReadAhead {
+            DisconnectReadAhead ret;
+            if (block_pos.IsNull()) return ret;
+            auto block{std::make_shared<CBlock>()};
+            if (!m_blockman.ReadBlock(*block, block_pos) || block->GetHash() != expected_hash) return ret;
+            ret.block = std::move(block);
+            if (undo_pos.IsNull()) return ret;
+            auto undo{std::make_unique<CBlockUndo>()};
+            if (m_blockman.ReadBlockUndo(*undo, undo_pos, prev_hash)) ret.undo = std::move(undo);
+            return ret;
+        });
+    };
     while (m_chain.Tip() && m_chain.Tip() != pindexFork) {
-        if (!DisconnectTip(state, &disconnectpool)) {
+        DisconnectReadAhead prefetched;
+        if (disconnect_read_ahead.valid()) prefetched = disconnect_read_ahead.get();
+        if (prefetched.block && prefetched.block->GetHash() != m_chain.Tip()->GetBlockHash()) prefetched = {};
+        if (const CBlockIndex* next{m_chain.Tip()->pprev}; next != pindexFork && next->pprev) {
+            start_disconnect_read_ahead(next);
+        }
+        if (!DisconnectTip(state, &disconnectpool, std::move(prefetched.block), prefetched.undo.get())) {
             // This is likely a fatal error, but keep the mempool consistent,
             // just in case. Only remove from the mempool in this case.
             MaybeUpdateMempoolForReorg(disconnectpool, false);
@@ -3390,9 +3714,39 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
         }
         nHeight = nTargetHeight;
 
-        // Connect new blocks.
-        for (CBlockIndex* pindexConnect : vpindexToConnect | std::views::reverse) {
-            if (!ConnectTip(state, pindexConnect, pindexConnect == pindexMostWork ? pblock : std::shared_ptr<const CBlock>(), connectTrace, disconnectpool)) {
+        // Connect new blocks. While block N is being connected, a background
+        // task reads, deserializes and PoW-checks block N+1 from disk
+        // (BlockManager::ReadBlock on a captured FlatFilePos takes no locks),
+        // so during IBD the disk read and the header PoW hash of the next
+        // block overlap with the UTXO application of the current one.
+        std::future<std::shared_ptr<const CBlock>> read_ahead;
+        auto start_read_ahead = [&](const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
+            const FlatFilePos pos{pindex->GetBlockPos()};
+            const uint256 expected_hash{pindex->GetBlockHash()};
+            read_ahead = std::async(std::launch::async, [this, pos, expected_hash]() -> std::shared_ptr<const CBlock> {
+                if (pos.IsNull()) return nullptr;
+                auto block{std::make_shared<CBlock>()};
+                if (!m_blockman.ReadBlock(*block, pos) || block->GetHash() != expected_hash) return nullptr;
+                return block;
+            });
+        };
+        const size_t num_to_connect{vpindexToConnect.size()};
+        for (size_t i = 0; i < num_to_connect; ++i) {
+            CBlockIndex* pindexConnect{vpindexToConnect[num_to_connect - 1 - i]};
+            std::shared_ptr<const CBlock> block_to_connect;
+            if (pindexConnect == pindexMostWork && pblock) {
+                block_to_connect = pblock;
+            } else if (read_ahead.valid()) {
+                // Started while the previous block was connecting. A failed
+                // read-ahead leaves this null and ConnectTip falls back to
+                // its own synchronous read, which owns the error handling.
+                block_to_connect = read_ahead.get();
+            }
+            if (i + 1 < num_to_connect) {
+                const CBlockIndex* pindexNext{vpindexToConnect[num_to_connect - 2 - i]};
+                if (!(pindexNext == pindexMostWork && pblock)) start_read_ahead(pindexNext);
+            }
+            if (!ConnectTip(state, pindexConnect, block_to_connect, connectTrace, disconnectpool)) {
                 if (state.IsInvalid()) {
                     // The block violates a consensus rule.
                     if (state.GetResult() != BlockValidationResult::BLOCK_MUTATED) {
@@ -3744,14 +4098,14 @@ bool Chainstate::InvalidateBlock(BlockValidationState& state, CBlockIndex* pinde
         // are no blocks that meet the "have data and are not invalid per
         // nStatus" criteria for inclusion in setBlockIndexCandidates).
         invalid_walk_tip->nStatus |= BLOCK_FAILED_VALID;
-        m_blockman.m_dirty_blockindex.insert(invalid_walk_tip);
+        m_blockman.MarkBlockIndexDirty(invalid_walk_tip);
         setBlockIndexCandidates.erase(invalid_walk_tip);
         setBlockIndexCandidates.insert(invalid_walk_tip->pprev);
         if (invalid_walk_tip->pprev == to_mark_failed && (to_mark_failed->nStatus & BLOCK_FAILED_VALID)) {
             // We only want to mark the last disconnected block as BLOCK_FAILED_VALID; its children
             // need to be BLOCK_FAILED_CHILD instead.
             to_mark_failed->nStatus = (to_mark_failed->nStatus ^ BLOCK_FAILED_VALID) | BLOCK_FAILED_CHILD;
-            m_blockman.m_dirty_blockindex.insert(to_mark_failed);
+            m_blockman.MarkBlockIndexDirty(to_mark_failed);
         }
 
         // Add any equal or more work headers to setBlockIndexCandidates
@@ -3781,7 +4135,7 @@ bool Chainstate::InvalidateBlock(BlockValidationState& state, CBlockIndex* pinde
 
         // Mark pindex (or the last disconnected block) as invalid, even when it never was in the main chain
         to_mark_failed->nStatus |= BLOCK_FAILED_VALID;
-        m_blockman.m_dirty_blockindex.insert(to_mark_failed);
+        m_blockman.MarkBlockIndexDirty(to_mark_failed);
         setBlockIndexCandidates.erase(to_mark_failed);
         m_chainman.m_failed_blocks.insert(to_mark_failed);
 
@@ -3841,7 +4195,7 @@ void Chainstate::ResetBlockFailureFlags(CBlockIndex *pindex) {
     for (auto& [_, block_index] : m_blockman.m_block_index) {
         if (!block_index.IsValid() && block_index.GetAncestor(nHeight) == pindex) {
             block_index.nStatus &= ~BLOCK_FAILED_MASK;
-            m_blockman.m_dirty_blockindex.insert(&block_index);
+            m_blockman.MarkBlockIndexDirty(&block_index);
             if (block_index.IsValid(BLOCK_VALID_TRANSACTIONS) && block_index.HaveNumChainTxs() && setBlockIndexCandidates.value_comp()(m_chain.Tip(), &block_index)) {
                 setBlockIndexCandidates.insert(&block_index);
             }
@@ -3857,7 +4211,7 @@ void Chainstate::ResetBlockFailureFlags(CBlockIndex *pindex) {
     while (pindex != nullptr) {
         if (pindex->nStatus & BLOCK_FAILED_MASK) {
             pindex->nStatus &= ~BLOCK_FAILED_MASK;
-            m_blockman.m_dirty_blockindex.insert(pindex);
+            m_blockman.MarkBlockIndexDirty(pindex);
             m_chainman.m_failed_blocks.erase(pindex);
         }
         pindex = pindex->pprev;
@@ -3914,7 +4268,7 @@ void ChainstateManager::ReceivedBlockTransactions(const CBlock& block, CBlockInd
         pindexNew->nStatus |= BLOCK_OPT_WITNESS;
     }
     pindexNew->RaiseValidity(BLOCK_VALID_TRANSACTIONS);
-    m_blockman.m_dirty_blockindex.insert(pindexNew);
+    m_blockman.MarkBlockIndexDirty(pindexNew);
 
     if (pindexNew->pprev == nullptr || pindexNew->pprev->HaveNumChainTxs()) {
         // If pindexNew is the genesis block or all parents are BLOCK_VALID_TRANSACTIONS.
@@ -3953,10 +4307,13 @@ void ChainstateManager::ReceivedBlockTransactions(const CBlock& block, CBlockInd
     }
 }
 
+/** With -assumevalidpow, one in this many headers below the anchor has its proof-of-work hash fully verified. */
+static constexpr int ASSUMED_VALID_POW_SPOT_CHECK_INTERVAL{20};
+
 static bool CheckBlockHeader(const CBlockHeader& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true)
 {
     // Check proof of work matches claimed amount
-    if (fCheckPOW && !CheckProofOfWork(block.GetPoWHash(), block.nBits, consensusParams))
+    if (fCheckPOW && !CheckHeaderProofOfWork(block, consensusParams))
         return state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, "high-hash", "proof of work failed");
 
     return true;
@@ -4108,6 +4465,69 @@ bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensu
     return true;
 }
 
+void ParallelPreCheckBlock(const CBlock& block, const Consensus::Params& consensusParams)
+{
+    if (block.fChecked) return;
+
+    // Proof of work, the merkle root and the per-transaction checks are
+    // independent of each other; compute them concurrently. The header check
+    // (PoW) is the expensive one, so it gets its own thread while this thread
+    // fans out the transaction checks.
+    BlockValidationState header_state;
+    std::thread header_thread{[&] {
+        if (CheckBlockHeader(block, header_state, consensusParams, /*fCheckPOW=*/true) &&
+            consensusParams.signet_blocks && !CheckSignetBlockSolution(block, consensusParams)) {
+            header_state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-signet-blksig");
+        }
+    }};
+
+    BlockValidationState merkle_state;
+    std::thread merkle_thread{[&] { CheckMerkleRoot(block, merkle_state); }};
+
+    // The cheap serial checks from CheckBlock().
+    bool ok = !block.vtx.empty() && block.vtx.size() * WITNESS_SCALE_FACTOR <= MAX_BLOCK_WEIGHT &&
+              ::GetSerializeSize(TX_NO_WITNESS(block)) * WITNESS_SCALE_FACTOR <= MAX_BLOCK_WEIGHT &&
+              block.vtx[0]->IsCoinBase();
+    for (unsigned int i = 1; ok && i < block.vtx.size(); i++) {
+        if (block.vtx[i]->IsCoinBase()) ok = false;
+    }
+
+    std::atomic<unsigned int> sigops{0};
+    if (ok) {
+        const size_t num_workers{std::clamp<size_t>(std::thread::hardware_concurrency(), 1, block.vtx.size())};
+        std::atomic<size_t> next_tx{0};
+        std::atomic<bool> tx_failed{false};
+        std::vector<std::thread> workers;
+        workers.reserve(num_workers - 1);
+        const auto check_txs{[&] {
+            unsigned int worker_sigops{0};
+            for (size_t i = next_tx.fetch_add(1); i < block.vtx.size() && !tx_failed.load(std::memory_order_relaxed); i = next_tx.fetch_add(1)) {
+                TxValidationState tx_state;
+                if (!CheckTransaction(*block.vtx[i], tx_state)) {
+                    tx_failed = true;
+                    break;
+                }
+                worker_sigops += GetLegacySigOpCount(*block.vtx[i]);
+            }
+            sigops += worker_sigops;
+        }};
+        for (size_t w = 1; w < num_workers; ++w) workers.emplace_back(check_txs);
+        check_txs();
+        for (auto& worker : workers) worker.join();
+        if (tx_failed || sigops * WITNESS_SCALE_FACTOR > MAX_BLOCK_SIGOPS_COST) ok = false;
+    }
+
+    header_thread.join();
+    merkle_thread.join();
+
+    // Only cache success. On any failure leave fChecked unset so the serial
+    // CheckBlock() under cs_main re-derives the canonical failure reason in
+    // its documented check order.
+    if (ok && header_state.IsValid() && merkle_state.IsValid()) {
+        block.fChecked = true;
+    }
+}
+
 void ChainstateManager::UpdateUncommittedBlockStructures(CBlock& block, const CBlockIndex* pindexPrev) const
 {
     int commitpos = GetWitnessCommitmentIndex(block);
@@ -4147,10 +4567,31 @@ std::vector<unsigned char> ChainstateManager::GenerateCoinbaseCommitment(CBlock&
     return commitment;
 }
 
-bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams)
+std::optional<uint256> CHeaderPoWCheck::operator()()
 {
-    return std::all_of(headers.cbegin(), headers.cend(),
-            [&](const auto& header) { return CheckProofOfWork(header.GetPoWHash(), header.nBits, consensusParams);});
+    if (CheckHeaderProofOfWork(m_header, *m_params)) return std::nullopt;
+    return m_header.GetHash();
+}
+
+bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, CCheckQueue<CHeaderPoWCheck>* pow_check_queue)
+{
+    if (pow_check_queue && pow_check_queue->HasThreads() && headers.size() > 1) {
+        CCheckQueueControl<CHeaderPoWCheck> control(pow_check_queue);
+        std::vector<CHeaderPoWCheck> vChecks;
+        vChecks.reserve(headers.size());
+        for (const CBlockHeader& header : headers) {
+            vChecks.emplace_back(header, consensusParams);
+        }
+        control.Add(std::move(vChecks));
+        if (auto result = control.Complete()) {
+            LogDebug(BCLog::POW, "invalid proof of work for header %s\n", result->ToString());
+            return false;
+        }
+        return true;
+    }
+
+    const std::vector<bool> valid{CheckProofOfWorkBatch(std::span{headers}, consensusParams)};
+    return std::all_of(valid.cbegin(), valid.cend(), [](bool v) { return v; });
 }
 
 bool IsBlockMutated(const CBlock& block, bool check_witness_root)
@@ -4214,6 +4655,18 @@ static bool ContextualCheckBlockHeader(const CBlockHeader& block, BlockValidatio
     if (block.nBits != GetNextWorkRequired(pindexPrev, &block, consensusParams))
         return state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, "bad-diffbits", "incorrect proof of work");
 
+    // Under the epoch seed schedule the proof of work is context-dependent
+    // (the matrices derive from an ancestor at the last epoch boundary), so
+    // it is enforced here rather than in the context-free CheckBlockHeader()
+    // path.
+    if (consensusParams.tenshash_epoch_length > 0 &&
+        DeploymentActiveAfter(pindexPrev, chainman, Consensus::DEPLOYMENT_POW_EPOCH)) {
+        const uint256 epoch_seed{GetPoWEpochSeed(pindexPrev, consensusParams)};
+        if (!CheckHeaderProofOfWorkEpoch(block, epoch_seed, consensusParams)) {
+            return state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, "high-hash-epoch", "epoch proof of work failed");
+        }
+    }
+
     // Check against checkpoints
     if (chainman.m_options.checkpoints_enabled) {
         // Don't accept any forks from the main chain prior to last checkpoint.
@@ -4341,7 +4794,22 @@ bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValida
             return true;
         }
 
-        if (!CheckBlockHeader(block, state, GetConsensus())) {
+        // With -assumevalidpow, the expensive proof-of-work hash is only spot
+        // checked for a random one-in-N sample of headers until the anchor
+        // header itself has been accepted (the anchor, and everything after
+        // it, is always fully verified). A peer feeding us fake headers
+        // cannot predict which ones get checked, so the expected number it
+        // can sneak in before being caught and disconnected is bounded by
+        // the sampling interval. Difficulty transitions are still validated
+        // for every header in ContextualCheckBlockHeader below, and chainwork
+        // accounting in AddToBlockIndex is unaffected.
+        bool check_pow{true};
+        const uint256& assumed_pow_block{AssumedValidPoWBlock()};
+        if (!assumed_pow_block.IsNull() && hash != assumed_pow_block &&
+            m_blockman.m_block_index.count(assumed_pow_block) == 0) {
+            check_pow = FastRandomContext().randrange(ASSUMED_VALID_POW_SPOT_CHECK_INTERVAL) == 0;
+        }
+        if (!CheckBlockHeader(block, state, GetConsensus(), check_pow)) {
             LogDebug(BCLog::VALIDATION, "%s: Consensus::CheckBlockHeader: %s, %s\n", __func__, hash.ToString(), state.ToString());
             return false;
         }
@@ -4393,7 +4861,7 @@ bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValida
                     CBlockIndex* invalid_walk = pindexPrev;
                     while (invalid_walk != failedit) {
                         invalid_walk->nStatus |= BLOCK_FAILED_CHILD;
-                        m_blockman.m_dirty_blockindex.insert(invalid_walk);
+                        m_blockman.MarkBlockIndexDirty(invalid_walk);
                         invalid_walk = invalid_walk->pprev;
                     }
                     LogDebug(BCLog::VALIDATION, "header %s has prev block invalid: %s\n", hash.ToString(), block.hashPrevBlock.ToString());
@@ -4544,7 +5012,7 @@ bool ChainstateManager::AcceptBlock(const std::shared_ptr<const CBlock>& pblock,
         !ContextualCheckBlock(block, state, *this, pindex->pprev)) {
         if (state.IsInvalid() && state.GetResult() != BlockValidationResult::BLOCK_MUTATED) {
             pindex->nStatus |= BLOCK_FAILED_VALID;
-            m_blockman.m_dirty_blockindex.insert(pindex);
+            m_blockman.MarkBlockIndexDirty(pindex);
         }
         LogError("%s: %s\n", __func__, state.ToString());
         return false;
@@ -4598,6 +5066,14 @@ bool ChainstateManager::ProcessNewBlock(const std::shared_ptr<const CBlock>& blo
         if (new_block) *new_block = false;
         BlockValidationState state;
 
+        // Fan the context-free checks (PoW, merkle root, per-tx checks) out
+        // across workers before entering the critical section; for a valid
+        // block this marks fChecked, making the CheckBlock() below a cached
+        // no-op. Safe outside cs_main because this thread holds the only
+        // reference through which CheckBlock() can be reached for this
+        // CBlock object, so the fChecked write cannot race.
+        ParallelPreCheckBlock(*block, GetConsensus());
+
         // CheckBlock() does not support multi-threaded block validation because CBlock::fChecked can cause data race.
         // Therefore, the following critical section must include the CheckBlock() call as well.
         LOCK(cs_main);
@@ -4691,6 +5167,199 @@ bool TestBlockValidity(BlockValidationState& state,
     return true;
 }
 
+//! CheckInputScripts() is annotated EXCLUSIVE_LOCKS_REQUIRED(cs_main) because
+//! the shared validation caches may only be written with synchronized access.
+//! TestProposedBlock() passes a private ValidationCache that nothing else
+//! touches, so the requirement does not apply there; this wrapper silences the
+//! lock annotation for that one call site.
+static bool CheckInputScriptsUncontended(const CTransaction& tx, TxValidationState& tx_state, const CCoinsViewCache& inputs,
+                                         unsigned int flags, PrecomputedTransactionData& txdata,
+                                         ValidationCache& validation_cache, std::vector<CScriptCheck>* pvChecks) NO_THREAD_SAFETY_ANALYSIS
+{
+    return CheckInputScripts(tx, tx_state, inputs, flags, /*cacheSigStore=*/false, /*cacheFullScriptStore=*/false, txdata, validation_cache, pvChecks);
+}
+
+ProposalCheckResult TestProposedBlock(BlockValidationState& state,
+                                      ChainstateManager& chainman,
+                                      const CBlock& block)
+{
+    // Context-free checks don't need the lock. Proposals are not required to
+    // carry valid proof of work (BIP 23), so it is not checked here either.
+    if (!CheckBlock(block, state, chainman.GetParams().GetConsensus(), /*fCheckPOW=*/false, /*fCheckMerkleRoot=*/true)) {
+        return ProposalCheckResult::INVALID;
+    }
+
+    const uint256 block_hash{block.GetHash()};
+    CBlockIndex indexDummy(block);
+    indexDummy.phashBlock = &block_hash;
+
+    unsigned int flags;
+    int nLockTimeFlags = 0;
+    std::vector<bool> prevalidated(block.vtx.size(), false);
+    CCoinsView coins_base;
+    CCoinsViewCache coins(&coins_base);
+    {
+        // Pin the tip, run the cheap contextual checks and snapshot every
+        // coin this block spends; everything after this scope runs against
+        // the snapshot without blocking block connection.
+        LOCK(cs_main);
+        Chainstate& chainstate{chainman.ActiveChainstate()};
+        CBlockIndex* pindexPrev{chainstate.m_chain.Tip()};
+        if (!pindexPrev || block.hashPrevBlock != pindexPrev->GetBlockHash()) {
+            return ProposalCheckResult::STALE_PREVBLK;
+        }
+        indexDummy.pprev = pindexPrev;
+        indexDummy.nHeight = pindexPrev->nHeight + 1;
+
+        if (!ContextualCheckBlockHeader(block, state, chainstate.m_blockman, chainman, pindexPrev)) {
+            return ProposalCheckResult::INVALID;
+        }
+        if (!ContextualCheckBlock(block, state, chainman, pindexPrev)) {
+            return ProposalCheckResult::INVALID;
+        }
+
+        flags = GetBlockScriptFlags(indexDummy, chainman);
+        if (DeploymentActiveAt(indexDummy, chainman, Consensus::DEPLOYMENT_CSV)) {
+            nLockTimeFlags |= LOCKTIME_VERIFY_SEQUENCE;
+        }
+
+        // Inputs not found in the tip's view are either created earlier in
+        // this block (added by UpdateCoins() below before they are needed) or
+        // genuinely missing, which CheckTxInputs() reports.
+        CCoinsViewCache& tip_coins{chainstate.CoinsTip()};
+        for (const auto& tx : block.vtx) {
+            if (tx->IsCoinBase()) continue;
+            for (const CTxIn& txin : tx->vin) {
+                if (auto coin{tip_coins.GetCoin(txin.prevout)}) {
+                    coins.AddCoin(txin.prevout, std::move(*coin), /*possible_overwrite=*/false);
+                }
+            }
+        }
+
+        // Same shortcut as ConnectBlock(): scripts already validated on
+        // mempool acceptance under identical flags need not run again.
+        if (chainstate.GetMempool()) {
+            CTxMemPool& mempool{*chainstate.GetMempool()};
+            LOCK(mempool.cs);
+            for (unsigned int i = 1; i < block.vtx.size(); i++) {
+                const CTransaction& tx{*block.vtx[i]};
+                const CTxMemPoolEntry* entry{mempool.GetEntry(tx.GetHash())};
+                if (entry && entry->GetTx().GetWitnessHash() == tx.GetWitnessHash() &&
+                    entry->GetValidatedScriptFlags() == std::optional<unsigned int>{flags}) {
+                    prevalidated[i] = true;
+                }
+            }
+        }
+    }
+
+    // The shared validation caches may not be read concurrently with writers
+    // (see cuckoocache.h), so proposal checks use a small private cache. The
+    // prevalidated[] shortcut above covers the common case of pool proposals,
+    // so little script execution reaches this cache in practice.
+    ValidationCache proposal_cache{/*script_execution_cache_bytes=*/1 << 20, /*signature_cache_bytes=*/1 << 20};
+
+    // BIP30 overwrite checks are not needed: ContextualCheckBlock() enforced
+    // BIP34, which rules out duplicate coinbases at this height.
+    std::vector<PrecomputedTransactionData> txsdata(block.vtx.size());
+    std::vector<CScriptCheck> script_checks;
+    std::vector<int> prevheights;
+    CAmount nFees = 0;
+    int64_t nSigOpsCost = 0;
+    for (unsigned int i = 0; i < block.vtx.size(); i++) {
+        const CTransaction& tx{*block.vtx[i]};
+
+        if (!tx.IsCoinBase()) {
+            CAmount txfee = 0;
+            TxValidationState tx_state;
+            if (!Consensus::CheckTxInputs(tx, tx_state, coins, indexDummy.nHeight, txfee)) {
+                state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
+                              tx_state.GetRejectReason(),
+                              tx_state.GetDebugMessage() + " in transaction " + tx.GetHash().ToString());
+                return ProposalCheckResult::INVALID;
+            }
+            nFees += txfee;
+            if (!MoneyRange(nFees)) {
+                state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-txns-accumulated-fee-outofrange",
+                              "accumulated fee in the block out of range");
+                return ProposalCheckResult::INVALID;
+            }
+
+            prevheights.resize(tx.vin.size());
+            for (size_t j = 0; j < tx.vin.size(); j++) {
+                prevheights[j] = coins.AccessCoin(tx.vin[j].prevout).nHeight;
+            }
+            // Reads only immutable fields of the pinned tip's ancestors, which
+            // are never freed while the node runs, so no lock is needed.
+            if (!SequenceLocks(tx, nLockTimeFlags, prevheights, indexDummy)) {
+                state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-txns-nonfinal",
+                              "contains a non-BIP68-final transaction " + tx.GetHash().ToString());
+                return ProposalCheckResult::INVALID;
+            }
+        }
+
+        nSigOpsCost += GetTransactionSigOpCost(tx, coins, flags);
+        if (nSigOpsCost > MAX_BLOCK_SIGOPS_COST) {
+            state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-blk-sigops", "too many sigops");
+            return ProposalCheckResult::INVALID;
+        }
+
+        if (!tx.IsCoinBase() && !prevalidated[i]) {
+            std::vector<CScriptCheck> vChecks;
+            TxValidationState tx_state;
+            if (!CheckInputScriptsUncontended(tx, tx_state, coins, flags, txsdata[i], proposal_cache, &vChecks)) {
+                state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
+                              tx_state.GetRejectReason(), tx_state.GetDebugMessage());
+                return ProposalCheckResult::INVALID;
+            }
+            for (auto& check : vChecks) {
+                script_checks.push_back(std::move(check));
+            }
+        }
+
+        CTxUndo undo;
+        UpdateCoins(tx, coins, undo, indexDummy.nHeight);
+    }
+
+    CAmount blockReward = nFees + GetBlockSubsidy(indexDummy.nHeight, chainman.GetParams().GetConsensus());
+    if (block.vtx[0]->GetValueOut() > blockReward) {
+        state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-cb-amount",
+                      strprintf("coinbase pays too much (actual=%d vs limit=%d)", block.vtx[0]->GetValueOut(), blockReward));
+        return ProposalCheckResult::INVALID;
+    }
+
+    // The shared check queue serves block connection (one batch at a time,
+    // under cs_main), so run any remaining script checks on a local pool.
+    if (!script_checks.empty()) {
+        const size_t num_workers{std::clamp<size_t>(std::thread::hardware_concurrency(), 1, script_checks.size())};
+        std::atomic<size_t> next_check{0};
+        std::vector<std::optional<std::pair<ScriptError, std::string>>> failures(num_workers);
+        std::vector<std::thread> workers;
+        workers.reserve(num_workers);
+        for (size_t w = 0; w < num_workers; ++w) {
+            workers.emplace_back([&, w] {
+                for (size_t i = next_check.fetch_add(1); i < script_checks.size(); i = next_check.fetch_add(1)) {
+                    if (auto result = script_checks[i]()) {
+                        failures[w] = std::move(result);
+                        break;
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        for (const auto& failure : failures) {
+            if (failure.has_value()) {
+                state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
+                              strprintf("mandatory-script-verify-flag-failed (%s)", ScriptErrorString(failure->first)),
+                              failure->second);
+                return ProposalCheckResult::INVALID;
+            }
+        }
+    }
+
+    assert(state.IsValid());
+    return ProposalCheckResult::VALID;
+}
+
 /* This function is called from the RPC code for pruneblockchain */
 void PruneBlockFilesManual(Chainstate& active_chainstate, int nManualPruneHeight)
 {
@@ -4777,14 +5446,10 @@ VerifyDBResult CVerifyDB::VerifyDB(
 
     const bool is_snapshot_cs{chainstate.m_from_snapshot_blockhash};
 
+    // Collect the window of blocks to verify: tip down to nCheckDepth deep,
+    // or to where block data stops being available.
+    std::vector<CBlockIndex*> window;
     for (pindex = chainstate.m_chain.Tip(); pindex && pindex->pprev; pindex = pindex->pprev) {
-        const int percentageDone = std::max(1, std::min(99, (int)(((double)(chainstate.m_chain.Height() - pindex->nHeight)) / (double)nCheckDepth * (nCheckLevel >= 4 ? 50 : 100))));
-        if (reportDone < percentageDone / 10) {
-            // report every 10% step
-            LogPrintf("Verification progress: %d%%\n", percentageDone);
-            reportDone = percentageDone / 10;
-        }
-        m_notifications.progress(_("Verifying blocks…"), percentageDone, false);
         if (pindex->nHeight <= chainstate.m_chain.Height() - nCheckDepth) {
             break;
         }
@@ -4795,42 +5460,130 @@ VerifyDBResult CVerifyDB::VerifyDB(
             skipped_no_block_data = true;
             break;
         }
-        CBlock block;
-        // check level 0: read from disk
-        if (!chainstate.m_blockman.ReadBlock(block, *pindex)) {
-            LogPrintf("Verification error: ReadBlock failed at %d, hash=%s\n", pindex->nHeight, pindex->GetBlockHash().ToString());
-            return VerifyDBResult::CORRUPTED_BLOCK_DB;
+        window.push_back(pindex);
+    }
+    // Re-point pindex at the deepest block below the verified window; the
+    // level 4 reconnect starts from there.
+    pindex = window.empty() ? chainstate.m_chain.Tip() : window.back()->pprev;
+
+    const int down_budget{nCheckLevel >= 4 ? 50 : 100};
+
+    // Check levels 0 and 1 across the whole window first: reading each block
+    // and checking its validity (including the expensive TensHash PoW
+    // re-verification) is independent per block, so this part is split across
+    // threads. Block positions are resolved up front because the workers must
+    // not take cs_main, which this thread holds.
+    {
+        std::vector<FlatFilePos> positions;
+        positions.reserve(window.size());
+        for (const CBlockIndex* index : window) {
+            positions.push_back(index->GetBlockPos());
+        }
+
+        std::atomic<bool> read_failed{false};
+        std::atomic<bool> interrupted{false};
+        std::atomic<size_t> next_block{0};
+        std::atomic<int> blocks_done{0};
+        std::mutex progress_mutex;
+        const size_t num_threads{std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4)};
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&] {
+                while (!read_failed.load(std::memory_order_relaxed) && !interrupted.load(std::memory_order_relaxed)) {
+                    const size_t i{next_block.fetch_add(1, std::memory_order_relaxed)};
+                    if (i >= window.size()) return;
+                    if (chainstate.m_chainman.m_interrupt) {
+                        interrupted = true;
+                        return;
+                    }
+                    const CBlockIndex* index{window[i]};
+                    CBlock block;
+                    // check level 0: read from disk
+                    if (!chainstate.m_blockman.ReadBlock(block, positions[i]) || block.GetHash() != index->GetBlockHash()) {
+                        LogPrintf("Verification error: ReadBlock failed at %d, hash=%s\n", index->nHeight, index->GetBlockHash().ToString());
+                        read_failed = true;
+                        return;
+                    }
+                    // check level 1: verify block validity
+                    BlockValidationState block_state;
+                    if (nCheckLevel >= 1 && !CheckBlock(block, block_state, consensus_params)) {
+                        LogPrintf("Verification error: found bad block at %d, hash=%s (%s)\n",
+                                  index->nHeight, index->GetBlockHash().ToString(), block_state.ToString());
+                        read_failed = true;
+                        return;
+                    }
+                    const int done{blocks_done.fetch_add(1, std::memory_order_relaxed) + 1};
+                    const int percentageDone{std::max(1, std::min(99, (int)((double)done / window.size() * down_budget / 2)))};
+                    std::lock_guard progress_lock{progress_mutex};
+                    if (reportDone < percentageDone / 10) {
+                        // report every 10% step
+                        LogPrintf("Verification progress: %d%%\n", percentageDone);
+                        reportDone = percentageDone / 10;
+                    }
+                    m_notifications.progress(_("Verifying blocks…"), percentageDone, false);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        if (interrupted) return VerifyDBResult::INTERRUPTED;
+        if (read_failed) return VerifyDBResult::CORRUPTED_BLOCK_DB;
+    }
+
+    // The window's PoW was already checked above, so the level 3 and 4 walks
+    // re-read blocks via the raw path and pin the identity against the index
+    // instead of paying TensHash again.
+    const auto read_verified_block = [&](CBlock& block, const CBlockIndex& index) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
+        std::vector<uint8_t> data;
+        if (!chainstate.m_blockman.ReadRawBlock(data, index.GetBlockPos())) return false;
+        try {
+            DataStream ss{data};
+            ss >> TX_WITH_WITNESS(block);
+        } catch (const std::exception&) {
+            return false;
         }
-        // check level 1: verify block validity
-        if (nCheckLevel >= 1 && !CheckBlock(block, state, consensus_params)) {
-            LogPrintf("Verification error: found bad block at %d, hash=%s (%s)\n",
-                      pindex->nHeight, pindex->GetBlockHash().ToString(), state.ToString());
-            return VerifyDBResult::CORRUPTED_BLOCK_DB;
+        return block.GetHash() == index.GetBlockHash();
+    };
+
+    // Levels 2 and 3 walk the window tip-down serially: level 3 disconnects
+    // must apply in order against the coins view.
+    for (size_t i = 0; nCheckLevel >= 2 && i < window.size(); ++i) {
+        CBlockIndex* index{window[i]};
+        const int percentageDone = std::max(1, std::min(99, (int)(down_budget / 2.0 + (double)(i + 1) / window.size() * down_budget / 2)));
+        if (reportDone < percentageDone / 10) {
+            // report every 10% step
+            LogPrintf("Verification progress: %d%%\n", percentageDone);
+            reportDone = percentageDone / 10;
         }
+        m_notifications.progress(_("Verifying blocks…"), percentageDone, false);
+
         // check level 2: verify undo validity
-        if (nCheckLevel >= 2 && pindex) {
+        if (!index->GetUndoPos().IsNull()) {
             CBlockUndo undo;
-            if (!pindex->GetUndoPos().IsNull()) {
-                if (!chainstate.m_blockman.ReadBlockUndo(undo, *pindex)) {
-                    LogPrintf("Verification error: found bad undo data at %d, hash=%s\n", pindex->nHeight, pindex->GetBlockHash().ToString());
-                    return VerifyDBResult::CORRUPTED_BLOCK_DB;
-                }
+            if (!chainstate.m_blockman.ReadBlockUndo(undo, *index)) {
+                LogPrintf("Verification error: found bad undo data at %d, hash=%s\n", index->nHeight, index->GetBlockHash().ToString());
+                return VerifyDBResult::CORRUPTED_BLOCK_DB;
             }
         }
         // check level 3: check for inconsistencies during memory-only disconnect of tip blocks
-        size_t curr_coins_usage = coins.DynamicMemoryUsage() + chainstate.CoinsTip().DynamicMemoryUsage();
-
         if (nCheckLevel >= 3) {
+            size_t curr_coins_usage = coins.DynamicMemoryUsage() + chainstate.CoinsTip().DynamicMemoryUsage();
+
             if (curr_coins_usage <= chainstate.m_coinstip_cache_size_bytes) {
-                assert(coins.GetBestBlock() == pindex->GetBlockHash());
-                DisconnectResult res = chainstate.DisconnectBlock(block, pindex, coins);
+                CBlock block;
+                if (!read_verified_block(block, *index)) {
+                    LogPrintf("Verification error: ReadBlock failed at %d, hash=%s\n", index->nHeight, index->GetBlockHash().ToString());
+                    return VerifyDBResult::CORRUPTED_BLOCK_DB;
+                }
+                assert(coins.GetBestBlock() == index->GetBlockHash());
+                DisconnectResult res = chainstate.DisconnectBlock(block, index, coins);
                 if (res == DISCONNECT_FAILED) {
-                    LogPrintf("Verification error: irrecoverable inconsistency in block data at %d, hash=%s\n", pindex->nHeight, pindex->GetBlockHash().ToString());
+                    LogPrintf("Verification error: irrecoverable inconsistency in block data at %d, hash=%s\n", index->nHeight, index->GetBlockHash().ToString());
                     return VerifyDBResult::CORRUPTED_BLOCK_DB;
                 }
                 if (res == DISCONNECT_UNCLEAN) {
                     nGoodTransactions = 0;
-                    pindexFailure = pindex;
+                    pindexFailure = index;
                 } else {
                     nGoodTransactions += block.vtx.size();
                 }
@@ -4863,7 +5616,7 @@ VerifyDBResult CVerifyDB::VerifyDB(
             m_notifications.progress(_("Verifying blocks…"), percentageDone, false);
             pindex = chainstate.m_chain.Next(pindex);
             CBlock block;
-            if (!chainstate.m_blockman.ReadBlock(block, *pindex)) {
+            if (!read_verified_block(block, *pindex)) {
                 LogPrintf("Verification error: ReadBlock failed at %d, hash=%s\n", pindex->nHeight, pindex->GetBlockHash().ToString());
                 return VerifyDBResult::CORRUPTED_BLOCK_DB;
             }
@@ -5112,7 +5865,7 @@ void ChainstateManager::LoadExternalBlockFile(
                 }
                 // read size
                 blkdat >> nSize;
-                if (nSize < 80 || nSize > MAX_BLOCK_SERIALIZED_SIZE)
+                if (nSize < CBlockHeader::SERIALIZED_SIZE || nSize > MAX_BLOCK_SERIALIZED_SIZE)
                     continue;
             } catch (const std::exception&) {
                 // no valid block header found; don't complain
@@ -5215,22 +5968,30 @@ void ChainstateManager::LoadExternalBlockFile(
                 while (!queue.empty()) {
                     uint256 head = queue.front();
                     queue.pop_front();
-                    auto range = blocks_with_unknown_parent->equal_range(head);
-                    while (range.first != range.second) {
-                        std::multimap<uint256, FlatFilePos>::iterator it = range.first;
+                    // Extract this block's stashed children under cs_main, so
+                    // that when several files are imported concurrently each
+                    // child is processed by exactly one thread.
+                    std::vector<FlatFilePos> children;
+                    {
+                        LOCK(cs_main);
+                        auto range = blocks_with_unknown_parent->equal_range(head);
+                        for (auto it = range.first; it != range.second;) {
+                            children.push_back(it->second);
+                            it = blocks_with_unknown_parent->erase(it);
+                        }
+                    }
+                    for (FlatFilePos child_pos : children) {
                         std::shared_ptr<CBlock> pblockrecursive = std::make_shared<CBlock>();
-                        if (m_blockman.ReadBlock(*pblockrecursive, it->second)) {
+                        if (m_blockman.ReadBlock(*pblockrecursive, child_pos)) {
                             LogDebug(BCLog::REINDEX, "%s: Processing out of order child %s of %s\n", __func__, pblockrecursive->GetHash().ToString(),
                                     head.ToString());
                             LOCK(cs_main);
                             BlockValidationState dummy;
-                            if (AcceptBlock(pblockrecursive, dummy, nullptr, true, &it->second, nullptr, true)) {
+                            if (AcceptBlock(pblockrecursive, dummy, nullptr, true, &child_pos, nullptr, true)) {
                                 nLoaded++;
                                 queue.push_back(pblockrecursive->GetHash());
                             }
                         }
-                        range.first++;
-                        blocks_with_unknown_parent->erase(it);
                         NotifyHeaderTip();
                     }
                 }
@@ -5263,6 +6024,58 @@ bool ChainstateManager::ShouldCheckBlockIndex() const
     return true;
 }
 
+void ChainstateManager::CheckBlockIndexEntry(const CBlockIndex* pindex) const
+{
+    AssertLockHeld(cs_main);
+    const CBlockIndex* snap_base{GetSnapshotBaseBlock()};
+
+    // Local invariants, mirroring the corresponding checks in CheckBlockIndex().
+    if (!m_blockman.m_have_pruned) {
+        // If we've never pruned, then HAVE_DATA should be equivalent to nTx > 0
+        assert(!(pindex->nStatus & BLOCK_HAVE_DATA) == (pindex->nTx == 0));
+    } else {
+        // If we have pruned, then we can only say that HAVE_DATA implies nTx > 0
+        if (pindex->nStatus & BLOCK_HAVE_DATA) assert(pindex->nTx > 0);
+    }
+    if (pindex->nStatus & BLOCK_HAVE_UNDO) assert(pindex->nStatus & BLOCK_HAVE_DATA);
+    // There should only be an nTx value if we have actually seen a block's transactions.
+    assert(((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TRANSACTIONS) == (pindex->nTx > 0));
+    if (!pindex->HaveNumChainTxs()) assert(pindex->nSequenceId <= 0);
+    assert((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_TREE);
+
+    if (pindex->pprev == nullptr) {
+        // Genesis block checks.
+        assert(pindex->GetBlockHash() == GetConsensus().hashGenesisBlock);
+        assert(pindex->nHeight == 0);
+        assert(pindex->m_chain_tx_count == pindex->nTx);
+        return;
+    }
+
+    // Linkage against the parent. The validity/failure implications below are
+    // transitive, so with every modified entry checked against its direct
+    // parent since the last full-tree pass, they hold inductively for the
+    // whole ancestor path.
+    const CBlockIndex* pprev{pindex->pprev};
+    assert(pindex->nHeight == pprev->nHeight + 1);
+    assert(pindex->nChainWork >= pprev->nChainWork);
+    assert(pindex->nHeight < 2 || (pindex->pskip && (pindex->pskip->nHeight < pindex->nHeight)));
+    if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_CHAIN) {
+        assert((pprev->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_CHAIN || pprev == snap_base);
+    }
+    if ((pindex->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_SCRIPTS) {
+        assert((pprev->nStatus & BLOCK_VALID_MASK) >= BLOCK_VALID_SCRIPTS || pprev == snap_base);
+    }
+    // Note: the failure-flag implications between parent and child are left to
+    // the periodic full-tree pass; they are fixed up lazily (e.g. by
+    // SetBlockFailureFlags) and can be transiently out of sync here.
+    // Make sure m_chain_tx_count sum is correctly computed.
+    if (pprev->m_chain_tx_count > 0 && pindex->nTx > 0) {
+        assert(pindex->m_chain_tx_count == pindex->nTx + pprev->m_chain_tx_count);
+    } else {
+        assert((pindex->m_chain_tx_count != 0) == (pindex == snap_base));
+    }
+}
+
 void ChainstateManager::CheckBlockIndex()
 {
     if (!ShouldCheckBlockIndex()) {
@@ -5279,6 +6092,27 @@ void ChainstateManager::CheckBlockIndex()
         return;
     }
 
+    // Incremental mode: when only a few entries were modified since the last
+    // pass, validate just those (and their parent linkage) instead of walking
+    // the entire tree. This makes always-on -checkblockindex affordable on
+    // mainnet, where a full walk over the whole block index per connected
+    // block is prohibitive. A full-tree pass still runs periodically (and
+    // whenever many entries changed) to cover the global invariants -
+    // setBlockIndexCandidates, m_blocks_unlinked and tree topology - that a
+    // per-entry check cannot see.
+    constexpr size_t MAX_INCREMENTAL_CHECK_SIZE{64};
+    constexpr int FULL_CHECK_INTERVAL{64};
+    if (m_full_block_index_checked &&
+        m_checks_since_full_block_index_check < FULL_CHECK_INTERVAL &&
+        m_blockman.m_modified_since_check.size() <= MAX_INCREMENTAL_CHECK_SIZE) {
+        for (const CBlockIndex* pindex : m_blockman.m_modified_since_check) {
+            CheckBlockIndexEntry(pindex);
+        }
+        m_blockman.m_modified_since_check.clear();
+        ++m_checks_since_full_block_index_check;
+        return;
+    }
+
     // Build forward-pointing data structure for the entire block tree.
     // For performance reasons, indexes of the best header chain are stored in a vector (within CChain).
     // All remaining blocks are stored in a multimap.
@@ -5572,6 +6406,12 @@ void ChainstateManager::CheckBlockIndex()
 
     // Check that we actually traversed the entire block index.
     assert(nNodes == forward.size() + best_hdr_chain.Height() + 1);
+
+    // A full-tree pass validated everything; subsequent passes may go
+    // incremental until enough has changed again.
+    m_blockman.m_modified_since_check.clear();
+    m_full_block_index_checked = true;
+    m_checks_since_full_block_index_check = 0;
 }
 
 std::string Chainstate::ToString()
@@ -5595,6 +6435,9 @@ bool Chainstate::ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size)
     m_coinstip_cache_size_bytes = coinstip_size;
     m_coinsdb_cache_size_bytes = coinsdb_size;
     CoinsDB().ResizeCache(coinsdb_size);
+    // Re-size the hash table reservation along with the budget; a shrunken
+    // reservation takes effect when the flush below rebuilds the map.
+    CoinsTip().Reserve(coinstip_size >= MIN_COINS_CACHE_RESERVE_BYTES ? coinstip_size : 0);
 
     LogPrintf("[%s] resized coinsdb cache to %.1f MiB\n",
         this->ToString(), coinsdb_size * (1.0 / 1024 / 1024));
@@ -5929,78 +6772,160 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     }
 
     const uint64_t coins_count = metadata.m_coins_count;
-    uint64_t coins_left = metadata.m_coins_count;
 
-    LogPrintf("[snapshot] loading %d coins from snapshot %s\n", coins_left, base_blockhash.ToString());
+    LogPrintf("[snapshot] loading %d coins from snapshot %s\n", coins_count, base_blockhash.ToString());
     int64_t coins_processed{0};
 
-    while (coins_left > 0) {
+    // Deserialization and cache insertion are pipelined: a producer thread
+    // reads, deserializes and sanity-checks coins from the file in batches,
+    // while this thread drains the bounded queue into the coins cache and
+    // handles the periodic flushes. The serialized format is pinned by the
+    // assumeutxo hash, so the parallelism has to come from overlapping the
+    // two stages rather than from restructuring the file into chunks.
+    constexpr size_t SNAPSHOT_BATCH_COINS{60'000};
+    constexpr size_t MAX_QUEUED_BATCHES{4};
+    using CoinBatch = std::vector<std::pair<COutPoint, Coin>>;
+    Mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::deque<CoinBatch> batch_queue GUARDED_BY(queue_mutex);
+    bool producer_done GUARDED_BY(queue_mutex){false};
+    bool stop_requested GUARDED_BY(queue_mutex){false};
+    std::string producer_error GUARDED_BY(queue_mutex);
+
+    std::thread producer{[&] {
+        std::string error;
+        CoinBatch batch;
+        batch.reserve(SNAPSHOT_BATCH_COINS);
+        auto push_batch = [&]() EXCLUSIVE_LOCKS_REQUIRED(!queue_mutex) {
+            WAIT_LOCK(queue_mutex, lock);
+            queue_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(queue_mutex) {
+                return batch_queue.size() < MAX_QUEUED_BATCHES || stop_requested;
+            });
+            if (stop_requested) return false;
+            batch_queue.push_back(std::move(batch));
+            batch = CoinBatch{};
+            batch.reserve(SNAPSHOT_BATCH_COINS);
+            queue_cv.notify_all();
+            return true;
+        };
+        uint64_t coins_left = coins_count;
         try {
-            Txid txid;
-            coins_file >> txid;
-            size_t coins_per_txid{0};
-            coins_per_txid = ReadCompactSize(coins_file);
+            while (coins_left > 0 && error.empty()) {
+                Txid txid;
+                coins_file >> txid;
+                const size_t coins_per_txid{ReadCompactSize(coins_file)};
 
-            if (coins_per_txid > coins_left) {
-                return util::Error{Untranslated("Mismatch in coins count in snapshot metadata and actual snapshot data")};
-            }
+                if (coins_per_txid > coins_left) {
+                    error = "Mismatch in coins count in snapshot metadata and actual snapshot data";
+                    break;
+                }
 
-            for (size_t i = 0; i < coins_per_txid; i++) {
-                COutPoint outpoint;
-                Coin coin;
-                outpoint.n = static_cast<uint32_t>(ReadCompactSize(coins_file));
-                outpoint.hash = txid;
-                coins_file >> coin;
-                if (coin.nHeight > base_height ||
-                    outpoint.n >= std::numeric_limits<decltype(outpoint.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
-                ) {
-                    return util::Error{Untranslated(strprintf("Bad snapshot data after deserializing %d coins",
-                              coins_count - coins_left))};
+                for (size_t i = 0; i < coins_per_txid; i++) {
+                    COutPoint outpoint;
+                    Coin coin;
+                    outpoint.n = static_cast<uint32_t>(ReadCompactSize(coins_file));
+                    outpoint.hash = txid;
+                    coins_file >> coin;
+                    if (coin.nHeight > base_height ||
+                        outpoint.n >= std::numeric_limits<decltype(outpoint.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
+                    ) {
+                        error = strprintf("Bad snapshot data after deserializing %d coins",
+                                          coins_count - coins_left);
+                        break;
+                    }
+                    if (!MoneyRange(coin.out.nValue)) {
+                        error = strprintf("Bad snapshot data after deserializing %d coins - bad tx out value",
+                                          coins_count - coins_left);
+                        break;
+                    }
+                    batch.emplace_back(std::move(outpoint), std::move(coin));
+                    --coins_left;
+                    if (batch.size() >= SNAPSHOT_BATCH_COINS && !push_batch()) return;
+                }
+            }
+            if (error.empty()) {
+                bool out_of_coins{false};
+                try {
+                    std::byte left_over_byte;
+                    coins_file >> left_over_byte;
+                } catch (const std::ios_base::failure&) {
+                    // We expect an exception since we should be out of coins.
+                    out_of_coins = true;
                 }
-                if (!MoneyRange(coin.out.nValue)) {
-                    return util::Error{Untranslated(strprintf("Bad snapshot data after deserializing %d coins - bad tx out value",
-                              coins_count - coins_left))};
+                if (!out_of_coins) {
+                    error = strprintf("Bad snapshot - coins left over after deserializing %d coins",
+                                      coins_count);
                 }
-                coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
+            }
+        } catch (const std::ios_base::failure&) {
+            error = strprintf("Bad snapshot format or truncated snapshot after deserializing %d coins",
+                              coins_count - coins_left);
+        }
+        if (!batch.empty() && error.empty()) push_batch();
+        WITH_LOCK(queue_mutex, producer_error = error; producer_done = true);
+        queue_cv.notify_all();
+    }};
+
+    auto stop_producer = [&]() EXCLUSIVE_LOCKS_REQUIRED(!queue_mutex) {
+        WITH_LOCK(queue_mutex, stop_requested = true);
+        queue_cv.notify_all();
+        producer.join();
+    };
 
-                --coins_left;
-                ++coins_processed;
+    while (true) {
+        CoinBatch batch;
+        {
+            WAIT_LOCK(queue_mutex, lock);
+            queue_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(queue_mutex) {
+                return !batch_queue.empty() || producer_done;
+            });
+            if (batch_queue.empty()) break;
+            batch = std::move(batch_queue.front());
+            batch_queue.pop_front();
+            queue_cv.notify_all();
+        }
+
+        for (auto& [outpoint, coin] : batch) {
+            coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
+
+            ++coins_processed;
+
+            if (coins_processed % 1000000 == 0) {
+                LogPrintf("[snapshot] %d coins loaded (%.2f%%, %.2f MB)\n",
+                    coins_processed,
+                    static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
+                    coins_cache.DynamicMemoryUsage() / (1000 * 1000));
+            }
 
-                if (coins_processed % 1000000 == 0) {
-                    LogPrintf("[snapshot] %d coins loaded (%.2f%%, %.2f MB)\n",
-                        coins_processed,
-                        static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
-                        coins_cache.DynamicMemoryUsage() / (1000 * 1000));
+            // Batch write and flush (if we need to) every so often.
+            //
+            // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
+            // means <5MB of memory imprecision.
+            if (coins_processed % 120000 == 0) {
+                if (m_interrupt) {
+                    stop_producer();
+                    return util::Error{Untranslated("Aborting after an interrupt was requested")};
                 }
 
-                // Batch write and flush (if we need to) every so often.
-                //
-                // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
-                // means <5MB of memory imprecision.
-                if (coins_processed % 120000 == 0) {
-                    if (m_interrupt) {
-                        return util::Error{Untranslated("Aborting after an interrupt was requested")};
-                    }
+                const auto snapshot_cache_state = WITH_LOCK(::cs_main,
+                    return snapshot_chainstate.GetCoinsCacheSizeState());
 
-                    const auto snapshot_cache_state = WITH_LOCK(::cs_main,
-                        return snapshot_chainstate.GetCoinsCacheSizeState());
+                if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
+                    // This is a hack - we don't know what the actual best block is, but that
+                    // doesn't matter for the purposes of flushing the cache here. We'll set this
+                    // to its correct value (`base_blockhash`) below after the coins are loaded.
+                    coins_cache.SetBestBlock(GetRandHash());
 
-                    if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
-                        // This is a hack - we don't know what the actual best block is, but that
-                        // doesn't matter for the purposes of flushing the cache here. We'll set this
-                        // to its correct value (`base_blockhash`) below after the coins are loaded.
-                        coins_cache.SetBestBlock(GetRandHash());
-
-                        // No need to acquire cs_main since this chainstate isn't being used yet.
-                        FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
-                    }
+                    // No need to acquire cs_main since this chainstate isn't being used yet.
+                    FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
                 }
             }
-        } catch (const std::ios_base::failure&) {
-            return util::Error{Untranslated(strprintf("Bad snapshot format or truncated snapshot after deserializing %d coins",
-                      coins_processed))};
         }
     }
+    producer.join();
+    if (const auto error{WITH_LOCK(queue_mutex, return producer_error)}; !error.empty()) {
+        return util::Error{Untranslated(error)};
+    }
 
     // Important that we set this. This and the coins_cache accesses above are
     // sort of a layer violation, but either we reach into the innards of
@@ -6009,19 +6934,6 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     // method.
     coins_cache.SetBestBlock(base_blockhash);
 
-    bool out_of_coins{false};
-    try {
-        std::byte left_over_byte;
-        coins_file >> left_over_byte;
-    } catch (const std::ios_base::failure&) {
-        // We expect an exception since we should be out of coins.
-        out_of_coins = true;
-    }
-    if (!out_of_coins) {
-        return util::Error{Untranslated(strprintf("Bad snapshot - coins left over after deserializing %d coins",
-            coins_count))};
-    }
-
     LogPrintf("[snapshot] loaded %d (%.2f MB) coins from snapshot %s\n",
         coins_count,
         coins_cache.DynamicMemoryUsage() / (1000 * 1000),
@@ -6076,7 +6988,7 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
             index->nStatus |= BLOCK_OPT_WITNESS;
         }
 
-        m_blockman.m_dirty_blockindex.insert(index);
+        m_blockman.MarkBlockIndexDirty(index);
         // Changes to the block index will be flushed to disk after this call
         // returns in `ActivateSnapshot()`, when `MaybeRebalanceCaches()` is
         // called, since we've added a snapshot chainstate and therefore will
@@ -6305,11 +7217,14 @@ static ChainstateManager::Options&& Flatten(ChainstateManager::Options&& opts)
     if (!opts.check_block_index.has_value()) opts.check_block_index = opts.chainparams.DefaultConsistencyChecks();
     if (!opts.minimum_chain_work.has_value()) opts.minimum_chain_work = UintToArith256(opts.chainparams.GetConsensus().nMinimumChainWork);
     if (!opts.assumed_valid_block.has_value()) opts.assumed_valid_block = opts.chainparams.GetConsensus().defaultAssumeValid;
+    if (!opts.assumed_valid_pow_block.has_value()) opts.assumed_valid_pow_block = uint256{};
     return std::move(opts);
 }
 
 ChainstateManager::ChainstateManager(const util::SignalInterrupt& interrupt, Options options, node::BlockManager::Options blockman_options)
     : m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS)},
+      // Small batches: one TensHash proof is ~1000x more work than one script check.
+      m_pow_check_queue{/*batch_size=*/8, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS), "powcheck"},
       m_interrupt{interrupt},
       m_options{Flatten(std::move(options))},
       m_blockman{interrupt, std::move(blockman_options)},
@@ -6464,6 +7379,25 @@ void ChainstateManager::RecalculateBestHeader()
     }
 }
 
+ChainstateManager::ConnectBlockTimings ChainstateManager::GetConnectBlockTimings() const
+{
+    AssertLockHeld(cs_main);
+    return {
+        .check = time_check,
+        .forks = time_forks,
+        .connect = time_connect,
+        .verify = time_verify,
+        .undo = time_undo,
+        .index = time_index,
+        .connect_total = time_connect_total,
+        .flush = time_flush,
+        .chainstate = time_chainstate,
+        .post_connect = time_post_connect,
+        .total = time_total,
+        .num_blocks = num_blocks_total,
+    };
+}
+
 bool ChainstateManager::ValidatedSnapshotCleanup()
 {
     AssertLockHeld(::cs_main);
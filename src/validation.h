@@ -46,6 +46,7 @@
 #include <utility>
 #include <vector>
 
+class CBlockUndo;
 class Chainstate;
 class CTxMemPool;
 class ChainstateManager;
@@ -383,6 +384,16 @@ public:
 /** Context-independent validity checks */
 bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, bool fCheckMerkleRoot = true);
 
+/**
+ * Run CheckBlock()'s context-independent checks concurrently: proof of work,
+ * the merkle root and the per-transaction checks on separate workers. On
+ * success marks the block checked so a subsequent CheckBlock() returns
+ * immediately; on failure caches nothing and lets CheckBlock() re-derive the
+ * canonical failure reason. The caller must be the only thread that can reach
+ * CheckBlock() for this CBlock object (the fChecked write is unsynchronized).
+ */
+void ParallelPreCheckBlock(const CBlock& block, const Consensus::Params& consensusParams);
+
 /** Check a block is completely valid from start to finish (only works on top of our current best block) */
 bool TestBlockValidity(BlockValidationState& state,
                        const CChainParams& chainparams,
@@ -392,8 +403,51 @@ bool TestBlockValidity(BlockValidationState& state,
                        bool fCheckPOW = true,
                        bool fCheckMerkleRoot = true) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
-/** Check with the proof of work on each blockheader matches the value in nBits */
-bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams);
+/** Outcome of TestProposedBlock(). */
+enum class ProposalCheckResult {
+    VALID,         //!< Fully valid on top of the current tip
+    INVALID,       //!< Failed a check; see the BlockValidationState for details
+    STALE_PREVBLK, //!< Not built on the current tip; validity was not assessed
+};
+
+/**
+ * Check a BIP 23 block proposal built on top of the current tip.
+ *
+ * Unlike TestBlockValidity() this holds cs_main only long enough to pin the
+ * tip, run the contextual header/block checks and snapshot the spent coins;
+ * the expensive work (input amounts, BIP68 finality, sigop cost and script
+ * execution) runs against that private snapshot off the lock, so continuous
+ * proposal traffic cannot stall block connection. Scripts of transactions
+ * that were already validated on mempool acceptance under the same script
+ * flags are not re-executed.
+ */
+ProposalCheckResult TestProposedBlock(BlockValidationState& state,
+                                      ChainstateManager& chainman,
+                                      const CBlock& block) LOCKS_EXCLUDED(::cs_main);
+
+/**
+ * Closure representing one header proof-of-work verification, suitable for
+ * execution on a CCheckQueue worker pool. Returns the hash of the header on
+ * failure, std::nullopt on success.
+ */
+class CHeaderPoWCheck
+{
+private:
+    CBlockHeader m_header;
+    const Consensus::Params* m_params;
+
+public:
+    CHeaderPoWCheck(const CBlockHeader& header, const Consensus::Params& params)
+        : m_header(header), m_params(&params) {}
+
+    std::optional<uint256> operator()();
+};
+
+/** Check with the proof of work on each blockheader matches the value in nBits.
+ * If a check queue with worker threads is supplied, the (expensive) per-header
+ * hashes are verified in parallel on its pool instead of serially on the
+ * calling thread. */
+bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, CCheckQueue<CHeaderPoWCheck>* pow_check_queue = nullptr);
 
 /** Check if a block has been mutated (with respect to its merkle root and witness commitments). */
 bool IsBlockMutated(const CBlock& block, bool check_witness_root);
@@ -704,13 +758,18 @@ public:
         LOCKS_EXCLUDED(::cs_main);
 
     // Block (dis)connection on a given view:
-    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view)
+    //! If `undo` is provided (e.g. read ahead during a reorg), it is applied
+    //! instead of reading the undo data from disk; its coins are moved out of
+    //! it in the process.
+    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, CBlockUndo* undo = nullptr)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     bool ConnectBlock(const CBlock& block, BlockValidationState& state, CBlockIndex* pindex,
                       CCoinsViewCache& view, bool fJustCheck = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Apply the effects of a block disconnection on the UTXO set.
-    bool DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
+    // `pblock`/`undo` may carry the tip's block and undo data if they were
+    // already read (e.g. ahead of time during a reorg); either may be null.
+    bool DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool, std::shared_ptr<const CBlock> pblock = nullptr, CBlockUndo* undo = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
 
     // Manual block validity manipulation:
     /** Mark a block as precious and reorganize.
@@ -901,6 +960,19 @@ private:
 
     CBlockIndex* m_best_invalid GUARDED_BY(::cs_main){nullptr};
 
+    //! Whether a full-tree CheckBlockIndex() pass has completed; incremental
+    //! passes are only sound once every entry has been validated at least once.
+    bool m_full_block_index_checked GUARDED_BY(::cs_main){false};
+
+    //! Number of incremental CheckBlockIndex() passes since the last full-tree
+    //! pass; used to schedule periodic full passes.
+    int m_checks_since_full_block_index_check GUARDED_BY(::cs_main){0};
+
+    //! Validate the local invariants of a single block index entry, plus its
+    //! linkage against its (already-validated) parent. Used by CheckBlockIndex()
+    //! for entries modified since the last pass.
+    void CheckBlockIndexEntry(const CBlockIndex* pindex) const EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     /** The last header for which a headerTip notification was issued. */
     CBlockIndex* m_last_notified_header GUARDED_BY(GetMutex()){nullptr};
 
@@ -949,6 +1021,11 @@ private:
     //! A queue for script verifications that have to be performed by worker threads.
     CCheckQueue<CScriptCheck> m_script_check_queue;
 
+    //! A queue for header proof-of-work verifications that have to be
+    //! performed by worker threads, keeping the net message-handler thread
+    //! responsive while large HEADERS messages are verified.
+    CCheckQueue<CHeaderPoWCheck> m_pow_check_queue;
+
     //! Timers and counters used for benchmarking validation in both background
     //! and active chainstates.
     SteadyClock::duration GUARDED_BY(::cs_main) time_check{};
@@ -965,6 +1042,30 @@ private:
     SteadyClock::duration GUARDED_BY(::cs_main) time_post_connect{};
 
 public:
+    //! Snapshot of the cumulative per-stage ConnectBlock() timers, for
+    //! benchmarking tools (see GetConnectStageTimes()).
+    struct ConnectStageTimes {
+        SteadyClock::duration check{};
+        SteadyClock::duration forks{};
+        SteadyClock::duration connect{};
+        SteadyClock::duration verify{};
+        SteadyClock::duration undo{};
+        SteadyClock::duration index{};
+        SteadyClock::duration chainstate{};
+        SteadyClock::duration flush{};
+        SteadyClock::duration post_connect{};
+        SteadyClock::duration total{};
+        int64_t num_blocks{0};
+    };
+
+    ConnectStageTimes GetConnectStageTimes() const EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+    {
+        AssertLockHeld(::cs_main);
+        return {time_check, time_forks, time_connect, time_verify, time_undo,
+                time_index, time_chainstate, time_flush, time_post_connect,
+                time_total, num_blocks_total};
+    }
+
     using Options = kernel::ChainstateManagerOpts;
 
     explicit ChainstateManager(const util::SignalInterrupt& interrupt, Options options, node::BlockManager::Options blockman_options);
@@ -978,11 +1079,18 @@ public:
     bool ShouldCheckBlockIndex() const;
     const arith_uint256& MinimumChainWork() const { return *Assert(m_options.minimum_chain_work); }
     const uint256& AssumedValidBlock() const { return *Assert(m_options.assumed_valid_block); }
+    const uint256& AssumedValidPoWBlock() const { return *Assert(m_options.assumed_valid_pow_block); }
     kernel::Notifications& GetNotifications() const { return m_options.notifications; };
 
     /**
      * Make various assertions about the state of the block index.
      *
+     * When only a few entries were modified since the last pass, validates
+     * just those entries (plus their parent linkage) instead of walking the
+     * whole tree; a full-tree pass still runs periodically to cover the
+     * global invariants. This keeps -checkblockindex affordable outside of
+     * tests.
+     *
      * By default this only executes fully when using the Regtest chain; see: m_options.check_block_index.
      */
     void CheckBlockIndex();
@@ -1170,6 +1278,9 @@ public:
      * This function can also be used to read blocks from user-specified block files using the
      * -loadblock= option. There's no unknown-parent tracking, so the last two arguments are omitted.
      *
+     * May be called concurrently from several threads for different files (ImportBlocks does so
+     * during -reindex); the shared blocks_with_unknown_parent map is only accessed under cs_main.
+     *
      *
      * @param[in]     file_in                       File containing blocks to read
      * @param[in]     dbp                           (optional) Disk block position (only for reindex)
@@ -1324,6 +1435,26 @@ public:
 
     CCheckQueue<CScriptCheck>& GetCheckQueue() { return m_script_check_queue; }
 
+    CCheckQueue<CHeaderPoWCheck>& GetPoWCheckQueue() { return m_pow_check_queue; }
+
+    //! Snapshot of the cumulative per-stage block-connection timers, for the
+    //! getblockconnectionstats RPC.
+    struct ConnectBlockTimings {
+        SteadyClock::duration check;
+        SteadyClock::duration forks;
+        SteadyClock::duration connect;
+        SteadyClock::duration verify;
+        SteadyClock::duration undo;
+        SteadyClock::duration index;
+        SteadyClock::duration connect_total;
+        SteadyClock::duration flush;
+        SteadyClock::duration chainstate;
+        SteadyClock::duration post_connect;
+        SteadyClock::duration total;
+        int64_t num_blocks;
+    };
+    ConnectBlockTimings GetConnectBlockTimings() const EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     ~ChainstateManager();
 };
 
@@ -15,10 +15,15 @@
 #include <primitives/transaction.h>
 #include <util/check.h>
 #include <util/task_runner.h>
+#include <util/time.h>
 
+#include <algorithm>
+#include <atomic>
 #include <future>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 /**
  * ValidationSignalsImpl manages a list of shared_ptr<CValidationInterface> callbacks.
@@ -89,6 +94,60 @@ public:
             it = --it->count ? std::next(it) : m_list.erase(it);
         }
     }
+
+    //! Like Iterate, but fans the event out to the subscribers on a small
+    //! worker pool so a slow subscriber (e.g. an indexer's BlockConnected
+    //! handler) only delays itself, not every other listener. The call does
+    //! not return until all subscribers have processed the event, so the
+    //! ordering of events seen by each subscriber is unchanged. Only worth
+    //! using for block-frequency events with heavyweight handlers; the
+    //! per-event thread spawn would dominate for per-transaction signals.
+    template<typename F> void IterateParallel(F&& f) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        // Take a reference to every currently registered callback so the
+        // entries survive concurrent unregistration, mirroring Iterate.
+        std::vector<std::list<ListEntry>::iterator> entries;
+        {
+            LOCK(m_mutex);
+            entries.reserve(m_list.size());
+            for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+                ++it->count;
+                entries.push_back(it);
+            }
+        }
+
+        if (!entries.empty()) {
+            std::atomic<size_t> next_entry{0};
+            auto run_entries = [&] {
+                for (size_t i = next_entry.fetch_add(1); i < entries.size(); i = next_entry.fetch_add(1)) {
+                    const auto start{SteadyClock::now()};
+                    f(*entries[i]->callbacks);
+                    const auto elapsed{SteadyClock::now() - start};
+                    if (elapsed > std::chrono::milliseconds{250}) {
+                        LogDebug(BCLog::VALIDATION, "Validation interface callback took %dms\n",
+                                 Ticks<std::chrono::milliseconds>(elapsed));
+                    }
+                }
+            };
+            const size_t num_threads{std::min(entries.size(), std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4))};
+            if (num_threads <= 1 || entries.size() <= 1) {
+                run_entries();
+            } else {
+                std::vector<std::thread> threads;
+                threads.reserve(num_threads - 1);
+                for (size_t t = 1; t < num_threads; ++t) {
+                    threads.emplace_back(run_entries);
+                }
+                run_entries();
+                for (auto& thread : threads) thread.join();
+            }
+        }
+
+        LOCK(m_mutex);
+        for (const auto& it : entries) {
+            if (!--it->count) m_list.erase(it);
+        }
+    }
 };
 
 ValidationSignals::ValidationSignals(std::unique_ptr<util::TaskRunnerInterface> task_runner)
@@ -210,7 +269,7 @@ void ValidationSignals::TransactionRemovedFromMempool(const CTransactionRef& tx,
 
 void ValidationSignals::BlockConnected(ChainstateRole role, const std::shared_ptr<const CBlock> &pblock, const CBlockIndex *pindex) {
     auto event = [role, pblock, pindex, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.BlockConnected(role, pblock, pindex); });
+        m_internals->IterateParallel([&](CValidationInterface& callbacks) { callbacks.BlockConnected(role, pblock, pindex); });
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s block height=%d", __func__,
                           pblock->GetHash().ToString(),
@@ -230,7 +289,7 @@ void ValidationSignals::MempoolTransactionsRemovedForBlock(const std::vector<Rem
 void ValidationSignals::BlockDisconnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex)
 {
     auto event = [pblock, pindex, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.BlockDisconnected(pblock, pindex); });
+        m_internals->IterateParallel([&](CValidationInterface& callbacks) { callbacks.BlockDisconnected(pblock, pindex); });
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s block height=%d", __func__,
                           pblock->GetHash().ToString(),
@@ -19,7 +19,13 @@
 
 #include <univalue.h>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
 #include <system_error>
+#include <thread>
+#include <vector>
 
 using util::Join;
 
@@ -113,6 +119,15 @@ bool LoadWallets(WalletContext& context)
 {
     interfaces::Chain& chain = *context.chain;
     try {
+        struct WalletToLoad {
+            std::string name;
+            std::unique_ptr<WalletDatabase> database;
+            uint64_t create_flags;
+            std::shared_ptr<CWallet> wallet;
+            bilingual_str error;
+            std::vector<bilingual_str> warnings;
+        };
+        std::vector<WalletToLoad> to_load;
         std::set<fs::path> wallet_paths;
         for (const auto& wallet : chain.getSettingsList("wallet")) {
             if (!wallet.isStr()) {
@@ -130,21 +145,58 @@ bool LoadWallets(WalletContext& context)
             options.require_existing = true;
             options.verify = false; // No need to verify, assuming verified earlier in VerifyWallets()
             bilingual_str error;
-            std::vector<bilingual_str> warnings;
             std::unique_ptr<WalletDatabase> database = MakeWalletDatabase(name, options, status, error);
             if (!database && status == DatabaseStatus::FAILED_NOT_FOUND) {
                 continue;
             }
-            chain.initMessage(_("Loading wallet…"));
-            std::shared_ptr<CWallet> pwallet = database ? CWallet::Create(context, name, std::move(database), options.create_flags, error, warnings) : nullptr;
-            if (!warnings.empty()) chain.initWarning(Join(warnings, Untranslated("\n")));
-            if (!pwallet) {
-                chain.initError(error);
+            to_load.push_back({name, std::move(database), options.create_flags, nullptr, std::move(error), {}});
+        }
+
+        std::mutex ui_mutex;
+        auto load_one = [&](WalletToLoad& entry) {
+            {
+                std::lock_guard lock{ui_mutex};
+                chain.initMessage((entry.name.empty() ? _("Loading wallet…") : strprintf(_("Loading wallet %s…"), entry.name)).translated);
+            }
+            if (!entry.database) return; // error was already set by MakeWalletDatabase
+            try {
+                entry.wallet = CWallet::Create(context, entry.name, std::move(entry.database), entry.create_flags, entry.error, entry.warnings);
+            } catch (const std::runtime_error& e) {
+                entry.wallet = nullptr;
+                entry.error = Untranslated(e.what());
+            }
+        };
+        if (to_load.size() <= 1) {
+            for (auto& entry : to_load) load_one(entry);
+        } else {
+            // Wallet databases are independent of each other, so load them in
+            // parallel. Registration happens afterwards on this thread, in
+            // settings order.
+            const size_t num_threads{std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 4)};
+            std::atomic<size_t> next_wallet{0};
+            std::vector<std::thread> threads;
+            threads.reserve(num_threads);
+            for (size_t t = 0; t < num_threads; ++t) {
+                threads.emplace_back([&] {
+                    while (true) {
+                        const size_t i{next_wallet.fetch_add(1)};
+                        if (i >= to_load.size()) break;
+                        load_one(to_load[i]);
+                    }
+                });
+            }
+            for (auto& thread : threads) thread.join();
+        }
+
+        for (auto& entry : to_load) {
+            if (!entry.warnings.empty()) chain.initWarning(Join(entry.warnings, Untranslated("\n")));
+            if (!entry.wallet) {
+                chain.initError(entry.error);
                 return false;
             }
 
-            NotifyWalletLoaded(context, pwallet);
-            AddWallet(context, pwallet);
+            NotifyWalletLoaded(context, entry.wallet);
+            AddWallet(context, entry.wallet);
         }
         return true;
     } catch (const std::runtime_error& e) {
@@ -168,9 +220,14 @@ void StartWallets(WalletContext& context)
 
 void FlushWallets(WalletContext& context)
 {
+    // Each wallet flushes to its own database file, so run the flushes in
+    // parallel and wait for all of them; the BDB backend serializes
+    // internally where databases share an environment.
+    std::vector<std::future<void>> flushes;
     for (const std::shared_ptr<CWallet>& pwallet : GetWallets(context)) {
-        pwallet->Flush();
+        flushes.emplace_back(std::async(std::launch::async, [pwallet] { pwallet->Flush(); }));
     }
+    for (auto& flush : flushes) flush.get();
 }
 
 void StopWallets(WalletContext& context)
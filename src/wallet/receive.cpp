@@ -296,6 +296,15 @@ Balance GetBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
     isminefilter reuse_filter = avoid_reuse ? ISMINE_NO : ISMINE_USED;
     {
         LOCK(wallet.cs_wallet);
+        // Reuse the previous result if nothing that can affect balances has
+        // changed since it was computed; frequent polling is then O(1)
+        // instead of a full mapWallet walk.
+        if (wallet.m_cached_balance &&
+            wallet.m_cached_balance_generation == wallet.m_balance_generation &&
+            wallet.m_cached_balance_min_depth == min_depth &&
+            wallet.m_cached_balance_avoid_reuse == avoid_reuse) {
+            return *wallet.m_cached_balance;
+        }
         std::set<uint256> trusted_parents;
         for (const auto& entry : wallet.mapWallet)
         {
@@ -315,6 +324,10 @@ Balance GetBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
             ret.m_mine_immature += CachedTxGetImmatureCredit(wallet, wtx, ISMINE_SPENDABLE);
             ret.m_watchonly_immature += CachedTxGetImmatureCredit(wallet, wtx, ISMINE_WATCH_ONLY);
         }
+        wallet.m_cached_balance = std::make_shared<const Balance>(ret);
+        wallet.m_cached_balance_generation = wallet.m_balance_generation;
+        wallet.m_cached_balance_min_depth = min_depth;
+        wallet.m_cached_balance_avoid_reuse = avoid_reuse;
     }
     return ret;
 }
@@ -99,17 +99,15 @@ static UniValue ListReceived(const CWallet& wallet, const UniValue& params, cons
 
     // Tally
     std::map<CTxDestination, tallyitem> mapTally;
-    for (const std::pair<const uint256, CWalletTx>& pairWtx : wallet.mapWallet) {
-        const CWalletTx& wtx = pairWtx.second;
-
+    const auto tally_tx = [&](const CWalletTx& wtx) {
         int nDepth = wallet.GetTxDepthInMainChain(wtx);
         if (nDepth < nMinDepth)
-            continue;
+            return;
 
         // Coinbase with less than 1 confirmation is no longer in the main chain
         if ((wtx.IsCoinBase() && (nDepth < 1))
             || (wallet.IsTxImmatureCoinBase(wtx) && !include_immature_coinbase)) {
-            continue;
+            return;
         }
 
         for (const CTxOut& txout : wtx.tx->vout) {
@@ -132,6 +130,19 @@ static UniValue ListReceived(const CWallet& wallet, const UniValue& params, cons
             if (mine & ISMINE_WATCH_ONLY)
                 item.fIsWatchonly = true;
         }
+    };
+    if (filtered_address) {
+        // Visit only the transactions paying the filtered address, via the
+        // wallet's scriptPubKey index, instead of scanning the whole wallet.
+        if (const auto* txids = wallet.GetTxidsBySpk(GetScriptForDestination(*filtered_address))) {
+            for (const uint256& txid : *txids) {
+                tally_tx(wallet.mapWallet.at(txid));
+            }
+        }
+    } else {
+        for (const std::pair<const uint256, CWalletTx>& pairWtx : wallet.mapWallet) {
+            tally_tx(pairWtx.second);
+        }
     }
 
     // Reply
@@ -649,11 +660,17 @@ RPCHelpMan listsinceblock()
 
     UniValue transactions(UniValue::VARR);
 
-    for (const std::pair<const uint256, CWalletTx>& pairWtx : wallet.mapWallet) {
-        const CWalletTx& tx = pairWtx.second;
-
-        if (depth == -1 || abs(wallet.GetTxDepthInMainChain(tx)) < depth) {
-            ListTransactions(wallet, tx, 0, true, transactions, filter, filter_label, include_change);
+    if (depth == -1) {
+        for (const std::pair<const uint256, CWalletTx>& pairWtx : wallet.mapWallet) {
+            ListTransactions(wallet, pairWtx.second, 0, true, transactions, filter, filter_label, include_change);
+        }
+    } else {
+        // abs(depth in main chain) < depth is equivalent to the confirmed (or
+        // conflicting) block height being above *height, with unconfirmed
+        // transactions always included; the wallet's height index yields
+        // exactly that set without scanning the whole wallet.
+        for (auto it = wallet.m_txs_by_height.upper_bound(*height); it != wallet.m_txs_by_height.end(); ++it) {
+            ListTransactions(wallet, wallet.mapWallet.at(it->second), 0, true, transactions, filter, filter_label, include_change);
         }
     }
 
@@ -2,6 +2,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <common/system.h>
 #include <hash.h>
 #include <key_io.h>
 #include <logging.h>
@@ -19,7 +20,9 @@
 #include <util/translation.h>
 #include <wallet/scriptpubkeyman.h>
 
+#include <atomic>
 #include <optional>
+#include <thread>
 
 using common::PSBTError;
 using util::ToString;
@@ -323,7 +326,7 @@ util::Result<CTxDestination> LegacyScriptPubKeyMan::GetReservedDestination(const
     return GetDestinationForKey(keypool.vchPubKey, type);
 }
 
-bool LegacyScriptPubKeyMan::TopUpInactiveHDChain(const CKeyID seed_id, int64_t index, bool internal)
+bool LegacyScriptPubKeyMan::TopUpInactiveHDChain(const CKeyID seed_id, int64_t index, bool internal, WalletBatch* batch)
 {
     LOCK(cs_KeyStore);
 
@@ -340,13 +343,17 @@ bool LegacyScriptPubKeyMan::TopUpInactiveHDChain(const CKeyID seed_id, int64_t i
         chain.m_next_external_index = std::max(chain.m_next_external_index, index + 1);
     }
 
-    WalletBatch batch(m_storage.GetDatabase());
-    TopUpChain(batch, chain, 0);
+    if (batch) {
+        TopUpChain(*batch, chain, 0);
+    } else {
+        WalletBatch local_batch(m_storage.GetDatabase());
+        TopUpChain(local_batch, chain, 0);
+    }
 
     return true;
 }
 
-std::vector<WalletDestination> LegacyScriptPubKeyMan::MarkUnusedAddresses(const CScript& script)
+std::vector<WalletDestination> LegacyScriptPubKeyMan::MarkUnusedAddresses(const CScript& script, WalletBatch* batch)
 {
     LOCK(cs_KeyStore);
     std::vector<WalletDestination> result;
@@ -363,7 +370,8 @@ std::vector<WalletDestination> LegacyScriptPubKeyMan::MarkUnusedAddresses(const
                 }
             }
 
-            if (!TopUp()) {
+            const bool topped_up{batch ? TopUpWithDB(*batch) : TopUp()};
+            if (!topped_up) {
                 WalletLogPrintf("%s: Topping up keypool failed (locked wallet)\n", __func__);
             }
         }
@@ -391,7 +399,7 @@ std::vector<WalletDestination> LegacyScriptPubKeyMan::MarkUnusedAddresses(const
                     bool internal = (path[1] & ~BIP32_HARDENED_KEY_LIMIT) != 0;
                     int64_t index = path[2] & ~BIP32_HARDENED_KEY_LIMIT;
 
-                    if (!TopUpInactiveHDChain(meta.hd_seed_id, index, internal)) {
+                    if (!TopUpInactiveHDChain(meta.hd_seed_id, index, internal, batch)) {
                         WalletLogPrintf("%s: Adding inactive seed keys failed\n", __func__);
                     }
                 }
@@ -1309,6 +1317,19 @@ bool LegacyScriptPubKeyMan::TopUp(unsigned int kpSize)
 
     WalletBatch batch(m_storage.GetDatabase());
     if (!batch.TxnBegin()) return false;
+    if (!TopUpWithDB(batch, kpSize)) {
+        return false;
+    }
+    if (!batch.TxnCommit()) throw std::runtime_error(strprintf("Error during keypool top up. Cannot commit changes for wallet %s", m_storage.GetDisplayName()));
+    return true;
+}
+
+bool LegacyScriptPubKeyMan::TopUpWithDB(WalletBatch& batch, unsigned int kpSize)
+{
+    if (!CanGenerateKeys()) {
+        return false;
+    }
+
     if (!TopUpChain(batch, m_hd_chain, kpSize)) {
         return false;
     }
@@ -1317,7 +1338,6 @@ bool LegacyScriptPubKeyMan::TopUp(unsigned int kpSize)
             return false;
         }
     }
-    if (!batch.TxnCommit()) throw std::runtime_error(strprintf("Error during keypool top up. Cannot commit changes for wallet %s", m_storage.GetDisplayName()));
     NotifyCanGetAddressesChanged();
     // Note: Unlike with DescriptorSPKM, LegacySPKM does not need to call
     // m_storage.TopUpCallback() as we do not know what new scripts the LegacySPKM is
@@ -2259,6 +2279,7 @@ bool DescriptorScriptPubKeyMan::TopUpWithDB(WalletBatch& batch, unsigned int siz
     provider.keys = GetKeys();
 
     uint256 id = GetID();
+    DescriptorCache new_items;
     for (int32_t i = m_max_cached_index + 1; i < new_range_end; ++i) {
         FlatSigningProvider out_keys;
         std::vector<CScript> scripts_temp;
@@ -2281,13 +2302,17 @@ bool DescriptorScriptPubKeyMan::TopUpWithDB(WalletBatch& batch, unsigned int siz
             }
             m_map_pubkeys[pubkey] = i;
         }
-        // Merge and write the cache
-        DescriptorCache new_items = m_wallet_descriptor.cache.MergeAndDiff(temp_cache);
-        if (!batch.WriteDescriptorCacheItems(id, new_items)) {
-            throw std::runtime_error(std::string(__func__) + ": writing cache items failed");
-        }
+        // Merge into the in-memory cache and accumulate the new items. They
+        // are written in a single batch below rather than once per index,
+        // which dominates the cost of topping up large ranges. Until the
+        // updated range_end is written the cache items carry no meaning, so
+        // deferring them loses nothing on a crash.
+        new_items.MergeAndDiff(m_wallet_descriptor.cache.MergeAndDiff(temp_cache));
         m_max_cached_index++;
     }
+    if (!batch.WriteDescriptorCacheItems(id, new_items)) {
+        throw std::runtime_error(std::string(__func__) + ": writing cache items failed");
+    }
     m_wallet_descriptor.range_end = new_range_end;
     batch.WriteDescriptor(GetID(), m_wallet_descriptor);
 
@@ -2299,7 +2324,7 @@ bool DescriptorScriptPubKeyMan::TopUpWithDB(WalletBatch& batch, unsigned int siz
     return true;
 }
 
-std::vector<WalletDestination> DescriptorScriptPubKeyMan::MarkUnusedAddresses(const CScript& script)
+std::vector<WalletDestination> DescriptorScriptPubKeyMan::MarkUnusedAddresses(const CScript& script, WalletBatch* batch)
 {
     LOCK(cs_desc_man);
     std::vector<WalletDestination> result;
@@ -2319,7 +2344,8 @@ std::vector<WalletDestination> DescriptorScriptPubKeyMan::MarkUnusedAddresses(co
                 m_wallet_descriptor.next_index++;
             }
         }
-        if (!TopUp()) {
+        const bool topped_up{batch ? TopUpWithDB(*batch) : TopUp()};
+        if (!topped_up) {
             WalletLogPrintf("%s: Topping up keypool failed (locked wallet)\n", __func__);
         }
     }
@@ -2550,6 +2576,15 @@ std::optional<PSBTError> DescriptorScriptPubKeyMan::FillPSBT(PartiallySignedTran
     if (n_signed) {
         *n_signed = 0;
     }
+    // First pass: validate each input and gather its signing provider. The
+    // provider lookups serialize on cs_desc_man and must stay on this thread;
+    // the (expensive) signature creation below need not.
+    struct SigningJob {
+        unsigned int index;
+        std::unique_ptr<FlatSigningProvider> keys;
+    };
+    std::vector<SigningJob> jobs;
+    jobs.reserve(psbtx.tx->vin.size());
     for (unsigned int i = 0; i < psbtx.tx->vin.size(); ++i) {
         const CTxIn& txin = psbtx.tx->vin[i];
         PSBTInput& input = psbtx.inputs.at(i);
@@ -2620,9 +2655,34 @@ std::optional<PSBTError> DescriptorScriptPubKeyMan::FillPSBT(PartiallySignedTran
             }
         }
 
-        SignPSBTInput(HidingSigningProvider(keys.get(), /*hide_secret=*/!sign, /*hide_origin=*/!bip32derivs), psbtx, i, &txdata, sighash_type, nullptr, finalize);
+        jobs.push_back({i, std::move(keys)});
+    }
+
+    // Second pass: produce the signatures. Inputs are independent - each
+    // SignPSBTInput call mutates only its own PSBTInput and reads the shared
+    // transaction and sighash cache - so large spends fan out to all cores.
+    auto sign_one = [&](SigningJob& job) {
+        SignPSBTInput(HidingSigningProvider(job.keys.get(), /*hide_secret=*/!sign, /*hide_origin=*/!bip32derivs), psbtx, job.index, &txdata, sighash_type, nullptr, finalize);
+    };
+    if (sign && jobs.size() >= PSBT_PARALLEL_SIGN_THRESHOLD && GetNumCores() > 1) {
+        const size_t num_threads{std::min(jobs.size(), size_t(std::clamp(GetNumCores(), 2, 16)))};
+        std::atomic<size_t> next_job{0};
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&] {
+                for (size_t j = next_job.fetch_add(1); j < jobs.size(); j = next_job.fetch_add(1)) {
+                    sign_one(jobs[j]);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    } else {
+        for (auto& job : jobs) sign_one(job);
+    }
 
-        bool signed_one = PSBTInputSigned(input);
+    for (const auto& job : jobs) {
+        bool signed_one = PSBTInputSigned(psbtx.inputs.at(job.index));
         if (n_signed && (signed_one || !sign)) {
             // If sign is false, we assume that we _could_ sign if we get here. This
             // will never have false negatives; it is hard to tell under what i
@@ -203,7 +203,10 @@ public:
      *
      * @return All of the addresses affected
      */
-    virtual std::vector<WalletDestination> MarkUnusedAddresses(const CScript& script) { return {}; }
+    //! Mark keypool entries covering this script as used. When a batch is
+    //! given, any resulting keypool top-up writes through it (the caller may
+    //! hold a database transaction); otherwise a fresh batch is used.
+    virtual std::vector<WalletDestination> MarkUnusedAddresses(const CScript& script, WalletBatch* batch = nullptr) { return {}; }
 
     /** Sets up the key generation stuff, i.e. generates new HD seeds and sets them as active.
       * Returns false if already setup or setup fails, true if setup is successful
@@ -446,7 +449,7 @@ private:
      *
      * @return true if seed was found and keys were derived. false if unable to derive seeds
      */
-    bool TopUpInactiveHDChain(const CKeyID seed_id, int64_t index, bool internal);
+    bool TopUpInactiveHDChain(const CKeyID seed_id, int64_t index, bool internal, WalletBatch* batch = nullptr);
 
     bool TopUpChain(WalletBatch& batch, CHDChain& chain, unsigned int size);
 public:
@@ -461,8 +464,9 @@ public:
     void ReturnDestination(int64_t index, bool internal, const CTxDestination&) override;
 
     bool TopUp(unsigned int size = 0) override;
+    bool TopUpWithDB(WalletBatch& batch, unsigned int kpSize = 0);
 
-    std::vector<WalletDestination> MarkUnusedAddresses(const CScript& script) override;
+    std::vector<WalletDestination> MarkUnusedAddresses(const CScript& script, WalletBatch* batch = nullptr) override;
 
     //! Upgrade stored CKeyMetadata objects to store key origin info as KeyOriginInfo
     void UpgradeKeyMetadata();
@@ -650,7 +654,7 @@ public:
     // (with or without private keys), the "keypool" is a single xpub.
     bool TopUp(unsigned int size = 0) override;
 
-    std::vector<WalletDestination> MarkUnusedAddresses(const CScript& script) override;
+    std::vector<WalletDestination> MarkUnusedAddresses(const CScript& script, WalletBatch* batch = nullptr) override;
 
     bool IsHDEnabled() const override;
 
@@ -900,9 +900,19 @@ util::Result<SelectionResult> AutomaticCoinSelection(const CWallet& wallet, Coin
         // If no solution is found, return the first detailed error (if any).
         // future: add "error level" so the worst one can be picked instead.
         std::vector<util::Result<SelectionResult>> res_detailed_errors;
+        std::optional<size_t> last_attempt_size;
+        bool last_allow_mixed{false};
         for (const auto& select_filter : ordered_filters) {
             auto it = filtered_groups.find(select_filter.filter);
             if (it == filtered_groups.end()) continue;
+            // The ordered filters only ever relax constraints, so each filter's group set contains
+            // the previous one's. If relaxing the filter admitted no new groups and does not newly
+            // allow mixing output types, this attempt would re-run the same algorithms over the
+            // same pool and fail the same way, so skip it.
+            const size_t attempt_size{it->second.all_groups.positive_group.size() + it->second.all_groups.mixed_group.size()};
+            if (last_attempt_size == attempt_size && !(select_filter.allow_mixed_output_types && !last_allow_mixed)) continue;
+            last_attempt_size = attempt_size;
+            last_allow_mixed = select_filter.allow_mixed_output_types;
             if (auto res{AttemptSelection(wallet.chain(), value_to_select, it->second,
                                           coin_selection_params, select_filter.allow_mixed_output_types)}) {
                 return res; // result found
@@ -311,6 +311,9 @@ std::shared_ptr<CWallet> LoadWalletInternal(WalletContext& context, const std::s
 class FastWalletRescanFilter
 {
 public:
+    //! Number of upcoming block filters matched per parallel prematch batch.
+    static constexpr size_t MATCH_LOOKAHEAD{512};
+
     FastWalletRescanFilter(const CWallet& wallet) : m_wallet(wallet)
     {
         // fast rescanning via block filters is only supported by descriptor wallets right now
@@ -338,15 +341,50 @@ public:
             if (current_range_end > last_range_end) {
                 AddScriptPubKeys(desc_spkm, last_range_end);
                 m_last_range_ends.at(desc_spkm->GetID()) = current_range_end;
+                // results matched against the smaller script set could be
+                // false negatives now
+                m_prematched.clear();
             }
         }
     }
 
     std::optional<bool> MatchesBlock(const uint256& block_hash) const
     {
+        if (const auto it{m_prematched.find(block_hash)}; it != m_prematched.end()) return it->second;
         return m_wallet.chain().blockFilterMatchesAny(BlockFilterType::BASIC, block_hash, m_filter_set);
     }
 
+    bool IsPrematched(const uint256& block_hash) const
+    {
+        return m_prematched.count(block_hash) > 0;
+    }
+
+    //! Match the filters of the given blocks against the wallet's script set
+    //! on multiple threads, caching the results for MatchesBlock(). Replaces
+    //! the previous window, keeping the cache bounded. A match result depends
+    //! only on the block and the script set, so cached entries survive reorgs.
+    void PrematchBlocks(const std::vector<uint256>& block_hashes)
+    {
+        std::vector<std::optional<bool>> results(block_hashes.size());
+        const size_t num_threads{std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 8)};
+        std::vector<std::thread> workers;
+        std::atomic<size_t> next_index{0};
+        for (size_t t{0}; t < num_threads; ++t) {
+            workers.emplace_back([&] {
+                for (size_t i{next_index++}; i < block_hashes.size(); i = next_index++) {
+                    results[i] = m_wallet.chain().blockFilterMatchesAny(BlockFilterType::BASIC, block_hashes[i], m_filter_set);
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        m_prematched.clear();
+        m_prematched.reserve(block_hashes.size());
+        for (size_t i{0}; i < block_hashes.size(); ++i) {
+            m_prematched.emplace(block_hashes[i], results[i]);
+        }
+    }
+
 private:
     const CWallet& m_wallet;
     /** Map for keeping track of each range descriptor's last seen end range.
@@ -357,6 +395,8 @@ private:
       */
     std::map<uint256, int32_t> m_last_range_ends;
     GCSFilter::ElementSet m_filter_set;
+    //! Filter-match results for the current look-ahead window, by block hash.
+    std::unordered_map<uint256, std::optional<bool>, SaltedTxidHasher> m_prematched;
 
     void AddScriptPubKeys(const DescriptorScriptPubKeyMan* desc_spkm, int32_t last_range_end = 0)
     {
@@ -983,6 +1023,7 @@ void CWallet::MarkDirty()
 {
     {
         LOCK(cs_wallet);
+        MarkBalanceDirty();
         for (std::pair<const uint256, CWalletTx>& item : mapWallet)
             item.second.MarkDirty();
     }
@@ -1069,11 +1110,76 @@ bool CWallet::IsSpentKey(const CScript& scriptPubKey) const
     return false;
 }
 
-CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const UpdateWalletTxFn& update_wtx, bool fFlushOnClose, bool rescanning_old_block)
+//! Key under which a transaction in this state sorts in m_txs_by_height.
+static int TxHeightIndexKey(const TxState& state)
+{
+    if (auto* conf = std::get_if<TxStateConfirmed>(&state)) return conf->confirmed_block_height;
+    if (auto* conflicted = std::get_if<TxStateBlockConflicted>(&state)) return conflicted->conflicting_block_height;
+    // Unconfirmed (and abandoned) transactions are part of every height window.
+    return std::numeric_limits<int>::max();
+}
+
+void CWallet::AddTxToIndexes(const CWalletTx& wtx)
+{
+    AssertLockHeld(cs_wallet);
+    const uint256 txid = wtx.GetHash();
+    for (const CTxOut& txout : wtx.tx->vout) {
+        std::vector<uint256>& txids = m_txids_by_spk[txout.scriptPubKey];
+        if (txids.empty() || txids.back() != txid) txids.push_back(txid);
+    }
+    m_txs_by_height.emplace(TxHeightIndexKey(wtx.m_state), txid);
+}
+
+void CWallet::RemoveTxFromIndexes(const CWalletTx& wtx)
+{
+    AssertLockHeld(cs_wallet);
+    const uint256 txid = wtx.GetHash();
+    for (const CTxOut& txout : wtx.tx->vout) {
+        auto it = m_txids_by_spk.find(txout.scriptPubKey);
+        if (it == m_txids_by_spk.end()) continue;
+        std::erase(it->second, txid);
+        if (it->second.empty()) m_txids_by_spk.erase(it);
+    }
+    auto range = m_txs_by_height.equal_range(TxHeightIndexKey(wtx.m_state));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == txid) {
+            m_txs_by_height.erase(it);
+            break;
+        }
+    }
+}
+
+void CWallet::RefreshTxHeightIndex(const CWalletTx& wtx, int old_key)
+{
+    AssertLockHeld(cs_wallet);
+    const int new_key = TxHeightIndexKey(wtx.m_state);
+    if (new_key == old_key) return;
+    const uint256 txid = wtx.GetHash();
+    auto range = m_txs_by_height.equal_range(old_key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == txid) {
+            m_txs_by_height.erase(it);
+            break;
+        }
+    }
+    m_txs_by_height.emplace(new_key, txid);
+}
+
+const std::vector<uint256>* CWallet::GetTxidsBySpk(const CScript& script) const
+{
+    AssertLockHeld(cs_wallet);
+    auto it = m_txids_by_spk.find(script);
+    return it != m_txids_by_spk.end() ? &it->second : nullptr;
+}
+
+CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const UpdateWalletTxFn& update_wtx, bool fFlushOnClose, bool rescanning_old_block, WalletBatch* input_batch)
 {
     LOCK(cs_wallet);
+    MarkBalanceDirty();
 
-    WalletBatch batch(GetDatabase(), fFlushOnClose);
+    std::optional<WalletBatch> local_batch;
+    if (!input_batch) local_batch.emplace(GetDatabase(), fFlushOnClose);
+    WalletBatch& batch{input_batch ? *input_batch : *local_batch};
 
     uint256 hash = tx->GetHash();
 
@@ -1100,6 +1206,7 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
         wtx.m_it_wtxOrdered = wtxOrdered.insert(std::make_pair(wtx.nOrderPos, &wtx));
         wtx.nTimeSmart = ComputeTimeSmart(wtx, rescanning_old_block);
         AddToSpends(wtx, &batch);
+        AddTxToIndexes(wtx);
 
         // Update birth time when tx time is older than it.
         MaybeUpdateBirthTime(wtx.GetTxTime());
@@ -1108,7 +1215,9 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
     if (!fInsertedNew)
     {
         if (state.index() != wtx.m_state.index()) {
+            const int old_height_key = TxHeightIndexKey(wtx.m_state);
             wtx.m_state = state;
+            RefreshTxHeightIndex(wtx, old_height_key);
             fUpdated = true;
         } else {
             assert(TxStateSerializedIndex(wtx.m_state) == TxStateSerializedIndex(state));
@@ -1134,7 +1243,9 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
         while (!txs.empty()) {
             CWalletTx* desc_tx = txs.back();
             txs.pop_back();
+            const int old_height_key = TxHeightIndexKey(desc_tx->m_state);
             desc_tx->m_state = inactive_state;
+            RefreshTxHeightIndex(*desc_tx, old_height_key);
             // Break caches since we have changed the state
             desc_tx->MarkDirty();
             batch.WriteTx(*desc_tx);
@@ -1211,6 +1322,7 @@ bool CWallet::LoadToWallet(const uint256& hash, const UpdateWalletTxFn& fill_wtx
     }
     if (/* insertion took place */ ins.second) {
         wtx.m_it_wtxOrdered = wtxOrdered.insert(std::make_pair(wtx.nOrderPos, &wtx));
+        AddTxToIndexes(wtx);
     }
     AddToSpends(wtx);
     for (const CTxIn& txin : wtx.tx->vin) {
@@ -1229,7 +1341,7 @@ bool CWallet::LoadToWallet(const uint256& hash, const UpdateWalletTxFn& fill_wtx
     return true;
 }
 
-bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, const SyncTxState& state, bool fUpdate, bool rescanning_old_block)
+bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, const SyncTxState& state, bool fUpdate, bool rescanning_old_block, WalletBatch* batch)
 {
     const CTransaction& tx = *ptx;
     {
@@ -1241,7 +1353,7 @@ bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, const SyncTxS
                 while (range.first != range.second) {
                     if (range.first->second != tx.GetHash()) {
                         WalletLogPrintf("Transaction %s (in block %s) conflicts with wallet transaction %s (both spend %s:%i)\n", tx.GetHash().ToString(), conf->confirmed_block_hash.ToString(), range.first->second.ToString(), range.first->first.hash.ToString(), range.first->first.n);
-                        MarkConflicted(conf->confirmed_block_hash, conf->confirmed_block_height, range.first->second);
+                        MarkConflicted(conf->confirmed_block_hash, conf->confirmed_block_height, range.first->second, batch);
                     }
                     range.first++;
                 }
@@ -1261,7 +1373,7 @@ bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, const SyncTxS
             // loop though all outputs
             for (const CTxOut& txout: tx.vout) {
                 for (const auto& spk_man : GetScriptPubKeyMans(txout.scriptPubKey)) {
-                    for (auto &dest : spk_man->MarkUnusedAddresses(txout.scriptPubKey)) {
+                    for (auto &dest : spk_man->MarkUnusedAddresses(txout.scriptPubKey, batch)) {
                         // If internal flag is not defined try to infer it from the ScriptPubKeyMan
                         if (!dest.internal.has_value()) {
                             dest.internal = IsInternalScriptPubKeyMan(spk_man);
@@ -1274,7 +1386,11 @@ bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, const SyncTxS
                         // (e.g. it wasn't generated on this node or we're restoring from backup)
                         // add it to the address book for proper transaction accounting
                         if (!*dest.internal && !FindAddressBookEntry(dest.dest, /* allow_change= */ false)) {
-                            SetAddressBook(dest.dest, "", AddressPurpose::RECEIVE);
+                            if (batch) {
+                                SetAddressBookWithDB(*batch, dest.dest, "", AddressPurpose::RECEIVE);
+                            } else {
+                                SetAddressBook(dest.dest, "", AddressPurpose::RECEIVE);
+                            }
                         }
                     }
                 }
@@ -1283,7 +1399,7 @@ bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, const SyncTxS
             // Block disconnection override an abandoned tx as unconfirmed
             // which means user may have to call abandontransaction again
             TxState tx_state = std::visit([](auto&& s) -> TxState { return s; }, state);
-            CWalletTx* wtx = AddToWallet(MakeTransactionRef(tx), tx_state, /*update_wtx=*/nullptr, /*fFlushOnClose=*/false, rescanning_old_block);
+            CWalletTx* wtx = AddToWallet(MakeTransactionRef(tx), tx_state, /*update_wtx=*/nullptr, /*fFlushOnClose=*/false, rescanning_old_block, batch);
             if (!wtx) {
                 // Can only be nullptr if there was a db write error (missing db, read-only db or a db engine internal writing error).
                 // As we only store arriving transaction in this process, and we don't want an inconsistent state, let's throw an error.
@@ -1304,6 +1420,7 @@ bool CWallet::TransactionCanBeAbandoned(const uint256& hashTx) const
 
 void CWallet::MarkInputsDirty(const CTransactionRef& tx)
 {
+    MarkBalanceDirty();
     for (const CTxIn& txin : tx->vin) {
         auto it = mapWallet.find(txin.prevout.hash);
         if (it != mapWallet.end()) {
@@ -1347,7 +1464,7 @@ bool CWallet::AbandonTransaction(const uint256& hashTx)
     return true;
 }
 
-void CWallet::MarkConflicted(const uint256& hashBlock, int conflicting_height, const uint256& hashTx)
+void CWallet::MarkConflicted(const uint256& hashBlock, int conflicting_height, const uint256& hashTx, WalletBatch* batch)
 {
     LOCK(cs_wallet);
 
@@ -1373,7 +1490,11 @@ void CWallet::MarkConflicted(const uint256& hashBlock, int conflicting_height, c
     };
 
     // Iterate over all its outputs, and mark transactions in the wallet that spend them conflicted too.
-    RecursiveUpdateTxState(hashTx, try_updating_state);
+    if (batch) {
+        RecursiveUpdateTxState(batch, hashTx, try_updating_state);
+    } else {
+        RecursiveUpdateTxState(hashTx, try_updating_state);
+    }
 
 }
 
@@ -1397,8 +1518,10 @@ void CWallet::RecursiveUpdateTxState(WalletBatch* batch, const uint256& tx_hash,
         assert(it != mapWallet.end());
         CWalletTx& wtx = it->second;
 
+        const int old_height_key = TxHeightIndexKey(wtx.m_state);
         TxUpdate update_state = try_updating_state(wtx);
         if (update_state != TxUpdate::UNCHANGED) {
+            RefreshTxHeightIndex(wtx, old_height_key);
             wtx.MarkDirty();
             if (batch) batch->WriteTx(wtx);
             // Iterate over all its outputs, and update those tx states as well (if applicable)
@@ -1422,9 +1545,9 @@ void CWallet::RecursiveUpdateTxState(WalletBatch* batch, const uint256& tx_hash,
     }
 }
 
-void CWallet::SyncTransaction(const CTransactionRef& ptx, const SyncTxState& state, bool update_tx, bool rescanning_old_block)
+void CWallet::SyncTransaction(const CTransactionRef& ptx, const SyncTxState& state, bool update_tx, bool rescanning_old_block, WalletBatch* batch)
 {
-    if (!AddToWalletIfInvolvingMe(ptx, state, update_tx, rescanning_old_block))
+    if (!AddToWalletIfInvolvingMe(ptx, state, update_tx, rescanning_old_block, batch))
         return; // Not one of ours
 
     // If a transaction changes 'conflicted' state, that changes the balance
@@ -1435,6 +1558,7 @@ void CWallet::SyncTransaction(const CTransactionRef& ptx, const SyncTxState& sta
 
 void CWallet::transactionAddedToMempool(const CTransactionRef& tx) {
     LOCK(cs_wallet);
+    MarkBalanceDirty();
     SyncTransaction(tx, TxStateInMempool{});
 
     auto it = mapWallet.find(tx->GetHash());
@@ -1459,6 +1583,7 @@ void CWallet::transactionAddedToMempool(const CTransactionRef& tx) {
 
 void CWallet::transactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason) {
     LOCK(cs_wallet);
+    MarkBalanceDirty();
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
@@ -1524,11 +1649,18 @@ void CWallet::blockConnected(ChainstateRole role, const interfaces::BlockInfo& b
     // Uses chain max time and twice the grace period to adjust time for block time variability.
     if (block.chain_time_max < m_birth_time.load() - (TIMESTAMP_WINDOW * 2)) return;
 
-    // Scan block
+    // Scan block. All wallet updates for the block go through one batch
+    // holding a single database transaction, so the per-record commits (one
+    // fsync each on SQLite) collapse into one.
+    WalletBatch batch(GetDatabase());
+    const bool batch_txn{batch.TxnBegin()};
     for (size_t index = 0; index < block.data->vtx.size(); index++) {
-        SyncTransaction(block.data->vtx[index], TxStateConfirmed{block.hash, block.height, static_cast<int>(index)});
+        SyncTransaction(block.data->vtx[index], TxStateConfirmed{block.hash, block.height, static_cast<int>(index)}, /*update_tx=*/true, /*rescanning_old_block=*/false, &batch);
         transactionRemovedFromMempool(block.data->vtx[index], MemPoolRemovalReason::BLOCK);
     }
+    if (batch_txn && !batch.TxnCommit()) {
+        throw std::runtime_error(strprintf("Error committing wallet updates for block %s", block.hash.ToString()));
+    }
 }
 
 void CWallet::blockDisconnected(const interfaces::BlockInfo& block)
@@ -1545,8 +1677,12 @@ void CWallet::blockDisconnected(const interfaces::BlockInfo& block)
 
     int disconnect_height = block.height;
 
+    // As with blockConnected, commit all wallet updates for the block in one
+    // database transaction.
+    WalletBatch batch(GetDatabase());
+    const bool batch_txn{batch.TxnBegin()};
     for (const CTransactionRef& ptx : Assert(block.data)->vtx) {
-        SyncTransaction(ptx, TxStateInactive{});
+        SyncTransaction(ptx, TxStateInactive{}, /*update_tx=*/true, /*rescanning_old_block=*/false, &batch);
 
         for (const CTxIn& tx_in : ptx->vin) {
             // No other wallet transactions conflicted with this transaction
@@ -1569,10 +1705,13 @@ void CWallet::blockDisconnected(const interfaces::BlockInfo& block)
                     return TxUpdate::UNCHANGED;
                 };
 
-                RecursiveUpdateTxState(wtx.tx->GetHash(), try_updating_state);
+                RecursiveUpdateTxState(&batch, wtx.tx->GetHash(), try_updating_state);
             }
         }
     }
+    if (batch_txn && !batch.TxnCommit()) {
+        throw std::runtime_error(strprintf("Error committing wallet updates for disconnected block %s", block.hash.ToString()));
+    }
 }
 
 void CWallet::updatedBlockTip()
@@ -1624,6 +1763,16 @@ isminetype CWallet::IsMine(const CScript& script) const
 {
     AssertLockHeld(cs_wallet);
 
+    // Front-line filter: settle the common not-mine case with two bit probes
+    // before paying for a full cache lookup. Legacy wallet scripts are not
+    // tracked by the filter, so those still consult their SPKM directly.
+    if (!m_spk_filter.empty() && !SpkFilterMayContain(script)) {
+        if (LegacyScriptPubKeyMan* spkm = GetLegacyScriptPubKeyMan()) {
+            return spkm->IsMine(script);
+        }
+        return ISMINE_NO;
+    }
+
     // Search the cache so that IsMine is called only on the relevant SPKMs instead of on everything in m_spk_managers
     const auto& it = m_cached_spks.find(script);
     if (it != m_cached_spks.end()) {
@@ -1911,6 +2060,18 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
     double progress_end = chain().guessVerificationProgress(end_hash);
     double progress_current = progress_begin;
     int block_height = start_height;
+
+    // One-block read-ahead: while the current block is matched against the
+    // wallet under cs_wallet, the next one is already being fetched on a
+    // helper thread. Matching has to be applied in block order, so deeper
+    // pipelining would not help; overlapping the read (which includes the
+    // proof-of-work re-check) with the scan hides most of its cost.
+    uint256 prefetch_hash;
+    CBlock prefetch_block;
+    std::thread prefetch_thread;
+    const auto join_prefetch{[&] {
+        if (prefetch_thread.joinable()) prefetch_thread.join();
+    }};
     while (!fAbortRescan && !chain().shutdownRequested()) {
         if (progress_end - progress_begin > 0.0) {
             m_scanning_progress = (progress_current - progress_begin) / (progress_end - progress_begin);
@@ -1930,6 +2091,24 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
         bool fetch_block{true};
         if (fast_rescan_filter) {
             fast_rescan_filter->UpdateIfNeeded();
+            if (!fast_rescan_filter->IsPrematched(block_hash)) {
+                // Refill the look-ahead window: collect the hashes of the
+                // upcoming blocks along the active chain and match their
+                // filters in parallel, so the scan loop below mostly consults
+                // precomputed results.
+                std::vector<uint256> window{block_hash};
+                window.reserve(FastWalletRescanFilter::MATCH_LOOKAHEAD);
+                uint256 walk{block_hash};
+                while (window.size() < FastWalletRescanFilter::MATCH_LOOKAHEAD) {
+                    bool in_chain{false};
+                    uint256 next_hash;
+                    chain().findBlock(walk, FoundBlock().nextBlock(FoundBlock().inActiveChain(in_chain).hash(next_hash)));
+                    if (!in_chain) break;
+                    walk = next_hash;
+                    window.push_back(walk);
+                }
+                fast_rescan_filter->PrematchBlocks(window);
+            }
             auto matches_block{fast_rescan_filter->MatchesBlock(block_hash)};
             if (matches_block.has_value()) {
                 if (*matches_block) {
@@ -1951,11 +2130,38 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
         uint256 next_block_hash;
         chain().findBlock(block_hash, FoundBlock().inActiveChain(block_still_active).nextBlock(FoundBlock().inActiveChain(next_block).hash(next_block_hash)));
 
+        // Read block data, preferring the read-ahead buffer filled while the
+        // previous block was being scanned.
+        CBlock block;
         if (fetch_block) {
-            // Read block data
-            CBlock block;
-            chain().findBlock(block_hash, FoundBlock().data(block));
+            join_prefetch();
+            if (block_hash == prefetch_hash) {
+                block = std::move(prefetch_block);
+                prefetch_hash.SetNull();
+            } else {
+                chain().findBlock(block_hash, FoundBlock().data(block));
+            }
+        }
 
+        // Start fetching the next block before matching this one, unless the
+        // filter already tells us it will be skipped.
+        if (next_block) {
+            join_prefetch();
+            bool prefetch_next{true};
+            if (fast_rescan_filter) {
+                const auto matches{fast_rescan_filter->MatchesBlock(next_block_hash)};
+                prefetch_next = !matches.has_value() || *matches;
+            }
+            if (prefetch_next) {
+                prefetch_hash = next_block_hash;
+                prefetch_thread = std::thread([&] {
+                    prefetch_block.SetNull();
+                    chain().findBlock(prefetch_hash, FoundBlock().data(prefetch_block));
+                });
+            }
+        }
+
+        if (fetch_block) {
             if (!block.IsNull()) {
                 LOCK(cs_wallet);
                 if (!block_still_active) {
@@ -2011,6 +2217,7 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
             }
         }
     }
+    join_prefetch();
     if (!max_height) {
         WalletLogPrintf("Scanning current mempool transactions.\n");
         WITH_LOCK(cs_wallet, chain().requestMempoolTransactions(*this));
@@ -2433,6 +2640,7 @@ util::Result<void> CWallet::RemoveTxs(WalletBatch& batch, std::vector<uint256>&
             wtxOrdered.erase(it->second.m_it_wtxOrdered);
             for (const auto& txin : it->second.tx->vin)
                 mapTxSpends.erase(txin.prevout);
+            RemoveTxFromIndexes(it->second);
             mapWallet.erase(it);
             NotifyTransactionChanged(hash, CT_DELETED);
         }
@@ -2611,6 +2819,7 @@ std::optional<int64_t> CWallet::GetOldestKeyPoolTime() const
 }
 
 void CWallet::MarkDestinationsDirty(const std::set<CTxDestination>& destinations) {
+    MarkBalanceDirty();
     for (auto& entry : mapWallet) {
         CWalletTx& wtx = entry.second;
         if (wtx.m_is_cache_empty) continue;
@@ -4613,11 +4822,51 @@ util::Result<MigrationResult> MigrateLegacyToDescriptor(std::shared_ptr<CWallet>
     return res;
 }
 
+void CWallet::SpkFilterInsert(size_t hash)
+{
+    // The two probes draw on disjoint bits of the salted 64-bit hash, so a
+    // low-bit collision with a member does not imply the other probe matches.
+    const uint64_t h{static_cast<uint64_t>(hash)};
+    const uint64_t p1{h & m_spk_filter_mask};
+    const uint64_t p2{(h >> 32) & m_spk_filter_mask};
+    m_spk_filter[p1 >> 6] |= uint64_t{1} << (p1 & 63);
+    m_spk_filter[p2 >> 6] |= uint64_t{1} << (p2 & 63);
+}
+
+bool CWallet::SpkFilterMayContain(const CScript& script) const
+{
+    const uint64_t h{static_cast<uint64_t>(m_cached_spks.hash_function()(script))};
+    const uint64_t p1{h & m_spk_filter_mask};
+    const uint64_t p2{(h >> 32) & m_spk_filter_mask};
+    return (m_spk_filter[p1 >> 6] & (uint64_t{1} << (p1 & 63))) &&
+           (m_spk_filter[p2 >> 6] & (uint64_t{1} << (p2 & 63)));
+}
+
+void CWallet::RebuildSpkFilter()
+{
+    size_t bits{1 << 14};
+    while (bits < m_cached_spks.size() * SPK_FILTER_BITS_PER_ENTRY) bits <<= 1;
+    m_spk_filter.assign(bits / 64, 0);
+    m_spk_filter_mask = bits - 1;
+    for (const auto& [script, _] : m_cached_spks) {
+        SpkFilterInsert(m_cached_spks.hash_function()(script));
+    }
+}
+
 void CWallet::CacheNewScriptPubKeys(const std::set<CScript>& spks, ScriptPubKeyMan* spkm)
 {
     for (const auto& script : spks) {
         m_cached_spks[script].push_back(spkm);
     }
+    // Keep the negative-lookup filter in sync: grow-and-rebuild when the
+    // sizing target is exceeded, otherwise add the new scripts in place.
+    if (m_spk_filter.empty() || m_cached_spks.size() * SPK_FILTER_BITS_PER_ENTRY > m_spk_filter.size() * 64) {
+        RebuildSpkFilter();
+    } else {
+        for (const auto& script : spks) {
+            SpkFilterInsert(m_cached_spks.hash_function()(script));
+        }
+    }
 }
 
 void CWallet::TopUpCallback(const std::set<CScript>& spks, ScriptPubKeyMan* spkm)
@@ -293,6 +293,7 @@ struct CRecipient
 };
 
 class WalletRescanReserver; //forward declarations for ScanForWalletTransactions/RescanFromTime
+struct Balance; //forward declaration for the memoized GetBalance result
 /**
  * A CWallet maintains a set of transactions and balances, and provides the ability to create new transactions.
  */
@@ -352,10 +353,10 @@ private:
      * Should be called with rescanning_old_block set to true, if the transaction is
      * not discovered in real time, but during a rescan of old blocks.
      */
-    bool AddToWalletIfInvolvingMe(const CTransactionRef& tx, const SyncTxState& state, bool fUpdate, bool rescanning_old_block) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    bool AddToWalletIfInvolvingMe(const CTransactionRef& tx, const SyncTxState& state, bool fUpdate, bool rescanning_old_block, WalletBatch* batch = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
     /** Mark a transaction (and its in-wallet descendants) as conflicting with a particular block. */
-    void MarkConflicted(const uint256& hashBlock, int conflicting_height, const uint256& hashTx);
+    void MarkConflicted(const uint256& hashBlock, int conflicting_height, const uint256& hashTx, WalletBatch* batch = nullptr);
 
     enum class TxUpdate { UNCHANGED, CHANGED, NOTIFY_CHANGED };
 
@@ -365,12 +366,21 @@ private:
     void RecursiveUpdateTxState(const uint256& tx_hash, const TryUpdatingStateFn& try_updating_state) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
     void RecursiveUpdateTxState(WalletBatch* batch, const uint256& tx_hash, const TryUpdatingStateFn& try_updating_state) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
+    /** Add a transaction to m_txids_by_spk and m_txs_by_height. Called once
+     * per transaction, when it enters mapWallet. */
+    void AddTxToIndexes(const CWalletTx& wtx) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    /** Remove a transaction from both indexes, before it leaves mapWallet. */
+    void RemoveTxFromIndexes(const CWalletTx& wtx) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    /** Re-key a transaction in m_txs_by_height after its state changed.
+     * old_key is TxHeightIndexKey() of the state before the change. */
+    void RefreshTxHeightIndex(const CWalletTx& wtx, int old_key) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+
     /** Mark a transaction's inputs dirty, thus forcing the outputs to be recomputed */
     void MarkInputsDirty(const CTransactionRef& tx) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
     void SyncMetaData(std::pair<TxSpends::iterator, TxSpends::iterator>) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
-    void SyncTransaction(const CTransactionRef& tx, const SyncTxState& state, bool update_tx = true, bool rescanning_old_block = false) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    void SyncTransaction(const CTransactionRef& tx, const SyncTxState& state, bool update_tx = true, bool rescanning_old_block = false, WalletBatch* batch = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
     /** WalletFlags set on this wallet. */
     std::atomic<uint64_t> m_wallet_flags{0};
@@ -428,6 +438,23 @@ private:
     //! Cache of descriptor ScriptPubKeys used for IsMine. Maps ScriptPubKey to set of spkms
     std::unordered_map<CScript, std::vector<ScriptPubKeyMan*>, SaltedSipHasher> m_cached_spks;
 
+    //! Bits per entry for m_spk_filter; with two probes per lookup this gives
+    //! roughly a 1.5% false positive rate.
+    static constexpr size_t SPK_FILTER_BITS_PER_ENTRY{16};
+    //! Front-line negative-lookup filter over the keys of m_cached_spks. During
+    //! block processing nearly every scriptPubKey is not ours, so IsMine()
+    //! answers the common miss with two bit probes instead of a full cache
+    //! lookup. False positives fall through to m_cached_spks; scripts are only
+    //! ever added to the cache (all insertions go through
+    //! CacheNewScriptPubKeys()), so the filter never gives a false negative.
+    std::vector<uint64_t> m_spk_filter;
+    uint64_t m_spk_filter_mask{0};
+
+    void SpkFilterInsert(size_t hash);
+    bool SpkFilterMayContain(const CScript& script) const;
+    //! Size the filter for the current m_cached_spks and re-add every key.
+    void RebuildSpkFilter();
+
     /**
      * Catch wallet up to current chain, scanning new blocks, updating the best
      * block locator and m_last_block_processed, and registering for
@@ -483,9 +510,44 @@ public:
      * interested in, including received and sent transactions. */
     std::unordered_map<uint256, CWalletTx, SaltedTxidHasher> mapWallet GUARDED_BY(cs_wallet);
 
+    /** Generation of the wallet state for the benefit of the memoized
+     * GetBalance result in receive.cpp. Every state change that can affect
+     * balances (new or updated transactions, dirtied amount caches, mempool
+     * status changes, a new chain tip) bumps it via MarkBalanceDirty. */
+    uint64_t m_balance_generation GUARDED_BY(cs_wallet){1};
+    /** Memoized result of the last GetBalance call, together with the
+     * generation and arguments it was computed for. Owned here, maintained by
+     * GetBalance in receive.cpp. */
+    mutable std::shared_ptr<const Balance> m_cached_balance GUARDED_BY(cs_wallet);
+    mutable uint64_t m_cached_balance_generation GUARDED_BY(cs_wallet){0};
+    mutable int m_cached_balance_min_depth GUARDED_BY(cs_wallet){0};
+    mutable bool m_cached_balance_avoid_reuse GUARDED_BY(cs_wallet){true};
+
+    /** Invalidate the memoized balance. */
+    void MarkBalanceDirty() EXCLUSIVE_LOCKS_REQUIRED(cs_wallet)
+    {
+        AssertLockHeld(cs_wallet);
+        ++m_balance_generation;
+    }
+
     typedef std::multimap<int64_t, CWalletTx*> TxItems;
     TxItems wtxOrdered;
 
+    /** Inverted index over mapWallet: output scriptPubKey -> txids of wallet
+     * transactions with an output paying it, in insertion order (each txid at
+     * most once per script). Lets address-filtered RPCs visit only the
+     * matching transactions instead of scanning the whole wallet. */
+    std::unordered_map<CScript, std::vector<uint256>, SaltedSipHasher> m_txids_by_spk GUARDED_BY(cs_wallet);
+    /** Wallet txids keyed by the height that determines their visibility in
+     * height-windowed RPCs like listsinceblock: the confirmed height, the
+     * conflicting block height for conflicted transactions, or INT_MAX for
+     * everything else (unconfirmed transactions belong to every window). */
+    std::multimap<int, uint256> m_txs_by_height GUARDED_BY(cs_wallet);
+
+    /** Look up the txids with an output to the given script, or nullptr if
+     * the wallet has none. */
+    const std::vector<uint256>* GetTxidsBySpk(const CScript& script) const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+
     int64_t nOrderPosNext GUARDED_BY(cs_wallet) = 0;
 
     std::map<CTxDestination, CAddressBookData> m_address_book GUARDED_BY(cs_wallet);
@@ -607,7 +669,10 @@ public:
      * Add the transaction to the wallet, wrapping it up inside a CWalletTx
      * @return the recently added wtx pointer or nullptr if there was a db write error.
      */
-    CWalletTx* AddToWallet(CTransactionRef tx, const TxState& state, const UpdateWalletTxFn& update_wtx=nullptr, bool fFlushOnClose=true, bool rescanning_old_block = false);
+    //! @param[in] input_batch  When given, write through this batch (which may
+    //!                         carry a database transaction) instead of a
+    //!                         locally created one; fFlushOnClose is ignored.
+    CWalletTx* AddToWallet(CTransactionRef tx, const TxState& state, const UpdateWalletTxFn& update_wtx=nullptr, bool fFlushOnClose=true, bool rescanning_old_block = false, WalletBatch* input_batch = nullptr);
     bool LoadToWallet(const uint256& hash, const UpdateWalletTxFn& fill_wtx) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
     void transactionAddedToMempool(const CTransactionRef& tx) override;
     void blockConnected(ChainstateRole role, const interfaces::BlockInfo& block) override;
@@ -994,6 +1059,7 @@ public:
         AssertLockHeld(cs_wallet);
         m_last_block_processed_height = block_height;
         m_last_block_processed = block_hash;
+        MarkBalanceDirty(); // depths and maturity change with the tip
     };
 
     //! Connect the signals from ScriptPubKeyMans to the signals in CWallet
@@ -43,6 +43,7 @@ static std::multimap<std::string, CZMQAbstractPublishNotifier*> mapPublishNotifi
 static const char *MSG_HASHBLOCK = "hashblock";
 static const char *MSG_HASHTX    = "hashtx";
 static const char *MSG_RAWBLOCK  = "rawblock";
+static const char *MSG_BLOCKPOS  = "blockpos";
 static const char *MSG_RAWTX     = "rawtx";
 static const char *MSG_SEQUENCE  = "sequence";
 
@@ -217,6 +218,47 @@ bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, const void
     return true;
 }
 
+bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, std::shared_ptr<const std::vector<uint8_t>> payload)
+{
+    assert(psocket);
+
+    if (zmq_send(psocket, command, strlen(command), ZMQ_SNDMORE) == -1) {
+        zmqError("Unable to send ZMQ msg");
+        return false;
+    }
+
+    /* Hand the data part to libzmq by reference. Each socket's message holds
+       a reference to the shared buffer, which is released from libzmq's free
+       callback once the message has been sent. */
+    zmq_msg_t msg;
+    auto* owner = new std::shared_ptr<const std::vector<uint8_t>>(payload);
+    int rc = zmq_msg_init_data(
+        &msg, const_cast<uint8_t*>((*owner)->data()), (*owner)->size(),
+        [](void* /*data*/, void* hint) { delete static_cast<std::shared_ptr<const std::vector<uint8_t>>*>(hint); }, owner);
+    if (rc != 0) {
+        delete owner;
+        zmqError("Unable to initialize ZMQ msg");
+        return false;
+    }
+    if (zmq_msg_send(&msg, psocket, ZMQ_SNDMORE) == -1) {
+        zmqError("Unable to send ZMQ msg");
+        zmq_msg_close(&msg);
+        return false;
+    }
+
+    unsigned char msgseq[sizeof(uint32_t)];
+    WriteLE32(msgseq, nSequence);
+    if (zmq_send(psocket, msgseq, sizeof(msgseq), 0) == -1) {
+        zmqError("Unable to send ZMQ msg");
+        return false;
+    }
+
+    /* increment memory only sequence number after sending */
+    nSequence++;
+
+    return true;
+}
+
 bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
 {
     uint256 hash = pindex->GetBlockHash();
@@ -243,22 +285,60 @@ bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
 {
     LogDebug(BCLog::ZMQ, "Publish rawblock %s to %s\n", pindex->GetBlockHash().GetHex(), this->address);
 
-    std::vector<uint8_t> block{};
-    if (!m_get_block_by_index(block, *pindex)) {
-        zmqError("Can't read block from disk");
+    // All notifiers run back-to-back on the validation callback thread, so
+    // when several rawblock sockets are configured the same block would be
+    // read from disk and serialized once per socket. Cache the most recent
+    // block and share the buffer across sockets.
+    static uint256 cached_hash;
+    static std::shared_ptr<const std::vector<uint8_t>> cached_block;
+    if (!cached_block || cached_hash != pindex->GetBlockHash()) {
+        std::vector<uint8_t> block{};
+        if (!m_get_block_by_index(block, *pindex)) {
+            zmqError("Can't read block from disk");
+            return false;
+        }
+        cached_hash = pindex->GetBlockHash();
+        cached_block = std::make_shared<const std::vector<uint8_t>>(std::move(block));
+    }
+
+    return SendZmqMessage(MSG_RAWBLOCK, cached_block);
+}
+
+bool CZMQPublishBlockPosNotifier::NotifyBlock(const CBlockIndex *pindex)
+{
+    const uint256 hash{pindex->GetBlockHash()};
+    const FlatFilePos pos{WITH_LOCK(cs_main, return pindex->GetBlockPos())};
+    if (pos.IsNull()) {
+        // Block data not on disk (yet); nothing a co-located reader could map.
+        zmqError("Can't publish position of a block without block data");
         return false;
     }
+    LogDebug(BCLog::ZMQ, "Publish blockpos %s (blk%05u.dat offset %u) to %s\n", hash.GetHex(), pos.nFile, pos.nPos, this->address);
 
-    return SendZmqMessage(MSG_RAWBLOCK, block.data(), block.size());
+    uint8_t data[32 + 8];
+    for (unsigned int i = 0; i < 32; i++) {
+        data[31 - i] = hash.begin()[i];
+    }
+    WriteLE32(data + 32, pos.nFile);
+    WriteLE32(data + 36, pos.nPos);
+    return SendZmqMessage(MSG_BLOCKPOS, data, sizeof(data));
 }
 
 bool CZMQPublishRawTransactionNotifier::NotifyTransaction(const CTransaction &transaction)
 {
     uint256 hash = transaction.GetHash();
     LogDebug(BCLog::ZMQ, "Publish rawtx %s to %s\n", hash.GetHex(), this->address);
-    DataStream ss;
-    ss << TX_WITH_WITNESS(transaction);
-    return SendZmqMessage(MSG_RAWTX, &(*ss.begin()), ss.size());
+    // As with rawblock, serialize each transaction once and share the buffer
+    // between all configured rawtx sockets.
+    static uint256 cached_wtxid;
+    static std::shared_ptr<const std::vector<uint8_t>> cached_tx;
+    if (!cached_tx || cached_wtxid != transaction.GetWitnessHash()) {
+        DataStream ss;
+        ss << TX_WITH_WITNESS(transaction);
+        cached_wtxid = transaction.GetWitnessHash();
+        cached_tx = std::make_shared<const std::vector<uint8_t>>(UCharCast(ss.data()), UCharCast(ss.data()) + ss.size());
+    }
+    return SendZmqMessage(MSG_RAWTX, cached_tx);
 }
 
 // Helper function to send a 'sequence' topic message with the following structure:
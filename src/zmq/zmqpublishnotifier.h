@@ -10,6 +10,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <vector>
 
 class CBlockIndex;
@@ -30,6 +31,12 @@ public:
     */
     bool SendZmqMessage(const char *command, const void* data, size_t size);
 
+    /* send zmq multipart message whose data part is a shared buffer.
+       The buffer is handed to libzmq by reference instead of being copied
+       into the message, so several sockets publishing the same block or
+       transaction share one serialization. */
+    bool SendZmqMessage(const char *command, std::shared_ptr<const std::vector<uint8_t>> payload);
+
     bool Initialize(void *pcontext) override;
     void Shutdown() override;
 };
@@ -57,6 +64,17 @@ public:
     bool NotifyBlock(const CBlockIndex *pindex) override;
 };
 
+/** Publishes the flat-file location of each connected block instead of its
+ * serialized bytes. Consumers on the same host can read (or mmap) the block
+ * directly from the blocks/blk*.dat file, avoiding the serialize/copy/
+ * deserialize round trip of rawblock. Not available when pruning: the files
+ * being referenced could be deleted at any time. */
+class CZMQPublishBlockPosNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyBlock(const CBlockIndex *pindex) override;
+};
+
 class CZMQPublishRawTransactionNotifier : public CZMQAbstractPublishNotifier
 {
 public: